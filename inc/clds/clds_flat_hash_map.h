@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_FLAT_HASH_MAP_H
+#define CLDS_FLAT_HASH_MAP_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "c_pal/interlocked.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct CLDS_FLAT_HASH_MAP_TAG* CLDS_FLAT_HASH_MAP_HANDLE;
+
+struct CLDS_FLAT_HASH_MAP_ITEM_TAG;
+
+typedef void(*FLAT_HASH_MAP_ITEM_CLEANUP_CB)(void* context, struct CLDS_FLAT_HASH_MAP_ITEM_TAG* item);
+
+// key value that marks an unused slot, it cannot be inserted in the map
+#define CLDS_FLAT_HASH_MAP_EMPTY_KEY 0
+
+// this is the structure needed for one flat hash map item (the map only stores pointers to items)
+typedef struct CLDS_FLAT_HASH_MAP_ITEM_TAG
+{
+    // these are internal variables used by the flat hash map
+    volatile_atomic int32_t ref_count;
+    FLAT_HASH_MAP_ITEM_CLEANUP_CB item_cleanup_callback;
+    void* item_cleanup_callback_context;
+} CLDS_FLAT_HASH_MAP_ITEM;
+
+// these are macros that help declaring a type that can be stored in the flat hash map
+#define DECLARE_FLAT_HASH_MAP_NODE_TYPE(record_type) \
+typedef struct MU_C3(FLAT_HASH_MAP_NODE_,record_type,_TAG) \
+{ \
+    CLDS_FLAT_HASH_MAP_ITEM item; \
+    record_type record; \
+} MU_C2(FLAT_HASH_MAP_NODE_,record_type); \
+
+#define CLDS_FLAT_HASH_MAP_NODE_CREATE(record_type, item_cleanup_callback, item_cleanup_callback_context) \
+clds_flat_hash_map_node_create(sizeof(MU_C2(FLAT_HASH_MAP_NODE_,record_type)), item_cleanup_callback, item_cleanup_callback_context)
+
+#define CLDS_FLAT_HASH_MAP_NODE_INC_REF(record_type, ptr) \
+clds_flat_hash_map_node_inc_ref(ptr)
+
+#define CLDS_FLAT_HASH_MAP_NODE_RELEASE(record_type, ptr) \
+clds_flat_hash_map_node_release(ptr)
+
+#define CLDS_FLAT_HASH_MAP_GET_VALUE(record_type, ptr) \
+((record_type*)((unsigned char*)ptr + offsetof(MU_C2(FLAT_HASH_MAP_NODE_,record_type), record)))
+
+#define CLDS_FLAT_HASH_MAP_INSERT_RESULT_VALUES \
+    CLDS_FLAT_HASH_MAP_INSERT_OK, \
+    CLDS_FLAT_HASH_MAP_INSERT_ERROR, \
+    CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS, \
+    CLDS_FLAT_HASH_MAP_INSERT_FULL
+
+MU_DEFINE_ENUM(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_RESULT_VALUES);
+
+#define CLDS_FLAT_HASH_MAP_DELETE_RESULT_VALUES \
+    CLDS_FLAT_HASH_MAP_DELETE_OK, \
+    CLDS_FLAT_HASH_MAP_DELETE_ERROR, \
+    CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND
+
+MU_DEFINE_ENUM(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_RESULT_VALUES);
+
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_MAP_HANDLE, clds_flat_hash_map_create, uint32_t, capacity, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
+MOCKABLE_FUNCTION(, void, clds_flat_hash_map_destroy, CLDS_FLAT_HASH_MAP_HANDLE, clds_flat_hash_map);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_MAP_INSERT_RESULT, clds_flat_hash_map_insert, CLDS_FLAT_HASH_MAP_HANDLE, clds_flat_hash_map, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, key, CLDS_FLAT_HASH_MAP_ITEM*, item);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_MAP_DELETE_RESULT, clds_flat_hash_map_delete, CLDS_FLAT_HASH_MAP_HANDLE, clds_flat_hash_map, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, key);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_MAP_ITEM*, clds_flat_hash_map_find, CLDS_FLAT_HASH_MAP_HANDLE, clds_flat_hash_map, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, key);
+
+// helper APIs for creating/destroying a flat hash map node
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_MAP_ITEM*, clds_flat_hash_map_node_create, size_t, node_size, FLAT_HASH_MAP_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
+MOCKABLE_FUNCTION(, int, clds_flat_hash_map_node_inc_ref, CLDS_FLAT_HASH_MAP_ITEM*, item);
+MOCKABLE_FUNCTION(, void, clds_flat_hash_map_node_release, CLDS_FLAT_HASH_MAP_ITEM*, item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_FLAT_HASH_MAP_H */
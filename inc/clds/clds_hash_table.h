@@ -7,6 +7,7 @@
 #include <cstdint>
 #else
 #include <stdint.h>
+#include <stdbool.h>
 #endif
 
 #include "c_pal/thandle.h"
@@ -25,6 +26,7 @@ extern "C" {
 struct CLDS_HASH_TABLE_ITEM_TAG;
 
 typedef struct CLDS_HASH_TABLE_TAG* CLDS_HASH_TABLE_HANDLE;
+typedef struct CLDS_HASH_TABLE_ITERATOR_TAG* CLDS_HASH_TABLE_ITERATOR_HANDLE;
 typedef uint64_t (*COMPUTE_HASH_FUNC)(void* key);
 typedef int (*KEY_COMPARE_FUNC)(void* key_1, void* key_2);
 typedef void(*HASH_TABLE_ITEM_CLEANUP_CB)(void* context, struct CLDS_HASH_TABLE_ITEM_TAG* item);
@@ -36,12 +38,24 @@ typedef struct HASH_TABLE_ITEM_TAG
     HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback;
     void* item_cleanup_callback_context;
     void* key;
+    // used by clds_hash_table_snapshot_concurrent: the snapshot epoch when the item was inserted (or taken by a snapshot)
+    volatile_atomic int64_t snapshot_epoch;
 } HASH_TABLE_ITEM;
 
 DECLARE_SORTED_LIST_NODE_TYPE(HASH_TABLE_ITEM)
 
 typedef struct SORTED_LIST_NODE_HASH_TABLE_ITEM_TAG CLDS_HASH_TABLE_ITEM;
 
+typedef void(*HASH_TABLE_FIND_VISIT_CB)(void* context, CLDS_HASH_TABLE_ITEM* item);
+typedef CLDS_HASH_TABLE_ITEM*(*HASH_TABLE_ITEM_FACTORY_CB)(void* context, void* key);
+
+// callbacks used for writing a snapshot image and restoring a table from it, a record is the serialized form of an item (key and value)
+typedef uint32_t(*HASH_TABLE_GET_RECORD_SIZE_CB)(void* context, CLDS_HASH_TABLE_ITEM* item);
+typedef int(*HASH_TABLE_SERIALIZE_RECORD_CB)(void* context, CLDS_HASH_TABLE_ITEM* item, unsigned char* record, uint32_t record_size);
+typedef int(*HASH_TABLE_WRITE_SNAPSHOT_IMAGE_CB)(void* context, uint64_t offset, const void* buffer, size_t buffer_size);
+typedef CLDS_HASH_TABLE_ITEM*(*HASH_TABLE_DESERIALIZE_RECORD_CB)(void* context, const unsigned char* record, uint32_t record_size, void** key);
+typedef bool(*HASH_TABLE_RECORD_MATCH_CB)(void* context, void* key, const unsigned char* record, uint32_t record_size);
+
 // these are macros that help declaring a type that can be stored in the hash table
 #define DECLARE_HASH_TABLE_NODE_TYPE(record_type) \
 typedef struct MU_C3(HASH_TABLE_NODE_,record_type,_TAG) \
@@ -97,16 +111,102 @@ MU_DEFINE_ENUM(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESUL
 
 MU_DEFINE_ENUM(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
 
+#define CLDS_HASH_TABLE_ITERATE_RESULT_VALUES \
+    CLDS_HASH_TABLE_ITERATE_OK, \
+    CLDS_HASH_TABLE_ITERATE_ERROR, \
+    CLDS_HASH_TABLE_ITERATE_END
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_RESULT_VALUES);
+
+#define CLDS_HASH_TABLE_MIGRATE_RESULT_VALUES \
+    CLDS_HASH_TABLE_MIGRATE_OK, \
+    CLDS_HASH_TABLE_MIGRATE_ERROR, \
+    CLDS_HASH_TABLE_MIGRATE_BUSY, \
+    CLDS_HASH_TABLE_MIGRATE_COMPLETE
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_RESULT_VALUES);
+
+#define CLDS_HASH_TABLE_SHRINK_RESULT_VALUES \
+    CLDS_HASH_TABLE_SHRINK_OK, \
+    CLDS_HASH_TABLE_SHRINK_ERROR, \
+    CLDS_HASH_TABLE_SHRINK_BUSY, \
+    CLDS_HASH_TABLE_SHRINK_NOT_NEEDED
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_RESULT_VALUES);
+
+#define CLDS_HASH_TABLE_RESERVE_RESULT_VALUES \
+    CLDS_HASH_TABLE_RESERVE_OK, \
+    CLDS_HASH_TABLE_RESERVE_ERROR, \
+    CLDS_HASH_TABLE_RESERVE_BUSY, \
+    CLDS_HASH_TABLE_RESERVE_NOT_NEEDED
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_RESULT_VALUES);
+
+#define CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT_VALUES \
+    CLDS_HASH_TABLE_FIND_AND_VISIT_OK, \
+    CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR, \
+    CLDS_HASH_TABLE_FIND_AND_VISIT_NOT_FOUND
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT_VALUES);
+
+#define CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT_VALUES \
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_OK, \
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, \
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_NOT_FOUND
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT_VALUES);
+
+#define CLDS_HASH_TABLE_HASH_FINALIZER_VALUES \
+    CLDS_HASH_TABLE_HASH_FINALIZER_NONE, \
+    CLDS_HASH_TABLE_HASH_FINALIZER_MIX64
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_HASH_FINALIZER, CLDS_HASH_TABLE_HASH_FINALIZER_VALUES);
+
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_HANDLE, clds_hash_table_create, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile_atomic int64_t*, start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_HANDLE, clds_hash_table_create_with_hash_finalizer, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile_atomic int64_t*, start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context, CLDS_HASH_TABLE_HASH_FINALIZER, hash_finalizer);
 MOCKABLE_FUNCTION(, void, clds_hash_table_destroy, CLDS_HASH_TABLE_HANDLE, clds_hash_table);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_hash_table_insert, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+// single traversal insert variants that hand back the item already in the table instead of only reporting that the key exists
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_hash_table_get_or_insert, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, CLDS_HASH_TABLE_ITEM**, existing_item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_hash_table_compute_if_absent, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, HASH_TABLE_ITEM_FACTORY_CB, item_factory, void*, item_factory_context, CLDS_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_hash_table_delete, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_hash_table_delete_key_value, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_REMOVE_RESULT, clds_hash_table_remove, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SET_VALUE_RESULT, clds_hash_table_set_value, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, new_item, CONDITION_CHECK_CB, condition_check_func, void*, condition_check_context, CLDS_HASH_TABLE_ITEM**, old_item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITEM*, clds_hash_table_find, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+// the item is only protected by a hazard pointer while visit_cb is called, it must not be used after visit_cb returns
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, clds_hash_table_find_and_visit, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, HASH_TABLE_FIND_VISIT_CB, visit_cb, void*, visit_cb_context);
+
+// batched versions of find/insert/delete, the result for each key is stored at the same index as the key
+MOCKABLE_FUNCTION(, int, clds_hash_table_find_batch, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void**, keys, uint32_t, key_count, CLDS_HASH_TABLE_ITEM**, items);
+MOCKABLE_FUNCTION(, int, clds_hash_table_insert_batch, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void**, keys, CLDS_HASH_TABLE_ITEM**, values, uint32_t, key_count, CLDS_HASH_TABLE_INSERT_RESULT*, results, int64_t*, sequence_numbers);
+MOCKABLE_FUNCTION(, int, clds_hash_table_delete_batch, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void**, keys, uint32_t, key_count, CLDS_HASH_TABLE_DELETE_RESULT*, results, int64_t*, sequence_numbers);
 
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count, THANDLE(CANCELLATION_TOKEN), cancellation_token);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_concurrent, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count, int64_t*, sequence_number, THANDLE(CANCELLATION_TOKEN), cancellation_token);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_parallel, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint32_t, worker_count, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count, THANDLE(CANCELLATION_TOKEN), cancellation_token);
+
+// APIs for walking the table in pages, without allocating memory for all the items
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITERATOR_HANDLE, clds_hash_table_iterate_begin, CLDS_HASH_TABLE_HANDLE, clds_hash_table);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITERATE_RESULT, clds_hash_table_iterate_next, CLDS_HASH_TABLE_ITERATOR_HANDLE, iterator, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM**, items, uint32_t, max_item_count, uint32_t*, item_count);
+MOCKABLE_FUNCTION(, void, clds_hash_table_iterate_end, CLDS_HASH_TABLE_ITERATOR_HANDLE, iterator);
+
+// APIs for moving items out of the older arrays of buckets
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_MIGRATE_RESULT, clds_hash_table_migrate, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint32_t, bucket_budget);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_migration_budget, CLDS_HASH_TABLE_HANDLE, clds_hash_table, uint32_t, bucket_budget);
+// shrink decides on the item count of all the bucket arrays, then moves all the items to the smaller bucket array before returning
+// (with the default migration bucket budget of 0 nothing else would move them unless the caller calls clds_hash_table_migrate)
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SHRINK_RESULT, clds_hash_table_shrink, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread);
+
+// APIs for loading a large number of items at once, for example when a table is rebuilt at startup
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_RESERVE_RESULT, clds_hash_table_reserve, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, item_count);
+MOCKABLE_FUNCTION(, int, clds_hash_table_bulk_load, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint32_t, worker_count, void**, keys, CLDS_HASH_TABLE_ITEM**, values, uint32_t, key_count, CLDS_HASH_TABLE_INSERT_RESULT*, results, int64_t*, sequence_numbers);
+
+// APIs for snapshot images: the items of a snapshot laid out so that the image can be saved in a file and used in place once the file is mapped in memory
+MOCKABLE_FUNCTION(, int, clds_hash_table_snapshot_image_write, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HASH_TABLE_ITEM**, items, uint64_t, item_count, int64_t, sequence_number, HASH_TABLE_GET_RECORD_SIZE_CB, get_record_size, HASH_TABLE_SERIALIZE_RECORD_CB, serialize_record, void*, serialize_context, HASH_TABLE_WRITE_SNAPSHOT_IMAGE_CB, write_image, void*, write_image_context, uint64_t*, image_size);
+MOCKABLE_FUNCTION(, int, clds_hash_table_snapshot_image_get_info, const void*, image, uint64_t, image_size, uint64_t*, record_count, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, clds_hash_table_snapshot_image_find, CLDS_HASH_TABLE_HANDLE, clds_hash_table, const void*, image, uint64_t, image_size, void*, key, HASH_TABLE_RECORD_MATCH_CB, record_match, void*, record_match_context, const unsigned char**, record, uint32_t*, record_size);
+MOCKABLE_FUNCTION(, int, clds_hash_table_restore, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint32_t, worker_count, const void*, image, uint64_t, image_size, HASH_TABLE_DESERIALIZE_RECORD_CB, deserialize_record, void*, deserialize_context, int64_t*, sequence_number);
 
 // helper APIs for creating/destroying a hash table node
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITEM*, clds_hash_table_node_create, size_t, node_size, HASH_TABLE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
@@ -11,6 +11,8 @@
 #include <stddef.h>
 #endif
 
+#include "macro_utils/macro_utils.h"
+
 #include "umock_c/umock_c_prod.h"
 #ifdef __cplusplus
 extern "C" {
@@ -21,15 +23,29 @@ typedef struct CLDS_HAZARD_POINTERS_THREAD_TAG* CLDS_HAZARD_POINTERS_THREAD_HAND
 typedef struct CLDS_HAZARD_POINTER_RECORD_TAG* CLDS_HAZARD_POINTER_RECORD_HANDLE;
 
 typedef void(*RECLAIM_FUNC)(void* node);
+typedef void(*RECLAIM_BATCH_FUNC)(void** nodes, size_t node_count);
+
+#define CLDS_HAZARD_POINTERS_RECLAMATION_MODE_VALUES \
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, \
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH
+
+MU_DEFINE_ENUM(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_VALUES);
 
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers_create);
+MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers_create_with_reclamation_mode, CLDS_HAZARD_POINTERS_RECLAMATION_MODE, reclamation_mode);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_destroy, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_register_thread, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_unregister_thread, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread);
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointers_acquire, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_release, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointer_record);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_reclaim, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node, RECLAIM_FUNC, reclaim_func);
+MOCKABLE_FUNCTION(, void, clds_hazard_pointers_reclaim_batched, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node, RECLAIM_BATCH_FUNC, reclaim_batch_func);
 MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_reclaim_threshold, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, size_t, reclaim_threshold);
+// Hazard pointer mode only: the reclaim threshold of each thread becomes twice the number of hazard pointers seen by its last reclaim cycle,
+// capped at max_reclaim_threshold. In epoch mode the threshold set by clds_hazard_pointers_set_reclaim_threshold applies.
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_adaptive_reclaim_threshold, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, size_t, max_reclaim_threshold);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_get_reclaim_backlog, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, uint64_t*, reclaim_backlog);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_async_reclaim, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, size_t, max_reclaim_backlog);
 
 #ifdef __cplusplus
 }
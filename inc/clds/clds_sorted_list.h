@@ -36,6 +36,9 @@ typedef int(*SORTED_LIST_KEY_COMPARE_CB)(void* context, void* key1, void* key2);
 typedef void(*SORTED_LIST_ITEM_CLEANUP_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item);
 typedef void(*SORTED_LIST_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
 typedef CLDS_CONDITION_CHECK_RESULT (*CONDITION_CHECK_CB)(void* context, void* new_key, void* old_key);
+typedef bool(*SORTED_LIST_VISIT_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item);
+typedef void(*SORTED_LIST_FIND_VISIT_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item);
+typedef struct CLDS_SORTED_LIST_ITEM_TAG*(*SORTED_LIST_ITEM_FACTORY_CB)(void* context, void* key);
 
 // this is the structure needed for one sorted list item
 // it contains information like ref count, next pointer, etc.
@@ -48,6 +51,35 @@ typedef struct CLDS_SORTED_LIST_ITEM_TAG
     struct CLDS_SORTED_LIST_ITEM_TAG* volatile_atomic next;
 } CLDS_SORTED_LIST_ITEM;
 
+// this is the configuration (callbacks and sequence number) of a sorted list
+// several lists can share one configuration, for example all the buckets of a hash table
+typedef struct CLDS_SORTED_LIST_CONFIG_TAG
+{
+    // these are internal variables used by the sorted list
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb;
+    void* get_item_key_cb_context;
+    SORTED_LIST_KEY_COMPARE_CB key_compare_cb;
+    void* key_compare_cb_context;
+    volatile_atomic int64_t* sequence_number;
+    SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
+    void* skipped_seq_no_cb_context;
+} CLDS_SORTED_LIST_CONFIG;
+
+// this is the state of one sorted list, it is exposed so that lists can be embedded in the memory of their owner
+// (clds_sorted_list_init) instead of being allocated one by one (clds_sorted_list_create)
+typedef struct CLDS_SORTED_LIST_TAG
+{
+    // these are internal variables used by the sorted list
+    const CLDS_SORTED_LIST_CONFIG* config;
+    volatile_atomic CLDS_SORTED_LIST_ITEM* head;
+
+    // Support for locking the list for writes
+    volatile_atomic int32_t locked_for_write;
+    volatile_atomic int32_t pending_write_operations;
+    volatile_atomic int32_t write_lock_waiters; // writers only wake when someone waits in internal_lock_writes
+} CLDS_SORTED_LIST;
+
 // these are macros that help declaring a type that can be stored in the sorted list
 #define DECLARE_SORTED_LIST_NODE_TYPE(record_type) \
 typedef struct MU_C3(SORTED_LIST_NODE_,record_type,_TAG) \
@@ -112,15 +144,39 @@ MU_DEFINE_ENUM(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_COUNT_RES
 
 MU_DEFINE_ENUM(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_RESULT_VALUES);
 
+#define CLDS_SORTED_LIST_VISIT_RESULT_VALUES \
+    CLDS_SORTED_LIST_VISIT_OK, \
+    CLDS_SORTED_LIST_VISIT_ERROR, \
+    CLDS_SORTED_LIST_VISIT_STOPPED
+
+MU_DEFINE_ENUM(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+
+#define CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT_VALUES \
+    CLDS_SORTED_LIST_FIND_AND_VISIT_OK, \
+    CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR, \
+    CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND
+
+MU_DEFINE_ENUM(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT_VALUES);
+
 // sorted list API
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_HANDLE, clds_sorted_list_create, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB, get_item_key_cb, void*, get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB, key_compare_cb, void*, key_compare_cb_context, volatile_atomic int64_t*, start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
 MOCKABLE_FUNCTION(, void, clds_sorted_list_destroy, CLDS_SORTED_LIST_HANDLE, clds_sorted_list);
 
+// embedded lists: the configuration and the list state live in memory owned by the caller
+MOCKABLE_FUNCTION(, int, clds_sorted_list_config_init, CLDS_SORTED_LIST_CONFIG*, config, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB, get_item_key_cb, void*, get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB, key_compare_cb, void*, key_compare_cb_context, volatile_atomic int64_t*, start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
+MOCKABLE_FUNCTION(, void, clds_sorted_list_init, CLDS_SORTED_LIST*, clds_sorted_list, const CLDS_SORTED_LIST_CONFIG*, config);
+MOCKABLE_FUNCTION(, void, clds_sorted_list_deinit, CLDS_SORTED_LIST*, clds_sorted_list);
+
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_INSERT_RESULT, clds_sorted_list_insert, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
+// insert variants that hand back the item already in the list instead of only reporting that the key exists
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_INSERT_RESULT, clds_sorted_list_get_or_insert, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, CLDS_SORTED_LIST_ITEM**, existing_item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_INSERT_RESULT, clds_sorted_list_compute_if_absent, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, SORTED_LIST_ITEM_FACTORY_CB, item_factory, void*, item_factory_context, CLDS_SORTED_LIST_ITEM**, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_delete_item, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_delete_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_REMOVE_RESULT, clds_sorted_list_remove_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SORTED_LIST_ITEM**, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_ITEM*, clds_sorted_list_find_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+// Finds key and calls visit_cb for the item while it is only protected by a hazard pointer, no reference is taken on the item
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, clds_sorted_list_find_key_and_visit, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, SORTED_LIST_FIND_VISIT_CB, visit_cb, void*, visit_cb_context);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_SET_VALUE_RESULT, clds_sorted_list_set_value, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SORTED_LIST_ITEM*, new_item, CONDITION_CHECK_CB, condition_check_func, void*, condition_check_context, CLDS_SORTED_LIST_ITEM**, old_item, int64_t*, sequence_number, bool, only_if_exists);
 
 // Helpers to take a snapshot of the list
@@ -129,6 +185,9 @@ MOCKABLE_FUNCTION(, void, clds_sorted_list_unlock_writes, CLDS_SORTED_LIST_HANDL
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_COUNT_RESULT, clds_sorted_list_get_count, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t*, item_count);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_ALL_RESULT, clds_sorted_list_get_all, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, item_count, CLDS_SORTED_LIST_ITEM**, items, uint64_t*, retrieved_item_count, bool, require_locked_list);
 
+// Walks the list while writes are in progress, each item is only protected by a hazard pointer while visit_cb is called for it
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_VISIT_RESULT, clds_sorted_list_visit, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB, visit_cb, void*, visit_cb_context);
+
 // helper APIs for creating/destroying a sorted list node
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_ITEM*, clds_sorted_list_node_create, size_t, node_size, SORTED_LIST_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
 MOCKABLE_FUNCTION(, int, clds_sorted_list_node_inc_ref, CLDS_SORTED_LIST_ITEM*, item);
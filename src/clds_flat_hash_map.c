@@ -0,0 +1,667 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <emmintrin.h>
+#endif
+
+#include "c_logging/logger.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/sync.h"
+#include "c_pal/interlocked.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#include "clds/clds_flat_hash_map.h"
+
+MU_DEFINE_ENUM_STRINGS(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_RESULT_VALUES);
+
+/* this is a lock free open addressing hash map, keys live inline in the slot array and items are reclaimed with hazard pointers */
+
+#define MAX_FLAT_HASH_MAP_CAPACITY ((uint32_t)1 << 31)
+
+// marks a slot whose item was deleted, the key stays in the slot so that probe sequences are not broken
+// the tombstone is tagged with the generation of the slot, so that a compare exchange from a tombstone read
+// before the slot was reused for another key (and deleted again) fails
+#define FLAT_HASH_MAP_TOMBSTONE(generation) ((CLDS_FLAT_HASH_MAP_ITEM*)((((uintptr_t)(uint32_t)(generation)) << 1) | 0x1))
+
+// marks a tombstoned slot that an insert is reusing for another key
+#define FLAT_HASH_MAP_CLAIMED ((CLDS_FLAT_HASH_MAP_ITEM*)(uintptr_t)0x2)
+
+#define FLAT_HASH_MAP_CLAIM_STRIPE_BITS 4
+#define FLAT_HASH_MAP_CLAIM_STRIPE_COUNT (1 << FLAT_HASH_MAP_CLAIM_STRIPE_BITS)
+#define CACHE_LINE_SIZE 64
+
+// an insert finding the claim sequence of its stripe odd checks it this many times before it goes to sleep
+#define CLAIM_SEQUENCE_SPIN_COUNT 1024
+
+// tells the core that this is a spin loop, so that it does not hog the pipeline shared with its sibling hyperthread while it waits
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#define CPU_PAUSE() __builtin_ia32_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define CPU_PAUSE() __asm__ __volatile__("yield")
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define CPU_PAUSE() _mm_pause()
+#else
+#define CPU_PAUSE() ((void)0)
+#endif
+
+typedef struct FLAT_HASH_MAP_SLOT_TAG
+{
+    // CLDS_FLAT_HASH_MAP_EMPTY_KEY until a key claims the slot, afterwards it changes only while the item is FLAT_HASH_MAP_CLAIMED
+    volatile_atomic int64_t key;
+    // NULL (never had an item), a tombstone (deleted), FLAT_HASH_MAP_CLAIMED (being reused) or a live item
+    CLDS_FLAT_HASH_MAP_ITEM* volatile_atomic item;
+    // incremented each time the slot is reused for another key
+    volatile_atomic int32_t generation;
+} FLAT_HASH_MAP_SLOT;
+
+// inserts that give a slot to a key not in the map serialize on the stripe of the start slot of the key,
+// so that 2 inserts of the same key cannot both find it missing and claim 2 different slots
+typedef struct FLAT_HASH_MAP_CLAIM_STRIPE_TAG
+{
+    // odd while an insert gives a slot to a key of the stripe, advanced by 2 for each such insert
+    volatile_atomic int32_t claim_sequence;
+    // number of inserts sleeping until claim_sequence changes
+    volatile_atomic int32_t claim_waiters;
+    uint8_t padding[CACHE_LINE_SIZE - 2 * sizeof(int32_t)];
+} FLAT_HASH_MAP_CLAIM_STRIPE;
+
+typedef struct CLDS_FLAT_HASH_MAP_TAG
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    uint32_t capacity;
+    FLAT_HASH_MAP_CLAIM_STRIPE claim_stripes[FLAT_HASH_MAP_CLAIM_STRIPE_COUNT];
+    FLAT_HASH_MAP_SLOT slots[];
+} CLDS_FLAT_HASH_MAP;
+
+static void internal_node_destroy(CLDS_FLAT_HASH_MAP_ITEM* item)
+{
+    if (interlocked_decrement(&item->ref_count) == 0)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_047: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed item. ]*/
+        if (item->item_cleanup_callback != NULL)
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_046: [ When the reference count reaches 0, the user callback item_cleanup_callback that was passed to clds_flat_hash_map_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments, and then the item shall be freed. ]*/
+            item->item_cleanup_callback(item->item_cleanup_callback_context, item);
+        }
+
+        free((void*)item);
+    }
+}
+
+static void reclaim_flat_hash_map_items(void** nodes, size_t node_count)
+{
+    for (size_t i = 0; i < node_count; i++)
+    {
+        internal_node_destroy((CLDS_FLAT_HASH_MAP_ITEM*)nodes[i]);
+    }
+}
+
+static uint32_t compute_start_slot(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map, uint64_t key)
+{
+    // the 64 bit finalizer from MurmurHash3, spreads sequential keys over the whole slot array
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+
+    return (uint32_t)(key & (clds_flat_hash_map->capacity - 1));
+}
+
+static bool is_live_item(CLDS_FLAT_HASH_MAP_ITEM* item)
+{
+    // items are at least pointer aligned, tombstones and FLAT_HASH_MAP_CLAIMED are not
+    return ((item != NULL) && (((uintptr_t)item & 0x3) == 0));
+}
+
+static bool is_tombstone(CLDS_FLAT_HASH_MAP_ITEM* item)
+{
+    return (((uintptr_t)item & 0x1) != 0);
+}
+
+static CLDS_FLAT_HASH_MAP_ITEM* read_slot(FLAT_HASH_MAP_SLOT* slot, int64_t* slot_key)
+{
+    // the item is read before the key: the key only changes while the item is FLAT_HASH_MAP_CLAIMED,
+    // so a tombstone read first was left by the key read afterwards (or a later compare exchange from it fails)
+    CLDS_FLAT_HASH_MAP_ITEM* item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&slot->item, NULL, NULL);
+    *slot_key = interlocked_add_64(&slot->key, 0);
+    return item;
+}
+
+static bool read_claim_sequences(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map, int32_t claim_sequences[FLAT_HASH_MAP_CLAIM_STRIPE_COUNT])
+{
+    bool result = true;
+
+    for (uint32_t i = 0; i < FLAT_HASH_MAP_CLAIM_STRIPE_COUNT; i++)
+    {
+        claim_sequences[i] = interlocked_add(&clds_flat_hash_map->claim_stripes[i].claim_sequence, 0);
+        if ((claim_sequences[i] & 1) != 0)
+        {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+static bool claim_sequences_changed(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map, const int32_t claim_sequences[FLAT_HASH_MAP_CLAIM_STRIPE_COUNT])
+{
+    bool result = false;
+
+    for (uint32_t i = 0; i < FLAT_HASH_MAP_CLAIM_STRIPE_COUNT; i++)
+    {
+        if (interlocked_add(&clds_flat_hash_map->claim_stripes[i].claim_sequence, 0) != claim_sequences[i])
+        {
+            result = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map_create(uint32_t capacity, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+{
+    CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_002: [ If capacity is 0, clds_flat_hash_map_create shall fail and return NULL. ]*/
+        (capacity == 0) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_003: [ If capacity is greater than 2^31, clds_flat_hash_map_create shall fail and return NULL. ]*/
+        (capacity > MAX_FLAT_HASH_MAP_CAPACITY) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_004: [ If clds_hazard_pointers is NULL, clds_flat_hash_map_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL)
+        )
+    {
+        LogError("Invalid arguments: uint32_t capacity=%" PRIu32 ", CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p",
+            capacity, clds_hazard_pointers);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_005: [ clds_flat_hash_map_create shall round capacity up to the next power of 2. ]*/
+        uint32_t slot_count = 1;
+        while (slot_count < capacity)
+        {
+            slot_count <<= 1;
+        }
+
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_001: [ clds_flat_hash_map_create shall create a new flat hash map object with an array of slot_count slots and on success it shall return a non-NULL handle to the newly created flat hash map. ]*/
+        clds_flat_hash_map = malloc_flex(sizeof(CLDS_FLAT_HASH_MAP), slot_count, sizeof(FLAT_HASH_MAP_SLOT));
+        if (clds_flat_hash_map == NULL)
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_007: [ If any error happens, clds_flat_hash_map_create shall fail and return NULL. ]*/
+            LogError("Cannot allocate memory for flat hash map. Failure in malloc_flex(sizeof(CLDS_FLAT_HASH_MAP)=%zu, slot_count=%" PRIu32 ", sizeof(FLAT_HASH_MAP_SLOT)=%zu);",
+                sizeof(CLDS_FLAT_HASH_MAP), slot_count, sizeof(FLAT_HASH_MAP_SLOT));
+        }
+        else
+        {
+            clds_flat_hash_map->clds_hazard_pointers = clds_hazard_pointers;
+            clds_flat_hash_map->capacity = slot_count;
+
+            for (uint32_t i = 0; i < FLAT_HASH_MAP_CLAIM_STRIPE_COUNT; i++)
+            {
+                (void)interlocked_exchange(&clds_flat_hash_map->claim_stripes[i].claim_sequence, 0);
+                (void)interlocked_exchange(&clds_flat_hash_map->claim_stripes[i].claim_waiters, 0);
+            }
+
+            /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_006: [ clds_flat_hash_map_create shall initialize all slots as empty. ]*/
+            for (uint32_t i = 0; i < slot_count; i++)
+            {
+                (void)interlocked_exchange_64(&clds_flat_hash_map->slots[i].key, CLDS_FLAT_HASH_MAP_EMPTY_KEY);
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_flat_hash_map->slots[i].item, NULL);
+                (void)interlocked_exchange(&clds_flat_hash_map->slots[i].generation, 0);
+            }
+
+            goto all_ok;
+        }
+    }
+
+    clds_flat_hash_map = NULL;
+
+all_ok:
+    return clds_flat_hash_map;
+}
+
+void clds_flat_hash_map_destroy(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map)
+{
+    if (clds_flat_hash_map == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_008: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map=%p", clds_flat_hash_map);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < clds_flat_hash_map->capacity; i++)
+        {
+            CLDS_FLAT_HASH_MAP_ITEM* item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_flat_hash_map->slots[i].item, NULL, NULL);
+            if (is_live_item(item))
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_009: [ For each item still in the flat hash map, clds_flat_hash_map_destroy shall release the reference held by the flat hash map. ]*/
+                internal_node_destroy(item);
+            }
+        }
+
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_010: [ clds_flat_hash_map_destroy shall free all resources associated with the flat hash map instance. ]*/
+        free(clds_flat_hash_map);
+    }
+}
+
+CLDS_FLAT_HASH_MAP_INSERT_RESULT clds_flat_hash_map_insert(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t key, CLDS_FLAT_HASH_MAP_ITEM* item)
+{
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_011: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+        (clds_flat_hash_map == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_012: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_013: [ If key is CLDS_FLAT_HASH_MAP_EMPTY_KEY, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+        (key == CLDS_FLAT_HASH_MAP_EMPTY_KEY) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_014: [ If item is NULL, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+        (item == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t key=%" PRIu64 ", CLDS_FLAT_HASH_MAP_ITEM* item=%p",
+            clds_flat_hash_map, clds_hazard_pointers_thread, key, item);
+        result = CLDS_FLAT_HASH_MAP_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_015: [ clds_flat_hash_map_insert shall hash key and probe linearly the slots starting at the slot given by the hash. ]*/
+        uint32_t start_slot = compute_start_slot(clds_flat_hash_map, key);
+        FLAT_HASH_MAP_CLAIM_STRIPE* claim_stripe = &clds_flat_hash_map->claim_stripes[start_slot & (FLAT_HASH_MAP_CLAIM_STRIPE_COUNT - 1)];
+        volatile_atomic int32_t* claim_sequence = &claim_stripe->claim_sequence;
+        int32_t claim_sequences[FLAT_HASH_MAP_CLAIM_STRIPE_COUNT];
+        uint32_t spin_count = 0;
+        bool confirming_full = false;
+        bool retry;
+
+        do
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_020: [ If all the slots were probed without finding the slot of key, an empty slot or a tombstoned slot, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_FULL. ]*/
+            result = CLDS_FLAT_HASH_MAP_INSERT_FULL;
+            retry = false;
+
+            int32_t sequence = interlocked_add(claim_sequence, 0);
+            if ((sequence & 1) != 0)
+            {
+                // another insert is giving a slot to a key of this stripe
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_057: [ If the claim sequence of the stripe of the start slot is odd, clds_flat_hash_map_insert shall wait for it to change, first by spinning with a CPU pause for a bounded number of times and then by using wait_on_address, and retry the insert. ]*/
+                if (spin_count < CLAIM_SEQUENCE_SPIN_COUNT)
+                {
+                    // the claims are short, unless their thread got preempted, so spin a bit before going to sleep
+                    CPU_PAUSE();
+                    spin_count++;
+                }
+                else
+                {
+                    // register before reading the claim sequence again, so that either the release sees the waiter or the waiter sees the release
+                    (void)interlocked_increment(&claim_stripe->claim_waiters);
+                    if (interlocked_add(claim_sequence, 0) == sequence)
+                    {
+                        (void)wait_on_address(claim_sequence, sequence, UINT32_MAX);
+                    }
+                    (void)interlocked_decrement(&claim_stripe->claim_waiters);
+                }
+
+                retry = true;
+                continue;
+            }
+
+            FLAT_HASH_MAP_SLOT* empty_slot = NULL;
+            FLAT_HASH_MAP_SLOT* tombstoned_slot = NULL;
+            CLDS_FLAT_HASH_MAP_ITEM* tombstone = NULL;
+            bool key_found = false;
+
+            for (uint32_t probe = 0; probe < clds_flat_hash_map->capacity; probe++)
+            {
+                FLAT_HASH_MAP_SLOT* slot = &clds_flat_hash_map->slots[(start_slot + probe) & (clds_flat_hash_map->capacity - 1)];
+                int64_t slot_key;
+                CLDS_FLAT_HASH_MAP_ITEM* current_item = read_slot(slot, &slot_key);
+                if (current_item == FLAT_HASH_MAP_CLAIMED)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_048: [ clds_flat_hash_map_insert shall skip the slots that are being reused by another insert. ]*/
+                    // if the slot is being reused for key, the claim sequence has changed and the insert is retried
+                    continue;
+                }
+
+                if (slot_key == CLDS_FLAT_HASH_MAP_EMPTY_KEY)
+                {
+                    empty_slot = slot;
+                    break;
+                }
+
+                if (slot_key == (int64_t)key)
+                {
+                    key_found = true;
+
+                    if (is_live_item(current_item))
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_017: [ If the slot for key holds a live item, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS. ]*/
+                        result = CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS;
+                    }
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_018: [ If the slot for key holds no item or a tombstone left by a delete, clds_flat_hash_map_insert shall set item in the slot by using interlocked_compare_exchange_pointer, retrying if the slot changed in the meanwhile. ]*/
+                    else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&slot->item, item, current_item) == current_item)
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_019: [ On success clds_flat_hash_map_insert shall return CLDS_FLAT_HASH_MAP_INSERT_OK. ]*/
+                        result = CLDS_FLAT_HASH_MAP_INSERT_OK;
+                    }
+                    else
+                    {
+                        retry = true;
+                    }
+
+                    break;
+                }
+
+                if ((tombstoned_slot == NULL) && is_tombstone(current_item))
+                {
+                    tombstoned_slot = slot;
+                    tombstone = current_item;
+                }
+            }
+
+            if (key_found)
+            {
+                // done
+            }
+            else if ((empty_slot == NULL) && (tombstoned_slot == NULL))
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_056: [ Before returning CLDS_FLAT_HASH_MAP_INSERT_FULL, clds_flat_hash_map_insert shall probe all the slots again and retry the insert if any claim sequence was odd or has changed in the meanwhile. ]*/
+                // keys move between slots only when a slot is given to a key, so if no claim sequence moved
+                // while probing, the probe saw each slot with a fixed key and the map really has no room for key
+                if (confirming_full && !claim_sequences_changed(clds_flat_hash_map, claim_sequences))
+                {
+                    // done
+                }
+                else
+                {
+                    confirming_full = read_claim_sequences(clds_flat_hash_map, claim_sequences);
+                    retry = true;
+                }
+            }
+            /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_049: [ If the slot for key was not found, clds_flat_hash_map_insert shall take the claim sequence of the stripe of the start slot by changing it with interlocked_compare_exchange from the even value read before probing to the next odd value, retrying the insert if the claim sequence was odd or has changed in the meanwhile. ]*/
+            else if (interlocked_compare_exchange(claim_sequence, sequence + 1, sequence) != sequence)
+            {
+                retry = true;
+            }
+            else
+            {
+                if (tombstoned_slot != NULL)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_050: [ If a tombstoned slot was probed, clds_flat_hash_map_insert shall reuse the first tombstoned slot by replacing its tombstone with a claimed marker by using interlocked_compare_exchange_pointer, retrying the insert if the slot changed in the meanwhile. ]*/
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&tombstoned_slot->item, FLAT_HASH_MAP_CLAIMED, tombstone) != tombstone)
+                    {
+                        retry = true;
+                    }
+                    else
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_051: [ clds_flat_hash_map_insert shall increment the generation of the reused slot, set key in it and then set item in it. ]*/
+                        (void)interlocked_increment(&tombstoned_slot->generation);
+                        (void)interlocked_exchange_64(&tombstoned_slot->key, (int64_t)key);
+                        (void)interlocked_exchange_pointer((void* volatile_atomic*)&tombstoned_slot->item, item);
+
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_019: [ On success clds_flat_hash_map_insert shall return CLDS_FLAT_HASH_MAP_INSERT_OK. ]*/
+                        result = CLDS_FLAT_HASH_MAP_INSERT_OK;
+                    }
+                }
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_016: [ If no tombstoned slot was probed and an empty slot was found, clds_flat_hash_map_insert shall claim it for key by using interlocked_compare_exchange_64, retrying the insert if another key claimed it in the meanwhile. ]*/
+                else if (interlocked_compare_exchange_64(&empty_slot->key, (int64_t)key, CLDS_FLAT_HASH_MAP_EMPTY_KEY) != CLDS_FLAT_HASH_MAP_EMPTY_KEY)
+                {
+                    retry = true;
+                }
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_018: [ If the slot for key holds no item or a tombstone left by a delete, clds_flat_hash_map_insert shall set item in the slot by using interlocked_compare_exchange_pointer, retrying if the slot changed in the meanwhile. ]*/
+                else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&empty_slot->item, item, NULL) == NULL)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_019: [ On success clds_flat_hash_map_insert shall return CLDS_FLAT_HASH_MAP_INSERT_OK. ]*/
+                    result = CLDS_FLAT_HASH_MAP_INSERT_OK;
+                }
+                else
+                {
+                    // an insert of the same key found the claimed slot and set its item first
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_017: [ If the slot for key holds a live item, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS. ]*/
+                    result = CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS;
+                }
+
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_052: [ clds_flat_hash_map_insert shall release the claim sequence by setting it to the next even value. ]*/
+                (void)interlocked_exchange(claim_sequence, sequence + 2);
+
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_058: [ If any insert waits for the claim sequence, clds_flat_hash_map_insert shall wake it by calling wake_by_address_all after releasing the claim sequence. ]*/
+                if (interlocked_add(&claim_stripe->claim_waiters, 0) != 0)
+                {
+                    wake_by_address_all(claim_sequence);
+                }
+            }
+        } while (retry);
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_MAP_DELETE_RESULT clds_flat_hash_map_delete(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t key)
+{
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_021: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+        (clds_flat_hash_map == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_022: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_023: [ If key is CLDS_FLAT_HASH_MAP_EMPTY_KEY, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+        (key == CLDS_FLAT_HASH_MAP_EMPTY_KEY)
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t key=%" PRIu64 "",
+            clds_flat_hash_map, clds_hazard_pointers_thread, key);
+        result = CLDS_FLAT_HASH_MAP_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_025: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND. ]*/
+        result = CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND;
+
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_024: [ clds_flat_hash_map_delete shall look for the slot of key by probing the slots in the same order as clds_flat_hash_map_insert. ]*/
+        uint32_t start_slot = compute_start_slot(clds_flat_hash_map, key);
+        for (uint32_t probe = 0; probe < clds_flat_hash_map->capacity; probe++)
+        {
+            FLAT_HASH_MAP_SLOT* slot = &clds_flat_hash_map->slots[(start_slot + probe) & (clds_flat_hash_map->capacity - 1)];
+            int64_t slot_key;
+            CLDS_FLAT_HASH_MAP_ITEM* current_item = read_slot(slot, &slot_key);
+            if (slot_key == CLDS_FLAT_HASH_MAP_EMPTY_KEY)
+            {
+                break;
+            }
+
+            if (slot_key == (int64_t)key)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_026: [ If the slot for key does not hold a live item, clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND. ]*/
+                while (is_live_item(current_item))
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_053: [ clds_flat_hash_map_delete shall acquire a hazard pointer on the item and check that the slot still holds the item for key, retrying if the slot changed in the meanwhile. ]*/
+                    // without it the item could be freed and its memory reused for another key inserted in the same slot
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, current_item);
+                    if (item_hp == NULL)
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_055: [ If acquiring the hazard pointer fails, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+                        LogError("Cannot acquire hazard pointer");
+                        result = CLDS_FLAT_HASH_MAP_DELETE_ERROR;
+                        break;
+                    }
+
+                    bool deleted = false;
+                    if ((interlocked_compare_exchange_pointer((void* volatile_atomic*)&slot->item, NULL, NULL) == current_item) &&
+                        (interlocked_add_64(&slot->key, 0) == (int64_t)key))
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_027: [ clds_flat_hash_map_delete shall replace the item in the slot with a tombstone tagged with the generation of the slot by using interlocked_compare_exchange_pointer, retrying if the slot changed in the meanwhile. ]*/
+                        CLDS_FLAT_HASH_MAP_ITEM* tombstone = FLAT_HASH_MAP_TOMBSTONE(interlocked_add(&slot->generation, 0));
+                        deleted = (interlocked_compare_exchange_pointer((void* volatile_atomic*)&slot->item, tombstone, current_item) == current_item);
+                    }
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_054: [ clds_flat_hash_map_delete shall release the hazard pointer. ]*/
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+
+                    if (deleted)
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_028: [ clds_flat_hash_map_delete shall indicate the deleted item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched, with a reclaim function that releases the reference held by the flat hash map. ]*/
+                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_flat_hash_map_items);
+
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_029: [ On success clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_OK. ]*/
+                        result = CLDS_FLAT_HASH_MAP_DELETE_OK;
+                        break;
+                    }
+
+                    current_item = read_slot(slot, &slot_key);
+                    if (slot_key != (int64_t)key)
+                    {
+                        // the slot was reused for another key, so key was deleted in the meanwhile
+                        break;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_MAP_ITEM* clds_flat_hash_map_find(CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t key)
+{
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_030: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_find shall fail and return NULL. ]*/
+        (clds_flat_hash_map == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_031: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_map_find shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_032: [ If key is CLDS_FLAT_HASH_MAP_EMPTY_KEY, clds_flat_hash_map_find shall fail and return NULL. ]*/
+        (key == CLDS_FLAT_HASH_MAP_EMPTY_KEY)
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_MAP_HANDLE clds_flat_hash_map=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t key=%" PRIu64 "",
+            clds_flat_hash_map, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_034: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_find shall return NULL. ]*/
+        result = NULL;
+
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_033: [ clds_flat_hash_map_find shall look for the slot of key by probing the slots in the same order as clds_flat_hash_map_insert. ]*/
+        uint32_t start_slot = compute_start_slot(clds_flat_hash_map, key);
+        for (uint32_t probe = 0; probe < clds_flat_hash_map->capacity; probe++)
+        {
+            FLAT_HASH_MAP_SLOT* slot = &clds_flat_hash_map->slots[(start_slot + probe) & (clds_flat_hash_map->capacity - 1)];
+            int64_t slot_key;
+            CLDS_FLAT_HASH_MAP_ITEM* current_item = read_slot(slot, &slot_key);
+            if (slot_key == CLDS_FLAT_HASH_MAP_EMPTY_KEY)
+            {
+                break;
+            }
+
+            if (slot_key == (int64_t)key)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_035: [ If the slot for key does not hold a live item, clds_flat_hash_map_find shall return NULL. ]*/
+                while (is_live_item(current_item))
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_036: [ clds_flat_hash_map_find shall acquire a hazard pointer on the item and check that the slot still holds the item for key, retrying if the slot changed in the meanwhile. ]*/
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, current_item);
+                    if (item_hp == NULL)
+                    {
+                        LogError("Cannot acquire hazard pointer");
+                        break;
+                    }
+
+                    if ((interlocked_compare_exchange_pointer((void* volatile_atomic*)&slot->item, NULL, NULL) == current_item) &&
+                        (interlocked_add_64(&slot->key, 0) == (int64_t)key))
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_037: [ On success clds_flat_hash_map_find shall increment the reference count of the item, release the hazard pointer and return the item. ]*/
+                        (void)interlocked_increment(&current_item->ref_count);
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                        result = current_item;
+                        break;
+                    }
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+
+                    current_item = read_slot(slot, &slot_key);
+                    if (slot_key != (int64_t)key)
+                    {
+                        // the slot was reused for another key, so key was deleted in the meanwhile
+                        break;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_MAP_ITEM* clds_flat_hash_map_node_create(size_t node_size, FLAT_HASH_MAP_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_039: [ item_cleanup_callback shall be allowed to be NULL. ]*/
+    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_040: [ item_cleanup_callback_context shall be allowed to be NULL. ]*/
+    /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_038: [ clds_flat_hash_map_node_create shall allocate a node of node_size bytes, store item_cleanup_callback and item_cleanup_callback_context in it and set its reference count to 1. ]*/
+    void* result = malloc(node_size);
+    if (result == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_041: [ If any error happens, clds_flat_hash_map_node_create shall fail and return NULL. ]*/
+        LogError("malloc(node_size=%zu) failed", node_size);
+    }
+    else
+    {
+        CLDS_FLAT_HASH_MAP_ITEM* item = result;
+        item->item_cleanup_callback = item_cleanup_callback;
+        item->item_cleanup_callback_context = item_cleanup_callback_context;
+        (void)interlocked_exchange(&item->ref_count, 1);
+    }
+
+    return result;
+}
+
+int clds_flat_hash_map_node_inc_ref(CLDS_FLAT_HASH_MAP_ITEM* item)
+{
+    int result;
+
+    if (item == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_042: [ If item is NULL, clds_flat_hash_map_node_inc_ref shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: CLDS_FLAT_HASH_MAP_ITEM* item=%p", item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_043: [ clds_flat_hash_map_node_inc_ref shall increment the reference count of item and return 0. ]*/
+        (void)interlocked_increment(&item->ref_count);
+        result = 0;
+    }
+
+    return result;
+}
+
+void clds_flat_hash_map_node_release(CLDS_FLAT_HASH_MAP_ITEM* item)
+{
+    if (item == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_044: [ If item is NULL, clds_flat_hash_map_node_release shall return. ]*/
+        LogError("Invalid arguments: CLDS_FLAT_HASH_MAP_ITEM* item=%p", item);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_MAP_07_045: [ clds_flat_hash_map_node_release shall decrement the reference count of item. ]*/
+        internal_node_destroy(item);
+    }
+}
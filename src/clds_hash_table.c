@@ -2,9 +2,14 @@
 // Licensed under the MIT license.See LICENSE file in the project root for full license information.
 
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <stdbool.h>
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <emmintrin.h>
+#endif
+
 #include "c_logging/logger.h"
 
 #include "c_pal/gballoc_hl.h"
@@ -12,6 +17,7 @@
 #include "c_pal/sync.h"
 #include "c_pal/interlocked.h"
 #include "c_pal/thandle.h"
+#include "c_pal/threadapi.h"
 #include "c_util/cancellation_token.h"
 
 #include "clds/clds_sorted_list.h"
@@ -26,19 +32,114 @@ MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RES
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_HASH_FINALIZER, CLDS_HASH_TABLE_HASH_FINALIZER_VALUES);
+
+// the pending write operations are counted in several counters, so that writers on different threads do not contend on one cache line
+#define PENDING_WRITE_OPERATIONS_STRIPE_BITS 4
+#define PENDING_WRITE_OPERATIONS_STRIPE_COUNT (1 << PENDING_WRITE_OPERATIONS_STRIPE_BITS)
+#define CACHE_LINE_SIZE 64
+
+// the keys are spread over this many migration stripes by their hash, moving a bucket only holds up the writers of the keys in the stripes of that bucket
+#define MIGRATION_STRIPE_BITS 6
+#define MIGRATION_STRIPE_COUNT (1 << MIGRATION_STRIPE_BITS)
+
+// a stripe of the item count of a bucket array is folded in the approximate item count of the bucket array once it moves this far away from 0
+#define ITEM_COUNT_FOLD_THRESHOLD 32
+// smaller bucket arrays fold sooner, so that the counts not folded yet hide at most 1/ITEM_COUNT_SLACK_DIVIDER of the buckets
+#define ITEM_COUNT_SLACK_DIVIDER 16
+
+// an insert waiting for the inserts in progress in a lower level bucket array checks a counter this many times before it goes to sleep
+#define PENDING_INSERTS_SPIN_COUNT 1024
+
+// clds_hash_table_snapshot_parallel hands out the buckets to the workers in chunks of this many buckets
+#define PARALLEL_SNAPSHOT_CHUNK_BUCKET_COUNT 256
+
+// bucket counts are powers of two and have to fit an int32_t even after the first resize
+#define MAX_INITIAL_BUCKET_SIZE ((size_t)1 << 29)
+
+// clds_hash_table_bulk_load hands out the keys to hash to the workers in chunks of this many keys
+#define BULK_LOAD_HASH_CHUNK_KEY_COUNT 4096
+
+// clds_hash_table_bulk_load splits the top level bucket array in this many ranges of buckets per worker, so that the workers that get crowded ranges do not hold up the others
+#define BULK_LOAD_RANGES_PER_WORKER 8
+
+// snapshot images start with this value ("CHTS" when read as bytes), an image written on a machine with the other byte order does not match it
+#define SNAPSHOT_IMAGE_MAGIC 0x53544843
+#define SNAPSHOT_IMAGE_VERSION 1
+// everything in a snapshot image is aligned to this many bytes, so that the image can be used in place once mapped in memory
+#define SNAPSHOT_IMAGE_ALIGNMENT 8
+
+// clds_hash_table_restore hands out the buckets of a snapshot image to the workers in chunks of this many buckets
+#define RESTORE_CHUNK_BUCKET_COUNT 256
+
+// the batch APIs work on groups of this many keys, the bucket lookups of a group are prefetched before any key of the group is processed
+#define BATCH_PIPELINE_DEPTH 16
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_FOR_READ(address) __builtin_prefetch((const void*)(address), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define PREFETCH_FOR_READ(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+#define PREFETCH_FOR_READ(address) ((void)(address))
+#endif
+
+// tells the core that this is a spin loop, so that it does not hog the pipeline shared with its sibling hyperthread while it waits
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#define CPU_PAUSE() __builtin_ia32_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define CPU_PAUSE() __asm__ __volatile__("yield")
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define CPU_PAUSE() _mm_pause()
+#else
+#define CPU_PAUSE() ((void)0)
+#endif
+
+typedef struct PENDING_WRITE_OPERATIONS_STRIPE_TAG
+{
+    volatile_atomic int32_t count;
+    uint8_t padding[CACHE_LINE_SIZE - sizeof(int32_t)];
+} PENDING_WRITE_OPERATIONS_STRIPE;
+
+// the item and pending insert counts of a bucket array are spread over the same stripes as the pending write operations,
+// so that writers on different threads do not contend on one cache line
+typedef struct BUCKET_ARRAY_COUNTERS_STRIPE_TAG
+{
+    volatile_atomic int32_t item_count; // item count change not yet folded in approximate_item_count
+    volatile_atomic int32_t pending_insert_count;
+    uint8_t padding[CACHE_LINE_SIZE - 2 * sizeof(int32_t)];
+} BUCKET_ARRAY_COUNTERS_STRIPE;
+
+typedef struct MIGRATION_STRIPE_TAG
+{
+    volatile_atomic int32_t sequence; // odd while a bucket that can hold keys of this stripe is being moved
+    volatile_atomic int32_t pending_write_operations;
+    uint8_t padding[CACHE_LINE_SIZE - 2 * sizeof(int32_t)];
+} MIGRATION_STRIPE;
 
 typedef struct BUCKET_ARRAY_TAG
 {
     struct BUCKET_ARRAY_TAG* volatile_atomic next_bucket;
-    volatile_atomic int32_t bucket_count;
-    volatile_atomic int32_t item_count;
-    volatile_atomic int32_t pending_insert_count;
-    CLDS_SORTED_LIST_HANDLE volatile_atomic hash_table[];
+    int32_t bucket_count; // power of two, set before the array is published and never changed afterwards
+    uint64_t bucket_mask; // bucket_count - 1, set together with bucket_count
+    int64_t bucket_array_id; // unique in the table, set before the array is published and never changed afterwards, lets an iterator find the array it stopped in
+    volatile_atomic int32_t approximate_item_count; // off by less than item_count_fold_threshold per stripe
+    int32_t item_count_fold_threshold; // set before the array is published and never changed afterwards
+    volatile_atomic int32_t pending_insert_waiters; // inserts only wake when someone sleeps in wait_for_pending_inserts
+    BUCKET_ARRAY_COUNTERS_STRIPE counters[PENDING_WRITE_OPERATIONS_STRIPE_COUNT];
+    // the bucket lists live in the bucket array, an empty bucket is a list without a head
+    CLDS_SORTED_LIST hash_table[];
 } BUCKET_ARRAY;
 
 typedef struct CLDS_HASH_TABLE_TAG
 {
     COMPUTE_HASH_FUNC compute_hash;
+    CLDS_HASH_TABLE_HASH_FINALIZER hash_finalizer;
     KEY_COMPARE_FUNC key_compare_func;
     BUCKET_ARRAY* volatile_atomic first_hash_table;
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
@@ -46,11 +147,135 @@ typedef struct CLDS_HASH_TABLE_TAG
     HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
     void* skipped_seq_no_cb_context;
 
+    // callbacks and sequence number shared by the lists of all the buckets
+    CLDS_SORTED_LIST_CONFIG sorted_list_config;
+
     // Support for locking the list for writes
     volatile_atomic int32_t locked_for_write;
-    volatile_atomic int32_t pending_write_operations;
+    volatile_atomic int32_t write_lock_waiters; // writers only wake when someone waits in internal_lock_writes
+    PENDING_WRITE_OPERATIONS_STRIPE pending_write_operations[PENDING_WRITE_OPERATIONS_STRIPE_COUNT];
+
+    // Support for migrating items out of the older bucket arrays
+    volatile_atomic int32_t migration_lock;
+    volatile_atomic int32_t migration_bucket_budget;
+    int32_t migration_bucket_index; // only accessed while holding migration_lock
+    MIGRATION_STRIPE migration_stripes[MIGRATION_STRIPE_COUNT];
+
+    // ids handed to the bucket arrays, the bucket array created with the table gets 0
+    volatile_atomic int64_t last_bucket_array_id;
+
+    // shrinking never goes below the bucket count the table was created with
+    int32_t initial_bucket_count;
+
+    // Support for snapshots that do not block writers
+    volatile_atomic int64_t snapshot_epoch; // new items are tagged with it, each concurrent snapshot starts a new epoch
+    struct CONCURRENT_SNAPSHOT_CONTEXT_TAG* volatile_atomic concurrent_snapshot; // set while a concurrent snapshot walks the table, only changes while writes are locked
 } CLDS_HASH_TABLE;
 
+typedef struct CONCURRENT_SNAPSHOT_CONTEXT_TAG
+{
+    int64_t snapshot_epoch;
+    CLDS_SORTED_LIST_ITEM** items;
+    uint64_t item_capacity;
+    volatile_atomic int64_t item_count; // number of slots in items handed out to the snapshot walk and to the writers that take items out of the table
+} CONCURRENT_SNAPSHOT_CONTEXT;
+
+typedef struct PARALLEL_SNAPSHOT_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    THANDLE(CANCELLATION_TOKEN) cancellation_token;
+    BUCKET_ARRAY* first_bucket_array;
+    volatile_atomic int64_t next_chunk; // chunks are numbered over all the bucket arrays, in order
+    CLDS_SORTED_LIST_ITEM** items;
+    int64_t item_capacity;
+    volatile_atomic int64_t item_count; // number of slots in items handed out to the workers
+    volatile_atomic int32_t result; // CLDS_HASH_TABLE_SNAPSHOT_RESULT, the first worker that fails sets it
+} PARALLEL_SNAPSHOT_CONTEXT;
+
+typedef struct BULK_LOAD_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    BUCKET_ARRAY* bucket_array; // top level, all the items are inserted in it
+    bool probe_lower_levels; // only when the lower level bucket arrays hold items
+    int64_t snapshot_epoch;
+    void** keys;
+    CLDS_HASH_TABLE_ITEM** values;
+    uint32_t key_count;
+    CLDS_HASH_TABLE_INSERT_RESULT* results;
+    int64_t* sequence_numbers;
+    uint64_t* hashes;
+    bool hashes_computed; // set before the workers that insert the items are started
+    uint32_t* key_indices; // grouped by range of buckets, in the order of the keys within each range
+    uint32_t* range_starts; // range_count + 1 entries, range i has the key indices from range_starts[i] to range_starts[i + 1]
+    uint32_t range_count;
+    uint32_t range_shift; // the range of a bucket is the bucket index shifted right by range_shift
+    volatile_atomic int64_t next_work_item; // next chunk of keys to hash or next range of buckets to fill
+} BULK_LOAD_CONTEXT;
+
+// a snapshot image is laid out as: header, bucket directory (bucket_count + 1 entries), records
+// all offsets are relative to the start of the image, so the image can be mapped at any address
+typedef struct SNAPSHOT_IMAGE_HEADER_TAG
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t hash_finalizer; // CLDS_HASH_TABLE_HASH_FINALIZER used to compute the hashes stored in the records
+    int64_t sequence_number;
+    uint64_t record_count;
+    uint64_t bucket_count; // power of two
+    uint64_t directory_offset;
+    uint64_t records_offset;
+    uint64_t records_size;
+} SNAPSHOT_IMAGE_HEADER;
+
+typedef struct SNAPSHOT_IMAGE_BUCKET_TAG
+{
+    uint64_t records_offset; // relative to the start of the records, the bucket ends where the next one starts
+    uint64_t first_record_index; // index of the first record of the bucket among all the records of the image
+} SNAPSHOT_IMAGE_BUCKET;
+
+typedef struct SNAPSHOT_IMAGE_RECORD_TAG
+{
+    uint64_t hash;
+    uint32_t record_size; // size of the serialized item that follows, not counting the padding up to SNAPSHOT_IMAGE_ALIGNMENT
+    uint32_t reserved;
+} SNAPSHOT_IMAGE_RECORD;
+
+typedef struct RESTORE_CONTEXT_TAG
+{
+    const SNAPSHOT_IMAGE_HEADER* header;
+    HASH_TABLE_DESERIALIZE_RECORD_CB deserialize_record;
+    void* deserialize_context;
+    void** keys;
+    CLDS_HASH_TABLE_ITEM** values;
+    volatile_atomic int64_t next_chunk;
+    volatile_atomic int32_t failed; // set by the first worker that fails, the others stop claiming chunks
+} RESTORE_CONTEXT;
+
+// the iterator has not walked any bucket array yet
+#define ITERATOR_NO_BUCKET_ARRAY_ID -1
+
+typedef struct CLDS_HASH_TABLE_ITERATOR_TAG
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    // the walk goes from the oldest bucket array to the top level one, the way the migration moves the items
+    // no hazard pointer is held between calls, so the bucket array is kept by id and looked up again by the next call
+    int64_t bucket_array_id;
+    int32_t bucket_index;
+    bool walk_complete;
+    // last item returned from the current bucket, referenced so that its key stays valid until the walk resumes after it
+    CLDS_SORTED_LIST_ITEM* last_item;
+} CLDS_HASH_TABLE_ITERATOR;
+
+typedef struct ITERATE_PAGE_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    void* resume_after_key;
+    CLDS_HASH_TABLE_ITEM** items;
+    uint32_t max_item_count;
+    uint32_t item_count;
+} ITERATE_PAGE_CONTEXT;
+
 typedef struct FIND_BY_KEY_VALUE_CONTEXT_TAG
 {
     void* key;
@@ -58,17 +283,156 @@ typedef struct FIND_BY_KEY_VALUE_CONTEXT_TAG
     KEY_COMPARE_FUNC key_compare_func;
 } FIND_BY_KEY_VALUE_CONTEXT;
 
-static void check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static uint32_t get_stripe_index(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    // the hazard pointers thread handle is unique per thread, so it is used to pick the counter (Fibonacci hashing of the address)
+    return ((uint32_t)((uintptr_t)clds_hazard_pointers_thread >> 4) * 2654435761U) >> (32 - PENDING_WRITE_OPERATIONS_STRIPE_BITS);
+}
+
+static volatile_atomic int32_t* get_pending_write_operations(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    return &clds_hash_table->pending_write_operations[get_stripe_index(clds_hazard_pointers_thread)].count;
+}
+
+static void init_bucket_array_counters(BUCKET_ARRAY* bucket_array)
+{
+    int32_t item_count_fold_threshold = bucket_array->bucket_count / (ITEM_COUNT_SLACK_DIVIDER * PENDING_WRITE_OPERATIONS_STRIPE_COUNT);
+    if (item_count_fold_threshold < 1)
+    {
+        item_count_fold_threshold = 1;
+    }
+    else if (item_count_fold_threshold > ITEM_COUNT_FOLD_THRESHOLD)
+    {
+        item_count_fold_threshold = ITEM_COUNT_FOLD_THRESHOLD;
+    }
+    bucket_array->item_count_fold_threshold = item_count_fold_threshold;
+
+    (void)interlocked_exchange(&bucket_array->approximate_item_count, 0);
+    (void)interlocked_exchange(&bucket_array->pending_insert_waiters, 0);
+    for (uint32_t i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
+    {
+        (void)interlocked_exchange(&bucket_array->counters[i].item_count, 0);
+        (void)interlocked_exchange(&bucket_array->counters[i].pending_insert_count, 0);
+    }
+}
+
+static void add_to_item_count(BUCKET_ARRAY* bucket_array, uint32_t stripe_index, int32_t delta)
+{
+    volatile_atomic int32_t* stripe_item_count = &bucket_array->counters[stripe_index].item_count;
+    int32_t stripe_value = interlocked_add(stripe_item_count, delta);
+    if ((stripe_value >= bucket_array->item_count_fold_threshold) || (stripe_value <= -bucket_array->item_count_fold_threshold))
+    {
+        // the shared count is only written once per item_count_fold_threshold changes of a stripe, if the stripe changed meanwhile the next change folds it
+        if (interlocked_compare_exchange(stripe_item_count, 0, stripe_value) == stripe_value)
+        {
+            (void)interlocked_add(&bucket_array->approximate_item_count, stripe_value);
+        }
+    }
+}
+
+// exact only while the table is locked for writes, otherwise it can miss a change being folded
+static int64_t get_exact_item_count(BUCKET_ARRAY* bucket_array)
+{
+    int64_t result = interlocked_add(&bucket_array->approximate_item_count, 0);
+    for (uint32_t i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
+    {
+        result += interlocked_add(&bucket_array->counters[i].item_count, 0);
+    }
+    return result;
+}
+
+static bool is_bucket_array_full(BUCKET_ARRAY* bucket_array, int32_t bucket_count)
+{
+    bool result;
+
+    // a stripe that is not folded yet holds less than item_count_fold_threshold items, the slack is at most 1/ITEM_COUNT_SLACK_DIVIDER of the buckets
+    // (and 0 for the small arrays, which fold every change), so the stripes are only summed when the array is about to be full
+    int64_t unfolded_item_count_slack = (int64_t)PENDING_WRITE_OPERATIONS_STRIPE_COUNT * (bucket_array->item_count_fold_threshold - 1);
+    if ((int64_t)interlocked_add(&bucket_array->approximate_item_count, 0) + unfolded_item_count_slack < bucket_count)
+    {
+        // not full even if every stripe is about to be folded, the stripes do not need to be read
+        result = false;
+    }
+    else
+    {
+        result = (get_exact_item_count(bucket_array) >= bucket_count);
+    }
+
+    return result;
+}
+
+static void end_pending_insert(BUCKET_ARRAY* bucket_array, uint32_t stripe_index)
+{
+    volatile_atomic int32_t* pending_insert_count = &bucket_array->counters[stripe_index].pending_insert_count;
+
+    if (
+        (interlocked_decrement(pending_insert_count) == 0) &&
+        // the waiter registers itself before reading the pending count again, so either it sees the decrement or we see the waiter
+        (interlocked_add(&bucket_array->pending_insert_waiters, 0) != 0)
+        )
+    {
+        wake_by_address_all(pending_insert_count);
+    }
+}
+
+static void wait_for_pending_inserts(BUCKET_ARRAY* bucket_array)
+{
+    bool registered_as_waiter = false;
+
+    for (uint32_t i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
+    {
+        volatile_atomic int32_t* pending_insert_count = &bucket_array->counters[i].pending_insert_count;
+        uint32_t spin_count = 0;
+        int32_t pending_inserts;
+
+        while ((pending_inserts = interlocked_add(pending_insert_count, 0)) != 0)
+        {
+            if (spin_count < PENDING_INSERTS_SPIN_COUNT)
+            {
+                // the inserts in progress are short, unless their thread got preempted, so spin a bit before going to sleep
+                CPU_PAUSE();
+                spin_count++;
+            }
+            else if (!registered_as_waiter)
+            {
+                // register and read the count again, so that the wake for the last insert is not missed
+                (void)interlocked_increment(&bucket_array->pending_insert_waiters);
+                registered_as_waiter = true;
+            }
+            else
+            {
+                (void)wait_on_address(pending_insert_count, pending_inserts, UINT32_MAX);
+            }
+        }
+    }
+
+    if (registered_as_waiter)
+    {
+        (void)interlocked_decrement(&bucket_array->pending_insert_waiters);
+    }
+}
+
+static void wake_write_lock_waiters(CLDS_HASH_TABLE_HANDLE clds_hash_table, volatile_atomic int32_t* pending_write_operations)
+{
+    // the waiter registers itself before reading the pending counts, so either it sees the decrement or we see the waiter
+    if (interlocked_add(&clds_hash_table->write_lock_waiters, 0) != 0)
+    {
+        wake_by_address_all(pending_write_operations);
+    }
+}
+
+static void check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
 {
+    volatile_atomic int32_t* pending_write_operations = get_pending_write_operations(clds_hash_table, clds_hazard_pointers_thread);
     int32_t locked_for_write;
     do
     {
-        (void)interlocked_increment(&clds_hash_table->pending_write_operations);
+        (void)interlocked_increment(pending_write_operations);
         locked_for_write = interlocked_add(&clds_hash_table->locked_for_write, 0);
         if (locked_for_write != 0)
         {
-            (void)interlocked_decrement(&clds_hash_table->pending_write_operations);
-            wake_by_address_all(&clds_hash_table->pending_write_operations);
+            (void)interlocked_decrement(pending_write_operations);
+            wake_write_lock_waiters(clds_hash_table, pending_write_operations);
 
             // Wait for unlock
             (void)wait_on_address(&clds_hash_table->locked_for_write, locked_for_write, UINT32_MAX);
@@ -76,10 +440,11 @@ static void check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_has
     } while (locked_for_write != 0);
 }
 
-static void end_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static void end_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
 {
-    (void)interlocked_decrement(&clds_hash_table->pending_write_operations);
-    wake_by_address_all(&clds_hash_table->pending_write_operations);
+    volatile_atomic int32_t* pending_write_operations = get_pending_write_operations(clds_hash_table, clds_hazard_pointers_thread);
+    (void)interlocked_decrement(pending_write_operations);
+    wake_write_lock_waiters(clds_hash_table, pending_write_operations);
 }
 
 static void internal_lock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
@@ -88,16 +453,31 @@ static void internal_lock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
     (void)interlocked_increment(&clds_hash_table->locked_for_write);
 
     /*Codes_SRS_CLDS_HASH_TABLE_42_018: [ clds_hash_table_snapshot shall wait for the ongoing write operations to complete. ]*/
-    int32_t pending_writes;
-    do
+    bool registered_as_waiter = false;
+    for (uint32_t i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
     {
-        pending_writes = interlocked_add(&clds_hash_table->pending_write_operations, 0);
-        if (pending_writes != 0)
+        volatile_atomic int32_t* pending_write_operations = &clds_hash_table->pending_write_operations[i].count;
+        int32_t pending_writes;
+        while ((pending_writes = interlocked_add(pending_write_operations, 0)) != 0)
         {
-            // Wait for writes
-            (void)wait_on_address(&clds_hash_table->pending_write_operations, pending_writes, UINT32_MAX);
+            if (!registered_as_waiter)
+            {
+                // register and read the count again, so that the wake for the last write is not missed
+                (void)interlocked_increment(&clds_hash_table->write_lock_waiters);
+                registered_as_waiter = true;
+            }
+            else
+            {
+                // Wait for writes
+                (void)wait_on_address(pending_write_operations, pending_writes, UINT32_MAX);
+            }
         }
-    } while (pending_writes != 0);
+    }
+
+    if (registered_as_waiter)
+    {
+        (void)interlocked_decrement(&clds_hash_table->write_lock_waiters);
+    }
 }
 
 static void internal_unlock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
@@ -107,1146 +487,4664 @@ static void internal_unlock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
     wake_by_address_all(&clds_hash_table->locked_for_write);
 }
 
-static void* get_item_key_cb(void* context, CLDS_SORTED_LIST_ITEM* item)
+static MIGRATION_STRIPE* get_migration_stripe(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint64_t hash)
 {
-    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
-    (void)context;
-    return hash_table_item->key;
+    return &clds_hash_table->migration_stripes[hash & (MIGRATION_STRIPE_COUNT - 1)];
 }
 
-static int key_compare_cb(void* context, void* key1, void* key2)
+static void end_key_write_operation(MIGRATION_STRIPE* migration_stripe)
 {
-    CLDS_HASH_TABLE_HANDLE clds_hash_table = context;
-    return clds_hash_table->key_compare_func(key1, key2);
+    if (
+        (interlocked_decrement(&migration_stripe->pending_write_operations) == 0) &&
+        // the mover makes the sequence odd before reading the pending count, so either it sees the decrement or we see the odd sequence
+        ((interlocked_add(&migration_stripe->sequence, 0) & 1) != 0)
+        )
+    {
+        wake_by_address_all(&migration_stripe->pending_write_operations);
+    }
 }
 
-static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequence_no)
+// keeps the buckets that can hold the key from being moved to another bucket array until end_key_write_operation is called
+static MIGRATION_STRIPE* begin_key_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint64_t hash)
 {
-    if (context == NULL)
-    {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_075: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
-        LogError("Invalid arguments: void* context=%p, int64_t skipped_sequence_no=%" PRId64,
-            context, skipped_sequence_no);
-    }
-    else
+    MIGRATION_STRIPE* migration_stripe = get_migration_stripe(clds_hash_table, hash);
+    int32_t sequence;
+    do
     {
-        CLDS_HASH_TABLE_HANDLE clds_hash_table = context;
-        if (clds_hash_table->skipped_seq_no_cb == NULL)
-        {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_113: [ If the sequence number callback passed to clds_hash_table_create was NULL, on_sorted_list_skipped_seq_no shall return. ]*/
-        }
-        else
+        (void)interlocked_increment(&migration_stripe->pending_write_operations);
+        sequence = interlocked_add(&migration_stripe->sequence, 0);
+        if ((sequence & 1) != 0)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_076: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
-            clds_hash_table->skipped_seq_no_cb(clds_hash_table->skipped_seq_no_cb_context, skipped_sequence_no);
+            end_key_write_operation(migration_stripe);
+
+            // wait for the bucket move to complete
+            (void)wait_on_address(&migration_stripe->sequence, sequence, UINT32_MAX);
         }
-    }
+    } while ((sequence & 1) != 0);
+
+    return migration_stripe;
 }
 
-static BUCKET_ARRAY* get_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table)
+static uint32_t get_first_migration_stripe_of_bucket(int32_t bucket_index)
 {
-    // always insert in the first bucket array
-    BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-    int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
-    while (interlocked_add(&first_bucket_array->item_count, 0) >= bucket_count)
-    {
-        // allocate a new bucket array
-        BUCKET_ARRAY* new_bucket_array = malloc_flex(sizeof(BUCKET_ARRAY), bucket_count, sizeof(CLDS_SORTED_LIST_HANDLE) * 2);
-        if (new_bucket_array == NULL)
-        {
-            // cannot allocate new bucket, will stick to what we have, but do not fail
-            break;
-        }
-        else
-        {
-            // insert new bucket
-            /* Codes_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
-            bucket_count = bucket_count * 2;
-            (void)interlocked_exchange(&new_bucket_array->bucket_count, bucket_count);
-            (void)interlocked_exchange(&new_bucket_array->item_count, 0);
-            (void)interlocked_exchange(&new_bucket_array->pending_insert_count, 0);
+    return (uint32_t)bucket_index & (MIGRATION_STRIPE_COUNT - 1);
+}
 
-            // initialize buckets
-            for (int32_t i = 0; i < bucket_count; i++)
-            {
-                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->hash_table[i], NULL);
-            }
+static uint32_t get_migration_stripe_step(uint64_t bucket_mask)
+{
+    // the keys of a bucket of a small bucket array map to several stripes, those of a bigger bucket array to exactly one
+    return (bucket_mask < (MIGRATION_STRIPE_COUNT - 1)) ? (uint32_t)bucket_mask + 1 : MIGRATION_STRIPE_COUNT;
+}
 
-            (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
-            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
-            {
-                first_bucket_array = new_bucket_array;
-                break;
-            }
-            else
-            {
-                // first bucket array changed, drop ours and use the one that was inserted
-                free(new_bucket_array);
+static void lock_bucket_for_move(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint64_t bucket_mask, int32_t bucket_index)
+{
+    for (uint32_t i = get_first_migration_stripe_of_bucket(bucket_index); i < MIGRATION_STRIPE_COUNT; i += get_migration_stripe_step(bucket_mask))
+    {
+        MIGRATION_STRIPE* migration_stripe = &clds_hash_table->migration_stripes[i];
 
-                first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-                bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
-            }
+        // new writers of the keys of the stripe wait and finds that miss a key look again
+        (void)interlocked_increment(&migration_stripe->sequence);
+
+        int32_t pending_writes;
+        while ((pending_writes = interlocked_add(&migration_stripe->pending_write_operations, 0)) != 0)
+        {
+            (void)wait_on_address(&migration_stripe->pending_write_operations, pending_writes, UINT32_MAX);
         }
     }
-
-    return first_bucket_array;
 }
 
-CLDS_HASH_TABLE_HANDLE clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+static void unlock_bucket_for_move(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint64_t bucket_mask, int32_t bucket_index)
 {
-    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    for (uint32_t i = get_first_migration_stripe_of_bucket(bucket_index); i < MIGRATION_STRIPE_COUNT; i += get_migration_stripe_step(bucket_mask))
+    {
+        MIGRATION_STRIPE* migration_stripe = &clds_hash_table->migration_stripes[i];
+        (void)interlocked_increment(&migration_stripe->sequence);
+        wake_by_address_all(&migration_stripe->sequence);
+    }
+}
 
-    /* Codes_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
-    /* Codes_S_R_S_CLDS_HASH_TABLE_01_072: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
-    /* Codes_S_R_S_CLDS_HASH_TABLE_01_073: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+// a find that misses a key while the key is moved between bucket arrays has to look again, this tells if that can have happened
+static bool wait_if_bucket_moved_during_lookup(MIGRATION_STRIPE* migration_stripe, int32_t sequence_before_lookup)
+{
+    bool result;
+    int32_t sequence = interlocked_add(&migration_stripe->sequence, 0);
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (compute_hash == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_045: [ If key_compare_func is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (key_compare_func == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_004: [ If initial_bucket_size is 0, clds_hash_table_create shall fail and return NULL. ]*/
-        (initial_bucket_size == 0) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (clds_hazard_pointers == NULL) ||
-        /* Codes_S_R_S_CLDS_HASH_TABLE_01_074: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_create shall fail and return NULL. ]*/
-        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+        ((sequence_before_lookup & 1) == 0) &&
+        (sequence == sequence_before_lookup)
         )
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
-        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
-            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        // no bucket that can hold the key was moved during the look up, the key is not in the table
+        result = false;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
-        clds_hash_table = malloc(sizeof(CLDS_HASH_TABLE));
-        if (clds_hash_table == NULL)
+        if ((sequence & 1) != 0)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
-            LogError("Cannot allocate memory for hash table");
+            (void)wait_on_address(&migration_stripe->sequence, sequence, UINT32_MAX);
         }
-        else
-        {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
-            clds_hash_table->first_hash_table = malloc_flex(sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST_HANDLE));
-            if (clds_hash_table->first_hash_table == NULL)
-            {
-                LogError("Cannot allocate memory for hash table array. Failure in malloc_flex(sizeof(BUCKET_ARRAY)=%zu, initial_bucket_size=%zu, sizeof(CLDS_SORTED_LIST_HANDLE)=%zu);",
-                    sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST_HANDLE));
-            }
-            else
-            {
-                size_t i;
-
-                // all OK
-                clds_hash_table->clds_hazard_pointers = clds_hazard_pointers;
-                clds_hash_table->compute_hash = compute_hash;
-                clds_hash_table->key_compare_func = key_compare_func;
-                clds_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
-                clds_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
-
-                (void)interlocked_exchange(&clds_hash_table->pending_write_operations, 0);
-                (void)interlocked_exchange(&clds_hash_table->locked_for_write, 0);
-
-                /* Codes_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
-                clds_hash_table->sequence_number = start_sequence_number;
 
-                // set the initial bucket count
-                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table->next_bucket, NULL);
-                (void)interlocked_exchange(&clds_hash_table->first_hash_table->bucket_count, (int32_t)initial_bucket_size);
-                (void)interlocked_exchange(&clds_hash_table->first_hash_table->item_count, 0);
-                (void)interlocked_exchange(&clds_hash_table->first_hash_table->pending_insert_count, 0);
+        result = true;
+    }
 
-                for (i = 0; i < initial_bucket_size; i++)
-                {
-                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table->hash_table[i], NULL);
-                }
+    return result;
+}
 
-                goto all_ok;
-            }
+// an item being moved is out of the old bucket for a moment before it lands in the new one, a walk that is done with the old bucket has to let the move complete before it goes on
+static void wait_for_bucket_move(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint64_t bucket_mask, int32_t bucket_index)
+{
+    for (uint32_t i = get_first_migration_stripe_of_bucket(bucket_index); i < MIGRATION_STRIPE_COUNT; i += get_migration_stripe_step(bucket_mask))
+    {
+        MIGRATION_STRIPE* migration_stripe = &clds_hash_table->migration_stripes[i];
 
-            free(clds_hash_table);
+        int32_t sequence;
+        while (((sequence = interlocked_add(&migration_stripe->sequence, 0)) & 1) != 0)
+        {
+            (void)wait_on_address(&migration_stripe->sequence, sequence, UINT32_MAX);
         }
     }
-
-    clds_hash_table = NULL;
-
-all_ok:
-    return clds_hash_table;
 }
 
-static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+static bool take_item_for_snapshot(CLDS_SORTED_LIST_ITEM* item, int64_t snapshot_epoch)
 {
+    // items with a lower epoch were in the table when the snapshot started, whoever moves the epoch first (the snapshot walk or a writer removing the item) takes it
     HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
-
-    (void)context;
-    if (hash_table_item->item_cleanup_callback != NULL)
+    bool result = false;
+    int64_t item_epoch = interlocked_add_64(&hash_table_item->snapshot_epoch, 0);
+    while (item_epoch < snapshot_epoch)
     {
-        hash_table_item->item_cleanup_callback(hash_table_item->item_cleanup_callback_context, (void*)item);
+        int64_t current_item_epoch = interlocked_compare_exchange_64(&hash_table_item->snapshot_epoch, snapshot_epoch, item_epoch);
+        if (current_item_epoch == item_epoch)
+        {
+            result = true;
+            break;
+        }
+
+        item_epoch = current_item_epoch;
     }
+
+    return result;
 }
 
-void clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static bool add_to_concurrent_snapshot_items(CONCURRENT_SNAPSHOT_CONTEXT* snapshot_context, CLDS_SORTED_LIST_ITEM* item)
 {
-    if (clds_hash_table == NULL)
+    bool result;
+
+    // each item that was in the table at the cut is taken once, so the array sized at the cut has room for all of them
+    int64_t item_index = interlocked_increment_64(&snapshot_context->item_count) - 1;
+    if ((uint64_t)item_index >= snapshot_context->item_capacity)
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+        LogError("More items found than the %" PRIu64 " items that were in the table when the snapshot started", snapshot_context->item_capacity);
+        result = false;
     }
     else
     {
-        int32_t i;
-
-        BUCKET_ARRAY* bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (bucket_array != NULL)
-        {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+        // the item is only protected by a hazard pointer or by the write operation that takes it out of the table here
+        (void)clds_sorted_list_node_inc_ref(item);
+        snapshot_context->items[item_index] = item;
+        result = true;
+    }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
-            for (i = 0; i < bucket_array->bucket_count; i++)
-            {
-                if (bucket_array->hash_table[i] != NULL)
-                {
-                    CLDS_SORTED_LIST_HANDLE linked_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->hash_table[i], NULL, NULL);
-                    if (linked_list != NULL)
-                    {
-                        clds_sorted_list_destroy(linked_list);
-                    }
-                }
-            }
+    return result;
+}
 
-            free(bucket_array);
-            bucket_array = next_bucket_array;
+static void preserve_item_for_concurrent_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HASH_TABLE_ITEM* item)
+{
+    // this is called within a write operation and the snapshot is only set and cleared while writes are locked, so it is stable here
+    CONCURRENT_SNAPSHOT_CONTEXT* snapshot_context = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->concurrent_snapshot, NULL, NULL);
+    if (snapshot_context != NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_045: [ While a concurrent snapshot is in progress, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall increment the ref count of each item they take out of the table that the snapshot did not take yet and add it to the array of the snapshot. ]*/
+        if (take_item_for_snapshot((void*)item, snapshot_context->snapshot_epoch))
+        {
+            // the snapshot fails on its own when it finds that more slots were handed out than it has
+            (void)add_to_concurrent_snapshot_items(snapshot_context, (void*)item);
         }
+    }
+}
 
-        free(clds_hash_table);
+static bool add_item_to_concurrent_snapshot(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    bool result;
+    CONCURRENT_SNAPSHOT_CONTEXT* snapshot_context = context;
+
+    if (!take_item_for_snapshot(item, snapshot_context->snapshot_epoch))
+    {
+        // inserted after the snapshot started or already taken
+        result = true;
+    }
+    else
+    {
+        result = add_to_concurrent_snapshot_items(snapshot_context, item);
     }
+
+    return result;
 }
 
-CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+static bool add_item_to_iterate_page(void* context, CLDS_SORTED_LIST_ITEM* item)
 {
-    CLDS_HASH_TABLE_INSERT_RESULT result;
+    bool result;
+    ITERATE_PAGE_CONTEXT* page_context = context;
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        (page_context->resume_after_key != NULL) &&
+        (page_context->clds_hash_table->key_compare_func(hash_table_item->key, page_context->resume_after_key) <= 0)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
-            clds_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
-        result = CLDS_HASH_TABLE_INSERT_ERROR;
+        // returned by a previous page
+        result = true;
+    }
+    else if (page_context->item_count == page_context->max_item_count)
+    {
+        // page is full, the walk resumes from here
+        result = false;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_035: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_036: [ clds_hash_table_insert shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
+        (void)clds_sorted_list_node_inc_ref(item);
+        page_context->items[page_context->item_count] = (void*)item;
+        page_context->item_count++;
+        result = true;
+    }
 
-        bool restart_needed;
-        CLDS_SORTED_LIST_HANDLE bucket_list = NULL;
-        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, value);
-        uint64_t hash;
-        BUCKET_ARRAY* current_bucket_array;
-        int32_t bucket_count;
-        uint64_t bucket_index;
-        bool found_in_lower_levels = false;
+    return result;
+}
 
-        // find or allocate a new bucket array
-        current_bucket_array = get_first_bucket_array(clds_hash_table);
-        bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
+static CLDS_SORTED_LIST_DELETE_RESULT delete_key_from_bucket(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_HANDLE bucket_list, void* key, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
 
-        (void)interlocked_increment(&current_bucket_array->pending_insert_count);
+    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->concurrent_snapshot, NULL, NULL) == NULL)
+    {
+        result = clds_sorted_list_delete_key(bucket_list, clds_hazard_pointers_thread, key, sequence_number);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_044: [ While a concurrent snapshot is in progress, clds_hash_table_delete shall remove the item by calling clds_sorted_list_remove_key instead of clds_sorted_list_delete_key and release it after preserving it for the snapshot. ]*/
+        CLDS_SORTED_LIST_ITEM* removed_item;
+        CLDS_SORTED_LIST_REMOVE_RESULT remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, key, &removed_item, sequence_number);
+        switch (remove_result)
+        {
+        case CLDS_SORTED_LIST_REMOVE_OK:
+            preserve_item_for_concurrent_snapshot(clds_hash_table, (void*)removed_item);
+            clds_sorted_list_node_release(removed_item);
+            result = CLDS_SORTED_LIST_DELETE_OK;
+            break;
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        hash = clds_hash_table->compute_hash(key);
+        case CLDS_SORTED_LIST_REMOVE_NOT_FOUND:
+            result = CLDS_SORTED_LIST_DELETE_NOT_FOUND;
+            break;
 
-        found_in_lower_levels = false;
+        default:
+        case CLDS_SORTED_LIST_REMOVE_ERROR:
+            result = CLDS_SORTED_LIST_DELETE_ERROR;
+            break;
+        }
+    }
 
-        // check if the key exists in the lower level bucket arrays
-        BUCKET_ARRAY* find_bucket_array = current_bucket_array;
-        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
+    return result;
+}
 
-        if (next_bucket_array != NULL)
+static void* get_item_key_cb(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+    (void)context;
+    return hash_table_item->key;
+}
+
+static int key_compare_cb(void* context, void* key1, void* key2)
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table = context;
+    return clds_hash_table->key_compare_func(key1, key2);
+}
+
+static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequence_no)
+{
+    if (context == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_075: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
+        LogError("Invalid arguments: void* context=%p, int64_t skipped_sequence_no=%" PRId64,
+            context, skipped_sequence_no);
+    }
+    else
+    {
+        CLDS_HASH_TABLE_HANDLE clds_hash_table = context;
+        if (clds_hash_table->skipped_seq_no_cb == NULL)
         {
-            // wait for all outstanding inserts in the lower levels to complete
-            do
-            {
-                if (interlocked_add(&next_bucket_array->pending_insert_count, 0) == 0)
-                {
-                    break;
-                }
-            } while (1);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_113: [ If the sequence number callback passed to clds_hash_table_create was NULL, on_sorted_list_skipped_seq_no shall return. ]*/
         }
-
-        find_bucket_array = next_bucket_array;
-        while (find_bucket_array != NULL)
+        else
         {
-            next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
-
-            bucket_index = hash % interlocked_add(&find_bucket_array->bucket_count, 0);
-            bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->hash_table[bucket_index], NULL, NULL);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_076: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
+            clds_hash_table->skipped_seq_no_cb(clds_hash_table->skipped_seq_no_cb_context, skipped_sequence_no);
+        }
+    }
+}
 
-            if (bucket_list != NULL)
-            {
-                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                if (sorted_list_item != NULL)
-                {
-                    clds_sorted_list_node_release(sorted_list_item);
+static uint64_t compute_key_hash(CLDS_HASH_TABLE* clds_hash_table, void* key)
+{
+    uint64_t hash = clds_hash_table->compute_hash(key);
 
-                    found_in_lower_levels = true;
-                    break;
-                }
-            }
+    if (clds_hash_table->hash_finalizer == CLDS_HASH_TABLE_HASH_FINALIZER_MIX64)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_170: [ If hash_finalizer is CLDS_HASH_TABLE_HASH_FINALIZER_MIX64, the value returned by compute_hash shall be mixed with the 64 bit MurmurHash3 finalizer before it is used to pick a bucket. ]*/
+        // every bit of the user hash ends up affecting the low bits that the bucket mask keeps
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+    }
 
-            find_bucket_array = next_bucket_array;
-        }
+    return hash;
+}
 
-        if (found_in_lower_levels)
+static BUCKET_ARRAY* get_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table)
+{
+    // always insert in the first bucket array
+    BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+    int32_t bucket_count = first_bucket_array->bucket_count;
+    while (is_bucket_array_full(first_bucket_array, bucket_count))
+    {
+        // allocate a new bucket array
+        BUCKET_ARRAY* new_bucket_array = malloc_flex(sizeof(BUCKET_ARRAY), bucket_count, sizeof(CLDS_SORTED_LIST) * 2);
+        if (new_bucket_array == NULL)
         {
-            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+            // cannot allocate new bucket, will stick to what we have, but do not fail
+            break;
         }
         else
         {
-            (void)interlocked_increment(&current_bucket_array->item_count);
-
-            // find the bucket
-            /* Codes_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
-            bucket_index = hash % bucket_count;
+            // insert new bucket
+            /* Codes_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+            bucket_count = bucket_count * 2;
+            new_bucket_array->bucket_count = bucket_count;
+            new_bucket_array->bucket_mask = (uint64_t)bucket_count - 1;
+            new_bucket_array->bucket_array_id = interlocked_increment_64(&clds_hash_table->last_bucket_array_id);
+            init_bucket_array_counters(new_bucket_array);
 
-            do
+            // initialize buckets
+            for (int32_t i = 0; i < bucket_count; i++)
             {
-                // do we have a list here or do we create one?
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
-                {
-                    restart_needed = false;
-                }
-                else
-                {
-                    // create a list
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_019: [ If no sorted list exists at the determined bucket index then a new list shall be created. ]*/
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
-                    bucket_list = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
-                    if (bucket_list == NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-                        LogError("Cannot allocate list for hash table bucket");
-                        restart_needed = false;
-                    }
-                    else
-                    {
-                        // now put the list in the bucket
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], bucket_list, NULL) != NULL)
-                        {
-                            // oops, someone else inserted a new list, just bail on our list and restart
-                            clds_sorted_list_destroy(bucket_list);
-                            restart_needed = true;
-                        }
-                        else
-                        {
-                            // set new list
-                            restart_needed = false;
-                        }
-                    }
-                }
-            } while (restart_needed);
+                clds_sorted_list_init(&new_bucket_array->hash_table[i], &clds_hash_table->sorted_list_config);
+            }
 
-            if (bucket_list == NULL)
+            (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
+            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
             {
-                (void)interlocked_decrement(&current_bucket_array->item_count);
-
-                LogError("Cannot acquire bucket list");
-                result = CLDS_HASH_TABLE_INSERT_ERROR;
+                first_bucket_array = new_bucket_array;
+                break;
             }
             else
             {
-                CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
-
-                /* Codes_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-                hash_table_item->key = key;
-
-                /* Codes_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
-                /* Codes_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
-                list_insert_result = clds_sorted_list_insert(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
-
-                if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
-                {
-                    (void)interlocked_decrement(&current_bucket_array->item_count);
-
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
-                    result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
-                }
-                else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
-                {
-                    (void)interlocked_decrement(&current_bucket_array->item_count);
+                // first bucket array changed, drop ours and use the one that was inserted
+                free(new_bucket_array);
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-                    LogError("Cannot insert hash table item into list");
-                    result = CLDS_HASH_TABLE_INSERT_ERROR;
-                }
-                else
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
-                    result = CLDS_HASH_TABLE_INSERT_OK;
-                }
+                first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+                bucket_count = first_bucket_array->bucket_count;
             }
         }
+    }
+
+    return first_bucket_array;
+}
+
+static bool is_bucket_empty(CLDS_SORTED_LIST_HANDLE bucket_list)
+{
+    // looking at the head saves a call into the list for the buckets that hold no items
+    return interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_list->head, NULL, NULL) == NULL;
+}
 
-        (void)interlocked_decrement(&current_bucket_array->pending_insert_count);
+static void reclaim_bucket_array(void* node)
+{
+    // the lists are empty at this point and they live in the bucket array, so there is nothing else to free
+    free(node);
+}
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_063: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+static void report_migration_sequence_number(CLDS_HASH_TABLE_HANDLE clds_hash_table, int64_t sequence_number)
+{
+    // moving an item is not a user visible operation, so the sequence numbers it consumes are reported as skipped
+    if (clds_hash_table->skipped_seq_no_cb != NULL)
+    {
+        clds_hash_table->skipped_seq_no_cb(clds_hash_table->skipped_seq_no_cb_context, sequence_number);
     }
-    return result;
 }
 
-static bool find_by_key_value(void* item_compare_context, CLDS_SORTED_LIST_ITEM* item)
+static int migrate_item(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* source_bucket_array, CLDS_SORTED_LIST_HANDLE source_list, BUCKET_ARRAY* target_bucket_array, CLDS_SORTED_LIST_ITEM* item)
 {
-    bool result;
-    FIND_BY_KEY_VALUE_CONTEXT* find_by_key_value_context = item_compare_context;
+    int result;
     HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+    uint64_t hash = compute_key_hash(clds_hash_table, hash_table_item->key);
+    uint64_t bucket_index = hash & target_bucket_array->bucket_mask;
+    CLDS_SORTED_LIST_HANDLE target_list = &target_bucket_array->hash_table[bucket_index];
+    uint32_t stripe_index = get_stripe_index(clds_hazard_pointers_thread);
 
-    if ((item != find_by_key_value_context->value) ||
-        (find_by_key_value_context->key_compare_func(hash_table_item->key, find_by_key_value_context->key) != 0))
+    int64_t sequence_number;
+    int64_t* sequence_number_ptr = (clds_hash_table->sequence_number == NULL) ? NULL : &sequence_number;
+    CLDS_SORTED_LIST_ITEM* removed_item;
+
+    CLDS_SORTED_LIST_REMOVE_RESULT remove_result = clds_sorted_list_remove_key(source_list, clds_hazard_pointers_thread, hash_table_item->key, &removed_item, sequence_number_ptr);
+    if (remove_result != CLDS_SORTED_LIST_REMOVE_OK)
     {
-        result = false;
+        LogError("clds_sorted_list_remove_key failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_REMOVE_RESULT, remove_result));
+        result = MU_FAILURE;
     }
     else
     {
-        result = true;
+        if (sequence_number_ptr != NULL)
+        {
+            report_migration_sequence_number(clds_hash_table, sequence_number);
+        }
+
+        add_to_item_count(target_bucket_array, stripe_index, 1);
+        add_to_item_count(source_bucket_array, stripe_index, -1);
+
+        // the reference obtained by the remove is handed over to the target list
+        CLDS_SORTED_LIST_INSERT_RESULT insert_result = clds_sorted_list_insert(target_list, clds_hazard_pointers_thread, removed_item, sequence_number_ptr);
+        if (insert_result != CLDS_SORTED_LIST_INSERT_OK)
+        {
+            LogError("clds_sorted_list_insert failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_INSERT_RESULT, insert_result));
+
+            add_to_item_count(target_bucket_array, stripe_index, -1);
+
+            // put the item back where it was so that it is not lost
+            if (clds_sorted_list_insert(source_list, clds_hazard_pointers_thread, removed_item, sequence_number_ptr) != CLDS_SORTED_LIST_INSERT_OK)
+            {
+                LogError("Cannot put item %p back in the old bucket array, item is dropped from the table", removed_item);
+                clds_sorted_list_node_release(removed_item);
+            }
+            else
+            {
+                add_to_item_count(source_bucket_array, stripe_index, 1);
+
+                if (sequence_number_ptr != NULL)
+                {
+                    report_migration_sequence_number(clds_hash_table, sequence_number);
+                }
+            }
+
+            result = MU_FAILURE;
+        }
+        else
+        {
+            if (sequence_number_ptr != NULL)
+            {
+                report_migration_sequence_number(clds_hash_table, sequence_number);
+            }
+
+            result = 0;
+        }
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+static int migrate_bucket(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* source_bucket_array, int32_t bucket_index, BUCKET_ARRAY* target_bucket_array)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    int result;
+    CLDS_SORTED_LIST_HANDLE source_list = &source_bucket_array->hash_table[bucket_index];
 
-    if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
-        )
+    if (is_bucket_empty(source_list))
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_HASH_TABLE_DELETE_ERROR;
+        // nothing to move from this bucket
+        result = 0;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_037: [ clds_hash_table_delete shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_038: [ clds_hash_table_delete shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_039: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_040: [ clds_hash_table_delete shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_041: [ clds_hash_table_delete shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
-
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        CLDS_SORTED_LIST_ITEM** items = NULL;
+        uint64_t item_count;
+        uint64_t retrieved_item_count = 0;
 
-        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        // the writers of the keys of this bucket are held up, locking the list is only needed to be able to count and collect its items
+        clds_sorted_list_lock_writes(source_list);
 
-        // always delete starting with the first bucket array
-        /* Codes_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        CLDS_SORTED_LIST_GET_COUNT_RESULT get_count_result = clds_sorted_list_get_count(source_list, clds_hazard_pointers_thread, &item_count);
+        if (get_count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
-
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, get_count_result));
+            result = MU_FAILURE;
+        }
+        else if (item_count == 0)
+        {
+            result = 0;
+        }
+        else
+        {
+            items = malloc_2((size_t)item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+            if (items == NULL)
             {
-                // find the bucket
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
-
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
+                LogError("malloc_2((size_t)item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed",
+                    (size_t)item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+                result = MU_FAILURE;
+            }
+            else
+            {
+                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(source_list, clds_hazard_pointers_thread, item_count, items, &retrieved_item_count, true);
+                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
+                    free(items);
+                    items = NULL;
+                    result = MU_FAILURE;
                 }
                 else
                 {
-                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+                    result = 0;
+                }
+            }
+        }
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-                    list_delete_result = clds_sorted_list_delete_key(bucket_list, clds_hazard_pointers_thread, key, sequence_number);
-                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
-                    {
-                        // not found
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    }
-                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
-                    {
-                        (void)interlocked_decrement(&current_bucket_array->item_count);
+        clds_sorted_list_unlock_writes(source_list);
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_OK;
-                        break;
-                    }
-                    else
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_ERROR;
-                        break;
-                    }
+        if (items != NULL)
+        {
+            for (uint64_t i = 0; i < retrieved_item_count; i++)
+            {
+                if (result == 0)
+                {
+                    result = migrate_item(clds_hash_table, clds_hazard_pointers_thread, source_bucket_array, source_list, target_bucket_array, items[i]);
                 }
+
+                // release the reference obtained by clds_sorted_list_get_all
+                clds_sorted_list_node_release(items[i]);
             }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-            current_bucket_array = next_bucket_array;
+            free(items);
         }
-
-        /* Codes_SRS_CLDS_HASH_TABLE_42_042: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+// called while holding the migration lock
+static CLDS_HASH_TABLE_MIGRATE_RESULT migrate_buckets(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t bucket_budget)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-
-    if (
-        /*Codes_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (value == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
-        )
-    {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, value, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_HASH_TABLE_DELETE_ERROR;
-    }
-    else
-    {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_043: [ clds_hash_table_delete_key_value shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_044: [ clds_hash_table_delete_key_value shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_045: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_046: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_047: [ clds_hash_table_delete_key_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
+    CLDS_HASH_TABLE_MIGRATE_RESULT result;
+    uint32_t migrated_bucket_count = 0;
 
-        // compute the hash
-        /*Codes_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+    // items are moved to the bucket array that is on top now, if a new one gets added meanwhile they are moved again later
+    BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
 
-        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+    result = CLDS_HASH_TABLE_MIGRATE_OK;
+    while (migrated_bucket_count < bucket_budget)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_005: [ The oldest bucket array shall be the last bucket array in the list of bucket arrays. ]*/
+        BUCKET_ARRAY* previous_bucket_array = first_bucket_array;
+        BUCKET_ARRAY* oldest_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&first_bucket_array->next_bucket, NULL, NULL);
+        if (oldest_bucket_array == NULL)
+        {
+            break;
+        }
 
-        // always insert in the first bucket array
-        /*Codes_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        BUCKET_ARRAY* next_bucket_array;
+        while ((next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&oldest_bucket_array->next_bucket, NULL, NULL)) != NULL)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+            previous_bucket_array = oldest_bucket_array;
+            oldest_bucket_array = next_bucket_array;
+        }
 
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
-            {
-                // find the bucket
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
+        if (clds_hash_table->migration_bucket_index < oldest_bucket_array->bucket_count)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_007: [ Before moving a bucket, clds_hash_table_migrate shall hold up new write operations on the keys that can be in the bucket and wait for the ongoing write operations on those keys to complete. ]*/
+            lock_bucket_for_move(clds_hash_table, oldest_bucket_array->bucket_mask, clds_hash_table->migration_bucket_index);
 
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
-                {
-                    /*Codes_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
-                }
-                else
-                {
-                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+            /* Codes_SRS_CLDS_HASH_TABLE_07_008: [ For each bucket, up to bucket_budget buckets, clds_hash_table_migrate shall move all the items in the next not yet migrated bucket of the oldest bucket array to the top level bucket array. ]*/
+            int migrate_bucket_result = migrate_bucket(clds_hash_table, clds_hazard_pointers_thread, oldest_bucket_array, clds_hash_table->migration_bucket_index, first_bucket_array);
 
-                    /*Codes_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-                    list_delete_result = clds_sorted_list_delete_item(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
-                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
-                    {
-                        // not found
-                    }
-                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
-                    {
-                        (void)interlocked_decrement(&current_bucket_array->item_count);
+            /* Codes_SRS_CLDS_HASH_TABLE_07_013: [ After moving a bucket, clds_hash_table_migrate shall let the write operations on the keys that can be in the bucket proceed. ]*/
+            unlock_bucket_for_move(clds_hash_table, oldest_bucket_array->bucket_mask, clds_hash_table->migration_bucket_index);
 
-                        /*Codes_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_OK;
-                        break;
-                    }
-                    else
-                    {
-                        /*Codes_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_ERROR;
-                        break;
-                    }
-                }
+            if (migrate_bucket_result != 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_011: [ If any error occurs, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+                LogError("Cannot migrate bucket %" PRId32 " of bucket array %p", clds_hash_table->migration_bucket_index, oldest_bucket_array);
+                result = CLDS_HASH_TABLE_MIGRATE_ERROR;
+                break;
             }
 
-            /*Codes_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-            current_bucket_array = next_bucket_array;
+            clds_hash_table->migration_bucket_index++;
+            migrated_bucket_count++;
+        }
+        else if (get_exact_item_count(oldest_bucket_array) != 0)
+        {
+            // items are left behind (an earlier move failed), go through the buckets again
+            // no insert targets this bucket array anymore, so a concurrent delete can only make the count look higher than it is
+            clds_hash_table->migration_bucket_index = 0;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_009: [ When all the buckets of the oldest bucket array have been moved, clds_hash_table_migrate shall unlink the oldest bucket array and reclaim it by calling clds_hazard_pointers_reclaim. ]*/
+            (void)interlocked_exchange_pointer((void* volatile_atomic*)&previous_bucket_array->next_bucket, NULL);
+            clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, oldest_bucket_array, reclaim_bucket_array);
+            clds_hash_table->migration_bucket_index = 0;
         }
+    }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_048: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+    if (
+        (result == CLDS_HASH_TABLE_MIGRATE_OK) &&
+        (interlocked_compare_exchange_pointer((void* volatile_atomic*)&first_bucket_array->next_bucket, NULL, NULL) == NULL)
+        )
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_010: [ If only the top level bucket array is left, clds_hash_table_migrate shall return CLDS_HASH_TABLE_MIGRATE_COMPLETE. ]*/
+        result = CLDS_HASH_TABLE_MIGRATE_COMPLETE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_012: [ Otherwise clds_hash_table_migrate shall succeed and return CLDS_HASH_TABLE_MIGRATE_OK. ]*/
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_REMOVE_RESULT clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+static CLDS_HASH_TABLE_MIGRATE_RESULT internal_migrate(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t bucket_budget)
 {
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_MIGRATE_RESULT result;
 
-    if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
-        )
+    if (interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0) != 0)
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, item, sequence_number);
-        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+        /* Codes_SRS_CLDS_HASH_TABLE_07_006: [ If another migration or a snapshot is in progress, clds_hash_table_migrate shall return CLDS_HASH_TABLE_MIGRATE_BUSY. ]*/
+        result = CLDS_HASH_TABLE_MIGRATE_BUSY;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_049: [ clds_hash_table_remove shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_050: [ clds_hash_table_remove shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_051: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_052: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_053: [ clds_hash_table_remove shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
-
-        /* Codes_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+        result = migrate_buckets(clds_hash_table, clds_hazard_pointers_thread, bucket_budget);
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+    }
 
-        result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+    return result;
+}
 
-        // always insert in the first bucket array
-        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+static void help_migrate(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, bool has_lower_levels)
+{
+    uint32_t bucket_budget = (uint32_t)interlocked_add(&clds_hash_table->migration_bucket_budget, 0);
+    if (
+        (bucket_budget != 0) &&
+        has_lower_levels
+        )
+    {
+        // do not wait if someone else is already migrating, the work will get done by them
+        CLDS_HASH_TABLE_MIGRATE_RESULT migrate_result = internal_migrate(clds_hash_table, clds_hazard_pointers_thread, bucket_budget);
+        if (migrate_result == CLDS_HASH_TABLE_MIGRATE_ERROR)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
-
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
-            {
-                // find the bucket
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
-
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
-                }
-                else
-                {
-                    CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result;
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove. ]*/
-                    list_remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, key, (void*)item, sequence_number);
-                    if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
-                    {
-                        // not found
-                    }
-                    else if (list_remove_result == CLDS_SORTED_LIST_REMOVE_OK)
-                    {
-                        (void)interlocked_decrement(&current_bucket_array->item_count);
-
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
-                        result = CLDS_HASH_TABLE_REMOVE_OK;
-                        break;
-                    }
-                    else
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_REMOVE_ERROR;
-                        break;
-                    }
-                }
-            }
-
-            /* Codes_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-            current_bucket_array = next_bucket_array;
+            LogError("Cooperative migration step failed");
         }
+    }
+}
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_054: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+static size_t round_up_to_power_of_two(size_t value)
+{
+    size_t result = 1;
+
+    while (result < value)
+    {
+        result <<= 1;
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_SET_VALUE_RESULT clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+CLDS_HASH_TABLE_HANDLE clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
 {
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    /* Codes_SRS_CLDS_HASH_TABLE_07_165: [ clds_hash_table_create shall create a hash table that uses the hash computed by compute_hash as is (CLDS_HASH_TABLE_HASH_FINALIZER_NONE). ]*/
+    return clds_hash_table_create_with_hash_finalizer(compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context, CLDS_HASH_TABLE_HASH_FINALIZER_NONE);
+}
+
+CLDS_HASH_TABLE_HANDLE clds_hash_table_create_with_hash_finalizer(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context, CLDS_HASH_TABLE_HASH_FINALIZER hash_finalizer)
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+    /* Codes_S_R_S_CLDS_HASH_TABLE_01_072: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
+    /* Codes_S_R_S_CLDS_HASH_TABLE_01_073: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (new_item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (old_item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        /* Codes_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_045: [ If key_compare_func is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_004: [ If initial_bucket_size is 0, clds_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_166: [ If initial_bucket_size is greater than 2^29, clds_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size > MAX_INITIAL_BUCKET_SIZE) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_S_R_S_CLDS_HASH_TABLE_01_074: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_create shall fail and return NULL. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL)) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_167: [ If hash_finalizer is not a valid CLDS_HASH_TABLE_HASH_FINALIZER value, clds_hash_table_create_with_hash_finalizer shall fail and return NULL. ]*/
+        ((hash_finalizer != CLDS_HASH_TABLE_HASH_FINALIZER_NONE) && (hash_finalizer != CLDS_HASH_TABLE_HASH_FINALIZER_MIX64))
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
-        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p, CLDS_HASH_TABLE_HASH_FINALIZER hash_finalizer=%" PRI_MU_ENUM "",
+            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context, MU_ENUM_VALUE(CLDS_HASH_TABLE_HASH_FINALIZER, hash_finalizer));
     }
     else
     {
-        uint64_t bucket_index;
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-
-        /* Codes_SRS_CLDS_HASH_TABLE_42_055: [ clds_hash_table_set_value shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_056: [ clds_hash_table_set_value shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_057: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_058: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_059: [ clds_hash_table_set_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        // compute the hash
-        uint64_t hash = clds_hash_table->compute_hash(key);
-
-        // find or allocate a new bucket array
-        BUCKET_ARRAY* first_bucket_array = get_first_bucket_array(clds_hash_table);
-
-        // increment pending inserts count
-        (void)interlocked_increment(&first_bucket_array->pending_insert_count);
+        /* Codes_SRS_CLDS_HASH_TABLE_07_168: [ clds_hash_table_create shall round initial_bucket_size up to the next power of two, so that the bucket of a hash is obtained by masking the hash instead of dividing it. ]*/
+        initial_bucket_size = round_up_to_power_of_two(initial_bucket_size);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+        clds_hash_table = malloc(sizeof(CLDS_HASH_TABLE));
+        if (clds_hash_table == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+            LogError("Cannot allocate memory for hash table");
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
+            clds_hash_table->first_hash_table = malloc_flex(sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST));
+            if (clds_hash_table->first_hash_table == NULL)
+            {
+                LogError("Cannot allocate memory for hash table array. Failure in malloc_flex(sizeof(BUCKET_ARRAY)=%zu, initial_bucket_size=%zu, sizeof(CLDS_SORTED_LIST)=%zu);",
+                    sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST));
+            }
+            /* Codes_SRS_CLDS_HASH_TABLE_07_087: [ clds_hash_table_create shall initialize the sorted list configuration shared by all the buckets by calling clds_sorted_list_config_init. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_01_071: [ The start sequence number passed to clds_hash_table_create shall be passed as the start_sequence_number argument to clds_sorted_list_config_init. ]*/
+            else if (clds_sorted_list_config_init(&clds_hash_table->sorted_list_config, clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, start_sequence_number, start_sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table) != 0)
+            {
+                LogError("clds_sorted_list_config_init failed");
+                free(clds_hash_table->first_hash_table);
+            }
+            else
+            {
+                size_t i;
+
+                // all OK
+                clds_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+                clds_hash_table->compute_hash = compute_hash;
+                /* Codes_SRS_CLDS_HASH_TABLE_07_169: [ clds_hash_table_create_with_hash_finalizer shall create a hash table that applies hash_finalizer to every hash computed by compute_hash. ]*/
+                clds_hash_table->hash_finalizer = hash_finalizer;
+                clds_hash_table->key_compare_func = key_compare_func;
+                clds_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
+                clds_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+
+                for (i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
+                {
+                    (void)interlocked_exchange(&clds_hash_table->pending_write_operations[i].count, 0);
+                }
+                (void)interlocked_exchange(&clds_hash_table->write_lock_waiters, 0);
+                (void)interlocked_exchange(&clds_hash_table->locked_for_write, 0);
+
+                (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+                for (i = 0; i < MIGRATION_STRIPE_COUNT; i++)
+                {
+                    (void)interlocked_exchange(&clds_hash_table->migration_stripes[i].sequence, 0);
+                    (void)interlocked_exchange(&clds_hash_table->migration_stripes[i].pending_write_operations, 0);
+                }
+                /* Codes_SRS_CLDS_HASH_TABLE_07_016: [ By default the migration bucket budget shall be 0, which means that insert and set value operations do not migrate any buckets. ]*/
+                (void)interlocked_exchange(&clds_hash_table->migration_bucket_budget, 0);
+                clds_hash_table->migration_bucket_index = 0;
+
+                (void)interlocked_exchange_64(&clds_hash_table->snapshot_epoch, 0);
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->concurrent_snapshot, NULL);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+                clds_hash_table->sequence_number = start_sequence_number;
+
+                // set the initial bucket count
+                clds_hash_table->initial_bucket_count = (int32_t)initial_bucket_size;
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table->next_bucket, NULL);
+                clds_hash_table->first_hash_table->bucket_count = (int32_t)initial_bucket_size;
+                clds_hash_table->first_hash_table->bucket_mask = (uint64_t)initial_bucket_size - 1;
+                clds_hash_table->first_hash_table->bucket_array_id = 0;
+                (void)interlocked_exchange_64(&clds_hash_table->last_bucket_array_id, 0);
+                init_bucket_array_counters(clds_hash_table->first_hash_table);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_07_088: [ clds_hash_table_create shall initialize the list of each bucket in place by calling clds_sorted_list_init. ]*/
+                for (i = 0; i < initial_bucket_size; i++)
+                {
+                    clds_sorted_list_init(&clds_hash_table->first_hash_table->hash_table[i], &clds_hash_table->sorted_list_config);
+                }
+
+                goto all_ok;
+            }
+
+            free(clds_hash_table);
+        }
+    }
+
+    clds_hash_table = NULL;
+
+all_ok:
+    return clds_hash_table;
+}
+
+static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    (void)context;
+    if (hash_table_item->item_cleanup_callback != NULL)
+    {
+        hash_table_item->item_cleanup_callback(hash_table_item->item_cleanup_callback_context, (void*)item);
+    }
+}
+
+void clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    if (clds_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+    }
+    else
+    {
+        int32_t i;
+
+        BUCKET_ARRAY* bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
+            for (i = 0; i < bucket_array->bucket_count; i++)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_089: [ clds_hash_table_destroy shall free the items of each non-empty bucket by calling clds_sorted_list_deinit. ]*/
+                if (!is_bucket_empty(&bucket_array->hash_table[i]))
+                {
+                    clds_sorted_list_deinit(&bucket_array->hash_table[i]);
+                }
+            }
+
+            free(bucket_array);
+            bucket_array = next_bucket_array;
+        }
+
+        free(clds_hash_table);
+    }
+}
+
+typedef struct ITEM_FACTORY_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    HASH_TABLE_ITEM_FACTORY_CB item_factory;
+    void* item_factory_context;
+} ITEM_FACTORY_CONTEXT;
+
+static CLDS_SORTED_LIST_ITEM* create_hash_table_item(void* context, void* key)
+{
+    ITEM_FACTORY_CONTEXT* item_factory_adapter_context = context;
+
+    CLDS_HASH_TABLE_ITEM* result = item_factory_adapter_context->item_factory(item_factory_adapter_context->item_factory_context, key);
+    if (result == NULL)
+    {
+        LogError("item_factory=%p failed creating the item for key=%p", item_factory_adapter_context->item_factory, key);
+    }
+    else
+    {
+        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, result);
+        hash_table_item->key = key;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_046: [ clds_hash_table_insert and clds_hash_table_set_value shall tag the new item with the current snapshot epoch. ]*/
+        (void)interlocked_exchange_64(&hash_table_item->snapshot_epoch, interlocked_add_64(&item_factory_adapter_context->clds_hash_table->snapshot_epoch, 0));
+    }
+
+    return (CLDS_SORTED_LIST_ITEM*)result;
+}
+
+// must be called while the write operation is counted as pending, current_bucket_array is the first bucket array
+// value is NULL when the item is created by item_factory, result_item receives the existing item (get or insert)
+// or the item that ends up in the table (compute if absent), with a reference taken for the caller
+static CLDS_HASH_TABLE_INSERT_RESULT insert_in_bucket_arrays(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* current_bucket_array, uint64_t hash, void* key, CLDS_HASH_TABLE_ITEM* value, HASH_TABLE_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_HASH_TABLE_ITEM** result_item, int64_t* sequence_number, bool* has_lower_levels)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_SORTED_LIST_HANDLE bucket_list = NULL;
+    uint64_t bucket_index;
+    bool found_in_lower_levels = false;
+    uint32_t stripe_index = get_stripe_index(clds_hazard_pointers_thread);
+
+    (void)interlocked_increment(&current_bucket_array->counters[stripe_index].pending_insert_count);
+
+    // check if the key exists in the lower level bucket arrays
+    BUCKET_ARRAY* find_bucket_array = current_bucket_array;
+    BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
+    *has_lower_levels = (next_bucket_array != NULL);
+
+    if (next_bucket_array != NULL)
+    {
+        // wait for all outstanding inserts in the lower levels to complete
+        wait_for_pending_inserts(next_bucket_array);
+    }
+
+    find_bucket_array = next_bucket_array;
+    while (find_bucket_array != NULL)
+    {
+        next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
+
+        bucket_index = hash & find_bucket_array->bucket_mask;
+        bucket_list = &find_bucket_array->hash_table[bucket_index];
+
+        if (!is_bucket_empty(bucket_list))
+        {
+            CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
+            if (sorted_list_item != NULL)
+            {
+                if (result_item != NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_118: [ If the key already exists in any of the bucket arrays, clds_hash_table_get_or_insert shall store the existing item, with its reference count incremented, in existing_item and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_128: [ If the key already exists in any of the bucket arrays, clds_hash_table_compute_if_absent shall store the existing item, with its reference count incremented, in item and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+                    // the reference taken by the find is handed to the caller
+                    *result_item = (CLDS_HASH_TABLE_ITEM*)sorted_list_item;
+                }
+                else
+                {
+                    clds_sorted_list_node_release(sorted_list_item);
+                }
+
+                found_in_lower_levels = true;
+                break;
+            }
+        }
+
+        find_bucket_array = next_bucket_array;
+    }
+
+    if (found_in_lower_levels)
+    {
+        result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+    }
+    else
+    {
+        add_to_item_count(current_bucket_array, stripe_index, 1);
+
+        // find the bucket
+        /* Codes_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
+        bucket_index = hash & current_bucket_array->bucket_mask;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_019: [ The sorted list embedded in the bucket array at the determined bucket index shall be used for the insert. ]*/
+        bucket_list = &current_bucket_array->hash_table[bucket_index];
+
+        CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
+
+        if (item_factory != NULL)
+        {
+            ITEM_FACTORY_CONTEXT item_factory_adapter_context;
+            item_factory_adapter_context.clds_hash_table = clds_hash_table;
+            item_factory_adapter_context.item_factory = item_factory;
+            item_factory_adapter_context.item_factory_context = item_factory_context;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_125: [ clds_hash_table_compute_if_absent shall call clds_sorted_list_compute_if_absent on the bucket list, so that item_factory is called with item_factory_context and key only when the key is not in the bucket. ]*/
+            list_insert_result = clds_sorted_list_compute_if_absent(bucket_list, clds_hazard_pointers_thread, key, create_hash_table_item, &item_factory_adapter_context, (CLDS_SORTED_LIST_ITEM**)result_item, sequence_number);
+        }
+        else
+        {
+            HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, value);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
+            hash_table_item->key = key;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_046: [ clds_hash_table_insert and clds_hash_table_set_value shall tag the new item with the current snapshot epoch. ]*/
+            (void)interlocked_exchange_64(&hash_table_item->snapshot_epoch, interlocked_add_64(&clds_hash_table->snapshot_epoch, 0));
+
+            if (result_item != NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_117: [ Otherwise clds_hash_table_get_or_insert shall insert value in the same way as clds_hash_table_insert, by calling clds_sorted_list_get_or_insert, and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+                list_insert_result = clds_sorted_list_get_or_insert(bucket_list, clds_hazard_pointers_thread, (void*)value, (CLDS_SORTED_LIST_ITEM**)result_item, sequence_number);
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
+                /* Codes_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
+                list_insert_result = clds_sorted_list_insert(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
+            }
+        }
+
+        if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+        {
+            add_to_item_count(current_bucket_array, stripe_index, -1);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
+            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+        }
+        else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+        {
+            add_to_item_count(current_bucket_array, stripe_index, -1);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_07_126: [ If item_factory fails or any other error occurs, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot insert hash table item into list");
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_07_127: [ On success clds_hash_table_compute_if_absent shall store the new item, with a reference count incremented for the caller, in item and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+            result = CLDS_HASH_TABLE_INSERT_OK;
+        }
+    }
+
+    end_pending_insert(current_bucket_array, stripe_index);
+
+    return result;
+}
+
+static CLDS_HASH_TABLE_INSERT_RESULT internal_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, HASH_TABLE_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_HASH_TABLE_ITEM** result_item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    bool has_lower_levels;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_42_035: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_42_036: [ clds_hash_table_insert shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+    check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+    // compute the hash
+    /* Codes_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+    uint64_t hash = compute_key_hash(clds_hash_table, key);
+
+    // keep the buckets that can hold the key from being moved meanwhile, the first bucket array has to be picked after this
+    // so that the insert cannot land in a bucket array whose buckets are already being moved
+    MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hash);
+
+    // find or allocate a new bucket array
+    BUCKET_ARRAY* current_bucket_array = get_first_bucket_array(clds_hash_table);
+
+    result = insert_in_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, current_bucket_array, hash, key, value, item_factory, item_factory_context, result_item, sequence_number, &has_lower_levels);
+
+    end_key_write_operation(migration_stripe);
+
+    /* Codes_SRS_CLDS_HASH_TABLE_42_063: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+    end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_017: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_insert shall migrate up to the migration bucket budget buckets as described in clds_hash_table_migrate. ]*/
+    help_migrate(clds_hash_table, clds_hazard_pointers_thread, has_lower_levels);
+
+    return result;
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        result = internal_insert(clds_hash_table, clds_hazard_pointers_thread, key, value, NULL, NULL, NULL, sequence_number);
+    }
+    return result;
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_get_or_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, CLDS_HASH_TABLE_ITEM** existing_item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_111: [ If clds_hash_table is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_112: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_113: [ If key is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_114: [ If value is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_115: [ If existing_item is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (existing_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_116: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, CLDS_HASH_TABLE_ITEM** existing_item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, value, existing_item, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        result = internal_insert(clds_hash_table, clds_hazard_pointers_thread, key, value, NULL, NULL, existing_item, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_compute_if_absent(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, HASH_TABLE_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_119: [ If clds_hash_table is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_120: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_121: [ If key is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_122: [ If item_factory is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (item_factory == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_123: [ If item is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_124: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, HASH_TABLE_ITEM_FACTORY_CB item_factory=%p, void* item_factory_context=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, item_factory, item_factory_context, item, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        result = internal_insert(clds_hash_table, clds_hazard_pointers_thread, key, NULL, item_factory, item_factory_context, item, sequence_number);
+    }
+
+    return result;
+}
+
+static bool find_by_key_value(void* item_compare_context, CLDS_SORTED_LIST_ITEM* item)
+{
+    bool result;
+    FIND_BY_KEY_VALUE_CONTEXT* find_by_key_value_context = item_compare_context;
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    if ((item != find_by_key_value_context->value) ||
+        (find_by_key_value_context->key_compare_func(hash_table_item->key, find_by_key_value_context->key) != 0))
+    {
+        result = false;
+    }
+    else
+    {
+        result = true;
+    }
+
+    return result;
+}
+
+// must be called while the write operation is counted as pending
+static CLDS_HASH_TABLE_DELETE_RESULT delete_from_bucket_arrays(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash, void* key, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_SORTED_LIST_HANDLE bucket_list;
+    BUCKET_ARRAY* current_bucket_array;
+
+    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+
+    // always delete starting with the first bucket array
+    /* Codes_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+    current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+    while (current_bucket_array != NULL)
+    {
+        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+        // find the bucket
+        uint64_t bucket_index = hash & current_bucket_array->bucket_mask;
+
+        bucket_list = &current_bucket_array->hash_table[bucket_index];
+        if (is_bucket_empty(bucket_list))
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+            result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        }
+        else
+        {
+            CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+            list_delete_result = delete_key_from_bucket(clds_hash_table, clds_hazard_pointers_thread, bucket_list, key, sequence_number);
+            if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+            {
+                // not found
+                /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+            }
+            else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+            {
+                add_to_item_count(current_bucket_array, get_stripe_index(clds_hazard_pointers_thread), -1);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+                result = CLDS_HASH_TABLE_DELETE_OK;
+                break;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+                result = CLDS_HASH_TABLE_DELETE_ERROR;
+                break;
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+        current_bucket_array = next_bucket_array;
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_037: [ clds_hash_table_delete shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_038: [ clds_hash_table_delete shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_039: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_040: [ clds_hash_table_delete shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_041: [ clds_hash_table_delete shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = compute_key_hash(clds_hash_table, key);
+
+        // keep the buckets that can hold the key from being moved meanwhile
+        MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hash);
+
+        result = delete_from_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, hash, key, sequence_number);
+
+        end_key_write_operation(migration_stripe);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_042: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /*Codes_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (value == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, value, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_043: [ clds_hash_table_delete_key_value shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_044: [ clds_hash_table_delete_key_value shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_045: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_046: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_047: [ clds_hash_table_delete_key_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        CLDS_SORTED_LIST_HANDLE bucket_list;
+        BUCKET_ARRAY* current_bucket_array;
+
+        // compute the hash
+        /*Codes_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = compute_key_hash(clds_hash_table, key);
+
+        // keep the buckets that can hold the key from being moved meanwhile
+        MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hash);
+
+        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+
+        // the snapshot is only set and cleared while writes are locked, so it is stable for this whole write operation
+        bool preserve_for_concurrent_snapshot = (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->concurrent_snapshot, NULL, NULL) != NULL);
+
+        // always insert in the first bucket array
+        /*Codes_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+            // find the bucket
+            uint64_t bucket_index = hash & current_bucket_array->bucket_mask;
+
+            bucket_list = &current_bucket_array->hash_table[bucket_index];
+            if (is_bucket_empty(bucket_list))
+            {
+                /*Codes_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+            }
+            else
+            {
+                CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+
+                if (preserve_for_concurrent_snapshot)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_268: [ While a concurrent snapshot is in progress, clds_hash_table_delete_key_value shall increment the ref count of value before deleting it and release it after preserving it for the snapshot. ]*/
+                    // the delete can reclaim value right away, so keep it alive until it is preserved
+                    (void)clds_sorted_list_node_inc_ref((void*)value);
+                }
+
+                /*Codes_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+                list_delete_result = clds_sorted_list_delete_item(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
+                if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                {
+                    // not found
+                }
+                else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+                {
+                    add_to_item_count(current_bucket_array, get_stripe_index(clds_hazard_pointers_thread), -1);
+
+                    if (preserve_for_concurrent_snapshot)
+                    {
+                        preserve_item_for_concurrent_snapshot(clds_hash_table, value);
+                    }
+
+                    /*Codes_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+                    result = CLDS_HASH_TABLE_DELETE_OK;
+                }
+                else
+                {
+                    /*Codes_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+                    result = CLDS_HASH_TABLE_DELETE_ERROR;
+                }
+
+                if (preserve_for_concurrent_snapshot)
+                {
+                    clds_sorted_list_node_release((void*)value);
+                }
+
+                if (list_delete_result != CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                {
+                    break;
+                }
+            }
+
+            /*Codes_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+            current_bucket_array = next_bucket_array;
+        }
+
+        end_key_write_operation(migration_stripe);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_048: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_REMOVE_RESULT clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_049: [ clds_hash_table_remove shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_050: [ clds_hash_table_remove shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_051: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_052: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_053: [ clds_hash_table_remove shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        CLDS_SORTED_LIST_HANDLE bucket_list;
+        BUCKET_ARRAY* current_bucket_array;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = compute_key_hash(clds_hash_table, key);
+
+        // keep the buckets that can hold the key from being moved meanwhile
+        MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hash);
+
+        result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+
+        // always insert in the first bucket array
+        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+            // find the bucket
+            uint64_t bucket_index = hash & current_bucket_array->bucket_mask;
+
+            bucket_list = &current_bucket_array->hash_table[bucket_index];
+            if (is_bucket_empty(bucket_list))
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+                result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+            }
+            else
+            {
+                CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result;
+                /* Codes_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove. ]*/
+                list_remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, key, (void*)item, sequence_number);
+                if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+                {
+                    // not found
+                }
+                else if (list_remove_result == CLDS_SORTED_LIST_REMOVE_OK)
+                {
+                    add_to_item_count(current_bucket_array, get_stripe_index(clds_hazard_pointers_thread), -1);
+
+                    preserve_item_for_concurrent_snapshot(clds_hash_table, *item);
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+                    result = CLDS_HASH_TABLE_REMOVE_OK;
+                    break;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+                    result = CLDS_HASH_TABLE_REMOVE_ERROR;
+                    break;
+                }
+            }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+            current_bucket_array = next_bucket_array;
+        }
+
+        end_key_write_operation(migration_stripe);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_054: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SET_VALUE_RESULT clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
+        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+    }
+    else
+    {
+        uint64_t bucket_index;
+        CLDS_SORTED_LIST_HANDLE bucket_list;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_055: [ clds_hash_table_set_value shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_056: [ clds_hash_table_set_value shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_057: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_058: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_059: [ clds_hash_table_set_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        // compute the hash
+        uint64_t hash = compute_key_hash(clds_hash_table, key);
+
+        // keep the buckets that can hold the key from being moved meanwhile
+        MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hash);
+
+        // find or allocate a new bucket array
+        BUCKET_ARRAY* first_bucket_array = get_first_bucket_array(clds_hash_table);
+
+        uint32_t stripe_index = get_stripe_index(clds_hazard_pointers_thread);
+
+        // increment pending inserts count
+        (void)interlocked_increment(&first_bucket_array->counters[stripe_index].pending_insert_count);
 
         BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&first_bucket_array->next_bucket, NULL, NULL);
+        bool has_lower_levels = (next_bucket_array != NULL);
+        if (next_bucket_array != NULL)
+        {
+            // wait for all outstanding inserts in the lower levels to complete
+            wait_for_pending_inserts(next_bucket_array);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+        bool set_value_in_top_level = true;
+        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+
+        BUCKET_ARRAY* find_bucket_array = next_bucket_array;
+        while (find_bucket_array != NULL)
+        {
+            next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
+
+            bucket_index = hash & find_bucket_array->bucket_mask;
+            bucket_list = &find_bucket_array->hash_table[bucket_index];
+
+            if (!is_bucket_empty(bucket_list))
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_108: [ If the bucket identified by the hash of the key is not empty, clds_hash_table_set_value shall find the key in the list. ]*/
+                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
+                if (sorted_list_item != NULL)
+                {
+                    clds_sorted_list_node_release(sorted_list_item);
+
+                    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+                    hash_table_item->key = key;
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_046: [ clds_hash_table_insert and clds_hash_table_set_value shall tag the new item with the current snapshot epoch. ]*/
+                    (void)interlocked_exchange_64(&hash_table_item->snapshot_epoch, interlocked_add_64(&clds_hash_table->snapshot_epoch, 0));
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+                    CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, condition_check_func, condition_check_context, (void*)old_item, sequence_number, true);
+                    switch (sorted_list_set_value_result)
+                    {
+                    default:
+                    case CLDS_SORTED_LIST_SET_VALUE_ERROR:
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                        LogError("Cannot set key in sorted list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
+                        set_value_in_top_level = false;
+                        break;
+
+                    case CLDS_SORTED_LIST_SET_VALUE_OK:
+                        if (*old_item != NULL)
+                        {
+                            preserve_item_for_concurrent_snapshot(clds_hash_table, *old_item);
+                        }
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                        result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                        set_value_in_top_level = false;
+                        break;
+                    
+                    case CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET:
+                        /* Codes_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+                        result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
+                        set_value_in_top_level = false;
+                        break;
+
+                    case CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND:
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_107: [ If the bucket identified by the hash of the key is empty, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+            }
+
+            find_bucket_array = next_bucket_array;
+        }
+
+        if (set_value_in_top_level)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+            BUCKET_ARRAY* current_bucket_array = first_bucket_array;
+
+            // look for the item in this bucket array
+            // find the bucket
+            bucket_index = hash & current_bucket_array->bucket_mask;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
+            bucket_list = &current_bucket_array->hash_table[bucket_index];
+
+            HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+
+            hash_table_item->key = key;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_046: [ clds_hash_table_insert and clds_hash_table_set_value shall tag the new item with the current snapshot epoch. ]*/
+            (void)interlocked_exchange_64(&hash_table_item->snapshot_epoch, interlocked_add_64(&clds_hash_table->snapshot_epoch, 0));
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
+            CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, condition_check_func, condition_check_context, (void*)old_item, sequence_number, false);
+            if (sorted_list_set_value == CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+                LogError("Condition not met during set value - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
+                result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
+            }
+            else if (sorted_list_set_value != CLDS_SORTED_LIST_SET_VALUE_OK)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                LogError("Cannot set key in sorted list - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
+                result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+            }
+            else
+            {
+                if (*old_item == NULL)
+                {
+                    add_to_item_count(first_bucket_array, stripe_index, 1);
+                }
+                else
+                {
+                    preserve_item_for_concurrent_snapshot(clds_hash_table, *old_item);
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                result = CLDS_HASH_TABLE_SET_VALUE_OK;
+            }
+        }
+
+        end_pending_insert(first_bucket_array, stripe_index);
+
+        end_key_write_operation(migration_stripe);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_060: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_018: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_set_value shall migrate up to the migration bucket budget buckets as described in clds_hash_table_migrate. ]*/
+        help_migrate(clds_hash_table, clds_hazard_pointers_thread, has_lower_levels);
+    }
+
+    return result;
+}
+
+typedef struct FIND_VISIT_CONTEXT_TAG
+{
+    HASH_TABLE_FIND_VISIT_CB visit_cb;
+    void* visit_cb_context;
+    CLDS_HASH_TABLE_ITEM* visited_item;
+} FIND_VISIT_CONTEXT;
+
+static void on_sorted_list_item_found(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item)
+{
+    FIND_VISIT_CONTEXT* find_visit_context = context;
+
+    find_visit_context->visited_item = (CLDS_HASH_TABLE_ITEM*)item;
+    find_visit_context->visit_cb(find_visit_context->visit_cb_context, find_visit_context->visited_item);
+}
+
+// when find_visit_context is NULL the found item is returned with a reference taken on it,
+// otherwise the item is visited under the hazard pointer and the returned pointer only signals that the key was found
+static CLDS_HASH_TABLE_ITEM* find_in_bucket_arrays(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash, void* key, FIND_VISIT_CONTEXT* find_visit_context)
+{
+    CLDS_HASH_TABLE_ITEM* result = NULL;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+    BUCKET_ARRAY* current_bucket_array;
+
+    // find is not blocked by a migration, so the bucket arrays it walks need to be protected from being reclaimed
+    /* Codes_SRS_CLDS_HASH_TABLE_07_019: [ clds_hash_table_find shall acquire a hazard pointer for each bucket array that it looks up the key in. ]*/
+    do
+    {
+        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        current_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, current_bucket_array);
+        if (current_bucket_array_hp == NULL)
+        {
+            LogError("Cannot acquire hazard pointer");
+            current_bucket_array = NULL;
+            break;
+        }
+
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL) == current_bucket_array)
+        {
+            break;
+        }
+
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+    } while (1);
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
+    while (current_bucket_array != NULL)
+    {
+        // find the bucket
+        /* Codes_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
+        uint64_t bucket_index = hash & current_bucket_array->bucket_mask;
+
+        CLDS_SORTED_LIST_HANDLE bucket_list = &current_bucket_array->hash_table[bucket_index];
+        if (!is_bucket_empty(bucket_list))
+        {
+            if (find_visit_context == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+                result = (void*)clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_105: [ clds_hash_table_find_and_visit shall look up the key in the bucket lists the same way as clds_hash_table_find, but by calling clds_sorted_list_find_key_and_visit so that no reference is taken on the found item. ]*/
+                /* Codes_SRS_CLDS_HASH_TABLE_07_106: [ For the found item clds_hash_table_find_and_visit shall call visit_cb with visit_cb_context and the item. ]*/
+                result = (clds_sorted_list_find_key_and_visit(bucket_list, clds_hazard_pointers_thread, key, on_sorted_list_item_found, find_visit_context) == CLDS_SORTED_LIST_FIND_AND_VISIT_OK) ? find_visit_context->visited_item : NULL;
+            }
+            if (result != NULL)
+            {
+                // found
+                break;
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
+        CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp = NULL;
+        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
         if (next_bucket_array != NULL)
         {
-            // wait for all outstanding inserts in the lower levels to complete
-            do
-            {
-                if (interlocked_add(&next_bucket_array->pending_insert_count, 0) == 0)
-                {
-                    break;
-                }
-            } while (1);
+            next_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, next_bucket_array);
+            if (next_bucket_array_hp == NULL)
+            {
+                LogError("Cannot acquire hazard pointer");
+                next_bucket_array = NULL;
+            }
+            else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL) != next_bucket_array)
+            {
+                // the next bucket array was unlinked by a migration, it was empty anyway
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, next_bucket_array_hp);
+                next_bucket_array_hp = NULL;
+                next_bucket_array = NULL;
+            }
+        }
+
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+        current_bucket_array_hp = next_bucket_array_hp;
+        current_bucket_array = next_bucket_array;
+    }
+
+    if (current_bucket_array == NULL)
+    {
+        /* not found */
+        /* Codes_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
+        result = NULL;
+    }
+    else
+    {
+        // all OK
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+    }
+
+    return result;
+}
+
+static CLDS_HASH_TABLE_ITEM* find_key(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash, void* key)
+{
+    CLDS_HASH_TABLE_ITEM* result;
+    MIGRATION_STRIPE* migration_stripe = get_migration_stripe(clds_hash_table, hash);
+    bool restart_needed;
+
+    do
+    {
+        int32_t migration_sequence = interlocked_add(&migration_stripe->sequence, 0);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_020: [ clds_hash_table_find shall look up the key without waiting for the bucket migrations in progress. ]*/
+        result = find_in_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, hash, key, NULL);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_021: [ If the key is not found and a bucket that can hold the key was being migrated while looking up the key, clds_hash_table_find shall wait for the bucket migration to complete and restart the look up. ]*/
+        restart_needed = (result == NULL) && wait_if_bucket_moved_during_lookup(migration_stripe, migration_sequence);
+    } while (restart_needed);
+
+    return result;
+}
+
+CLDS_HASH_TABLE_ITEM* clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_HASH_TABLE_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = compute_key_hash(clds_hash_table, key);
+
+        result = find_key(clds_hash_table, clds_hazard_pointers_thread, hash, key);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT clds_hash_table_find_and_visit(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, HASH_TABLE_FIND_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_100: [ If clds_hash_table is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_101: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_102: [ If key is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_103: [ If visit_cb is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+        (visit_cb == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, HASH_TABLE_FIND_VISIT_CB visit_cb=%p, void* visit_cb_context=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, visit_cb, visit_cb_context);
+        result = CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR;
+    }
+    else
+    {
+        bool restart_needed;
+        FIND_VISIT_CONTEXT find_visit_context;
+        find_visit_context.visit_cb = visit_cb;
+        find_visit_context.visit_cb_context = visit_cb_context;
+        find_visit_context.visited_item = NULL;
+
+        CLDS_HASH_TABLE_ITEM* found_item;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_104: [ clds_hash_table_find_and_visit shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = compute_key_hash(clds_hash_table, key);
+        MIGRATION_STRIPE* migration_stripe = get_migration_stripe(clds_hash_table, hash);
+
+        do
+        {
+            int32_t migration_sequence = interlocked_add(&migration_stripe->sequence, 0);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_107: [ clds_hash_table_find_and_visit shall look up the key without waiting for the bucket migrations in progress. ]*/
+            found_item = find_in_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, hash, key, &find_visit_context);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_108: [ If the key is not found and a bucket that can hold the key was being migrated while looking up the key, clds_hash_table_find_and_visit shall wait for the bucket migration to complete and restart the look up. ]*/
+            restart_needed = (found_item == NULL) && wait_if_bucket_moved_during_lookup(migration_stripe, migration_sequence);
+        } while (restart_needed);
+
+        if (found_item == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_109: [ If the key is not found, clds_hash_table_find_and_visit shall return CLDS_HASH_TABLE_FIND_AND_VISIT_NOT_FOUND without calling visit_cb. ]*/
+            result = CLDS_HASH_TABLE_FIND_AND_VISIT_NOT_FOUND;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_110: [ Otherwise clds_hash_table_find_and_visit shall succeed and return CLDS_HASH_TABLE_FIND_AND_VISIT_OK. ]*/
+            result = CLDS_HASH_TABLE_FIND_AND_VISIT_OK;
+        }
+    }
+
+    return result;
+}
+
+static bool has_null_key(void** keys, uint32_t key_count)
+{
+    bool result = false;
+
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        if (keys[i] == NULL)
+        {
+            LogError("Invalid arguments: keys[%" PRIu32 "] is NULL", i);
+            result = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// hashes a group of keys of a batch and prefetches the bucket slots and the heads of the bucket lists they map to in the first bucket array,
+// so that the cache misses for the whole group overlap instead of being taken one key at a time
+static void hash_and_prefetch_keys(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, uint64_t* hashes)
+{
+    CLDS_SORTED_LIST_HANDLE bucket_lists[BATCH_PIPELINE_DEPTH];
+
+    // the first bucket array is protected so that its bucket mask can be read, if it gets replaced meanwhile the prefetched slots are simply not used
+    BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, first_bucket_array);
+    if (first_bucket_array_hp == NULL)
+    {
+        // prefetching is only an optimization, the keys are still looked up without it
+        LogError("Cannot acquire hazard pointer");
+        first_bucket_array = NULL;
+    }
+    else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL) != first_bucket_array)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+        first_bucket_array = NULL;
+    }
+
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        hashes[i] = compute_key_hash(clds_hash_table, keys[i]);
+
+        if (first_bucket_array != NULL)
+        {
+            bucket_lists[i] = &first_bucket_array->hash_table[hashes[i] & first_bucket_array->bucket_mask];
+            PREFETCH_FOR_READ(bucket_lists[i]);
+        }
+    }
+
+    if (first_bucket_array != NULL)
+    {
+        // by now the bucket slots of the whole group are on their way to the cache, follow them to the list heads
+        // the head is only used as an address to prefetch, so it is read without protecting the node
+        for (uint32_t i = 0; i < key_count; i++)
+        {
+            PREFETCH_FOR_READ(bucket_lists[i]->head);
+        }
+
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+    }
+}
+
+int clds_hash_table_find_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, CLDS_HASH_TABLE_ITEM** items)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_129: [ If clds_hash_table is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_130: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_131: [ If keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (keys == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_132: [ If key_count is 0, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (key_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_133: [ If items is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (items == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void** keys=%p, uint32_t key_count=%" PRIu32 ", CLDS_HASH_TABLE_ITEM** items=%p",
+            clds_hash_table, clds_hazard_pointers_thread, keys, key_count, items);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_CLDS_HASH_TABLE_07_134: [ If any of the keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+    else if (has_null_key(keys, key_count))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint64_t hashes[BATCH_PIPELINE_DEPTH];
+
+        for (uint32_t group_start = 0; group_start < key_count; group_start += BATCH_PIPELINE_DEPTH)
+        {
+            uint32_t group_key_count = ((key_count - group_start) < BATCH_PIPELINE_DEPTH) ? (key_count - group_start) : BATCH_PIPELINE_DEPTH;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_135: [ clds_hash_table_find_batch shall process the keys in groups of up to BATCH_PIPELINE_DEPTH keys, hashing all the keys of a group by calling compute_hash before looking up any of them. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_07_136: [ clds_hash_table_find_batch shall prefetch the bucket slots and the heads of the bucket lists in the first bucket array for all the keys of a group before looking up any of them. ]*/
+            hash_and_prefetch_keys(clds_hash_table, clds_hazard_pointers_thread, &keys[group_start], group_key_count, hashes);
+
+            for (uint32_t i = 0; i < group_key_count; i++)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_137: [ clds_hash_table_find_batch shall look up each key the same way as clds_hash_table_find and store the found item, or NULL if the key is not found, at the same index in items. ]*/
+                items[group_start + i] = find_key(clds_hash_table, clds_hazard_pointers_thread, hashes[i], keys[group_start + i]);
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_138: [ On success clds_hash_table_find_batch shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hash_table_insert_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, CLDS_HASH_TABLE_ITEM** values, uint32_t key_count, CLDS_HASH_TABLE_INSERT_RESULT* results, int64_t* sequence_numbers)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_139: [ If clds_hash_table is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_140: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_141: [ If keys is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (keys == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_142: [ If values is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (values == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_143: [ If key_count is 0, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (key_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_144: [ If results is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (results == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_145: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        ((sequence_numbers != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void** keys=%p, CLDS_HASH_TABLE_ITEM** values=%p, uint32_t key_count=%" PRIu32 ", CLDS_HASH_TABLE_INSERT_RESULT* results=%p, int64_t* sequence_numbers=%p",
+            clds_hash_table, clds_hazard_pointers_thread, keys, values, key_count, results, sequence_numbers);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_CLDS_HASH_TABLE_07_146: [ If any of the keys is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+    else if (has_null_key(keys, key_count))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint64_t hashes[BATCH_PIPELINE_DEPTH];
+        bool has_lower_levels = false;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_147: [ clds_hash_table_insert_batch shall begin one write operation for the whole batch, in the same way as clds_hash_table_insert does for one key. ]*/
+        check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        for (uint32_t group_start = 0; group_start < key_count; group_start += BATCH_PIPELINE_DEPTH)
+        {
+            uint32_t group_key_count = ((key_count - group_start) < BATCH_PIPELINE_DEPTH) ? (key_count - group_start) : BATCH_PIPELINE_DEPTH;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_148: [ clds_hash_table_insert_batch shall hash and prefetch the keys in groups in the same way as clds_hash_table_find_batch. ]*/
+            hash_and_prefetch_keys(clds_hash_table, clds_hazard_pointers_thread, &keys[group_start], group_key_count, hashes);
+
+            for (uint32_t i = 0; i < group_key_count; i++)
+            {
+                uint32_t key_index = group_start + i;
+                bool key_has_lower_levels;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_07_149: [ clds_hash_table_insert_batch shall insert each key and value the same way as clds_hash_table_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+                MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hashes[i]);
+                BUCKET_ARRAY* current_bucket_array = get_first_bucket_array(clds_hash_table);
+                results[key_index] = insert_in_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, current_bucket_array, hashes[i], keys[key_index], values[key_index], NULL, NULL, NULL, (sequence_numbers == NULL) ? NULL : &sequence_numbers[key_index], &key_has_lower_levels);
+                end_key_write_operation(migration_stripe);
+                has_lower_levels = has_lower_levels || key_has_lower_levels;
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_150: [ clds_hash_table_insert_batch shall end the write operation after all the keys were inserted. ]*/
+        end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_151: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_insert_batch shall migrate up to the migration bucket budget buckets once for the whole batch. ]*/
+        help_migrate(clds_hash_table, clds_hazard_pointers_thread, has_lower_levels);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_152: [ On success clds_hash_table_insert_batch shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hash_table_delete_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, CLDS_HASH_TABLE_DELETE_RESULT* results, int64_t* sequence_numbers)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_153: [ If clds_hash_table is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_154: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_155: [ If keys is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+        (keys == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_156: [ If key_count is 0, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+        (key_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_157: [ If results is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+        (results == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_158: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+        ((sequence_numbers != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void** keys=%p, uint32_t key_count=%" PRIu32 ", CLDS_HASH_TABLE_DELETE_RESULT* results=%p, int64_t* sequence_numbers=%p",
+            clds_hash_table, clds_hazard_pointers_thread, keys, key_count, results, sequence_numbers);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_CLDS_HASH_TABLE_07_159: [ If any of the keys is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+    else if (has_null_key(keys, key_count))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint64_t hashes[BATCH_PIPELINE_DEPTH];
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_160: [ clds_hash_table_delete_batch shall begin one write operation for the whole batch, in the same way as clds_hash_table_delete does for one key. ]*/
+        check_lock_and_begin_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        for (uint32_t group_start = 0; group_start < key_count; group_start += BATCH_PIPELINE_DEPTH)
+        {
+            uint32_t group_key_count = ((key_count - group_start) < BATCH_PIPELINE_DEPTH) ? (key_count - group_start) : BATCH_PIPELINE_DEPTH;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_161: [ clds_hash_table_delete_batch shall hash and prefetch the keys in groups in the same way as clds_hash_table_find_batch. ]*/
+            hash_and_prefetch_keys(clds_hash_table, clds_hazard_pointers_thread, &keys[group_start], group_key_count, hashes);
+
+            for (uint32_t i = 0; i < group_key_count; i++)
+            {
+                uint32_t key_index = group_start + i;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_07_162: [ clds_hash_table_delete_batch shall delete each key the same way as clds_hash_table_delete, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+                MIGRATION_STRIPE* migration_stripe = begin_key_write_operation(clds_hash_table, hashes[i]);
+                results[key_index] = delete_from_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, hashes[i], keys[key_index], (sequence_numbers == NULL) ? NULL : &sequence_numbers[key_index]);
+                end_key_write_operation(migration_stripe);
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_163: [ clds_hash_table_delete_batch shall end the write operation after all the keys were deleted. ]*/
+        end_write_operation(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_164: [ On success clds_hash_table_delete_batch shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, THANDLE(CANCELLATION_TOKEN) cancellation_token)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, THANDLE(CANCELLATION_TOKEN) cancellation_token=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count, cancellation_token);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_022: [ clds_hash_table_snapshot shall wait for any migration in progress to complete and prevent new migrations from starting. ]*/
+        int32_t migration_lock;
+        while ((migration_lock = interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0)) != 0)
+        {
+            (void)wait_on_address(&clds_hash_table->migration_lock, migration_lock, UINT32_MAX);
+        }
+
+        internal_lock_writes(clds_hash_table);
+
+        uint64_t temp_item_count = 0;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+            temp_item_count += (uint64_t)get_exact_item_count(current_bucket_array);
+
+            current_bucket_array = next_bucket_array;
+        }
+
+        if (temp_item_count == 0)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+            *items = NULL;
+            *item_count = 0;
+            result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+            CLDS_SORTED_LIST_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+
+            if (items_to_return == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
+                    (size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else
+            {
+                uint64_t result_index = 0;
+                bool is_cancelled = false;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+                current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+                while (current_bucket_array != NULL)
+                {
+                    BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+                    if (get_exact_item_count(current_bucket_array) != 0)
+                    {
+                        int32_t bucket_count = current_bucket_array->bucket_count;
+                        int32_t i;
+
+                        for (i = 0; i < bucket_count; i++)
+                        {
+                            if (!is_bucket_empty(&current_bucket_array->hash_table[i]) && (temp_item_count > 0))
+                            {
+                                uint64_t retrieved_item_count;
+
+                                if (
+                                    /* Codes_SRS_CLDS_HASH_TABLE_01_115: [ If cancellation_token is non-NULL and cancellation_token_is_cancelled returns true for cancellation_token, clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+                                    (cancellation_token != NULL) &&
+                                    (cancellation_token_is_canceled(cancellation_token))
+                                    )
+                                {
+                                    LogVerbose("snapshot cancelled");
+                                    is_cancelled = true;
+                                    break;
+                                }
+
+                                /* Codes_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+                                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(&current_bucket_array->hash_table[i], clds_hazard_pointers_thread, temp_item_count, items_to_return + result_index, &retrieved_item_count, false);
+                                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
+                                    break;
+                                }
+                                else
+                                {
+                                    result_index += retrieved_item_count;
+                                    temp_item_count -= retrieved_item_count;
+                                }
+                            }
+                        }
+
+                        if (i < bucket_count)
+                        {
+                            break;
+                        }
+                    }
+
+                    current_bucket_array = next_bucket_array;
+                }
+
+                if (current_bucket_array != NULL)
+                {
+                    if (is_cancelled)
+                    {
+                        result = CLDS_HASH_TABLE_SNAPSHOT_ABANDONED;
+                    }
+                    else
+                    {
+                        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                    }
+
+                    for (uint64_t i = 0; i < result_index; i++)
+                    {
+                        clds_sorted_list_node_release(items_to_return[i]);
+                    }
+                    free(items_to_return);
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+                    *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
+                    items_to_return = NULL;
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+                    *item_count = result_index;
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+                }
+            }
+        }
+
+        internal_unlock_writes(clds_hash_table);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_023: [ clds_hash_table_snapshot shall allow migrations to start again. ]*/
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+    }
+
+    return result;
+}
+
+static bool count_item_for_parallel_snapshot(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    (void)item;
+    (*(uint64_t*)context)++;
+    return true;
+}
+
+// chunks do not span bucket arrays, returns NULL when chunk_index is past the last chunk
+static BUCKET_ARRAY* get_parallel_snapshot_chunk(BUCKET_ARRAY* bucket_array, int64_t chunk_index, int32_t* first_bucket_index, int32_t* end_bucket_index)
+{
+    while (bucket_array != NULL)
+    {
+        int32_t bucket_count = bucket_array->bucket_count;
+        int64_t chunk_count = ((int64_t)bucket_count + PARALLEL_SNAPSHOT_CHUNK_BUCKET_COUNT - 1) / PARALLEL_SNAPSHOT_CHUNK_BUCKET_COUNT;
+
+        if (chunk_index < chunk_count)
+        {
+            *first_bucket_index = (int32_t)(chunk_index * PARALLEL_SNAPSHOT_CHUNK_BUCKET_COUNT);
+            *end_bucket_index = (bucket_count - *first_bucket_index > PARALLEL_SNAPSHOT_CHUNK_BUCKET_COUNT) ? (*first_bucket_index + PARALLEL_SNAPSHOT_CHUNK_BUCKET_COUNT) : bucket_count;
+            break;
+        }
+
+        chunk_index -= chunk_count;
+        bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+    }
+
+    return bucket_array;
+}
+
+static int snapshot_parallel_chunk(PARALLEL_SNAPSHOT_CONTEXT* context, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* bucket_array, int32_t first_bucket_index, int32_t end_bucket_index)
+{
+    int result;
+    uint64_t chunk_item_count = 0;
+    int32_t i;
+
+    // the items are counted first so that the chunk takes one contiguous range of the output array
+    for (i = first_bucket_index; i < end_bucket_index; i++)
+    {
+        if (!is_bucket_empty(&bucket_array->hash_table[i]))
+        {
+            CLDS_SORTED_LIST_VISIT_RESULT visit_result = clds_sorted_list_visit(&bucket_array->hash_table[i], clds_hazard_pointers_thread, count_item_for_parallel_snapshot, &chunk_item_count);
+            if (visit_result != CLDS_SORTED_LIST_VISIT_OK)
+            {
+                LogError("clds_sorted_list_visit failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_VISIT_RESULT, visit_result));
+                break;
+            }
+        }
+    }
+
+    if (i < end_bucket_index)
+    {
+        result = MU_FAILURE;
+    }
+    else if (chunk_item_count == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        int64_t first_item_index = interlocked_add_64(&context->item_count, (int64_t)chunk_item_count) - (int64_t)chunk_item_count;
+        uint64_t retrieved_chunk_item_count = 0;
+        uint64_t slot_count;
+
+        if (first_item_index + (int64_t)chunk_item_count > context->item_capacity)
+        {
+            LogError("Found more items than the %" PRId64 " items counted in the bucket arrays", context->item_capacity);
+            slot_count = (first_item_index < context->item_capacity) ? (uint64_t)(context->item_capacity - first_item_index) : 0;
+        }
+        else
+        {
+            slot_count = chunk_item_count;
+
+            for (i = first_bucket_index; (i < end_bucket_index) && (retrieved_chunk_item_count < chunk_item_count); i++)
+            {
+                if (!is_bucket_empty(&bucket_array->hash_table[i]))
+                {
+                    uint64_t retrieved_item_count;
+                    CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(&bucket_array->hash_table[i], clds_hazard_pointers_thread, chunk_item_count - retrieved_chunk_item_count, context->items + first_item_index + retrieved_chunk_item_count, &retrieved_item_count, false);
+                    if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
+                    {
+                        LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
+                        break;
+                    }
+
+                    retrieved_chunk_item_count += retrieved_item_count;
+                }
+            }
+        }
+
+        if (retrieved_chunk_item_count == chunk_item_count)
+        {
+            result = 0;
+        }
+        else
+        {
+            // the slots of a failed chunk are set to NULL, so that the cleanup only releases the items that were retrieved
+            for (uint64_t j = 0; j < slot_count; j++)
+            {
+                if (j < retrieved_chunk_item_count)
+                {
+                    clds_sorted_list_node_release(context->items[first_item_index + j]);
+                }
+                context->items[first_item_index + j] = NULL;
+            }
+
+            result = MU_FAILURE;
+        }
+    }
+
+    return result;
+}
+
+static void run_parallel_snapshot_worker(PARALLEL_SNAPSHOT_CONTEXT* context, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    while (interlocked_add(&context->result, 0) == (int32_t)CLDS_HASH_TABLE_SNAPSHOT_OK)
+    {
+        if (
+            /* Codes_SRS_CLDS_HASH_TABLE_07_082: [ If cancellation_token is non-NULL and cancellation_token_is_canceled returns true for cancellation_token, clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+            (context->cancellation_token != NULL) &&
+            (cancellation_token_is_canceled(context->cancellation_token))
+            )
+        {
+            LogVerbose("snapshot cancelled");
+            (void)interlocked_compare_exchange(&context->result, (int32_t)CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, (int32_t)CLDS_HASH_TABLE_SNAPSHOT_OK);
+            break;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_080: [ Each worker shall repeatedly claim the next chunk of buckets that no worker claimed yet, until all the chunks of all the bucket arrays are claimed. ]*/
+        int64_t chunk_index = interlocked_increment_64(&context->next_chunk) - 1;
+        int32_t first_bucket_index;
+        int32_t end_bucket_index;
+        BUCKET_ARRAY* bucket_array = get_parallel_snapshot_chunk(context->first_bucket_array, chunk_index, &first_bucket_index, &end_bucket_index);
+        if (bucket_array == NULL)
+        {
+            break;
+        }
+
+        if (
+            (get_exact_item_count(bucket_array) != 0) &&
+            /* Codes_SRS_CLDS_HASH_TABLE_07_081: [ For each chunk, the worker shall count the items in the non-empty buckets of the chunk with clds_sorted_list_visit, claim a range of the allocated array for them and call clds_sorted_list_get_all for each non-empty bucket of the chunk with the next portion of that range and false as require_locked_list. ]*/
+            (snapshot_parallel_chunk(context, clds_hazard_pointers_thread, bucket_array, first_bucket_index, end_bucket_index) != 0)
+            )
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            (void)interlocked_compare_exchange(&context->result, (int32_t)CLDS_HASH_TABLE_SNAPSHOT_ERROR, (int32_t)CLDS_HASH_TABLE_SNAPSHOT_OK);
+            break;
+        }
+    }
+}
+
+static int parallel_snapshot_worker_thread(void* arg)
+{
+    PARALLEL_SNAPSHOT_CONTEXT* context = arg;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_079: [ Each worker thread shall register a thread with the hazard pointers instance of the hash table by calling clds_hazard_pointers_register_thread and unregister it when done. ]*/
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(context->clds_hash_table->clds_hazard_pointers);
+    if (clds_hazard_pointers_thread == NULL)
+    {
+        // not a failure of the snapshot, the chunks are claimed by the other workers
+        LogError("clds_hazard_pointers_register_thread failed, worker exits without snapshotting any buckets");
+    }
+    else
+    {
+        run_parallel_snapshot_worker(context, clds_hazard_pointers_thread);
+        clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
+    }
+
+    return 0;
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_parallel(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t worker_count, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, THANDLE(CANCELLATION_TOKEN) cancellation_token)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_068: [ If clds_hash_table is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_069: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_070: [ If worker_count is 0 then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (worker_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_071: [ If items is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_072: [ If item_count is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint32_t worker_count=%" PRIu32 ", CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, THANDLE(CANCELLATION_TOKEN) cancellation_token=%p",
+            clds_hash_table, clds_hazard_pointers_thread, worker_count, items, item_count, cancellation_token);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_073: [ clds_hash_table_snapshot_parallel shall wait for any migration or snapshot in progress to complete, prevent new ones from starting, lock the table for writes and wait for the write operations in progress to complete. ]*/
+        int32_t migration_lock;
+        while ((migration_lock = interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0)) != 0)
+        {
+            (void)wait_on_address(&clds_hash_table->migration_lock, migration_lock, UINT32_MAX);
+        }
+
+        internal_lock_writes(clds_hash_table);
+
+        uint64_t temp_item_count = 0;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_074: [ clds_hash_table_snapshot_parallel shall determine the number of items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+            temp_item_count += (uint64_t)get_exact_item_count(current_bucket_array);
+
+            current_bucket_array = next_bucket_array;
+        }
+
+        if (temp_item_count == 0)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_075: [ If there are no items then clds_hash_table_snapshot_parallel shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+            *items = NULL;
+            *item_count = 0;
+            result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_076: [ clds_hash_table_snapshot_parallel shall allocate an array of CLDS_HASH_TABLE_ITEM* large enough for all the items in the hash table. ]*/
+            CLDS_SORTED_LIST_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+            THREAD_HANDLE* worker_threads = NULL;
+
+            if (items_to_return == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
+                    (size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else if (
+                (worker_count > 1) &&
+                ((worker_threads = malloc_2(worker_count - 1, sizeof(THREAD_HANDLE))) == NULL)
+                )
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("malloc_2(worker_count - 1=%" PRIu32 ", sizeof(THREAD_HANDLE)=%zu) failed for the worker threads",
+                    worker_count - 1, sizeof(THREAD_HANDLE));
+                free(items_to_return);
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else
+            {
+                // the workers are joined before returning, so they can borrow the cancellation token of the caller
+                PARALLEL_SNAPSHOT_CONTEXT context =
+                {
+                    .clds_hash_table = clds_hash_table,
+                    .cancellation_token = cancellation_token,
+                    .first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL),
+                    .next_chunk = 0,
+                    .items = items_to_return,
+                    .item_capacity = (int64_t)temp_item_count,
+                    .item_count = 0,
+                    .result = (int32_t)CLDS_HASH_TABLE_SNAPSHOT_OK
+                };
+                uint32_t started_worker_count;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_07_077: [ clds_hash_table_snapshot_parallel shall start worker_count - 1 worker threads by calling ThreadAPI_Create and collect the items together with them, the calling thread being the last worker. ]*/
+                for (started_worker_count = 0; started_worker_count < worker_count - 1; started_worker_count++)
+                {
+                    if (ThreadAPI_Create(&worker_threads[started_worker_count], parallel_snapshot_worker_thread, &context) != THREADAPI_OK)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_078: [ If ThreadAPI_Create fails, clds_hash_table_snapshot_parallel shall collect the items with the workers started so far. ]*/
+                        LogError("ThreadAPI_Create failed, snapshot continues with %" PRIu32 " worker threads", started_worker_count);
+                        break;
+                    }
+                }
+
+                run_parallel_snapshot_worker(&context, clds_hazard_pointers_thread);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_07_083: [ clds_hash_table_snapshot_parallel shall wait for the worker threads to complete by calling ThreadAPI_Join. ]*/
+                for (uint32_t i = 0; i < started_worker_count; i++)
+                {
+                    int dont_care;
+                    if (ThreadAPI_Join(worker_threads[i], &dont_care) != THREADAPI_OK)
+                    {
+                        LogError("ThreadAPI_Join failed for worker thread %" PRIu32 "", i);
+                    }
+                }
+
+                result = (CLDS_HASH_TABLE_SNAPSHOT_RESULT)interlocked_add(&context.result, 0);
+                int64_t retrieved_item_count = interlocked_add_64(&context.item_count, 0);
+
+                if (result != CLDS_HASH_TABLE_SNAPSHOT_OK)
+                {
+                    // slots past the capacity were never written
+                    if (retrieved_item_count > context.item_capacity)
+                    {
+                        retrieved_item_count = context.item_capacity;
+                    }
+
+                    for (int64_t i = 0; i < retrieved_item_count; i++)
+                    {
+                        if (items_to_return[i] != NULL)
+                        {
+                            clds_sorted_list_node_release(items_to_return[i]);
+                        }
+                    }
+                    free(items_to_return);
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_084: [ clds_hash_table_snapshot_parallel shall store the allocated array of items in items, the count of items in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
+                    *item_count = (uint64_t)retrieved_item_count;
+                }
+
+                if (worker_threads != NULL)
+                {
+                    free(worker_threads);
+                }
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_085: [ clds_hash_table_snapshot_parallel shall unlock the table for writes and allow migrations and snapshots to start again. ]*/
+        internal_unlock_writes(clds_hash_table);
+
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_concurrent(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, int64_t* sequence_number, THANDLE(CANCELLATION_TOKEN) cancellation_token)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_024: [ If clds_hash_table is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_025: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_026: [ If items is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_027: [ If item_count is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_028: [ If sequence_number is non-NULL and no start sequence number was specified in clds_hash_table_create, clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, int64_t* sequence_number=%p, THANDLE(CANCELLATION_TOKEN) cancellation_token=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count, sequence_number, cancellation_token);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_029: [ clds_hash_table_snapshot_concurrent shall wait for any migration or snapshot in progress to complete and prevent new ones from starting. ]*/
+        int32_t migration_lock;
+        while ((migration_lock = interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0)) != 0)
+        {
+            (void)wait_on_address(&clds_hash_table->migration_lock, migration_lock, UINT32_MAX);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_030: [ clds_hash_table_snapshot_concurrent shall lock the table for writes and wait for the write operations in progress to complete. ]*/
+        internal_lock_writes(clds_hash_table);
+
+        uint64_t snapshot_item_count = 0;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_031: [ clds_hash_table_snapshot_concurrent shall determine the number of items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+            snapshot_item_count += (uint64_t)get_exact_item_count(current_bucket_array);
+
+            current_bucket_array = next_bucket_array;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_032: [ clds_hash_table_snapshot_concurrent shall start a new snapshot epoch, items inserted from then on are not part of the snapshot. ]*/
+        CONCURRENT_SNAPSHOT_CONTEXT snapshot_context;
+        snapshot_context.snapshot_epoch = interlocked_increment_64(&clds_hash_table->snapshot_epoch);
+        snapshot_context.items = NULL;
+        snapshot_context.item_capacity = snapshot_item_count;
+        (void)interlocked_exchange_64(&snapshot_context.item_count, 0);
+
+        if (snapshot_item_count != 0)
+        {
+            // the array is allocated at the cut, so that the writers can add the items they take out of the table to it as soon as they are let go
+            /* Codes_SRS_CLDS_HASH_TABLE_07_036: [ clds_hash_table_snapshot_concurrent shall allocate an array of CLDS_HASH_TABLE_ITEM* large enough for all the items in the hash table. ]*/
+            snapshot_context.items = malloc_2((size_t)snapshot_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+            if (snapshot_context.items == NULL)
+            {
+                LogError("malloc_2((size_t)snapshot_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
+                    (size_t)snapshot_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+            }
+            else
+            {
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->concurrent_snapshot, &snapshot_context);
+            }
+        }
+
+        if (sequence_number != NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_033: [ If sequence_number is non-NULL, clds_hash_table_snapshot_concurrent shall store in sequence_number the current sequence number of the hash table. ]*/
+            *sequence_number = interlocked_add_64(clds_hash_table->sequence_number, 0);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_034: [ clds_hash_table_snapshot_concurrent shall unlock the table for writes. ]*/
+        internal_unlock_writes(clds_hash_table);
+
+        if (snapshot_item_count == 0)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_035: [ If there are no items then clds_hash_table_snapshot_concurrent shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+            *items = NULL;
+            *item_count = 0;
+            result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+        }
+        else if (snapshot_context.items == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_042: [ If there are any other failures then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            bool is_cancelled = false;
+            bool failed = false;
+
+            current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+            while ((current_bucket_array != NULL) && !failed)
+            {
+                BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+                int32_t bucket_count = current_bucket_array->bucket_count;
+
+                for (int32_t i = 0; i < bucket_count; i++)
+                {
+                    if (
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_038: [ If cancellation_token is non-NULL and cancellation_token_is_canceled returns true for cancellation_token, clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+                        (cancellation_token != NULL) &&
+                        (cancellation_token_is_canceled(cancellation_token))
+                        )
+                    {
+                        LogVerbose("concurrent snapshot cancelled");
+                        is_cancelled = true;
+                        failed = true;
+                        break;
+                    }
+
+                    CLDS_SORTED_LIST_HANDLE bucket_list = &current_bucket_array->hash_table[i];
+                    if (!is_bucket_empty(bucket_list))
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_037: [ For each non-empty bucket in each bucket array, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and, for each visited item that was in the table when the snapshot epoch started and that was not taken by the snapshot yet, increment its ref count and add it to the array. ]*/
+                        CLDS_SORTED_LIST_VISIT_RESULT visit_result = clds_sorted_list_visit(bucket_list, clds_hazard_pointers_thread, add_item_to_concurrent_snapshot, &snapshot_context);
+                        if (visit_result != CLDS_SORTED_LIST_VISIT_OK)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_042: [ If there are any other failures then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                            LogError("clds_sorted_list_visit failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_VISIT_RESULT, visit_result));
+                            failed = true;
+                            break;
+                        }
+                    }
+                }
+
+                current_bucket_array = next_bucket_array;
+            }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_039: [ clds_hash_table_snapshot_concurrent shall lock the table for writes, stop the writers from adding removed items to the array and unlock the table for writes. ]*/
+            internal_lock_writes(clds_hash_table);
+            (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->concurrent_snapshot, NULL);
+            internal_unlock_writes(clds_hash_table);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_040: [ The array shall also hold the items that were removed from the hash table while the snapshot was in progress, added by the writers that removed them. ]*/
+            uint64_t taken_item_count = (uint64_t)interlocked_add_64(&snapshot_context.item_count, 0);
+            if (taken_item_count > snapshot_context.item_capacity)
+            {
+                // the slots past the end of the array were never filled
+                taken_item_count = snapshot_context.item_capacity;
+                failed = true;
+            }
+
+            if (failed)
+            {
+                if (is_cancelled)
+                {
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ABANDONED;
+                }
+                else
+                {
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                }
+
+                for (uint64_t i = 0; i < taken_item_count; i++)
+                {
+                    clds_sorted_list_node_release(snapshot_context.items[i]);
+                }
+                free(snapshot_context.items);
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_041: [ clds_hash_table_snapshot_concurrent shall store the allocated array of items in items, the count of items in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = (CLDS_HASH_TABLE_ITEM**)snapshot_context.items;
+                *item_count = taken_item_count;
+                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_043: [ clds_hash_table_snapshot_concurrent shall allow migrations and snapshots to start again. ]*/
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+    }
+
+    return result;
+}
+
+// acquires a hazard pointer on the top level bucket array, checking that it is still the top level one once it is protected
+static int acquire_top_bucket_array(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY** bucket_array, CLDS_HAZARD_POINTER_RECORD_HANDLE* bucket_array_hp)
+{
+    int result;
+
+    do
+    {
+        BUCKET_ARRAY* top_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        CLDS_HAZARD_POINTER_RECORD_HANDLE top_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, top_bucket_array);
+        if (top_bucket_array_hp == NULL)
+        {
+            LogError("Cannot acquire hazard pointer");
+            result = MU_FAILURE;
+            break;
+        }
+
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL) == top_bucket_array)
+        {
+            *bucket_array = top_bucket_array;
+            *bucket_array_hp = top_bucket_array_hp;
+            result = 0;
+            break;
+        }
+
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, top_bucket_array_hp);
+    } while (1);
+
+    return result;
+}
+
+// acquires a hazard pointer on the bucket array below bucket_array (which the caller protects), NULL if there is none
+static int acquire_next_bucket_array(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* bucket_array, BUCKET_ARRAY** next_bucket_array, CLDS_HAZARD_POINTER_RECORD_HANDLE* next_bucket_array_hp)
+{
+    int result;
+    BUCKET_ARRAY* next = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+
+    *next_bucket_array = NULL;
+    *next_bucket_array_hp = NULL;
+
+    if (next == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        CLDS_HAZARD_POINTER_RECORD_HANDLE next_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, next);
+        if (next_hp == NULL)
+        {
+            LogError("Cannot acquire hazard pointer");
+            result = MU_FAILURE;
+        }
+        else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL) != next)
+        {
+            // unlinked by a migration once it was empty, it was the oldest bucket array so there is nothing below bucket_array anymore
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, next_hp);
+            result = 0;
+        }
+        else
+        {
+            *next_bucket_array = next;
+            *next_bucket_array_hp = next_hp;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+// acquires a hazard pointer on the bucket array where the walk stopped
+// if that one is not linked anymore a migration moved its items to the newer bucket arrays, which the walk did not reach yet, so the walk starts over at the oldest bucket array
+static int acquire_iterator_bucket_array(CLDS_HASH_TABLE_ITERATOR_HANDLE iterator, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY** bucket_array, CLDS_HAZARD_POINTER_RECORD_HANDLE* bucket_array_hp)
+{
+    BUCKET_ARRAY* current_bucket_array;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+    int result = acquire_top_bucket_array(iterator->clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array, &current_bucket_array_hp);
+
+    while ((result == 0) && (current_bucket_array->bucket_array_id != iterator->bucket_array_id))
+    {
+        BUCKET_ARRAY* next_bucket_array;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+        if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            result = MU_FAILURE;
+        }
+        else if (next_bucket_array == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_272: [ If the bucket array where the previous call stopped is not in the list of bucket arrays anymore, clds_hash_table_iterate_next shall resume the walk at the first bucket of the oldest bucket array. ]*/
+            iterator->bucket_array_id = current_bucket_array->bucket_array_id;
+            iterator->bucket_index = 0;
+            if (iterator->last_item != NULL)
+            {
+                clds_sorted_list_node_release(iterator->last_item);
+                iterator->last_item = NULL;
+            }
+            break;
+        }
+        else
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            current_bucket_array = next_bucket_array;
+            current_bucket_array_hp = next_bucket_array_hp;
+        }
+    }
+
+    if (result == 0)
+    {
+        *bucket_array = current_bucket_array;
+        *bucket_array_hp = current_bucket_array_hp;
+    }
+
+    return result;
+}
+
+// acquires a hazard pointer on the bucket array right above bucket_array (which the caller protects), NULL if bucket_array is the top level one
+// if bucket_array is not linked anymore its items went to the newer bucket arrays, so the walk goes on with the oldest bucket array left
+static int acquire_newer_bucket_array(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* bucket_array, BUCKET_ARRAY** newer_bucket_array, CLDS_HAZARD_POINTER_RECORD_HANDLE* newer_bucket_array_hp)
+{
+    BUCKET_ARRAY* current_bucket_array;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+    int result = acquire_top_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array, &current_bucket_array_hp);
+
+    if (result != 0)
+    {
+        // already logged
+    }
+    else if (current_bucket_array == bucket_array)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+        *newer_bucket_array = NULL;
+        *newer_bucket_array_hp = NULL;
+    }
+    else
+    {
+        do
+        {
+            BUCKET_ARRAY* next_bucket_array;
+            CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+            if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+                result = MU_FAILURE;
+                break;
+            }
+
+            if ((next_bucket_array == NULL) || (next_bucket_array == bucket_array))
+            {
+                if (next_bucket_array_hp != NULL)
+                {
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, next_bucket_array_hp);
+                }
+
+                *newer_bucket_array = current_bucket_array;
+                *newer_bucket_array_hp = current_bucket_array_hp;
+                break;
+            }
+
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            current_bucket_array = next_bucket_array;
+            current_bucket_array_hp = next_bucket_array_hp;
+        } while (1);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_ITERATOR_HANDLE clds_hash_table_iterate_begin(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    CLDS_HASH_TABLE_ITERATOR_HANDLE result;
+
+    if (clds_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_047: [ If clds_hash_table is NULL, clds_hash_table_iterate_begin shall fail and return NULL. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_048: [ clds_hash_table_iterate_begin shall allocate memory for the iterator. ]*/
+        result = malloc(sizeof(CLDS_HASH_TABLE_ITERATOR));
+        if (result == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_051: [ If any error occurs, clds_hash_table_iterate_begin shall fail and return NULL. ]*/
+            LogError("malloc(%zu) failed", sizeof(CLDS_HASH_TABLE_ITERATOR));
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_269: [ clds_hash_table_iterate_begin shall set the walk to start at the first bucket of the oldest bucket array. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_07_275: [ clds_hash_table_iterate_begin shall not hold off migrations, snapshots, shrinks or reservations until clds_hash_table_iterate_end is called. ]*/
+            // the bucket arrays are only looked up by clds_hash_table_iterate_next, nothing is held between the calls
+            result->clds_hash_table = clds_hash_table;
+            result->bucket_array_id = ITERATOR_NO_BUCKET_ARRAY_ID;
+            result->bucket_index = 0;
+            result->walk_complete = false;
+            result->last_item = NULL;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_052: [ clds_hash_table_iterate_begin shall succeed and return the iterator. ]*/
+        }
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_ITERATE_RESULT clds_hash_table_iterate_next(CLDS_HASH_TABLE_ITERATOR_HANDLE iterator, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM** items, uint32_t max_item_count, uint32_t* item_count)
+{
+    CLDS_HASH_TABLE_ITERATE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_053: [ If iterator is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+        (iterator == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_054: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_055: [ If items is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_056: [ If max_item_count is 0, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+        (max_item_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_057: [ If item_count is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_ITERATOR_HANDLE iterator=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM** items=%p, uint32_t max_item_count=%" PRIu32 ", uint32_t* item_count=%p",
+            iterator, clds_hazard_pointers_thread, items, max_item_count, item_count);
+        result = CLDS_HASH_TABLE_ITERATE_ERROR;
+    }
+    else
+    {
+        ITERATE_PAGE_CONTEXT page_context;
+        bool failed = false;
+
+        page_context.clds_hash_table = iterator->clds_hash_table;
+        page_context.items = items;
+        page_context.max_item_count = max_item_count;
+        page_context.item_count = 0;
+
+        if (!iterator->walk_complete)
+        {
+            BUCKET_ARRAY* bucket_array;
+            CLDS_HAZARD_POINTER_RECORD_HANDLE bucket_array_hp;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_270: [ clds_hash_table_iterate_next shall acquire a hazard pointer on each bucket array it looks at, walking the list of bucket arrays from the top level one, and release them all before returning. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_07_271: [ clds_hash_table_iterate_next shall resume the walk in the bucket array where the previous call stopped, at the bucket where it stopped. ]*/
+            if (acquire_iterator_bucket_array(iterator, clds_hazard_pointers_thread, &bucket_array, &bucket_array_hp) != 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_274: [ If acquiring a hazard pointer fails, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+                LogError("Cannot find the bucket array where the walk stopped");
+                failed = true;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_058: [ clds_hash_table_iterate_next shall go through the buckets of each bucket array, starting where the previous call stopped and calling clds_sorted_list_visit for each non-empty bucket, until max_item_count items are stored in items or all the bucket arrays have been walked. ]*/
+                while (page_context.item_count < max_item_count)
+                {
+                    bool bucket_done = true;
+
+                    if (iterator->bucket_index >= bucket_array->bucket_count)
+                    {
+                        BUCKET_ARRAY* newer_bucket_array;
+                        CLDS_HAZARD_POINTER_RECORD_HANDLE newer_bucket_array_hp;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_273: [ When all the buckets of a bucket array have been walked, clds_hash_table_iterate_next shall go on with the bucket array right above it, or with the oldest bucket array if it is not in the list of bucket arrays anymore. ]*/
+                        if (acquire_newer_bucket_array(iterator->clds_hash_table, clds_hazard_pointers_thread, bucket_array, &newer_bucket_array, &newer_bucket_array_hp) != 0)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_274: [ If acquiring a hazard pointer fails, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+                            LogError("Cannot find the bucket array that comes after bucket array %p", bucket_array);
+                            failed = true;
+                            break;
+                        }
+
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, bucket_array_hp);
+                        bucket_array = newer_bucket_array;
+                        bucket_array_hp = newer_bucket_array_hp;
+
+                        if (bucket_array == NULL)
+                        {
+                            // the top level bucket array was the last one
+                            iterator->walk_complete = true;
+                            break;
+                        }
+
+                        iterator->bucket_array_id = bucket_array->bucket_array_id;
+                        iterator->bucket_index = 0;
+                    }
+                    else
+                    {
+                        CLDS_SORTED_LIST_HANDLE bucket_list = &bucket_array->hash_table[iterator->bucket_index];
+                        if (!is_bucket_empty(bucket_list))
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_059: [ For each visited item with a key greater than the key of the last item returned from the same bucket, clds_hash_table_iterate_next shall increment the ref count of the item and store it in items. ]*/
+                            page_context.resume_after_key = (iterator->last_item == NULL) ? NULL : CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, iterator->last_item)->key;
+
+                            CLDS_SORTED_LIST_VISIT_RESULT visit_result = clds_sorted_list_visit(bucket_list, clds_hazard_pointers_thread, add_item_to_iterate_page, &page_context);
+                            if (visit_result == CLDS_SORTED_LIST_VISIT_STOPPED)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_060: [ If the page is full before the end of a bucket, clds_hash_table_iterate_next shall keep a reference to the last item stored in items, so that the next call resumes the bucket after its key. ]*/
+                                // the page was not full when the visit started, so the last item in the page is from this bucket
+                                CLDS_SORTED_LIST_ITEM* last_page_item = (void*)items[page_context.item_count - 1];
+                                (void)clds_sorted_list_node_inc_ref(last_page_item);
+                                if (iterator->last_item != NULL)
+                                {
+                                    clds_sorted_list_node_release(iterator->last_item);
+                                }
+                                iterator->last_item = last_page_item;
+                                bucket_done = false;
+                            }
+                            else if (visit_result != CLDS_SORTED_LIST_VISIT_OK)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_061: [ If clds_sorted_list_visit fails, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+                                LogError("clds_sorted_list_visit failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_VISIT_RESULT, visit_result));
+                                failed = true;
+                                break;
+                            }
+                            else
+                            {
+                                // end of the bucket
+                            }
+                        }
+
+                        if (bucket_done)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_276: [ When it is done with a bucket, clds_hash_table_iterate_next shall wait for a move of the bucket that is in progress to complete. ]*/
+                            wait_for_bucket_move(iterator->clds_hash_table, bucket_array->bucket_mask, iterator->bucket_index);
+                            iterator->bucket_index++;
+                        }
+                    }
+
+                    if (bucket_done && (iterator->last_item != NULL))
+                    {
+                        clds_sorted_list_node_release(iterator->last_item);
+                        iterator->last_item = NULL;
+                    }
+                }
+
+                if (bucket_array_hp != NULL)
+                {
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, bucket_array_hp);
+                }
+            }
+        }
+
+        if (failed)
+        {
+            for (uint32_t i = 0; i < page_context.item_count; i++)
+            {
+                clds_sorted_list_node_release((void*)items[i]);
+            }
+            *item_count = 0;
+            result = CLDS_HASH_TABLE_ITERATE_ERROR;
+        }
+        else if (page_context.item_count == 0)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_063: [ If all the bucket arrays have been walked and no item was stored in items, clds_hash_table_iterate_next shall set item_count to 0 and return CLDS_HASH_TABLE_ITERATE_END. ]*/
+            *item_count = 0;
+            result = CLDS_HASH_TABLE_ITERATE_END;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_062: [ clds_hash_table_iterate_next shall store the number of items stored in items in item_count and return CLDS_HASH_TABLE_ITERATE_OK. ]*/
+            *item_count = page_context.item_count;
+            result = CLDS_HASH_TABLE_ITERATE_OK;
+        }
+    }
+
+    return result;
+}
+
+void clds_hash_table_iterate_end(CLDS_HASH_TABLE_ITERATOR_HANDLE iterator)
+{
+    if (iterator == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_064: [ If iterator is NULL, clds_hash_table_iterate_end shall return. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_ITERATOR_HANDLE iterator=%p", iterator);
+    }
+    else
+    {
+        if (iterator->last_item != NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_065: [ clds_hash_table_iterate_end shall release the reference to the last item returned from the bucket where the walk stopped. ]*/
+            clds_sorted_list_node_release(iterator->last_item);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_067: [ clds_hash_table_iterate_end shall free the iterator. ]*/
+        free(iterator);
+    }
+}
+
+CLDS_HASH_TABLE_MIGRATE_RESULT clds_hash_table_migrate(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t bucket_budget)
+{
+    CLDS_HASH_TABLE_MIGRATE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_002: [ If clds_hash_table is NULL, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_003: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_004: [ If bucket_budget is 0, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+        (bucket_budget == 0)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint32_t bucket_budget=%" PRIu32 "",
+            clds_hash_table, clds_hazard_pointers_thread, bucket_budget);
+        result = CLDS_HASH_TABLE_MIGRATE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_001: [ clds_hash_table_migrate shall move the items in at most bucket_budget buckets of the oldest bucket array to the top level bucket array. ]*/
+        result = internal_migrate(clds_hash_table, clds_hazard_pointers_thread, bucket_budget);
+    }
+
+    return result;
+}
+
+int clds_hash_table_set_migration_budget(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t bucket_budget)
+{
+    int result;
+
+    if (clds_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_014: [ If clds_hash_table is NULL, clds_hash_table_set_migration_budget shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, uint32_t bucket_budget=%" PRIu32 "",
+            clds_hash_table, bucket_budget);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_015: [ clds_hash_table_set_migration_budget shall set the number of buckets that each insert and set value operation migrates and succeed, returning 0. ]*/
+        (void)interlocked_exchange(&clds_hash_table->migration_bucket_budget, (int32_t)bucket_budget);
+        result = 0;
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SHRINK_RESULT clds_hash_table_shrink(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HASH_TABLE_SHRINK_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_090: [ If clds_hash_table is NULL, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_277: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p",
+            clds_hash_table, clds_hazard_pointers_thread);
+        result = CLDS_HASH_TABLE_SHRINK_ERROR;
+    }
+    else if (interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0) != 0)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_091: [ If a migration or a snapshot is in progress, clds_hash_table_shrink shall return CLDS_HASH_TABLE_SHRINK_BUSY. ]*/
+        result = CLDS_HASH_TABLE_SHRINK_BUSY;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_092: [ clds_hash_table_shrink shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+        internal_lock_writes(clds_hash_table);
+
+        BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        int32_t bucket_count = first_bucket_array->bucket_count;
+        int32_t new_bucket_count = bucket_count;
+        int64_t total_item_count = 0;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_093: [ clds_hash_table_shrink shall count the items in all the bucket arrays. ]*/
+        BUCKET_ARRAY* bucket_array = first_bucket_array;
+        while (bucket_array != NULL)
+        {
+            total_item_count += get_exact_item_count(bucket_array);
+            bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+        }
+
+        // the items of the older bucket arrays all end up in the new one, so they count for its load as much as those of the top level bucket array
+        /* Codes_SRS_CLDS_HASH_TABLE_07_094: [ If the number of items in all the bucket arrays is less than a quarter of the number of buckets in the top level bucket array, clds_hash_table_shrink shall halve the number of buckets for as long as the result holds at least twice the number of items and is not less than the initial_bucket_size passed to clds_hash_table_create. ]*/
+        if (total_item_count * 4 < bucket_count)
+        {
+            // leave room for the items to double before the table grows again
+            while (
+                (new_bucket_count / 2 >= clds_hash_table->initial_bucket_count) &&
+                ((int64_t)(new_bucket_count / 2) >= total_item_count * 2)
+                )
+            {
+                new_bucket_count /= 2;
+            }
+        }
+
+        if (new_bucket_count == bucket_count)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_095: [ If the number of buckets would not change, clds_hash_table_shrink shall return CLDS_HASH_TABLE_SHRINK_NOT_NEEDED. ]*/
+            result = CLDS_HASH_TABLE_SHRINK_NOT_NEEDED;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_096: [ clds_hash_table_shrink shall allocate a new bucket array with the computed number of buckets and initialize the list of each bucket by calling clds_sorted_list_init. ]*/
+            BUCKET_ARRAY* new_bucket_array = malloc_flex(sizeof(BUCKET_ARRAY), (size_t)new_bucket_count, sizeof(CLDS_SORTED_LIST));
+            if (new_bucket_array == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_098: [ If any error occurs, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+                LogError("malloc_flex(sizeof(BUCKET_ARRAY)=%zu, new_bucket_count=%" PRId32 ", sizeof(CLDS_SORTED_LIST)=%zu) failed",
+                    sizeof(BUCKET_ARRAY), new_bucket_count, sizeof(CLDS_SORTED_LIST));
+                result = CLDS_HASH_TABLE_SHRINK_ERROR;
+            }
+            else
+            {
+                new_bucket_array->bucket_count = new_bucket_count;
+                new_bucket_array->bucket_mask = (uint64_t)new_bucket_count - 1;
+                new_bucket_array->bucket_array_id = interlocked_increment_64(&clds_hash_table->last_bucket_array_id);
+                init_bucket_array_counters(new_bucket_array);
+
+                for (int32_t i = 0; i < new_bucket_count; i++)
+                {
+                    clds_sorted_list_init(&new_bucket_array->hash_table[i], &clds_hash_table->sorted_list_config);
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_07_097: [ clds_hash_table_shrink shall make the new bucket array the top level bucket array, with all the existing bucket arrays below it. ]*/
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array);
+
+                result = CLDS_HASH_TABLE_SHRINK_OK;
+            }
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_099: [ clds_hash_table_shrink shall unlock the table for writes. ]*/
+        internal_unlock_writes(clds_hash_table);
+
+        if (result == CLDS_HASH_TABLE_SHRINK_OK)
+        {
+            // nothing would move the items out of the larger bucket arrays when the migration bucket budget is 0, so they are moved right away
+            // the writers are not held up for all of it, only those of the keys of the bucket being moved
+            /* Codes_SRS_CLDS_HASH_TABLE_07_278: [ clds_hash_table_shrink shall move all the items of the older bucket arrays to the new bucket array and reclaim the older bucket arrays as described in clds_hash_table_migrate. ]*/
+            CLDS_HASH_TABLE_MIGRATE_RESULT migrate_result = migrate_buckets(clds_hash_table, clds_hazard_pointers_thread, UINT32_MAX);
+            if (migrate_result == CLDS_HASH_TABLE_MIGRATE_ERROR)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_098: [ If any error occurs, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+                LogError("Cannot move the items to the smaller bucket array, clds_hash_table_migrate moves the rest");
+                result = CLDS_HASH_TABLE_SHRINK_ERROR;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_279: [ clds_hash_table_shrink shall succeed and return CLDS_HASH_TABLE_SHRINK_OK. ]*/
+            }
+        }
+
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+    }
+
+    return result;
+}
+
+// called while holding the migration lock and with the table locked for writes
+static CLDS_HASH_TABLE_RESERVE_RESULT reserve_top_level_bucket_array(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count)
+{
+    CLDS_HASH_TABLE_RESERVE_RESULT result;
+
+    BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+    int32_t bucket_count = first_bucket_array->bucket_count;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_177: [ clds_hash_table_reserve shall round item_count up to the next power of two to obtain the number of buckets and if the top level bucket array already has at least that many buckets, clds_hash_table_reserve shall return CLDS_HASH_TABLE_RESERVE_NOT_NEEDED. ]*/
+    // the top level bucket array is full once it holds as many items as it has buckets
+    int32_t new_bucket_count = (int32_t)round_up_to_power_of_two((size_t)item_count);
+    if (new_bucket_count <= bucket_count)
+    {
+        result = CLDS_HASH_TABLE_RESERVE_NOT_NEEDED;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_178: [ clds_hash_table_reserve shall allocate a new bucket array with the computed number of buckets and initialize the list of each bucket by calling clds_sorted_list_init. ]*/
+        BUCKET_ARRAY* new_bucket_array = malloc_flex(sizeof(BUCKET_ARRAY), (size_t)new_bucket_count, sizeof(CLDS_SORTED_LIST));
+        if (new_bucket_array == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_181: [ If any error occurs, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+            LogError("malloc_flex(sizeof(BUCKET_ARRAY)=%zu, new_bucket_count=%" PRId32 ", sizeof(CLDS_SORTED_LIST)=%zu) failed",
+                sizeof(BUCKET_ARRAY), new_bucket_count, sizeof(CLDS_SORTED_LIST));
+            result = CLDS_HASH_TABLE_RESERVE_ERROR;
+        }
+        else
+        {
+            int64_t total_item_count = 0;
+
+            new_bucket_array->bucket_count = new_bucket_count;
+            new_bucket_array->bucket_mask = (uint64_t)new_bucket_count - 1;
+            new_bucket_array->bucket_array_id = interlocked_increment_64(&clds_hash_table->last_bucket_array_id);
+            init_bucket_array_counters(new_bucket_array);
+
+            for (int32_t i = 0; i < new_bucket_count; i++)
+            {
+                clds_sorted_list_init(&new_bucket_array->hash_table[i], &clds_hash_table->sorted_list_config);
+            }
+
+            BUCKET_ARRAY* bucket_array = first_bucket_array;
+            while (bucket_array != NULL)
+            {
+                total_item_count += get_exact_item_count(bucket_array);
+                bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+            }
+
+            if (total_item_count == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_179: [ If the hash table holds no items, clds_hash_table_reserve shall make the new bucket array the only bucket array of the hash table, reclaim the existing bucket arrays by calling clds_hazard_pointers_reclaim and return CLDS_HASH_TABLE_RESERVE_OK. ]*/
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, NULL);
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array);
+
+                // a find still walking the old bucket arrays sees each of them unlinked before it is reclaimed, so it stops there
+                bucket_array = first_bucket_array;
+                while (bucket_array != NULL)
+                {
+                    BUCKET_ARRAY* next_bucket_array = interlocked_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL);
+                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, bucket_array, reclaim_bucket_array);
+                    bucket_array = next_bucket_array;
+                }
+
+                clds_hash_table->migration_bucket_index = 0;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_180: [ Otherwise clds_hash_table_reserve shall make the new bucket array the top level bucket array, with all the existing bucket arrays below it, and return CLDS_HASH_TABLE_RESERVE_OK. ]*/
+                // the items are moved into the new array by clds_hash_table_migrate, which also reclaims the emptied arrays
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array);
+            }
+
+            result = CLDS_HASH_TABLE_RESERVE_OK;
+        }
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_RESERVE_RESULT clds_hash_table_reserve(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count)
+{
+    CLDS_HASH_TABLE_RESERVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_171: [ If clds_hash_table is NULL, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_172: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_173: [ If item_count is 0, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+        (item_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_174: [ If item_count is greater than 2^29, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+        (item_count > MAX_INITIAL_BUCKET_SIZE)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t item_count=%" PRIu64 "",
+            clds_hash_table, clds_hazard_pointers_thread, item_count);
+        result = CLDS_HASH_TABLE_RESERVE_ERROR;
+    }
+    else if (interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0) != 0)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_175: [ If a migration or a snapshot is in progress, clds_hash_table_reserve shall return CLDS_HASH_TABLE_RESERVE_BUSY. ]*/
+        result = CLDS_HASH_TABLE_RESERVE_BUSY;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_176: [ clds_hash_table_reserve shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+        internal_lock_writes(clds_hash_table);
+
+        result = reserve_top_level_bucket_array(clds_hash_table, clds_hazard_pointers_thread, item_count);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_182: [ clds_hash_table_reserve shall unlock the table for writes and allow migrations and snapshots to start again. ]*/
+        internal_unlock_writes(clds_hash_table);
+
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+    }
+
+    return result;
+}
+
+static void run_bulk_load_hash_worker(BULK_LOAD_CONTEXT* context)
+{
+    int64_t chunk_index;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_198: [ Each worker shall repeatedly claim the next chunk of keys that no worker claimed yet and hash the keys of the chunk by calling the compute_hash function passed to clds_hash_table_create. ]*/
+    while ((chunk_index = interlocked_increment_64(&context->next_work_item) - 1) < ((int64_t)context->key_count + BULK_LOAD_HASH_CHUNK_KEY_COUNT - 1) / BULK_LOAD_HASH_CHUNK_KEY_COUNT)
+    {
+        uint32_t first_key_index = (uint32_t)chunk_index * BULK_LOAD_HASH_CHUNK_KEY_COUNT;
+        uint32_t end_key_index = ((context->key_count - first_key_index) < BULK_LOAD_HASH_CHUNK_KEY_COUNT) ? context->key_count : (first_key_index + BULK_LOAD_HASH_CHUNK_KEY_COUNT);
+
+        for (uint32_t i = first_key_index; i < end_key_index; i++)
+        {
+            context->hashes[i] = compute_key_hash(context->clds_hash_table, context->keys[i]);
+        }
+    }
+}
+
+static CLDS_HASH_TABLE_INSERT_RESULT bulk_load_item(BULK_LOAD_CONTEXT* context, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t stripe_index, uint32_t key_index)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    uint64_t hash = context->hashes[key_index];
+    void* key = context->keys[key_index];
+    bool found_in_lower_levels = false;
+
+    if (context->probe_lower_levels)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_202: [ If the lower level bucket arrays hold any items, the worker shall first look up the key in them by calling clds_sorted_list_find_key and store CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS for the key if it is found. ]*/
+        // the lower level bucket arrays cannot be reclaimed while the migration lock is held
+        BUCKET_ARRAY* bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&context->bucket_array->next_bucket, NULL, NULL);
+        while (bucket_array != NULL)
+        {
+            CLDS_SORTED_LIST_HANDLE bucket_list = &bucket_array->hash_table[hash & bucket_array->bucket_mask];
+            if (!is_bucket_empty(bucket_list))
+            {
+                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
+                if (sorted_list_item != NULL)
+                {
+                    clds_sorted_list_node_release(sorted_list_item);
+                    found_in_lower_levels = true;
+                    break;
+                }
+            }
+
+            bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+        }
+    }
+
+    if (found_in_lower_levels)
+    {
+        result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+    }
+    else
+    {
+        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, context->values[key_index]);
+        hash_table_item->key = key;
+        (void)interlocked_exchange_64(&hash_table_item->snapshot_epoch, context->snapshot_epoch);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_203: [ For each range, the worker shall insert the values of the keys in the range, in the order of the keys, in the bucket lists of the top level bucket array by calling clds_sorted_list_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+        CLDS_SORTED_LIST_INSERT_RESULT list_insert_result = clds_sorted_list_insert(&context->bucket_array->hash_table[hash & context->bucket_array->bucket_mask], clds_hazard_pointers_thread, (void*)context->values[key_index], (context->sequence_numbers == NULL) ? NULL : &context->sequence_numbers[key_index]);
+        if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_204: [ If a key is already in the top level bucket array or appears earlier in keys, the worker shall store CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS for it. ]*/
+            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+        }
+        else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_205: [ If inserting a key fails, the worker shall store CLDS_HASH_TABLE_INSERT_ERROR for it and continue with the next key. ]*/
+            LogError("clds_sorted_list_insert failed with %" PRI_MU_ENUM " for key index %" PRIu32 "", MU_ENUM_VALUE(CLDS_SORTED_LIST_INSERT_RESULT, list_insert_result), key_index);
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            add_to_item_count(context->bucket_array, stripe_index, 1);
+            result = CLDS_HASH_TABLE_INSERT_OK;
+        }
+    }
+
+    return result;
+}
+
+static void run_bulk_load_insert_worker(BULK_LOAD_CONTEXT* context, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    uint32_t stripe_index = get_stripe_index(clds_hazard_pointers_thread);
+    int64_t range_index;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_201: [ Each worker shall repeatedly claim the next range of buckets that no worker claimed yet, so that no two workers insert in the same bucket. ]*/
+    while ((range_index = interlocked_increment_64(&context->next_work_item) - 1) < (int64_t)context->range_count)
+    {
+        for (uint32_t i = context->range_starts[range_index]; i < context->range_starts[range_index + 1]; i++)
+        {
+            uint32_t key_index = context->key_indices[i];
+            context->results[key_index] = bulk_load_item(context, clds_hazard_pointers_thread, stripe_index, key_index);
+        }
+    }
+}
+
+static int bulk_load_worker_thread(void* arg)
+{
+    BULK_LOAD_CONTEXT* context = arg;
+
+    if (!context->hashes_computed)
+    {
+        run_bulk_load_hash_worker(context);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_200: [ Each worker thread that inserts items shall register a thread with the hazard pointers instance of the hash table by calling clds_hazard_pointers_register_thread and unregister it when done. ]*/
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(context->clds_hash_table->clds_hazard_pointers);
+        if (clds_hazard_pointers_thread == NULL)
+        {
+            // not a failure of the bulk load, the ranges are claimed by the other workers
+            LogError("clds_hazard_pointers_register_thread failed, worker exits without inserting any items");
+        }
+        else
+        {
+            run_bulk_load_insert_worker(context, clds_hazard_pointers_thread);
+            clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
+        }
+    }
+
+    return 0;
+}
+
+static void run_bulk_load_workers(BULK_LOAD_CONTEXT* context, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, THREAD_HANDLE* worker_threads, uint32_t worker_count)
+{
+    uint32_t started_worker_count;
+
+    (void)interlocked_exchange_64(&context->next_work_item, 0);
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_196: [ clds_hash_table_bulk_load shall start worker_count - 1 worker threads by calling ThreadAPI_Create, once for hashing the keys and once for inserting the items, the calling thread being the last worker each time. ]*/
+    for (started_worker_count = 0; started_worker_count < worker_count - 1; started_worker_count++)
+    {
+        if (ThreadAPI_Create(&worker_threads[started_worker_count], bulk_load_worker_thread, context) != THREADAPI_OK)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_197: [ If ThreadAPI_Create fails, clds_hash_table_bulk_load shall continue with the workers started so far. ]*/
+            LogError("ThreadAPI_Create failed, bulk load continues with %" PRIu32 " worker threads", started_worker_count);
+            break;
+        }
+    }
+
+    if (!context->hashes_computed)
+    {
+        run_bulk_load_hash_worker(context);
+    }
+    else
+    {
+        run_bulk_load_insert_worker(context, clds_hazard_pointers_thread);
+    }
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_206: [ clds_hash_table_bulk_load shall wait for the worker threads to complete by calling ThreadAPI_Join. ]*/
+    for (uint32_t i = 0; i < started_worker_count; i++)
+    {
+        int dont_care;
+        if (ThreadAPI_Join(worker_threads[i], &dont_care) != THREADAPI_OK)
+        {
+            LogError("ThreadAPI_Join failed for worker thread %" PRIu32 "", i);
+        }
+    }
+}
+
+static void group_keys_by_bucket_range(BULK_LOAD_CONTEXT* context)
+{
+    uint64_t bucket_mask = context->bucket_array->bucket_mask;
+
+    for (uint32_t i = 0; i <= context->range_count; i++)
+    {
+        context->range_starts[i] = 0;
+    }
+
+    for (uint32_t i = 0; i < context->key_count; i++)
+    {
+        context->range_starts[(context->hashes[i] & bucket_mask) >> context->range_shift]++;
+    }
+
+    // turn the counts into the end of each range
+    uint32_t range_end = 0;
+    for (uint32_t i = 0; i < context->range_count; i++)
+    {
+        range_end += context->range_starts[i];
+        context->range_starts[i] = range_end;
+    }
+    context->range_starts[context->range_count] = context->key_count;
+
+    // walking the keys backwards leaves each range in the order of the keys and its entry at the start of the range
+    for (uint32_t i = context->key_count; i > 0; i--)
+    {
+        uint32_t key_index = i - 1;
+        uint32_t range_index = (uint32_t)((context->hashes[key_index] & bucket_mask) >> context->range_shift);
+        context->key_indices[--context->range_starts[range_index]] = key_index;
+    }
+}
+
+int clds_hash_table_bulk_load(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t worker_count, void** keys, CLDS_HASH_TABLE_ITEM** values, uint32_t key_count, CLDS_HASH_TABLE_INSERT_RESULT* results, int64_t* sequence_numbers)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_183: [ If clds_hash_table is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_184: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_185: [ If worker_count is 0, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (worker_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_186: [ If keys is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (keys == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_187: [ If values is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (values == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_188: [ If key_count is 0, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (key_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_189: [ If results is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        (results == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_190: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+        ((sequence_numbers != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint32_t worker_count=%" PRIu32 ", void** keys=%p, CLDS_HASH_TABLE_ITEM** values=%p, uint32_t key_count=%" PRIu32 ", CLDS_HASH_TABLE_INSERT_RESULT* results=%p, int64_t* sequence_numbers=%p",
+            clds_hash_table, clds_hazard_pointers_thread, worker_count, keys, values, key_count, results, sequence_numbers);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_CLDS_HASH_TABLE_07_191: [ If any of the keys is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+    else if (has_null_key(keys, key_count))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_192: [ clds_hash_table_bulk_load shall wait for any migration or snapshot in progress to complete, prevent new ones from starting, lock the table for writes and wait for the write operations in progress to complete. ]*/
+        int32_t migration_lock;
+        while ((migration_lock = interlocked_compare_exchange(&clds_hash_table->migration_lock, 1, 0)) != 0)
+        {
+            (void)wait_on_address(&clds_hash_table->migration_lock, migration_lock, UINT32_MAX);
         }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-        bool set_value_in_top_level = true;
-        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        internal_lock_writes(clds_hash_table);
 
-        BUCKET_ARRAY* find_bucket_array = next_bucket_array;
-        while (find_bucket_array != NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_07_193: [ clds_hash_table_bulk_load shall count the items in all the bucket arrays and reserve room in the top level bucket array for them and for key_count more items (but no more than 2^29 items) in the same way as clds_hash_table_reserve. ]*/
+        uint64_t reserve_item_count = key_count;
+        BUCKET_ARRAY* bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (bucket_array != NULL)
         {
-            next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
+            reserve_item_count += (uint64_t)get_exact_item_count(bucket_array);
+            bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+        }
+
+        if (reserve_item_count > MAX_INITIAL_BUCKET_SIZE)
+        {
+            // the top level bucket array ends up more loaded than usual, which makes the lookups slower but is not a failure
+            reserve_item_count = MAX_INITIAL_BUCKET_SIZE;
+        }
 
-            bucket_index = hash % interlocked_add(&find_bucket_array->bucket_count, 0);
-            bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->hash_table[bucket_index], NULL, NULL);
+        if (reserve_top_level_bucket_array(clds_hash_table, clds_hazard_pointers_thread, reserve_item_count) == CLDS_HASH_TABLE_RESERVE_ERROR)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_194: [ If reserving room fails, clds_hash_table_bulk_load shall insert the items in the existing top level bucket array. ]*/
+            LogError("Cannot reserve room for %" PRIu64 " items, loading the items in the existing top level bucket array", reserve_item_count);
+        }
 
-            if (bucket_list != NULL)
+        BULK_LOAD_CONTEXT context =
+        {
+            .clds_hash_table = clds_hash_table,
+            .bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL),
+            .probe_lower_levels = false,
+            .snapshot_epoch = interlocked_add_64(&clds_hash_table->snapshot_epoch, 0),
+            .keys = keys,
+            .values = values,
+            .key_count = key_count,
+            .results = results,
+            .sequence_numbers = sequence_numbers,
+            .hashes = NULL,
+            .hashes_computed = false,
+            .key_indices = NULL,
+            .range_starts = NULL,
+            .range_count = 0,
+            .range_shift = 0,
+            .next_work_item = 0
+        };
+
+        // looking up the keys in the lower level bucket arrays is only needed when they hold items
+        // (no insert lands in them anymore and the migrations cannot move items into them while the migration lock is held)
+        bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&context.bucket_array->next_bucket, NULL, NULL);
+        bool has_lower_levels = (bucket_array != NULL);
+        while (bucket_array != NULL)
+        {
+            if (get_exact_item_count(bucket_array) != 0)
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
-                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                if (sorted_list_item != NULL)
-                {
-                    clds_sorted_list_node_release(sorted_list_item);
+                context.probe_lower_levels = true;
+                break;
+            }
+            bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+        }
 
-                    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
-                    hash_table_item->key = key;
+        /* Codes_SRS_CLDS_HASH_TABLE_07_267: [ Once room is reserved, clds_hash_table_bulk_load shall count itself as an insert in progress in the top level bucket array and unlock the table for writes, so that the other write operations run concurrently with the load. ]*/
+        // an insert that allocates a bucket array on top of this one meanwhile waits for the load before looking up its key in here
+        uint32_t stripe_index = get_stripe_index(clds_hazard_pointers_thread);
+        (void)interlocked_increment(&context.bucket_array->counters[stripe_index].pending_insert_count);
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-                    CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, condition_check_func, condition_check_context, (void*)old_item, sequence_number, true);
-                    switch (sorted_list_set_value_result)
+        internal_unlock_writes(clds_hash_table);
+
+        // both the bucket count and the range count are powers of two
+        uint32_t bucket_count = (uint32_t)context.bucket_array->bucket_count;
+        size_t desired_range_count = round_up_to_power_of_two((size_t)worker_count * BULK_LOAD_RANGES_PER_WORKER);
+        while ((size_t)(bucket_count >> context.range_shift) > desired_range_count)
+        {
+            context.range_shift++;
+        }
+        context.range_count = bucket_count >> context.range_shift;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_195: [ clds_hash_table_bulk_load shall allocate memory for the hashes of the keys and for grouping the keys by ranges of buckets of the top level bucket array. ]*/
+        context.hashes = malloc_2(key_count, sizeof(uint64_t));
+        if (context.hashes == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_207: [ If any other error occurs, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+            LogError("malloc_2(key_count=%" PRIu32 ", sizeof(uint64_t)=%zu) failed for the hashes", key_count, sizeof(uint64_t));
+            result = MU_FAILURE;
+        }
+        else
+        {
+            context.key_indices = malloc_2(key_count, sizeof(uint32_t));
+            if (context.key_indices == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_207: [ If any other error occurs, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+                LogError("malloc_2(key_count=%" PRIu32 ", sizeof(uint32_t)=%zu) failed for the key indices", key_count, sizeof(uint32_t));
+                result = MU_FAILURE;
+            }
+            else
+            {
+                context.range_starts = malloc_2((size_t)context.range_count + 1, sizeof(uint32_t));
+                if (context.range_starts == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_207: [ If any other error occurs, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+                    LogError("malloc_2(context.range_count + 1=%" PRIu32 ", sizeof(uint32_t)=%zu) failed for the ranges", context.range_count + 1, sizeof(uint32_t));
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    THREAD_HANDLE* worker_threads = NULL;
+
+                    if (
+                        (worker_count > 1) &&
+                        ((worker_threads = malloc_2(worker_count - 1, sizeof(THREAD_HANDLE))) == NULL)
+                        )
                     {
-                    default:
-                    case CLDS_SORTED_LIST_SET_VALUE_ERROR:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                        LogError("Cannot set key in sorted list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
-                        set_value_in_top_level = false;
-                        break;
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_207: [ If any other error occurs, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+                        LogError("malloc_2(worker_count - 1=%" PRIu32 ", sizeof(THREAD_HANDLE)=%zu) failed for the worker threads",
+                            worker_count - 1, sizeof(THREAD_HANDLE));
+                        result = MU_FAILURE;
+                    }
+                    else
+                    {
+                        run_bulk_load_workers(&context, clds_hazard_pointers_thread, worker_threads, worker_count);
 
-                    case CLDS_SORTED_LIST_SET_VALUE_OK:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-                        result = CLDS_HASH_TABLE_SET_VALUE_OK;
-                        set_value_in_top_level = false;
-                        break;
-                    
-                    case CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET:
-                        /* Codes_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-                        result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
-                        set_value_in_top_level = false;
-                        break;
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_199: [ clds_hash_table_bulk_load shall group the keys by ranges of buckets of the top level bucket array, keeping the order of the keys within each range. ]*/
+                        group_keys_by_bucket_range(&context);
 
-                    case CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-                        break;
+                        context.hashes_computed = true;
+                        run_bulk_load_workers(&context, clds_hazard_pointers_thread, worker_threads, worker_count);
+
+                        if (worker_threads != NULL)
+                        {
+                            free(worker_threads);
+                        }
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_210: [ On success clds_hash_table_bulk_load shall return 0. ]*/
+                        result = 0;
                     }
+
+                    free(context.range_starts);
                 }
+
+                free(context.key_indices);
             }
-            else
+
+            free(context.hashes);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_208: [ clds_hash_table_bulk_load shall stop counting itself as an insert in progress in the top level bucket array and allow migrations and snapshots to start again. ]*/
+        end_pending_insert(context.bucket_array, stripe_index);
+
+        (void)interlocked_exchange(&clds_hash_table->migration_lock, 0);
+        wake_by_address_all(&clds_hash_table->migration_lock);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_07_209: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_bulk_load shall migrate up to the migration bucket budget buckets once. ]*/
+        help_migrate(clds_hash_table, clds_hazard_pointers_thread, has_lower_levels);
+    }
+
+    return result;
+}
+
+static uint64_t get_snapshot_image_record_total_size(uint32_t record_size)
+{
+    // header and record, padded so that the next record header is aligned
+    return ((uint64_t)sizeof(SNAPSHOT_IMAGE_RECORD) + record_size + SNAPSHOT_IMAGE_ALIGNMENT - 1) & ~(uint64_t)(SNAPSHOT_IMAGE_ALIGNMENT - 1);
+}
+
+static const SNAPSHOT_IMAGE_HEADER* get_snapshot_image_header(const void* image, uint64_t image_size)
+{
+    const SNAPSHOT_IMAGE_HEADER* result;
+    const SNAPSHOT_IMAGE_HEADER* header = image;
+
+    // only the header is looked at, the directory is checked by the callers that walk all of it
+    if (image_size < sizeof(SNAPSHOT_IMAGE_HEADER))
+    {
+        LogError("Snapshot image too small, image_size=%" PRIu64 "", image_size);
+        result = NULL;
+    }
+    else if (((uintptr_t)image % SNAPSHOT_IMAGE_ALIGNMENT) != 0)
+    {
+        LogError("Snapshot image at %p is not aligned to %d bytes", image, SNAPSHOT_IMAGE_ALIGNMENT);
+        result = NULL;
+    }
+    else if (
+        (header->magic != SNAPSHOT_IMAGE_MAGIC) ||
+        (header->version != SNAPSHOT_IMAGE_VERSION) ||
+        (header->header_size != sizeof(SNAPSHOT_IMAGE_HEADER))
+        )
+    {
+        LogError("Not a snapshot image of a supported version, magic=%" PRIx32 ", version=%" PRIu32 ", header_size=%" PRIu32 "",
+            header->magic, header->version, header->header_size);
+        result = NULL;
+    }
+    else if (
+        (header->bucket_count == 0) ||
+        (header->bucket_count > MAX_INITIAL_BUCKET_SIZE) ||
+        ((header->bucket_count & (header->bucket_count - 1)) != 0)
+        )
+    {
+        LogError("Invalid bucket count in snapshot image, bucket_count=%" PRIu64 "", header->bucket_count);
+        result = NULL;
+    }
+    else if (
+        ((header->directory_offset % SNAPSHOT_IMAGE_ALIGNMENT) != 0) ||
+        ((header->records_offset % SNAPSHOT_IMAGE_ALIGNMENT) != 0) ||
+        (header->directory_offset < sizeof(SNAPSHOT_IMAGE_HEADER)) ||
+        (header->directory_offset > image_size) ||
+        ((image_size - header->directory_offset) / sizeof(SNAPSHOT_IMAGE_BUCKET) < header->bucket_count + 1) ||
+        (header->records_offset < header->directory_offset + (header->bucket_count + 1) * sizeof(SNAPSHOT_IMAGE_BUCKET)) ||
+        (header->records_offset > image_size) ||
+        (header->records_size > image_size - header->records_offset)
+        )
+    {
+        LogError("Snapshot image layout does not fit in image_size=%" PRIu64 ", directory_offset=%" PRIu64 ", records_offset=%" PRIu64 ", records_size=%" PRIu64 "",
+            image_size, header->directory_offset, header->records_offset, header->records_size);
+        result = NULL;
+    }
+    else
+    {
+        result = header;
+    }
+
+    return result;
+}
+
+static const SNAPSHOT_IMAGE_BUCKET* get_snapshot_image_directory(const SNAPSHOT_IMAGE_HEADER* header)
+{
+    return (const SNAPSHOT_IMAGE_BUCKET*)((const unsigned char*)header + header->directory_offset);
+}
+
+static int validate_snapshot_image_directory(const SNAPSHOT_IMAGE_HEADER* header)
+{
+    int result;
+    const SNAPSHOT_IMAGE_BUCKET* directory = get_snapshot_image_directory(header);
+    uint64_t i;
+
+    if (
+        (directory[0].records_offset != 0) ||
+        (directory[0].first_record_index != 0) ||
+        (directory[header->bucket_count].records_offset != header->records_size) ||
+        (directory[header->bucket_count].first_record_index != header->record_count)
+        )
+    {
+        LogError("Snapshot image directory does not cover the %" PRIu64 " records (%" PRIu64 " bytes)", header->record_count, header->records_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        for (i = 0; i < header->bucket_count; i++)
+        {
+            if (
+                ((directory[i + 1].records_offset % SNAPSHOT_IMAGE_ALIGNMENT) != 0) ||
+                (directory[i + 1].records_offset < directory[i].records_offset) ||
+                (directory[i + 1].first_record_index < directory[i].first_record_index) ||
+                // each record takes at least a record header
+                ((directory[i + 1].first_record_index - directory[i].first_record_index) > (directory[i + 1].records_offset - directory[i].records_offset) / sizeof(SNAPSHOT_IMAGE_RECORD))
+                )
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+                break;
             }
+        }
 
-            find_bucket_array = next_bucket_array;
+        if (i < header->bucket_count)
+        {
+            LogError("Snapshot image directory entry for bucket %" PRIu64 " is invalid", i);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            result = 0;
         }
+    }
 
-        if (set_value_in_top_level)
+    return result;
+}
+
+static const SNAPSHOT_IMAGE_RECORD* get_snapshot_image_record(const SNAPSHOT_IMAGE_HEADER* header, uint64_t offset, uint64_t end_offset)
+{
+    const SNAPSHOT_IMAGE_RECORD* result;
+
+    if ((end_offset - offset) < sizeof(SNAPSHOT_IMAGE_RECORD))
+    {
+        LogError("Snapshot image record at offset %" PRIu64 " does not fit in its bucket, bucket ends at %" PRIu64 "", offset, end_offset);
+        result = NULL;
+    }
+    else
+    {
+        const SNAPSHOT_IMAGE_RECORD* record = (const SNAPSHOT_IMAGE_RECORD*)((const unsigned char*)header + header->records_offset + offset);
+        if (get_snapshot_image_record_total_size(record->record_size) > end_offset - offset)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-            BUCKET_ARRAY* current_bucket_array = first_bucket_array;
+            LogError("Snapshot image record at offset %" PRIu64 " with record_size=%" PRIu32 " does not fit in its bucket, bucket ends at %" PRIu64 "",
+                offset, record->record_size, end_offset);
+            result = NULL;
+        }
+        else
+        {
+            result = record;
+        }
+    }
 
-            // look for the item in this bucket array
-            // find the bucket
-            bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
-            bool restart_needed = false;
+    return result;
+}
+
+int clds_hash_table_snapshot_image_write(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HASH_TABLE_ITEM** items, uint64_t item_count, int64_t sequence_number, HASH_TABLE_GET_RECORD_SIZE_CB get_record_size, HASH_TABLE_SERIALIZE_RECORD_CB serialize_record, void* serialize_context, HASH_TABLE_WRITE_SNAPSHOT_IMAGE_CB write_image, void* write_image_context, uint64_t* image_size)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_211: [ If clds_hash_table is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_212: [ If items is NULL and item_count is not 0, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+        ((items == NULL) && (item_count != 0)) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_213: [ If get_record_size is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+        (get_record_size == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_214: [ If serialize_record is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+        (serialize_record == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_215: [ If write_image is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+        (write_image == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_216: [ If image_size is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+        (image_size == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HASH_TABLE_ITEM** items=%p, uint64_t item_count=%" PRIu64 ", int64_t sequence_number=%" PRId64 ", HASH_TABLE_GET_RECORD_SIZE_CB get_record_size=%p, HASH_TABLE_SERIALIZE_RECORD_CB serialize_record=%p, void* serialize_context=%p, HASH_TABLE_WRITE_SNAPSHOT_IMAGE_CB write_image=%p, void* write_image_context=%p, uint64_t* image_size=%p",
+            clds_hash_table, items, item_count, sequence_number, get_record_size, serialize_record, serialize_context, write_image, write_image_context, image_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_217: [ clds_hash_table_snapshot_image_write shall lay out the image with item_count rounded up to a power of two buckets (at least 1 and at most 2^29). ]*/
+        uint64_t bucket_count = (item_count > MAX_INITIAL_BUCKET_SIZE) ? MAX_INITIAL_BUCKET_SIZE : round_up_to_power_of_two((size_t)item_count);
+        uint64_t bucket_mask = bucket_count - 1;
+
+        // an image with no items still has the header and a directory with 1 bucket, malloc_2 is not asked for 0 bytes
+        size_t item_allocation_count = (item_count == 0) ? 1 : (size_t)item_count;
 
-            do
+        /* Codes_SRS_CLDS_HASH_TABLE_07_218: [ clds_hash_table_snapshot_image_write shall allocate memory for the hashes and record sizes of the items, for the bucket directory of the image and for placing the records in their buckets. ]*/
+        uint64_t* hashes = malloc_2(item_allocation_count, sizeof(uint64_t));
+        if (hashes == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_226: [ If any other error occurs, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+            LogError("malloc_2(item_count=%" PRIu64 ", sizeof(uint64_t)=%zu) failed for the hashes", item_count, sizeof(uint64_t));
+            result = MU_FAILURE;
+        }
+        else
+        {
+            uint32_t* record_sizes = malloc_2(item_allocation_count, sizeof(uint32_t));
+            if (record_sizes == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_226: [ If any other error occurs, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                LogError("malloc_2(item_count=%" PRIu64 ", sizeof(uint32_t)=%zu) failed for the record sizes", item_count, sizeof(uint32_t));
+                result = MU_FAILURE;
+            }
+            else
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
-                // do we have a list here or do we create one?
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*) &current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
+                SNAPSHOT_IMAGE_BUCKET* directory = malloc_2((size_t)bucket_count + 1, sizeof(SNAPSHOT_IMAGE_BUCKET));
+                if (directory == NULL)
                 {
-                    restart_needed = false;
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_226: [ If any other error occurs, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                    LogError("malloc_2(bucket_count + 1=%" PRIu64 ", sizeof(SNAPSHOT_IMAGE_BUCKET)=%zu) failed for the directory", bucket_count + 1, sizeof(SNAPSHOT_IMAGE_BUCKET));
+                    result = MU_FAILURE;
                 }
                 else
                 {
-                    // create a list
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-                    bucket_list = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
-                    if (bucket_list == NULL)
+                    uint64_t* bucket_write_offsets = malloc_2((size_t)bucket_count, sizeof(uint64_t));
+                    if (bucket_write_offsets == NULL)
                     {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                        LogError("Cannot allocate list for hash table bucket");
-                        restart_needed = false;
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_226: [ If any other error occurs, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                        LogError("malloc_2(bucket_count=%" PRIu64 ", sizeof(uint64_t)=%zu) failed for the bucket write offsets", bucket_count, sizeof(uint64_t));
+                        result = MU_FAILURE;
                     }
                     else
                     {
-                        // now put the list in the bucket
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], bucket_list, NULL) != NULL)
+                        uint64_t i;
+                        uint32_t max_record_size = 0;
+
+                        for (i = 0; i <= bucket_count; i++)
                         {
-                            // oops, someone else inserted a new list, just bail on our list and restart
-                            clds_sorted_list_destroy(bucket_list);
-                            restart_needed = true;
+                            directory[i].records_offset = 0;
+                            directory[i].first_record_index = 0;
                         }
-                        else
+
+                        for (i = 0; i < item_count; i++)
+                        {
+                            if (items[i] == NULL)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_280: [ If any of the first item_count entries of items is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                LogError("NULL item at index %" PRIu64 "", i);
+                                break;
+                            }
+
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_219: [ For each item, clds_hash_table_snapshot_image_write shall compute the hash of its key in the same way as the hash table does and get the size of its record by calling get_record_size. ]*/
+                            HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, items[i]);
+                            hashes[i] = compute_key_hash(clds_hash_table, hash_table_item->key);
+                            record_sizes[i] = get_record_size(serialize_context, items[i]);
+                            if (record_sizes[i] > UINT32_MAX - sizeof(SNAPSHOT_IMAGE_RECORD) - SNAPSHOT_IMAGE_ALIGNMENT)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_220: [ If the size of a record is greater than UINT32_MAX minus the size of the record header and padding, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                LogError("Record of item %" PRIu64 " too large, record_size=%" PRIu32 "", i, record_sizes[i]);
+                                break;
+                            }
+
+                            if (record_sizes[i] > max_record_size)
+                            {
+                                max_record_size = record_sizes[i];
+                            }
+
+                            // count the bytes and records of each bucket, they become the bucket offsets below
+                            directory[(hashes[i] & bucket_mask) + 1].records_offset += get_snapshot_image_record_total_size(record_sizes[i]);
+                            directory[(hashes[i] & bucket_mask) + 1].first_record_index++;
+                        }
+
+                        if (i < item_count)
                         {
-                            // set new list
-                            restart_needed = false;
+                            result = MU_FAILURE;
                         }
-                    }
-                }
-            } while (restart_needed);
+                        else
+                        {
+                            for (i = 0; i < bucket_count; i++)
+                            {
+                                directory[i + 1].records_offset += directory[i].records_offset;
+                                directory[i + 1].first_record_index += directory[i].first_record_index;
+                                bucket_write_offsets[i] = directory[i].records_offset;
+                            }
 
-            if (bucket_list == NULL)
-            {
-                LogError("Cannot acquire bucket list");
-                result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
-            }
-            else
-            {
-                HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+                            SNAPSHOT_IMAGE_HEADER header =
+                            {
+                                .magic = SNAPSHOT_IMAGE_MAGIC,
+                                .version = SNAPSHOT_IMAGE_VERSION,
+                                .header_size = sizeof(SNAPSHOT_IMAGE_HEADER),
+                                .hash_finalizer = (uint32_t)clds_hash_table->hash_finalizer,
+                                .sequence_number = sequence_number,
+                                .record_count = item_count,
+                                .bucket_count = bucket_count,
+                                .directory_offset = sizeof(SNAPSHOT_IMAGE_HEADER),
+                                .records_offset = sizeof(SNAPSHOT_IMAGE_HEADER) + (bucket_count + 1) * sizeof(SNAPSHOT_IMAGE_BUCKET),
+                                .records_size = directory[bucket_count].records_offset
+                            };
+
+                            unsigned char* record_buffer = malloc((size_t)get_snapshot_image_record_total_size(max_record_size));
+                            if (record_buffer == NULL)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_226: [ If any other error occurs, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                LogError("malloc(%" PRIu64 ") failed for the record buffer", get_snapshot_image_record_total_size(max_record_size));
+                                result = MU_FAILURE;
+                            }
+                            else
+                            {
+                                SNAPSHOT_IMAGE_RECORD* record = (SNAPSHOT_IMAGE_RECORD*)record_buffer;
+
+                                for (i = 0; i < item_count; i++)
+                                {
+                                    uint64_t record_total_size = get_snapshot_image_record_total_size(record_sizes[i]);
+                                    uint64_t* bucket_write_offset = &bucket_write_offsets[hashes[i] & bucket_mask];
+
+                                    record->hash = hashes[i];
+                                    record->record_size = record_sizes[i];
+                                    record->reserved = 0;
+                                    // the padding is zeroed so that the same items always make the same image
+                                    (void)memset(record_buffer + sizeof(SNAPSHOT_IMAGE_RECORD) + record_sizes[i], 0, (size_t)(record_total_size - sizeof(SNAPSHOT_IMAGE_RECORD) - record_sizes[i]));
+
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_221: [ For each item, clds_hash_table_snapshot_image_write shall call serialize_record to fill the record of the item and call write_image to write the record header, the record and its padding at the next free offset in the bucket of the item. ]*/
+                                    if (serialize_record(serialize_context, items[i], record_buffer + sizeof(SNAPSHOT_IMAGE_RECORD), record_sizes[i]) != 0)
+                                    {
+                                        /* Codes_SRS_CLDS_HASH_TABLE_07_222: [ If serialize_record or write_image fail, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                        LogError("serialize_record failed for item %" PRIu64 "", i);
+                                        break;
+                                    }
+
+                                    if (write_image(write_image_context, header.records_offset + *bucket_write_offset, record_buffer, (size_t)record_total_size) != 0)
+                                    {
+                                        /* Codes_SRS_CLDS_HASH_TABLE_07_222: [ If serialize_record or write_image fail, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                        LogError("write_image failed for the record of item %" PRIu64 " at offset %" PRIu64 "", i, header.records_offset + *bucket_write_offset);
+                                        break;
+                                    }
+
+                                    *bucket_write_offset += record_total_size;
+                                }
+
+                                if (i < item_count)
+                                {
+                                    result = MU_FAILURE;
+                                }
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_223: [ clds_hash_table_snapshot_image_write shall then call write_image to write the bucket directory and, last, the header holding the version of the format, sequence_number, the hash finalizer of the table and the layout of the image. ]*/
+                                else if (write_image(write_image_context, header.directory_offset, directory, (size_t)((bucket_count + 1) * sizeof(SNAPSHOT_IMAGE_BUCKET))) != 0)
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_222: [ If serialize_record or write_image fail, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                    LogError("write_image failed for the directory");
+                                    result = MU_FAILURE;
+                                }
+                                // the header goes last, so that an image whose writing did not complete is not taken for a valid one
+                                else if (write_image(write_image_context, 0, &header, sizeof(header)) != 0)
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_222: [ If serialize_record or write_image fail, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+                                    LogError("write_image failed for the header");
+                                    result = MU_FAILURE;
+                                }
+                                else
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_224: [ clds_hash_table_snapshot_image_write shall store the size of the image in image_size. ]*/
+                                    *image_size = header.records_offset + header.records_size;
+
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_225: [ On success clds_hash_table_snapshot_image_write shall return 0. ]*/
+                                    result = 0;
+                                }
 
-                hash_table_item->key = key;
+                                free(record_buffer);
+                            }
+                        }
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
-                CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, condition_check_func, condition_check_context, (void*)old_item, sequence_number, false);
-                if (sorted_list_set_value == CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-                    LogError("Condition not met during set value - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
-                    result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
-                }
-                else if (sorted_list_set_value != CLDS_SORTED_LIST_SET_VALUE_OK)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                    LogError("Cannot set key in sorted list - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
-                    result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
-                }
-                else
-                {
-                    if (*old_item == NULL)
-                    {
-                        (void)interlocked_increment(&first_bucket_array->item_count);
+                        free(bucket_write_offsets);
                     }
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-                    result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                    free(directory);
                 }
-            }
-        }
 
-        (void)interlocked_decrement(&first_bucket_array->pending_insert_count);
+                free(record_sizes);
+            }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_060: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+            free(hashes);
+        }
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_ITEM* clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+int clds_hash_table_snapshot_image_get_info(const void* image, uint64_t image_size, uint64_t* record_count, int64_t* sequence_number)
 {
-    CLDS_HASH_TABLE_ITEM* result;
+    int result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-        (key == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_07_227: [ If image is NULL, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+        (image == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_228: [ If record_count is NULL, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+        (record_count == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_229: [ If sequence_number is NULL, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+        (sequence_number == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
-            clds_hash_table, clds_hazard_pointers_thread, key);
-        result = NULL;
+        LogError("Invalid arguments: const void* image=%p, uint64_t image_size=%" PRIu64 ", uint64_t* record_count=%p, int64_t* sequence_number=%p",
+            image, image_size, record_count, sequence_number);
+        result = MU_FAILURE;
     }
     else
     {
-        CLDS_SORTED_LIST_HANDLE bucket_list;
+        /* Codes_SRS_CLDS_HASH_TABLE_07_230: [ clds_hash_table_snapshot_image_get_info shall validate that image is aligned to 8 bytes, starts with a header of a supported version and that the bucket directory and the records fit in image_size and cover all the records. ]*/
+        const SNAPSHOT_IMAGE_HEADER* header = get_snapshot_image_header(image, image_size);
+        if (
+            (header == NULL) ||
+            (validate_snapshot_image_directory(header) != 0)
+            )
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_231: [ If the image is not valid, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+            LogError("Invalid snapshot image %p, image_size=%" PRIu64 "", image, image_size);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_232: [ On success clds_hash_table_snapshot_image_get_info shall store the number of records and the sequence number of the image in record_count and sequence_number and return 0. ]*/
+            *record_count = header->record_count;
+            *sequence_number = header->sequence_number;
+            result = 0;
+        }
+    }
 
-        result = NULL;
+    return result;
+}
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT clds_hash_table_snapshot_image_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, const void* image, uint64_t image_size, void* key, HASH_TABLE_RECORD_MATCH_CB record_match, void* record_match_context, const unsigned char** record, uint32_t* record_size)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
 
-        /* Codes_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
-        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_07_233: [ If clds_hash_table is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_234: [ If image is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+        (image == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_235: [ If key is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_236: [ If record_match is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+        (record_match == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_237: [ If record is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+        (record == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_238: [ If record_size is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+        (record_size == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, const void* image=%p, uint64_t image_size=%" PRIu64 ", void* key=%p, HASH_TABLE_RECORD_MATCH_CB record_match=%p, void* record_match_context=%p, const unsigned char** record=%p, uint32_t* record_size=%p",
+            clds_hash_table, image, image_size, key, record_match, record_match_context, record, record_size);
+        result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_239: [ clds_hash_table_snapshot_image_find shall validate the header of the image in the same way as clds_hash_table_snapshot_image_get_info, without walking the whole bucket directory. ]*/
+        const SNAPSHOT_IMAGE_HEADER* header = get_snapshot_image_header(image, image_size);
+        if (header == NULL)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
-
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+            /* Codes_SRS_CLDS_HASH_TABLE_07_240: [ If the header is not valid or the image was written by a table with a different hash finalizer, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+            LogError("Invalid snapshot image %p, image_size=%" PRIu64 "", image, image_size);
+            result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR;
+        }
+        else if (header->hash_finalizer != (uint32_t)clds_hash_table->hash_finalizer)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_240: [ If the header is not valid or the image was written by a table with a different hash finalizer, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+            LogError("Snapshot image hashes were computed with hash finalizer %" PRIu32 ", the table uses %" PRI_MU_ENUM "",
+                header->hash_finalizer, MU_ENUM_VALUE(CLDS_HASH_TABLE_HASH_FINALIZER, clds_hash_table->hash_finalizer));
+            result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_241: [ clds_hash_table_snapshot_image_find shall compute the hash of key in the same way as the hash table does and look at the records of the bucket of the image that the hash maps to. ]*/
+            uint64_t hash = compute_key_hash(clds_hash_table, key);
+            const SNAPSHOT_IMAGE_BUCKET* bucket = &get_snapshot_image_directory(header)[hash & (header->bucket_count - 1)];
+            uint64_t offset = bucket[0].records_offset;
+            uint64_t end_offset = bucket[1].records_offset;
+
+            if (
+                (end_offset < offset) ||
+                (end_offset > header->records_size) ||
+                ((offset % SNAPSHOT_IMAGE_ALIGNMENT) != 0)
+                )
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_243: [ If a record does not fit in its bucket, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+                LogError("Invalid snapshot image bucket, records from %" PRIu64 " to %" PRIu64 ", records_size=%" PRIu64 "", offset, end_offset, header->records_size);
+                result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR;
+            }
+            else
             {
-                // find the bucket
-                /* Codes_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
+                /* Codes_SRS_CLDS_HASH_TABLE_07_244: [ If no record matches, clds_hash_table_snapshot_image_find shall return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_NOT_FOUND. ]*/
+                result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_NOT_FOUND;
 
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
+                while (offset < end_offset)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-                    result = (void*)clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                    if (result == NULL)
+                    const SNAPSHOT_IMAGE_RECORD* image_record = get_snapshot_image_record(header, offset, end_offset);
+                    if (image_record == NULL)
                     {
-                        // go to the next level of buckets
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_243: [ If a record does not fit in its bucket, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+                        result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR;
+                        break;
                     }
-                    else
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_242: [ For each record of the bucket with the same hash, clds_hash_table_snapshot_image_find shall call record_match and if it returns true store the record and its size in record and record_size and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_OK. ]*/
+                    if (
+                        (image_record->hash == hash) &&
+                        record_match(record_match_context, key, (const unsigned char*)(image_record + 1), image_record->record_size)
+                        )
                     {
-                        // found
+                        *record = (const unsigned char*)(image_record + 1);
+                        *record_size = image_record->record_size;
+                        result = CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_OK;
                         break;
                     }
+
+                    offset += get_snapshot_image_record_total_size(image_record->record_size);
                 }
             }
+        }
+    }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
-            current_bucket_array = next_bucket_array;
+    return result;
+}
+
+static int restore_bucket(RESTORE_CONTEXT* context, uint64_t bucket_index)
+{
+    int result = 0;
+    const SNAPSHOT_IMAGE_BUCKET* bucket = &get_snapshot_image_directory(context->header)[bucket_index];
+    uint64_t offset = bucket[0].records_offset;
+    uint64_t record_index = bucket[0].first_record_index;
+
+    while (offset < bucket[1].records_offset)
+    {
+        const SNAPSHOT_IMAGE_RECORD* image_record = get_snapshot_image_record(context->header, offset, bucket[1].records_offset);
+        if (
+            (image_record == NULL) ||
+            (record_index == bucket[1].first_record_index)
+            )
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+            LogError("Records of snapshot image bucket %" PRIu64 " do not match the bucket directory", bucket_index);
+            result = MU_FAILURE;
+            break;
         }
 
-        if (current_bucket_array == NULL)
+        void* key = NULL;
+        /* Codes_SRS_CLDS_HASH_TABLE_07_257: [ For each record of the buckets of the chunk, the worker shall call deserialize_record to create the item and store the item and its key at the index of the record. ]*/
+        CLDS_HASH_TABLE_ITEM* item = context->deserialize_record(context->deserialize_context, (const unsigned char*)(image_record + 1), image_record->record_size, &key);
+        if (item == NULL)
         {
-            /* not found */
-            /* Codes_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
-            result = NULL;
+            /* Codes_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+            LogError("deserialize_record failed for record %" PRIu64 "", record_index);
+            result = MU_FAILURE;
+            break;
         }
-        else
+
+        context->values[record_index] = item;
+        if (key == NULL)
         {
-            // all OK
+            /* Codes_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+            LogError("deserialize_record returned a NULL key for record %" PRIu64 "", record_index);
+            result = MU_FAILURE;
+            break;
         }
+
+        context->keys[record_index] = key;
+        record_index++;
+        offset += get_snapshot_image_record_total_size(image_record->record_size);
+    }
+
+    if (
+        (result == 0) &&
+        (record_index != bucket[1].first_record_index)
+        )
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+        LogError("Snapshot image bucket %" PRIu64 " has fewer records than the bucket directory says", bucket_index);
+        result = MU_FAILURE;
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, THANDLE(CANCELLATION_TOKEN) cancellation_token)
+static int restore_worker_thread(void* arg)
 {
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+    RESTORE_CONTEXT* context = arg;
+    int64_t chunk_index;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_07_256: [ Each worker shall repeatedly claim the next chunk of buckets of the image that no worker claimed yet. ]*/
+    while (
+        (interlocked_add(&context->failed, 0) == 0) &&
+        ((chunk_index = interlocked_increment_64(&context->next_chunk) - 1) < (int64_t)((context->header->bucket_count + RESTORE_CHUNK_BUCKET_COUNT - 1) / RESTORE_CHUNK_BUCKET_COUNT))
+        )
+    {
+        uint64_t first_bucket_index = (uint64_t)chunk_index * RESTORE_CHUNK_BUCKET_COUNT;
+        uint64_t end_bucket_index = ((context->header->bucket_count - first_bucket_index) < RESTORE_CHUNK_BUCKET_COUNT) ? context->header->bucket_count : (first_bucket_index + RESTORE_CHUNK_BUCKET_COUNT);
+
+        for (uint64_t i = first_bucket_index; i < end_bucket_index; i++)
+        {
+            if (restore_bucket(context, i) != 0)
+            {
+                (void)interlocked_exchange(&context->failed, 1);
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int clds_hash_table_restore(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t worker_count, const void* image, uint64_t image_size, HASH_TABLE_DESERIALIZE_RECORD_CB deserialize_record, void* deserialize_context, int64_t* sequence_number)
+{
+    int result;
+    const SNAPSHOT_IMAGE_HEADER* header;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_07_245: [ If clds_hash_table is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_07_246: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (items == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (item_count == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_07_247: [ If worker_count is 0, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+        (worker_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_248: [ If image is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+        (image == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_07_249: [ If deserialize_record is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+        (deserialize_record == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, THANDLE(CANCELLATION_TOKEN) cancellation_token=%p",
-            clds_hash_table, clds_hazard_pointers_thread, items, item_count, cancellation_token);
-        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint32_t worker_count=%" PRIu32 ", const void* image=%p, uint64_t image_size=%" PRIu64 ", HASH_TABLE_DESERIALIZE_RECORD_CB deserialize_record=%p, void* deserialize_context=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, worker_count, image, image_size, deserialize_record, deserialize_context, sequence_number);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_CLDS_HASH_TABLE_07_250: [ clds_hash_table_restore shall validate the image in the same way as clds_hash_table_snapshot_image_get_info. ]*/
+    else if (
+        ((header = get_snapshot_image_header(image, image_size)) == NULL) ||
+        (validate_snapshot_image_directory(header) != 0)
+        )
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_251: [ If the image is not valid or has more than UINT32_MAX records, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+        LogError("Invalid snapshot image %p, image_size=%" PRIu64 "", image, image_size);
+        result = MU_FAILURE;
+    }
+    else if (header->record_count > UINT32_MAX)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_07_251: [ If the image is not valid or has more than UINT32_MAX records, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+        LogError("Snapshot image has too many records to restore, record_count=%" PRIu64 "", header->record_count);
+        result = MU_FAILURE;
     }
     else
     {
-        internal_lock_writes(clds_hash_table);
-
-        uint64_t temp_item_count = 0;
-
-        /* Codes_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
-        {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
-
-            temp_item_count += interlocked_add(&current_bucket_array->item_count, 0);
+        uint32_t record_count = (uint32_t)header->record_count;
+        // the inserts of the load take sequence numbers too, those are not operations that the image has to be followed by
+        int64_t sequence_number_before_load = (clds_hash_table->sequence_number == NULL) ? 0 : interlocked_add_64(clds_hash_table->sequence_number, 0);
 
-            current_bucket_array = next_bucket_array;
-        }
-
-        if (temp_item_count == 0)
+        if (record_count == 0)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-            *items = NULL;
-            *item_count = 0;
-            result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            /* Codes_SRS_CLDS_HASH_TABLE_07_252: [ If the image has no records, clds_hash_table_restore shall only carry over the sequence number of the image. ]*/
+            result = 0;
         }
         else
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-            CLDS_SORTED_LIST_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
-
-            if (items_to_return == NULL)
+            /* Codes_SRS_CLDS_HASH_TABLE_07_253: [ clds_hash_table_restore shall allocate memory for the keys, items and insert results of the records and for the worker thread handles. ]*/
+            void** keys = malloc_2(record_count, sizeof(void*));
+            if (keys == NULL)
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
-                    (size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
-                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                /* Codes_SRS_CLDS_HASH_TABLE_07_266: [ If any other error occurs, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+                LogError("malloc_2(record_count=%" PRIu32 ", sizeof(void*)=%zu) failed for the keys", record_count, sizeof(void*));
+                result = MU_FAILURE;
             }
             else
             {
-                uint64_t result_index = 0;
-                bool is_cancelled = false;
-
-                /* Codes_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-                current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-                while (current_bucket_array != NULL)
+                CLDS_HASH_TABLE_ITEM** values = malloc_2(record_count, sizeof(CLDS_HASH_TABLE_ITEM*));
+                if (values == NULL)
                 {
-                    BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
-
-                    if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+                    /* Codes_SRS_CLDS_HASH_TABLE_07_266: [ If any other error occurs, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+                    LogError("malloc_2(record_count=%" PRIu32 ", sizeof(CLDS_HASH_TABLE_ITEM*)=%zu) failed for the items", record_count, sizeof(CLDS_HASH_TABLE_ITEM*));
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    CLDS_HASH_TABLE_INSERT_RESULT* results = malloc_2(record_count, sizeof(CLDS_HASH_TABLE_INSERT_RESULT));
+                    if (results == NULL)
                     {
-                        int32_t bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
-                        int32_t i;
+                        /* Codes_SRS_CLDS_HASH_TABLE_07_266: [ If any other error occurs, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+                        LogError("malloc_2(record_count=%" PRIu32 ", sizeof(CLDS_HASH_TABLE_INSERT_RESULT)=%zu) failed for the results", record_count, sizeof(CLDS_HASH_TABLE_INSERT_RESULT));
+                        result = MU_FAILURE;
+                    }
+                    else
+                    {
+                        THREAD_HANDLE* worker_threads = NULL;
 
-                        for (i = 0; i < bucket_count; i++)
+                        if (
+                            (worker_count > 1) &&
+                            ((worker_threads = malloc_2(worker_count - 1, sizeof(THREAD_HANDLE))) == NULL)
+                            )
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_266: [ If any other error occurs, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+                            LogError("malloc_2(worker_count - 1=%" PRIu32 ", sizeof(THREAD_HANDLE)=%zu) failed for the worker threads",
+                                worker_count - 1, sizeof(THREAD_HANDLE));
+                            result = MU_FAILURE;
+                        }
+                        else
                         {
-                            if ((current_bucket_array->hash_table[i] != NULL) && (temp_item_count > 0))
+                            RESTORE_CONTEXT context =
                             {
-                                uint64_t retrieved_item_count;
+                                .header = header,
+                                .deserialize_record = deserialize_record,
+                                .deserialize_context = deserialize_context,
+                                .keys = keys,
+                                .values = values,
+                                .next_chunk = 0,
+                                .failed = 0
+                            };
+                            uint32_t started_worker_count;
+
+                            for (uint32_t i = 0; i < record_count; i++)
+                            {
+                                values[i] = NULL;
+                            }
 
-                                if (
-                                    /* Codes_SRS_CLDS_HASH_TABLE_01_115: [ If cancellation_token is non-NULL and cancellation_token_is_cancelled returns true for cancellation_token, clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
-                                    (cancellation_token != NULL) &&
-                                    (cancellation_token_is_canceled(cancellation_token))
-                                    )
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_254: [ clds_hash_table_restore shall start worker_count - 1 worker threads by calling ThreadAPI_Create to deserialize the records, the calling thread being the last worker. ]*/
+                            for (started_worker_count = 0; started_worker_count < worker_count - 1; started_worker_count++)
+                            {
+                                if (ThreadAPI_Create(&worker_threads[started_worker_count], restore_worker_thread, &context) != THREADAPI_OK)
                                 {
-                                    LogVerbose("snapshot cancelled");
-                                    is_cancelled = true;
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_255: [ If ThreadAPI_Create fails, clds_hash_table_restore shall continue with the workers started so far. ]*/
+                                    LogError("ThreadAPI_Create failed, restore continues with %" PRIu32 " worker threads", started_worker_count);
                                     break;
                                 }
+                            }
 
-                                /* Codes_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-                                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, temp_item_count, items_to_return + result_index, &retrieved_item_count, false);
-                                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
+                            (void)restore_worker_thread(&context);
+
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_259: [ clds_hash_table_restore shall wait for the worker threads to complete by calling ThreadAPI_Join. ]*/
+                            for (uint32_t i = 0; i < started_worker_count; i++)
+                            {
+                                int dont_care;
+                                if (ThreadAPI_Join(worker_threads[i], &dont_care) != THREADAPI_OK)
                                 {
-                                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
-                                    break;
+                                    LogError("ThreadAPI_Join failed for worker thread %" PRIu32 "", i);
+                                }
+                            }
+
+                            if (interlocked_add(&context.failed, 0) != 0)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+                                LogError("Deserializing the records of snapshot image %p failed", image);
+                                result = MU_FAILURE;
+
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+                                for (uint32_t i = 0; i < record_count; i++)
+                                {
+                                    if (values[i] != NULL)
+                                    {
+                                        clds_hash_table_node_release(values[i]);
+                                    }
+                                }
+                            }
+                            /* Codes_SRS_CLDS_HASH_TABLE_07_260: [ clds_hash_table_restore shall insert the items in the table by calling clds_hash_table_bulk_load with worker_count. ]*/
+                            else if (clds_hash_table_bulk_load(clds_hash_table, clds_hazard_pointers_thread, worker_count, keys, values, record_count, results, NULL) != 0)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_261: [ If clds_hash_table_bulk_load fails or any item could not be inserted for a reason other than its key already being in the table, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+                                LogError("clds_hash_table_bulk_load failed for %" PRIu32 " records", record_count);
+                                result = MU_FAILURE;
+
+                                /* Codes_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+                                for (uint32_t i = 0; i < record_count; i++)
+                                {
+                                    clds_hash_table_node_release(values[i]);
+                                }
+                            }
+                            else
+                            {
+                                uint32_t error_count = 0;
+
+                                for (uint32_t i = 0; i < record_count; i++)
+                                {
+                                    if (results[i] != CLDS_HASH_TABLE_INSERT_OK)
+                                    {
+                                        if (results[i] != CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS)
+                                        {
+                                            error_count++;
+                                        }
+
+                                        /* Codes_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+                                        clds_hash_table_node_release(values[i]);
+                                    }
+                                }
+
+                                if (error_count != 0)
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_07_261: [ If clds_hash_table_bulk_load fails or any item could not be inserted for a reason other than its key already being in the table, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+                                    LogError("%" PRIu32 " of the %" PRIu32 " records could not be inserted", error_count, record_count);
+                                    result = MU_FAILURE;
                                 }
                                 else
                                 {
-                                    result_index += retrieved_item_count;
-                                    temp_item_count -= retrieved_item_count;
+                                    result = 0;
                                 }
                             }
-                        }
 
-                        if (i < bucket_count)
-                        {
-                            break;
+                            if (worker_threads != NULL)
+                            {
+                                free(worker_threads);
+                            }
                         }
-                    }
-
-                    current_bucket_array = next_bucket_array;
-                }
 
-                if (current_bucket_array != NULL)
-                {
-                    if (is_cancelled)
-                    {
-                        result = CLDS_HASH_TABLE_SNAPSHOT_ABANDONED;
-                    }
-                    else
-                    {
-                        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                        free(results);
                     }
 
-                    for (uint64_t i = 0; i < result_index; i++)
-                    {
-                        clds_sorted_list_node_release(items_to_return[i]);
-                    }
-                    free(items_to_return);
+                    free(values);
                 }
-                else
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-                    *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
-                    items_to_return = NULL;
-
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-                    *item_count = result_index;
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-                    result = CLDS_HASH_TABLE_SNAPSHOT_OK;
-                }
+                free(keys);
             }
         }
 
-        internal_unlock_writes(clds_hash_table);
+        if (result == 0)
+        {
+            if (clds_hash_table->sequence_number != NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_263: [ If the hash table has a start sequence number, clds_hash_table_restore shall set it to the sequence number of the image, or back to the sequence number the table had before the load if that one is higher. ]*/
+                // set rather than moved forward, moving forward would keep the record_count sequence numbers the load used
+                (void)interlocked_exchange_64(clds_hash_table->sequence_number, (sequence_number_before_load > header->sequence_number) ? sequence_number_before_load : header->sequence_number);
+            }
+
+            if (sequence_number != NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_07_264: [ If sequence_number is not NULL, clds_hash_table_restore shall store the sequence number of the image in it. ]*/
+                *sequence_number = header->sequence_number;
+            }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_07_265: [ On success clds_hash_table_restore shall return 0. ]*/
+        }
     }
 
     return result;
@@ -1266,6 +5164,7 @@ CLDS_HASH_TABLE_ITEM* clds_hash_table_node_create(size_t node_size, HASH_TABLE_I
         HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
         hash_table_item->item_cleanup_callback = item_cleanup_callback;
         hash_table_item->item_cleanup_callback_context = item_cleanup_callback_context;
+        (void)interlocked_exchange_64(&hash_table_item->snapshot_epoch, 0);
         item->item.item_cleanup_callback = sorted_list_item_cleanup;
         item->item.item_cleanup_callback_context = (void*)item;
         (void)interlocked_exchange(&item->item.ref_count, 1);
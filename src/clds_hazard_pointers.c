@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "c_logging/logger.h"
 
@@ -22,17 +23,40 @@
 
 #include "c_util/worker_thread.h"
 
-#include "clds/clds_st_hash_set.h"
 #include "clds/inactive_hp_thread_queue.h"
 
 #include "clds/clds_hazard_pointers.h"
 
+MU_DEFINE_ENUM_STRINGS(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_VALUES);
+
 #define DEFAULT_RECLAIM_THRESHOLD 1
 
 #define INITIAL_INACTIVE_THREADS_QUEUE_SIZE 16
 // Let's have a decent number, if we have 16K inactive threads we'd have issues iterating over them anyway
 #define MAX_INACTIVE_THREADS_QUEUE_SIZE 16384
 
+// Number of hazard pointer records each thread has inline (the sorted list holds at most a handful at a time)
+// Acquiring beyond this falls back to the allocated overflow list
+#define HAZARD_POINTER_SLOT_COUNT 8
+#define ALL_HAZARD_POINTER_SLOTS_FREE ((uint32_t)((1U << HAZARD_POINTER_SLOT_COUNT) - 1))
+
+// Announced by a thread that is not inside an epoch critical section
+#define EPOCH_QUIESCENT -1
+
+// Maximum number of nodes handed to a RECLAIM_BATCH_FUNC in one call
+#define RECLAIM_BATCH_SIZE 64
+
+// Initial number of hazard pointers the per-thread scan buffer can hold, it doubles whenever a reclaim cycle needs more
+#define INITIAL_SCAN_BUFFER_SIZE 64
+
+// Maximum number of reclaim list entries a thread keeps in its pool, and also the most that are parked in the shared pool of the instance
+#define RECLAIM_LIST_ENTRY_POOL_SIZE 256
+
+// Async reclaim: minimum number of retired nodes a thread holds before handing its reclaim list off and scheduling the worker
+#define ASYNC_RECLAIM_HAND_OFF_THRESHOLD 64
+
+#define CACHE_LINE_SIZE 64
+
 typedef struct CLDS_HAZARD_POINTER_RECORD_TAG
 {
     void* volatile_atomic node;
@@ -43,24 +67,70 @@ typedef struct CLDS_RECLAIM_LIST_ENTRY_TAG
 {
     struct CLDS_RECLAIM_LIST_ENTRY_TAG* next;
     void* node;
+    // exactly one of reclaim and reclaim_batch is set
     RECLAIM_FUNC reclaim;
+    RECLAIM_BATCH_FUNC reclaim_batch;
+    // reclamation epoch at the time the node was retired (only used in epoch mode)
+    int64_t retire_epoch;
 } CLDS_RECLAIM_LIST_ENTRY;
 
 typedef struct CLDS_HAZARD_POINTERS_THREAD_TAG
 {
+    // The fixed slots are written by the owning thread on every acquire/release and read by every reclaim scan, so they are one contiguous block
+    // with a cache line of padding on each side: the thread data comes from malloc, which does not align it to a cache line, and the padding keeps
+    // the slots off the cache lines of the neighbouring allocation and of the fields below, which other threads write
+    uint8_t slots_leading_padding[CACHE_LINE_SIZE];
+    CLDS_HAZARD_POINTER_RECORD slots[HAZARD_POINTER_SLOT_COUNT];
+    uint8_t slots_trailing_padding[CACHE_LINE_SIZE];
+    // Bit i set means slots[i] is free, only ever touched by the owning thread
+    uint32_t free_slot_mask;
     struct CLDS_HAZARD_POINTERS_THREAD_TAG* volatile_atomic next;
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
     CLDS_HAZARD_POINTER_RECORD* free_pointers;
     CLDS_HAZARD_POINTER_RECORD* volatile_atomic pointers;
     CLDS_RECLAIM_LIST_ENTRY* reclaim_list;
+    // Entries of nodes reclaimed by this thread, reused by the next retires so that retiring does not allocate in the steady state
+    CLDS_RECLAIM_LIST_ENTRY* free_reclaim_list_entries;
+    size_t free_reclaim_list_entry_count;
+    // Entries reclaimed by the current reclaim cycle that did not fit in the pool, offered to the shared pool of the instance when the cycle ends
+    CLDS_RECLAIM_LIST_ENTRY* spare_reclaim_list_entries;
+    size_t spare_reclaim_list_entry_count;
     volatile_atomic int32_t active;
     size_t reclaim_list_entry_count;
+    // Reclaim cycles run by this thread collect all hazard pointers here, the buffer is kept for the next cycle
+    void** scan_buffer;
+    size_t scan_buffer_size;
+    // Epoch mode: the reclamation epoch observed when entering the current critical section, EPOCH_QUIESCENT when outside of one
+    volatile_atomic int64_t announced_epoch;
+    // Epoch mode: number of acquired and not yet released records, only touched by the owning thread
+    uint32_t epoch_nesting;
+    // Epoch mode: the record handed out by acquire, its only purpose is to be a non-NULL handle
+    CLDS_HAZARD_POINTER_RECORD epoch_record;
+    // Number of hazard pointers seen by the last reclaim cycle of this thread, the adaptive reclaim threshold is derived from it
+    size_t last_scan_hazard_pointer_count;
+    // Nodes found safe to reclaim by the current reclaim cycle that were retired with reclaim_batch_func, handed to it in one call
+    void* reclaim_batch[RECLAIM_BATCH_SIZE];
+    size_t reclaim_batch_count;
+    RECLAIM_BATCH_FUNC reclaim_batch_func;
 } CLDS_HAZARD_POINTERS_THREAD;
 
 typedef struct CLDS_HAZARD_POINTERS_TAG
 {
     WORKER_THREAD_HANDLE hp_thread_cleanup_worker;
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode;
+    // Epoch mode: global reclamation epoch, unrelated to the inactive threads epoch below
+    volatile_atomic int64_t reclamation_epoch;
     size_t reclaim_threshold;
+    // When set in hazard pointer mode, the reclaim threshold of each thread follows the number of hazard pointers, between reclaim_threshold and max_reclaim_threshold
+    // Epoch mode scans no hazard pointers and keeps reclaim_threshold
+    bool adaptive_reclaim_threshold;
+    size_t max_reclaim_threshold;
+    // Nodes retired and not reclaimed yet, incremented by each retire and decremented by each reclaim
+    volatile_atomic int64_t reclaim_backlog;
+    // Async reclaim: thread data the cleanup worker runs its reclaim cycles with, NULL when reclaim cycles run on the retiring thread
+    CLDS_HAZARD_POINTERS_THREAD* volatile_atomic async_reclaim_thread;
+    // Async reclaim: above this reclaim backlog the retiring thread runs the reclaim cycle itself
+    size_t max_reclaim_backlog;
     CLDS_HAZARD_POINTERS_THREAD* volatile_atomic head;
     // This epoch exists in order to make sure that no HP thread information that is still being accessed
     // is actually freed
@@ -75,16 +145,17 @@ typedef struct CLDS_HAZARD_POINTERS_TAG
     // Without this hand-off such entries (and their reclaim callbacks) would be lost when the thread's data is freed.
     // Pushed lock-free with an interlocked CAS; drained by internal_reclaim and by clds_hazard_pointers_destroy.
     CLDS_RECLAIM_LIST_ENTRY* volatile_atomic pending_reclaim_list;
+    // Reclaim list entries that a reclaim cycle had no room for in its own pool (typically the async reclaim worker, which reclaims what other threads retired).
+    // Only ever set when empty and only ever taken whole, so it needs no ABA protection. A thread takes it when its own pool runs dry.
+    CLDS_RECLAIM_LIST_ENTRY* volatile_atomic shared_free_reclaim_list_entries;
 } CLDS_HAZARD_POINTERS;
 
-static uint64_t hp_key_hash(void* key)
-{
-    return (uint64_t)key;
-}
-
-static int hp_key_compare(void* key1, void* key2)
+// qsort comparer for the hazard pointers collected in a reclaim cycle
+static int hp_key_compare(const void* left, const void* right)
 {
     int result;
+    void* key1 = *(void* const*)left;
+    void* key2 = *(void* const*)right;
 
     if (key1 < key2)
     {
@@ -102,6 +173,34 @@ static int hp_key_compare(void* key1, void* key2)
     return result;
 }
 
+// binary search for node in the sorted array of hazard pointers collected in a reclaim cycle
+static bool is_node_protected(void** sorted_hazard_pointers, size_t hazard_pointer_count, void* node)
+{
+    bool result = false;
+    size_t low = 0;
+    size_t high = hazard_pointer_count;
+
+    while (low < high)
+    {
+        size_t middle = low + ((high - low) / 2);
+        if (sorted_hazard_pointers[middle] < node)
+        {
+            low = middle + 1;
+        }
+        else if (sorted_hazard_pointers[middle] > node)
+        {
+            high = middle;
+        }
+        else
+        {
+            result = true;
+            break;
+        }
+    }
+
+    return result;
+}
+
 // adds a hp thread handle to the inactive queue, stamping on it the current epoch number.
 // The epoch number is incremented any time there are no pending reclaim calls
 // we know that once a thread is added to the inactive queue it cannot be scanned by any thread any longer, so it is safe to free it
@@ -123,6 +222,16 @@ static int add_to_inactive_threads(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_point
     return result;
 }
 
+static void free_reclaim_list_entries(CLDS_RECLAIM_LIST_ENTRY* reclaim_list_entry)
+{
+    while (reclaim_list_entry != NULL)
+    {
+        CLDS_RECLAIM_LIST_ENTRY* next_reclaim_list_entry = reclaim_list_entry->next;
+        free(reclaim_list_entry);
+        reclaim_list_entry = next_reclaim_list_entry;
+    }
+}
+
 static void free_thread_data(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
 {
     CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*) & clds_hazard_pointers_thread->pointers, NULL, NULL);
@@ -141,6 +250,14 @@ static void free_thread_data(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_poin
         hazard_ptr = next_hazard_ptr;
     }
 
+    free_reclaim_list_entries(clds_hazard_pointers_thread->free_reclaim_list_entries);
+    free_reclaim_list_entries(clds_hazard_pointers_thread->spare_reclaim_list_entries);
+
+    if (clds_hazard_pointers_thread->scan_buffer != NULL)
+    {
+        free(clds_hazard_pointers_thread->scan_buffer);
+    }
+
     free(clds_hazard_pointers_thread);
 }
 
@@ -165,159 +282,423 @@ static void free_inactive_threads_in_previous_epochs(CLDS_HAZARD_POINTERS_HANDLE
     } while (1);
 }
 
-static void internal_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+// appends a hazard pointer to the scan buffer of the thread running the reclaim cycle
+// the buffer is kept between cycles, so it only gets reallocated when a cycle sees more hazard pointers than ever before
+static int add_hazard_pointer_to_scan_buffer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, size_t* hazard_pointer_count, void* node)
 {
-    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    int result;
 
-    (void)interlocked_increment(&clds_hazard_pointers->pending_reclaim_calls);
+    if (*hazard_pointer_count == clds_hazard_pointers_thread->scan_buffer_size)
+    {
+        size_t new_scan_buffer_size = (clds_hazard_pointers_thread->scan_buffer_size == 0) ? INITIAL_SCAN_BUFFER_SIZE : clds_hazard_pointers_thread->scan_buffer_size * 2;
+        void** new_scan_buffer = malloc_2(new_scan_buffer_size, sizeof(void*));
+        if (new_scan_buffer == NULL)
+        {
+            LogError("malloc_2(new_scan_buffer_size=%zu, sizeof(void*)=%zu) failed", new_scan_buffer_size, sizeof(void*));
+            result = MU_FAILURE;
+            goto all_ok;
+        }
+
+        if (clds_hazard_pointers_thread->scan_buffer != NULL)
+        {
+            (void)memcpy(new_scan_buffer, clds_hazard_pointers_thread->scan_buffer, *hazard_pointer_count * sizeof(void*));
+            free(clds_hazard_pointers_thread->scan_buffer);
+        }
+
+        clds_hazard_pointers_thread->scan_buffer = new_scan_buffer;
+        clds_hazard_pointers_thread->scan_buffer_size = new_scan_buffer_size;
+    }
 
-    CLDS_ST_HASH_SET_HANDLE all_hps_set = clds_st_hash_set_create(hp_key_hash, hp_key_compare, clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_threshold);
-    if (all_hps_set == NULL)
+    clds_hazard_pointers_thread->scan_buffer[*hazard_pointer_count] = node;
+    (*hazard_pointer_count)++;
+    result = 0;
+
+all_ok:
+    return result;
+}
+
+static void release_reclaim_list_entry(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_RECLAIM_LIST_ENTRY* reclaim_list_entry)
+{
+    // only the owning thread touches the pool and the spare entries
+    if (clds_hazard_pointers_thread->free_reclaim_list_entry_count < RECLAIM_LIST_ENTRY_POOL_SIZE)
     {
-        // oops, panic now!
-        LogError("Cannot allocate hazard pointers hash set");
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_024: [ A reclaim cycle shall keep the reclaim list entries of the reclaimed nodes in the pool of the reclaiming thread, as long as the pool holds less than 256 entries. ]*/
+        reclaim_list_entry->next = clds_hazard_pointers_thread->free_reclaim_list_entries;
+        clds_hazard_pointers_thread->free_reclaim_list_entries = reclaim_list_entry;
+        clds_hazard_pointers_thread->free_reclaim_list_entry_count++;
+    }
+    else if (clds_hazard_pointers_thread->spare_reclaim_list_entry_count < RECLAIM_LIST_ENTRY_POOL_SIZE)
+    {
+        reclaim_list_entry->next = clds_hazard_pointers_thread->spare_reclaim_list_entries;
+        clds_hazard_pointers_thread->spare_reclaim_list_entries = reclaim_list_entry;
+        clds_hazard_pointers_thread->spare_reclaim_list_entry_count++;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_043: [ A reclaim cycle shall free the reclaim list entries that fit neither in the pool of the reclaiming thread nor in the shared pool of the instance. ]*/
+        free(reclaim_list_entry);
+    }
+}
+
+// offers the entries the cycle had no room for to the other threads, at most one pool worth of entries is parked there at any time
+static void release_spare_reclaim_list_entries(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_RECLAIM_LIST_ENTRY* spare_reclaim_list_entries = clds_hazard_pointers_thread->spare_reclaim_list_entries;
+    if (spare_reclaim_list_entries != NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_042: [ When a reclaim cycle ends, the reclaim list entries that did not fit in the pool of the reclaiming thread shall be moved to the shared pool of the instance if that is empty. ]*/
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->clds_hazard_pointers->shared_free_reclaim_list_entries, spare_reclaim_list_entries, NULL) != NULL)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_043: [ A reclaim cycle shall free the reclaim list entries that fit neither in the pool of the reclaiming thread nor in the shared pool of the instance. ]*/
+            // nobody took the previous ones yet, so these are not needed either
+            free_reclaim_list_entries(spare_reclaim_list_entries);
+        }
+
+        clds_hazard_pointers_thread->spare_reclaim_list_entries = NULL;
+        clds_hazard_pointers_thread->spare_reclaim_list_entry_count = 0;
+    }
+}
+
+static void flush_reclaim_batch(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    if (clds_hazard_pointers_thread->reclaim_batch_count > 0)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_029: [ A reclaim cycle shall call the reclaim_batch_func of the nodes that are safe to reclaim with an array of such nodes rather than once per node. ]*/
+        clds_hazard_pointers_thread->reclaim_batch_func(clds_hazard_pointers_thread->reclaim_batch, clds_hazard_pointers_thread->reclaim_batch_count);
+        clds_hazard_pointers_thread->reclaim_batch_count = 0;
+    }
+}
+
+static void reclaim_node(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_RECLAIM_LIST_ENTRY* reclaim_list_entry)
+{
+    /*Codes_SRS_CLDS_HAZARD_POINTERS_07_041: [ A reclaim cycle shall decrement the reclaim backlog of the instance for each node it reclaims. ]*/
+    (void)interlocked_decrement_64(&clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_backlog);
+
+    if (reclaim_list_entry->reclaim_batch == NULL)
+    {
+        reclaim_list_entry->reclaim(reclaim_list_entry->node);
     }
     else
     {
-        // go through all hazard pointers of all threads, no thread should be able to get a hazard pointer after this point
-        CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
-        while (current_thread != NULL)
+        // nodes of one container are usually retired back to back, so batching consecutive nodes with the same function is enough
+        if ((clds_hazard_pointers_thread->reclaim_batch_count == RECLAIM_BATCH_SIZE) ||
+            ((clds_hazard_pointers_thread->reclaim_batch_count > 0) && (clds_hazard_pointers_thread->reclaim_batch_func != reclaim_list_entry->reclaim_batch)))
         {
-            CLDS_HAZARD_POINTERS_THREAD_HANDLE next_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
-            if (interlocked_add(&current_thread->active, 0) == 1)
+            flush_reclaim_batch(clds_hazard_pointers_thread);
+        }
+
+        clds_hazard_pointers_thread->reclaim_batch_func = reclaim_list_entry->reclaim_batch;
+        clds_hazard_pointers_thread->reclaim_batch[clds_hazard_pointers_thread->reclaim_batch_count] = reclaim_list_entry->node;
+        clds_hazard_pointers_thread->reclaim_batch_count++;
+    }
+}
+
+static void reclaim_with_hazard_pointers(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    size_t hazard_pointer_count = 0;
+
+    // go through all hazard pointers of all threads, no thread should be able to get a hazard pointer after this point
+    /*Codes_SRS_CLDS_HAZARD_POINTERS_07_006: [ A reclaim cycle shall collect the hazard pointers of all threads in a scan buffer owned by the reclaiming thread, which is kept for the following reclaim cycles. ]*/
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+    while (current_thread != NULL)
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE next_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
+        if (interlocked_add(&current_thread->active, 0) == 1)
+        {
+            // look at the pointers of this thread
+            // if it gets unregistered in the meanwhile we won't care
+            // if it gets registered again we also don't care as for sure it does not have our hazard pointer anymore
+            // the fixed slots are scanned first, as one contiguous array
+            uint32_t i;
+            for (i = 0; i < HAZARD_POINTER_SLOT_COUNT; i++)
             {
-                // look at the pointers of this thread
-                // if it gets unregistered in the meanwhile we won't care
-                // if it gets registered again we also don't care as for sure it does not have our hazard pointer anymore
-                CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->pointers, NULL, NULL);
-                while (clds_hazard_pointer != NULL)
+                void* node = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->slots[i].node, NULL, NULL);
+                if ((node != NULL) &&
+                    (add_hazard_pointer_to_scan_buffer(clds_hazard_pointers_thread, &hazard_pointer_count, node) != 0))
                 {
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->next, NULL, NULL);
-                    void* node = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->node, NULL, NULL);
-                    if (node != NULL)
-                    {
-                        CLDS_ST_HASH_SET_INSERT_RESULT insert_result = clds_st_hash_set_insert(all_hps_set, node);
-                        if ((insert_result == CLDS_ST_HASH_SET_INSERT_OK) ||
-                            (insert_result == CLDS_ST_HASH_SET_INSERT_KEY_ALREADY_EXISTS))
-                        {
-                            // all ok
-                        }
-                        else
-                        {
-                            LogError("Cannot insert hazard pointer in set");
-                            break;
-                        }
-                    }
-
-                    clds_hazard_pointer = next_hazard_pointer;
+                    break;
                 }
+            }
+
+            if (i < HAZARD_POINTER_SLOT_COUNT)
+            {
+                break;
+            }
 
-                if (clds_hazard_pointer != NULL)
+            // then the overflow list
+            CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->pointers, NULL, NULL);
+            while (clds_hazard_pointer != NULL)
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->next, NULL, NULL);
+                void* node = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->node, NULL, NULL);
+                if ((node != NULL) &&
+                    (add_hazard_pointer_to_scan_buffer(clds_hazard_pointers_thread, &hazard_pointer_count, node) != 0))
                 {
                     break;
                 }
+
+                clds_hazard_pointer = next_hazard_pointer;
             }
 
-            current_thread = next_thread;
+            if (clds_hazard_pointer != NULL)
+            {
+                break;
+            }
         }
 
-        if (current_thread != NULL)
+        current_thread = next_thread;
+    }
+
+    if (current_thread != NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_007: [ If the scan buffer cannot be grown, the reclaim cycle shall not reclaim any node. ]*/
+        LogError("Error collecting hazard pointers");
+    }
+    else
+    {
+        clds_hazard_pointers_thread->last_scan_hazard_pointer_count = hazard_pointer_count;
+
+        // sort once, then each retired node is a binary search
+        void** sorted_hazard_pointers = clds_hazard_pointers_thread->scan_buffer;
+        if (hazard_pointer_count > 1)
         {
-            LogError("Error collecting hazard pointers");
+            qsort(sorted_hazard_pointers, hazard_pointer_count, sizeof(void*), hp_key_compare);
         }
-        else
+
+        // go through all pointers in the reclaim list
+        CLDS_RECLAIM_LIST_ENTRY* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
+        CLDS_RECLAIM_LIST_ENTRY* prev_reclaim_entry = NULL;
+        while (current_reclaim_entry != NULL)
         {
-            // go through all pointers in the reclaim list
-            CLDS_RECLAIM_LIST_ENTRY* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
-            CLDS_RECLAIM_LIST_ENTRY* prev_reclaim_entry = NULL;
-            while (current_reclaim_entry != NULL)
+            // this is the scan for the pointers
+            if (!is_node_protected(sorted_hazard_pointers, hazard_pointer_count, current_reclaim_entry->node))
             {
-                // this is the scan for the pointers
-                CLDS_ST_HASH_SET_FIND_RESULT find_result = clds_st_hash_set_find(all_hps_set, current_reclaim_entry->node);
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_01_020: [ If no thread has acquired a hazard pointer for node, reclaim_func shall be called for node to reclaim it. ]*/
+                // node is safe to be reclaimed
+                reclaim_node(clds_hazard_pointers_thread, current_reclaim_entry);
 
-                if (find_result == CLDS_ST_HASH_SET_FIND_ERROR)
+                // now remove it from the reclaim list
+                if (prev_reclaim_entry == NULL)
                 {
-                    LogError("Error finding pointer");
-                    break;
+                    // this is the head of the reclaim list
+                    clds_hazard_pointers_thread->reclaim_list = current_reclaim_entry->next;
+                    release_reclaim_list_entry(clds_hazard_pointers_thread, current_reclaim_entry);
+                    current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
                 }
-                else if (find_result == CLDS_ST_HASH_SET_FIND_NOT_FOUND)
+                else
                 {
-                    /*Codes_SRS_CLDS_HAZARD_POINTERS_01_020: [ If no thread has acquired a hazard pointer for node, reclaim_func shall be called for node to reclaim it. ]*/
-                    // node is safe to be reclaimed
-                    current_reclaim_entry->reclaim(current_reclaim_entry->node);
+                    prev_reclaim_entry->next = current_reclaim_entry->next;
+                    release_reclaim_list_entry(clds_hazard_pointers_thread, current_reclaim_entry);
+                    current_reclaim_entry = prev_reclaim_entry->next;
+                }
 
-                    // now remove it from the reclaim list
-                    if (prev_reclaim_entry == NULL)
-                    {
-                        // this is the head of the reclaim list
-                        clds_hazard_pointers_thread->reclaim_list = current_reclaim_entry->next;
-                        free(current_reclaim_entry);
-                        current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
-                    }
-                    else
-                    {
-                        prev_reclaim_entry->next = current_reclaim_entry->next;
-                        free(current_reclaim_entry);
-                        current_reclaim_entry = prev_reclaim_entry->next;
-                    }
+                clds_hazard_pointers_thread->reclaim_list_entry_count--;
+            }
+            else
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_01_019: [ If any other thread has acquired a hazard pointer for node, the reclaim_func shall not be called for node. ]*/
+                // not safe, sorry, shall still have it around, move to next reclaim entry
+                prev_reclaim_entry = current_reclaim_entry;
+                current_reclaim_entry = current_reclaim_entry->next;
+            }
+        }
 
-                    clds_hazard_pointers_thread->reclaim_list_entry_count--;
-                }
-                else
+        // Sweep the global pending reclaim list (entries handed off by threads that unregistered while their retired node was still protected by another thread).
+        // Detach the whole list atomically, reclaim every entry whose node is no longer held and re-push the ones that are still protected.
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_42_002: [ When a reclaim cycle is triggered, it shall also reclaim each entry on the global pending reclaim list whose node is no longer protected by any hazard pointer and re-park the rest. ]*/
+        CLDS_RECLAIM_LIST_ENTRY* pending_entry = interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL);
+        CLDS_RECLAIM_LIST_ENTRY* still_held_first = NULL;
+        CLDS_RECLAIM_LIST_ENTRY* still_held_last = NULL;
+        while (pending_entry != NULL)
+        {
+            CLDS_RECLAIM_LIST_ENTRY* next_pending_entry = pending_entry->next;
+
+            if (!is_node_protected(sorted_hazard_pointers, hazard_pointer_count, pending_entry->node))
+            {
+                // node is no longer protected, reclaim it
+                reclaim_node(clds_hazard_pointers_thread, pending_entry);
+                release_reclaim_list_entry(clds_hazard_pointers_thread, pending_entry);
+            }
+            else
+            {
+                // still protected: keep it for a later reclaim cycle
+                pending_entry->next = still_held_first;
+                still_held_first = pending_entry;
+                if (still_held_last == NULL)
                 {
-                    /*Codes_SRS_CLDS_HAZARD_POINTERS_01_019: [ If any other thread has acquired a hazard pointer for node, the reclaim_func shall not be called for node. ]*/
-                    // not safe, sorry, shall still have it around, move to next reclaim entry
-                    prev_reclaim_entry = current_reclaim_entry;
-                    current_reclaim_entry = current_reclaim_entry->next;
+                    still_held_last = pending_entry;
                 }
             }
 
-            // Sweep the global pending reclaim list (entries handed off by threads that unregistered while their retired node was still protected by another thread).
-            // Detach the whole list atomically, reclaim every entry whose node is no longer held and re-push the ones that are still protected.
-            /*Codes_SRS_CLDS_HAZARD_POINTERS_42_002: [ When a reclaim cycle is triggered, it shall also reclaim each entry on the global pending reclaim list whose node is no longer protected by any hazard pointer and re-park the rest. ]*/
-            CLDS_RECLAIM_LIST_ENTRY* pending_entry = interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL);
-            CLDS_RECLAIM_LIST_ENTRY* still_held_first = NULL;
-            CLDS_RECLAIM_LIST_ENTRY* still_held_last = NULL;
-            while (pending_entry != NULL)
+            pending_entry = next_pending_entry;
+        }
+
+        if (still_held_first != NULL)
+        {
+            // re-push the still-held chain onto the global pending list
+            CLDS_RECLAIM_LIST_ENTRY* current_pending_head;
+            do
             {
-                CLDS_RECLAIM_LIST_ENTRY* next_pending_entry = pending_entry->next;
+                current_pending_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL, NULL);
+                still_held_last->next = current_pending_head;
+            } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, still_held_first, current_pending_head) != current_pending_head);
+        }
+    }
+}
 
-                CLDS_ST_HASH_SET_FIND_RESULT pending_find_result = clds_st_hash_set_find(all_hps_set, pending_entry->node);
-                if (pending_find_result == CLDS_ST_HASH_SET_FIND_NOT_FOUND)
-                {
-                    // node is no longer protected, reclaim it
-                    pending_entry->reclaim(pending_entry->node);
-                    free(pending_entry);
-                }
-                else
-                {
-                    // still protected (or a lookup error): keep it for a later reclaim cycle
-                    pending_entry->next = still_held_first;
-                    still_held_first = pending_entry;
-                    if (still_held_last == NULL)
-                    {
-                        still_held_last = pending_entry;
-                    }
-                }
+// moves the reclamation epoch forward by one if every thread that is inside a critical section has already observed the current epoch
+static int64_t try_advance_reclamation_epoch(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+{
+    int64_t current_reclamation_epoch = interlocked_add_64(&clds_hazard_pointers->reclamation_epoch, 0);
 
-                pending_entry = next_pending_entry;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+    while (current_thread != NULL)
+    {
+        if (interlocked_add(&current_thread->active, 0) == 1)
+        {
+            int64_t announced_epoch = interlocked_add_64(&current_thread->announced_epoch, 0);
+            if ((announced_epoch != EPOCH_QUIESCENT) &&
+                (announced_epoch != current_reclamation_epoch))
+            {
+                // this thread is still in a critical section that started in an older epoch
+                break;
             }
+        }
 
-            if (still_held_first != NULL)
+        current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
+    }
+
+    if (current_thread == NULL)
+    {
+        // if someone else advanced it in the meanwhile that is just as good
+        (void)interlocked_compare_exchange_64(&clds_hazard_pointers->reclamation_epoch, current_reclamation_epoch + 1, current_reclamation_epoch);
+    }
+
+    return interlocked_add_64(&clds_hazard_pointers->reclamation_epoch, 0);
+}
+
+static void reclaim_with_epochs(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+
+    // A thread in a critical section announces the epoch it observed when entering, and the epoch can only advance once all such threads observed it.
+    // So while a thread that could still see a node retired in epoch E is in its critical section, the epoch cannot get past E + 1.
+    int64_t current_reclamation_epoch = try_advance_reclamation_epoch(clds_hazard_pointers);
+
+    CLDS_RECLAIM_LIST_ENTRY* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
+    CLDS_RECLAIM_LIST_ENTRY* prev_reclaim_entry = NULL;
+    while (current_reclaim_entry != NULL)
+    {
+        if (current_reclaim_entry->retire_epoch + 2 <= current_reclamation_epoch)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_011: [ In epoch mode, a reclaim cycle shall call reclaim_func for each retired node once the reclamation epoch has advanced at least twice since the node was retired. ]*/
+            reclaim_node(clds_hazard_pointers_thread, current_reclaim_entry);
+
+            if (prev_reclaim_entry == NULL)
             {
-                // re-push the still-held chain onto the global pending list
-                CLDS_RECLAIM_LIST_ENTRY* current_pending_head;
-                do
-                {
-                    current_pending_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL, NULL);
-                    still_held_last->next = current_pending_head;
-                } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, still_held_first, current_pending_head) != current_pending_head);
+                clds_hazard_pointers_thread->reclaim_list = current_reclaim_entry->next;
+                release_reclaim_list_entry(clds_hazard_pointers_thread, current_reclaim_entry);
+                current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
             }
+            else
+            {
+                prev_reclaim_entry->next = current_reclaim_entry->next;
+                release_reclaim_list_entry(clds_hazard_pointers_thread, current_reclaim_entry);
+                current_reclaim_entry = prev_reclaim_entry->next;
+            }
+
+            clds_hazard_pointers_thread->reclaim_list_entry_count--;
         }
+        else
+        {
+            // a thread could still be looking at it
+            prev_reclaim_entry = current_reclaim_entry;
+            current_reclaim_entry = current_reclaim_entry->next;
+        }
+    }
 
-        clds_st_hash_set_destroy(all_hps_set);
+    // same sweep of the global pending reclaim list as for hazard pointers, but by retire epoch
+    CLDS_RECLAIM_LIST_ENTRY* pending_entry = interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL);
+    CLDS_RECLAIM_LIST_ENTRY* still_held_first = NULL;
+    CLDS_RECLAIM_LIST_ENTRY* still_held_last = NULL;
+    while (pending_entry != NULL)
+    {
+        CLDS_RECLAIM_LIST_ENTRY* next_pending_entry = pending_entry->next;
+
+        if (pending_entry->retire_epoch + 2 <= current_reclamation_epoch)
+        {
+            reclaim_node(clds_hazard_pointers_thread, pending_entry);
+            release_reclaim_list_entry(clds_hazard_pointers_thread, pending_entry);
+        }
+        else
+        {
+            pending_entry->next = still_held_first;
+            still_held_first = pending_entry;
+            if (still_held_last == NULL)
+            {
+                still_held_last = pending_entry;
+            }
+        }
+
+        pending_entry = next_pending_entry;
+    }
+
+    if (still_held_first != NULL)
+    {
+        CLDS_RECLAIM_LIST_ENTRY* current_pending_head;
+        do
+        {
+            current_pending_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL, NULL);
+            still_held_last->next = current_pending_head;
+        } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, still_held_first, current_pending_head) != current_pending_head);
+    }
+}
+
+// moves the whole reclaim list of the thread to the global pending reclaim list, where the next reclaim cycle of any thread picks it up
+static void hand_off_reclaim_list(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    CLDS_RECLAIM_LIST_ENTRY* first_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
+    if (first_reclaim_entry != NULL)
+    {
+        CLDS_RECLAIM_LIST_ENTRY* last_reclaim_entry = first_reclaim_entry;
+        while (last_reclaim_entry->next != NULL)
+        {
+            last_reclaim_entry = last_reclaim_entry->next;
+        }
+
+        CLDS_RECLAIM_LIST_ENTRY* current_pending_head;
+        do
+        {
+            current_pending_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL, NULL);
+            last_reclaim_entry->next = current_pending_head;
+        } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, first_reclaim_entry, current_pending_head) != current_pending_head);
+
+        clds_hazard_pointers_thread->reclaim_list = NULL;
+        clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
+    }
+}
+
+static void internal_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+
+    // both engines walk the thread list, so both are covered by the inactive threads epoch
+    (void)interlocked_increment(&clds_hazard_pointers->pending_reclaim_calls);
+
+    if (clds_hazard_pointers->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH)
+    {
+        reclaim_with_epochs(clds_hazard_pointers_thread);
+    }
+    else
+    {
+        reclaim_with_hazard_pointers(clds_hazard_pointers_thread);
     }
 
+    flush_reclaim_batch(clds_hazard_pointers_thread);
+    release_spare_reclaim_list_entries(clds_hazard_pointers_thread);
+
     int64_t current_epoch = interlocked_add_64(&clds_hazard_pointers->epoch, 0);
     if (interlocked_decrement(&clds_hazard_pointers->pending_reclaim_calls) == 0)
     {
@@ -389,13 +770,40 @@ static void hp_thread_cleanup_func(void* context)
             }
         }
     }
+
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE async_reclaim_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->async_reclaim_thread, NULL, NULL);
+    if (async_reclaim_thread != NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_038: [ When async reclaim is enabled, the worker of the instance shall run a reclaim cycle that reclaims the nodes handed off by the retiring threads. ]*/
+        // this thread data has an empty reclaim list, the cycle only sweeps the global pending reclaim list
+        internal_reclaim(async_reclaim_thread);
+    }
 }
 
 CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create(void)
+{
+    /*Codes_SRS_CLDS_HAZARD_POINTERS_07_008: [ clds_hazard_pointers_create shall create an instance that uses hazard pointers for reclamation. ]*/
+    return clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+}
+
+CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode)
 {
     CLDS_HAZARD_POINTERS_HANDLE result;
 
+    if (
+        (reclamation_mode != CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS) &&
+        (reclamation_mode != CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH)
+        )
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_009: [ If reclamation_mode is not a valid CLDS_HAZARD_POINTERS_RECLAMATION_MODE value, clds_hazard_pointers_create_with_reclamation_mode shall fail and return NULL. ]*/
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode=%" PRI_MU_ENUM "",
+            MU_ENUM_VALUE(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, reclamation_mode));
+        result = NULL;
+        goto all_ok;
+    }
+
     /*Codes_SRS_CLDS_HAZARD_POINTERS_01_001: [ clds_hazard_pointers_create shall create a new hazard pointers instance and on success return a non-NULL handle to it. ]*/
+    /*Codes_SRS_CLDS_HAZARD_POINTERS_07_010: [ clds_hazard_pointers_create_with_reclamation_mode shall create a new instance that uses the engine selected by reclamation_mode and on success return a non-NULL handle to it. ]*/
     result = malloc(sizeof(CLDS_HAZARD_POINTERS));
     if (result == NULL)
     {
@@ -429,8 +837,16 @@ CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create(void)
                 {
                     TQUEUE_INITIALIZE_MOVE(CLDS_HP_INACTIVE_THREAD)(&result->inactive_threads, &inactive_threads);
                     result->reclaim_threshold = DEFAULT_RECLAIM_THRESHOLD;
+                    result->adaptive_reclaim_threshold = false;
+                    result->max_reclaim_threshold = DEFAULT_RECLAIM_THRESHOLD;
+                    (void)interlocked_exchange_64(&result->reclaim_backlog, 0);
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&result->async_reclaim_thread, NULL);
+                    result->max_reclaim_backlog = 0;
+                    result->reclamation_mode = reclamation_mode;
+                    (void)interlocked_exchange_64(&result->reclamation_epoch, 0);
                     (void)interlocked_exchange_pointer((void* volatile_atomic*) & result->head, NULL);
                     (void)interlocked_exchange_pointer((void* volatile_atomic*) & result->pending_reclaim_list, NULL);
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&result->shared_free_reclaim_list_entries, NULL);
                     (void)interlocked_exchange_64(&result->epoch, 0);
                     (void)interlocked_exchange(&result->pending_reclaim_calls, 0);
 
@@ -465,6 +881,12 @@ void clds_hazard_pointers_destroy(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointe
 
         worker_thread_destroy(clds_hazard_pointers->hp_thread_cleanup_worker);
 
+        if (clds_hazard_pointers->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH)
+        {
+            // nobody can be in a critical section anymore, so every node retired so far can go
+            (void)interlocked_add_64(&clds_hazard_pointers->reclamation_epoch, 2);
+        }
+
         CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
         while (clds_hazard_pointers_thread != NULL)
         {
@@ -489,7 +911,14 @@ void clds_hazard_pointers_destroy(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointe
         while (pending_entry != NULL)
         {
             CLDS_RECLAIM_LIST_ENTRY* next_pending_entry = pending_entry->next;
-            pending_entry->reclaim(pending_entry->node);
+            if (pending_entry->reclaim_batch == NULL)
+            {
+                pending_entry->reclaim(pending_entry->node);
+            }
+            else
+            {
+                pending_entry->reclaim_batch(&pending_entry->node, 1);
+            }
             free(pending_entry);
             pending_entry = next_pending_entry;
         }
@@ -497,6 +926,7 @@ void clds_hazard_pointers_destroy(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointe
         // free all inactive threads
         free_inactive_threads_in_previous_epochs(clds_hazard_pointers, INT64_MAX);
         TQUEUE_ASSIGN(CLDS_HP_INACTIVE_THREAD)(&clds_hazard_pointers->inactive_threads, NULL);
+        free_reclaim_list_entries(interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->shared_free_reclaim_list_entries, NULL));
         free(clds_hazard_pointers);
     }
 }
@@ -525,6 +955,26 @@ CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_register_thread(CLDS_HAZ
             bool restart_needed;
 
             clds_hazard_pointers_thread->clds_hazard_pointers = clds_hazard_pointers;
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_001: [ clds_hazard_pointers_register_thread shall initialize a fixed number of inline hazard pointer slots for the thread, all free. ]*/
+            for (uint32_t i = 0; i < HAZARD_POINTER_SLOT_COUNT; i++)
+            {
+                (void)interlocked_exchange_pointer(&clds_hazard_pointers_thread->slots[i].node, NULL);
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->slots[i].next, NULL);
+            }
+            clds_hazard_pointers_thread->free_slot_mask = ALL_HAZARD_POINTER_SLOTS_FREE;
+            clds_hazard_pointers_thread->free_reclaim_list_entries = NULL;
+            clds_hazard_pointers_thread->free_reclaim_list_entry_count = 0;
+            clds_hazard_pointers_thread->spare_reclaim_list_entries = NULL;
+            clds_hazard_pointers_thread->spare_reclaim_list_entry_count = 0;
+            clds_hazard_pointers_thread->scan_buffer = NULL;
+            clds_hazard_pointers_thread->scan_buffer_size = 0;
+            clds_hazard_pointers_thread->reclaim_batch_count = 0;
+            clds_hazard_pointers_thread->reclaim_batch_func = NULL;
+            clds_hazard_pointers_thread->last_scan_hazard_pointer_count = 0;
+            (void)interlocked_exchange_64(&clds_hazard_pointers_thread->announced_epoch, EPOCH_QUIESCENT);
+            clds_hazard_pointers_thread->epoch_nesting = 0;
+            (void)interlocked_exchange_pointer(&clds_hazard_pointers_thread->epoch_record.node, NULL);
+            (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->epoch_record.next, NULL);
             do
             {
                 CLDS_HAZARD_POINTERS_THREAD_HANDLE current_threads_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
@@ -564,25 +1014,7 @@ void clds_hazard_pointers_unregister_thread(CLDS_HAZARD_POINTERS_THREAD_HANDLE c
 
         /*Codes_SRS_CLDS_HAZARD_POINTERS_42_001: [ clds_hazard_pointers_unregister_thread shall hand off any entries still on the thread's reclaim list to the global pending reclaim list of the hazard pointers instance. ]*/
         // Done before the thread is marked inactive (and thus eligible for cleanup/free) so that nodes retired by this thread but still protected by another thread are not lost.
-        CLDS_RECLAIM_LIST_ENTRY* first_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
-        if (first_reclaim_entry != NULL)
-        {
-            CLDS_RECLAIM_LIST_ENTRY* last_reclaim_entry = first_reclaim_entry;
-            while (last_reclaim_entry->next != NULL)
-            {
-                last_reclaim_entry = last_reclaim_entry->next;
-            }
-
-            CLDS_RECLAIM_LIST_ENTRY* current_pending_head;
-            do
-            {
-                current_pending_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, NULL, NULL);
-                last_reclaim_entry->next = current_pending_head;
-            } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->pending_reclaim_list, first_reclaim_entry, current_pending_head) != current_pending_head);
-
-            clds_hazard_pointers_thread->reclaim_list = NULL;
-            clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
-        }
+        hand_off_reclaim_list(clds_hazard_pointers_thread);
 
         // remove the thread from the thread list
         (void)interlocked_exchange(&clds_hazard_pointers_thread->active, 0);
@@ -596,72 +1028,45 @@ void clds_hazard_pointers_unregister_thread(CLDS_HAZARD_POINTERS_THREAD_HANDLE c
     }
 }
 
-CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointers_acquire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node)
+static CLDS_HAZARD_POINTER_RECORD_HANDLE acquire_overflow_hazard_pointer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node)
 {
     CLDS_HAZARD_POINTER_RECORD_HANDLE result;
+    bool restart_needed;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_ptr;
 
-    if (clds_hazard_pointers_thread == NULL)
-    {
-        /*Codes_SRS_CLDS_HAZARD_POINTERS_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hazard_pointers_acquire shall fail and return NULL. ]*/
-        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* node=%p",
-            clds_hazard_pointers_thread, node);
-        result = NULL;
-    }
-    else
+    // get a hazard pointer for the node from the free list
+    do
     {
-        /*Codes_SRS_CLDS_HAZARD_POINTERS_01_011: [ clds_hazard_pointers_acquire shall acquire a hazard pointer for the given node and on success return a non-NULL handle to the hazard pointer record. ]*/
-        bool restart_needed;
-        CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_ptr;
-
-        // get a hazard pointer for the node from the free list
-        do
+        hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, NULL, NULL);
+        if (hazard_ptr != NULL)
         {
-            hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, NULL, NULL);
-            if (hazard_ptr != NULL)
+            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, hazard_ptr->next, hazard_ptr) != hazard_ptr)
             {
-                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, hazard_ptr->next, hazard_ptr) != hazard_ptr)
-                {
-                    restart_needed = true;
-                }
-                else
-                {
-                    // got it
-                    restart_needed = false;
-                }
+                restart_needed = true;
             }
             else
             {
-                // no free one
+                // got it
                 restart_needed = false;
             }
         }
-        while (restart_needed);
+        else
+        {
+            // no free one
+            restart_needed = false;
+        }
+    }
+    while (restart_needed);
 
+    if (hazard_ptr == NULL)
+    {
+        // no more pointers in free list, create one
+        hazard_ptr = malloc(sizeof(CLDS_HAZARD_POINTER_RECORD));
         if (hazard_ptr == NULL)
         {
-            // no more pointers in free list, create one
-            hazard_ptr = malloc(sizeof(CLDS_HAZARD_POINTER_RECORD));
-            if (hazard_ptr == NULL)
-            {
-                /*Codes_SRS_CLDS_HAZARD_POINTERS_01_013: [ If any error occurs, clds_hazard_pointers_acquire shall fail and return NULL. ]*/
-                LogError("Error allocating hazard pointer");
-                result = NULL;
-            }
-            else
-            {
-                CLDS_HAZARD_POINTER_RECORD* current_list_head;
-
-                // add it to the hazard pointer list
-                current_list_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
-
-                (void)interlocked_exchange_pointer(&hazard_ptr->node, node);
-                hazard_ptr->next = current_list_head;
-
-                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, hazard_ptr);
-
-                // inserted in the used hazard pointer list, we are done
-                result = hazard_ptr;
-            }
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_01_013: [ If any error occurs, clds_hazard_pointers_acquire shall fail and return NULL. ]*/
+            LogError("Error allocating hazard pointer");
+            result = NULL;
         }
         else
         {
@@ -679,6 +1084,112 @@ CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointers_acquire(CLDS_HAZARD_POINT
             result = hazard_ptr;
         }
     }
+    else
+    {
+        CLDS_HAZARD_POINTER_RECORD* current_list_head;
+
+        // add it to the hazard pointer list
+        current_list_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
+
+        (void)interlocked_exchange_pointer(&hazard_ptr->node, node);
+        hazard_ptr->next = current_list_head;
+
+        (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, hazard_ptr);
+
+        // inserted in the used hazard pointer list, we are done
+        result = hazard_ptr;
+    }
+
+    return result;
+}
+
+static void release_overflow_hazard_pointer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record)
+{
+    // remove it from the hazard pointers list for this thread, this thread is the only one removing
+    // so no contention on the list
+    CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hazard_pointer = NULL;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
+
+    (void)interlocked_exchange_pointer(&clds_hazard_pointer_record->node, NULL);
+
+    while (clds_hazard_pointer != NULL)
+    {
+        if (clds_hazard_pointer == clds_hazard_pointer_record)
+        {
+            if (previous_hazard_pointer != NULL)
+            {
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&previous_hazard_pointer->next, clds_hazard_pointer->next);
+            }
+            else
+            {
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, clds_hazard_pointer->next);
+            }
+
+            break;
+        }
+        else
+        {
+            previous_hazard_pointer = clds_hazard_pointer;
+            clds_hazard_pointer = clds_hazard_pointer->next;
+        }
+    }
+
+    // insert it in the free list
+    struct CLDS_HAZARD_POINTER_RECORD_TAG* current_free_pointers = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, NULL, NULL);
+    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer_record->next, current_free_pointers);
+    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, clds_hazard_pointer_record);
+}
+
+CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointers_acquire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node)
+{
+    CLDS_HAZARD_POINTER_RECORD_HANDLE result;
+
+    if (clds_hazard_pointers_thread == NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hazard_pointers_acquire shall fail and return NULL. ]*/
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* node=%p",
+            clds_hazard_pointers_thread, node);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_01_011: [ clds_hazard_pointers_acquire shall acquire a hazard pointer for the given node and on success return a non-NULL handle to the hazard pointer record. ]*/
+        uint32_t free_slot_mask = clds_hazard_pointers_thread->free_slot_mask;
+        if (clds_hazard_pointers_thread->clds_hazard_pointers->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_012: [ In epoch mode, if the thread is not in a critical section, clds_hazard_pointers_acquire shall enter one by announcing the current reclamation epoch. ]*/
+            if (clds_hazard_pointers_thread->epoch_nesting == 0)
+            {
+                // the exchange is a full barrier, so the announcement is visible before the caller re-validates node
+                int64_t current_reclamation_epoch = interlocked_add_64(&clds_hazard_pointers_thread->clds_hazard_pointers->reclamation_epoch, 0);
+                (void)interlocked_exchange_64(&clds_hazard_pointers_thread->announced_epoch, current_reclamation_epoch);
+            }
+
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_013: [ In epoch mode, clds_hazard_pointers_acquire shall count the acquire as nested in the critical section and return the epoch record of the thread. ]*/
+            clds_hazard_pointers_thread->epoch_nesting++;
+            result = &clds_hazard_pointers_thread->epoch_record;
+        }
+        else if (free_slot_mask != 0)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_002: [ If a fixed slot is free, clds_hazard_pointers_acquire shall publish node in that slot without allocating memory. ]*/
+            uint32_t slot_index = 0;
+            while ((free_slot_mask & (1U << slot_index)) == 0)
+            {
+                slot_index++;
+            }
+
+            clds_hazard_pointers_thread->free_slot_mask = free_slot_mask & ~(1U << slot_index);
+
+            // the exchange is a full barrier, so the node is published before the caller re-validates it
+            result = &clds_hazard_pointers_thread->slots[slot_index];
+            (void)interlocked_exchange_pointer(&result->node, node);
+        }
+        else
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_003: [ If all fixed slots are in use, clds_hazard_pointers_acquire shall take a hazard pointer record from the overflow list of the thread, allocating a new one if needed. ]*/
+            result = acquire_overflow_hazard_pointer(clds_hazard_pointers_thread, node);
+        }
+    }
 
     return result;
 }
@@ -694,39 +1205,157 @@ void clds_hazard_pointers_release(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard
     else
     {
         /*Codes_SRS_CLDS_HAZARD_POINTERS_01_014: [ clds_hazard_pointers_release shall release the hazard pointer associated with clds_hazard_pointer_record. ]*/
-        // remove it from the hazard pointers list for this thread, this thread is the only one removing
-        // so no contention on the list
-        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hazard_pointer = NULL;
-        CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
+        uintptr_t record_address = (uintptr_t)clds_hazard_pointer_record;
+        uintptr_t slots_start = (uintptr_t)&clds_hazard_pointers_thread->slots[0];
+        if (clds_hazard_pointer_record == &clds_hazard_pointers_thread->epoch_record)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_014: [ In epoch mode, clds_hazard_pointers_release shall leave the critical section when the last acquired record of the thread is released. ]*/
+            clds_hazard_pointers_thread->epoch_nesting--;
+            if (clds_hazard_pointers_thread->epoch_nesting == 0)
+            {
+                (void)interlocked_exchange_64(&clds_hazard_pointers_thread->announced_epoch, EPOCH_QUIESCENT);
+            }
+        }
+        else if ((record_address >= slots_start) &&
+            (record_address < (uintptr_t)&clds_hazard_pointers_thread->slots[HAZARD_POINTER_SLOT_COUNT]))
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_004: [ If clds_hazard_pointer_record is one of the fixed slots of the thread, clds_hazard_pointers_release shall clear the slot and mark it free. ]*/
+            uint32_t slot_index = (uint32_t)((record_address - slots_start) / sizeof(CLDS_HAZARD_POINTER_RECORD));
+            (void)interlocked_exchange_pointer(&clds_hazard_pointer_record->node, NULL);
+            clds_hazard_pointers_thread->free_slot_mask |= (1U << slot_index);
+        }
+        else
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_005: [ Otherwise clds_hazard_pointers_release shall remove clds_hazard_pointer_record from the overflow list of the thread and keep it for reuse. ]*/
+            release_overflow_hazard_pointer(clds_hazard_pointers_thread, clds_hazard_pointer_record);
+        }
+    }
+}
 
-        (void)interlocked_exchange_pointer(&clds_hazard_pointer_record->node, NULL);
+static size_t get_reclaim_threshold(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    size_t result = clds_hazard_pointers->reclaim_threshold;
 
-        while (clds_hazard_pointer != NULL)
+    if (
+        (clds_hazard_pointers->adaptive_reclaim_threshold) &&
+        (clds_hazard_pointers->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS)
+        )
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_017: [ In hazard pointer mode, clds_hazard_pointers_set_adaptive_reclaim_threshold shall make the reclaim threshold of each thread twice the number of hazard pointers seen by the last reclaim cycle of that thread, but not less than the reclaim threshold set by clds_hazard_pointers_set_reclaim_threshold and not more than max_reclaim_threshold. ]*/
+        // at most last_scan_hazard_pointer_count entries survive a cycle, so each cycle reclaims at least as many nodes as there are hazard pointers to scan
+        size_t scaled_reclaim_threshold = 2 * clds_hazard_pointers_thread->last_scan_hazard_pointer_count;
+        if (scaled_reclaim_threshold > result)
         {
-            if (clds_hazard_pointer == clds_hazard_pointer_record)
+            result = scaled_reclaim_threshold;
+        }
+
+        // keeps the backlog of each thread bounded no matter how many hazard pointers there are
+        if (result > clds_hazard_pointers->max_reclaim_threshold)
+        {
+            result = clds_hazard_pointers->max_reclaim_threshold;
+        }
+    }
+
+    if ((result < ASYNC_RECLAIM_HAND_OFF_THRESHOLD) &&
+        (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->async_reclaim_thread, NULL, NULL) != NULL))
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_039: [ When async reclaim is enabled, the retiring thread shall only hand off its reclaim list once it holds at least 64 retired nodes, even if the reclaim threshold is lower. ]*/
+        // a hand off is a CAS on the global pending reclaim list plus a worker wake up, doing that for every retire costs more than the scan it saves
+        result = ASYNC_RECLAIM_HAND_OFF_THRESHOLD;
+    }
+
+    return result;
+}
+
+static CLDS_RECLAIM_LIST_ENTRY* get_reclaim_list_entry(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_RECLAIM_LIST_ENTRY* result = clds_hazard_pointers_thread->free_reclaim_list_entries;
+
+    if (result == NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_044: [ If the pool of the thread is empty, clds_hazard_pointers_reclaim shall take all the reclaim list entries in the shared pool of the instance into the pool of the thread. ]*/
+        // taking the whole list (rather than popping one entry) is what keeps the shared pool free of ABA
+        result = interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->clds_hazard_pointers->shared_free_reclaim_list_entries, NULL);
+
+        size_t taken_count = 0;
+        for (CLDS_RECLAIM_LIST_ENTRY* taken_entry = result; taken_entry != NULL; taken_entry = taken_entry->next)
+        {
+            taken_count++;
+        }
+        clds_hazard_pointers_thread->free_reclaim_list_entry_count = taken_count;
+    }
+
+    if (result != NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_023: [ clds_hazard_pointers_reclaim shall take the reclaim list entry for node from the pool of the thread and only allocate a new one if the pool is empty. ]*/
+        clds_hazard_pointers_thread->free_reclaim_list_entries = result->next;
+        clds_hazard_pointers_thread->free_reclaim_list_entry_count--;
+    }
+    else
+    {
+        result = malloc(sizeof(CLDS_RECLAIM_LIST_ENTRY));
+    }
+
+    return result;
+}
+
+static void add_to_reclaim_list(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, RECLAIM_FUNC reclaim_func, RECLAIM_BATCH_FUNC reclaim_batch_func)
+{
+    CLDS_RECLAIM_LIST_ENTRY* reclaim_list_entry = get_reclaim_list_entry(clds_hazard_pointers_thread);
+    if (reclaim_list_entry == NULL)
+    {
+        // oops, panic now!
+        LogError("Cannot allocate reclaim list entry");
+    }
+    else
+    {
+        reclaim_list_entry->next = clds_hazard_pointers_thread->reclaim_list;
+        reclaim_list_entry->node = node;
+        reclaim_list_entry->reclaim = reclaim_func;
+        reclaim_list_entry->reclaim_batch = reclaim_batch_func;
+        reclaim_list_entry->retire_epoch = (clds_hazard_pointers_thread->clds_hazard_pointers->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH) ?
+            interlocked_add_64(&clds_hazard_pointers_thread->clds_hazard_pointers->reclamation_epoch, 0) :
+            0;
+
+        // add the pointer to the reclaim list, no other thread has access to this list, so no interlocked needed
+        clds_hazard_pointers_thread->reclaim_list = reclaim_list_entry;
+        clds_hazard_pointers_thread->reclaim_list_entry_count++;
+
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_040: [ clds_hazard_pointers_reclaim shall increment the reclaim backlog of the instance when it adds node to the reclaim list. ]*/
+        (void)interlocked_increment_64(&clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_backlog);
+
+        if (clds_hazard_pointers_thread->reclaim_list_entry_count >= get_reclaim_threshold(clds_hazard_pointers_thread))
+        {
+            CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->async_reclaim_thread, NULL, NULL) == NULL)
             {
-                if (previous_hazard_pointer != NULL)
+                internal_reclaim(clds_hazard_pointers_thread);
+            }
+            else
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_07_035: [ When async reclaim is enabled and the reclaim threshold is reached, the retiring thread shall hand off its reclaim list to the global pending reclaim list and schedule the worker of the instance instead of running a reclaim cycle. ]*/
+                hand_off_reclaim_list(clds_hazard_pointers_thread);
+
+                if (interlocked_add_64(&clds_hazard_pointers->reclaim_backlog, 0) > (int64_t)clds_hazard_pointers->max_reclaim_backlog)
                 {
-                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&previous_hazard_pointer->next, clds_hazard_pointer->next);
+                    /*Codes_SRS_CLDS_HAZARD_POINTERS_07_036: [ If the reclaim backlog is above max_reclaim_backlog after the hand off, the retiring thread shall run the reclaim cycle itself. ]*/
+                    // the worker is not keeping up, push back on the retiring thread
+                    internal_reclaim(clds_hazard_pointers_thread);
                 }
                 else
                 {
-                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, clds_hazard_pointer->next);
+                    WORKER_THREAD_SCHEDULE_PROCESS_RESULT schedule_result = worker_thread_schedule_process(clds_hazard_pointers->hp_thread_cleanup_worker);
+                    if (schedule_result != WORKER_THREAD_SCHEDULE_PROCESS_OK)
+                    {
+                        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_037: [ If scheduling the worker fails, the retiring thread shall run the reclaim cycle itself. ]*/
+                        LogError("worker_thread_schedule_process failed with %" PRI_MU_ENUM "",
+                            MU_ENUM_VALUE(WORKER_THREAD_SCHEDULE_PROCESS_RESULT, schedule_result));
+                        internal_reclaim(clds_hazard_pointers_thread);
+                    }
                 }
-
-                break;
-            }
-            else
-            {
-                previous_hazard_pointer = clds_hazard_pointer;
-                clds_hazard_pointer = clds_hazard_pointer->next;
             }
         }
-
-        // insert it in the free list
-        struct CLDS_HAZARD_POINTER_RECORD_TAG* current_free_pointers = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, NULL, NULL);
-        (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer_record->next, current_free_pointers);
-        (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, clds_hazard_pointer_record);
     }
 }
 
@@ -745,26 +1374,28 @@ void clds_hazard_pointers_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard
     else
     {
         /*Codes_SRS_CLDS_HAZARD_POINTERS_01_016: [ clds_hazard_pointers_reclaim shall add the node to the reclaim list and when the reclaim threshold is reached, it shall trigger a reclaim cycle. ]*/
-        CLDS_RECLAIM_LIST_ENTRY* reclaim_list_entry = malloc(sizeof(CLDS_RECLAIM_LIST_ENTRY));
-        if (reclaim_list_entry == NULL)
-        {
-            // oops, panic now!
-            LogError("Cannot allocate reclaim list entry");
-        }
-        else
-        {
-            reclaim_list_entry->next = clds_hazard_pointers_thread->reclaim_list;
-            reclaim_list_entry->node = node;
-            reclaim_list_entry->reclaim = reclaim_func;
+        add_to_reclaim_list(clds_hazard_pointers_thread, node, reclaim_func, NULL);
+    }
+}
 
-            // add the pointer to the reclaim list, no other thread has access to this list, so no interlocked needed
-            clds_hazard_pointers_thread->reclaim_list = reclaim_list_entry;
-            clds_hazard_pointers_thread->reclaim_list_entry_count++;
-            if (clds_hazard_pointers_thread->reclaim_list_entry_count >= clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_threshold)
-            {
-                internal_reclaim(clds_hazard_pointers_thread);
-            }
-        }
+void clds_hazard_pointers_reclaim_batched(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, RECLAIM_BATCH_FUNC reclaim_batch_func)
+{
+    if (
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_025: [ If clds_hazard_pointers_thread is NULL, clds_hazard_pointers_reclaim_batched shall return. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_026: [ If node is NULL, clds_hazard_pointers_reclaim_batched shall return. ]*/
+        (node == NULL) ||
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_027: [ If reclaim_batch_func is NULL, clds_hazard_pointers_reclaim_batched shall return. ]*/
+        (reclaim_batch_func == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* node=%p, RECLAIM_BATCH_FUNC reclaim_batch_func=%p",
+            clds_hazard_pointers_thread, node, reclaim_batch_func);
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_028: [ clds_hazard_pointers_reclaim_batched shall add the node to the reclaim list and when the reclaim threshold is reached, it shall trigger a reclaim cycle. ]*/
+        add_to_reclaim_list(clds_hazard_pointers_thread, node, NULL, reclaim_batch_func);
     }
 }
 
@@ -793,3 +1424,107 @@ int clds_hazard_pointers_set_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_
 
     return result;
 }
+
+int clds_hazard_pointers_set_adaptive_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t max_reclaim_threshold)
+{
+    int result;
+
+    if (
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_015: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_set_adaptive_reclaim_threshold shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_016: [ If max_reclaim_threshold is 0, clds_hazard_pointers_set_adaptive_reclaim_threshold shall fail and return a non-zero value. ]*/
+        (max_reclaim_threshold == 0)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, max_reclaim_threshold = %zu",
+            clds_hazard_pointers, max_reclaim_threshold);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_017: [ In hazard pointer mode, clds_hazard_pointers_set_adaptive_reclaim_threshold shall make the reclaim threshold of each thread twice the number of hazard pointers seen by the last reclaim cycle of that thread, but not less than the reclaim threshold set by clds_hazard_pointers_set_reclaim_threshold and not more than max_reclaim_threshold. ]*/
+        clds_hazard_pointers->max_reclaim_threshold = max_reclaim_threshold;
+        clds_hazard_pointers->adaptive_reclaim_threshold = true;
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_018: [ On success, clds_hazard_pointers_set_adaptive_reclaim_threshold shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_get_reclaim_backlog(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint64_t* reclaim_backlog)
+{
+    int result;
+
+    if (
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_019: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_get_reclaim_backlog shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_020: [ If reclaim_backlog is NULL, clds_hazard_pointers_get_reclaim_backlog shall fail and return a non-zero value. ]*/
+        (reclaim_backlog == NULL)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, uint64_t* reclaim_backlog = %p",
+            clds_hazard_pointers, reclaim_backlog);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_021: [ clds_hazard_pointers_get_reclaim_backlog shall provide in reclaim_backlog the number of retired nodes that were not reclaimed yet. ]*/
+        int64_t current_reclaim_backlog = interlocked_add_64(&clds_hazard_pointers->reclaim_backlog, 0);
+        // threads publish their share at different times, so the sum can briefly be below 0
+        *reclaim_backlog = (current_reclaim_backlog < 0) ? 0 : (uint64_t)current_reclaim_backlog;
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_022: [ On success, clds_hazard_pointers_get_reclaim_backlog shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_set_async_reclaim(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t max_reclaim_backlog)
+{
+    int result;
+
+    if (
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_030: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_set_async_reclaim shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_07_031: [ If max_reclaim_backlog is 0, clds_hazard_pointers_set_async_reclaim shall fail and return a non-zero value. ]*/
+        (max_reclaim_backlog == 0)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, max_reclaim_backlog = %zu",
+            clds_hazard_pointers, max_reclaim_backlog);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        clds_hazard_pointers->max_reclaim_backlog = max_reclaim_backlog;
+
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->async_reclaim_thread, NULL, NULL) != NULL)
+        {
+            // already enabled, only the backlog limit changes
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_034: [ On success, clds_hazard_pointers_set_async_reclaim shall return 0. ]*/
+            result = 0;
+        }
+        else
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_07_032: [ clds_hazard_pointers_set_async_reclaim shall register a thread for the worker of the instance, used by the worker to run reclaim cycles, and set the maximum reclaim backlog to max_reclaim_backlog. ]*/
+            CLDS_HAZARD_POINTERS_THREAD_HANDLE async_reclaim_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+            if (async_reclaim_thread == NULL)
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_07_033: [ If registering the thread fails, clds_hazard_pointers_set_async_reclaim shall fail and return a non-zero value. ]*/
+                LogError("clds_hazard_pointers_register_thread failed");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                // the thread data stays registered (and thus in the thread list) until the instance is destroyed
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->async_reclaim_thread, async_reclaim_thread);
+
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_07_034: [ On success, clds_hazard_pointers_set_async_reclaim shall return 0. ]*/
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
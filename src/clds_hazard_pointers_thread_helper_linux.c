@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <pthread.h> // Thread Local Storage doesn't have a PAL yet
+
+#include "macro_utils/macro_utils.h"
+
+#include "c_logging/logger.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#include "clds/clds_hazard_pointers_thread_helper.h"
+
+typedef struct CLDS_HAZARD_POINTERS_THREAD_HELPER_TAG
+{
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers;
+    pthread_key_t tls_key;
+} CLDS_HAZARD_POINTERS_THREAD_HELPER;
+
+// Destructor of the TLS key, pthread calls it when a thread that has a non-NULL value for the key exits
+// (after setting the value of the key to NULL for that thread), so no thread notifications are needed on Linux
+static void clds_hazard_pointers_thread_helper_thread_exit(void* value)
+{
+    /* Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_005: [ When a thread that has a thread local handle exits, clds_hazard_pointers_thread_helper_thread_exit shall call clds_hazard_pointers_unregister_thread with the thread local handle. ]*/
+    clds_hazard_pointers_unregister_thread(value);
+}
+
+CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE clds_hazard_pointers_thread_helper_create(CLDS_HAZARD_POINTERS_HANDLE hazard_pointers)
+{
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE result;
+
+    if (hazard_pointers == NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_001: [ If hazard_pointers is NULL then clds_hazard_pointers_thread_helper_create shall fail and return NULL. ]*/
+        LogError("Invalid args: CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = %p", hazard_pointers);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_002: [ clds_hazard_pointers_thread_helper_create shall allocate memory for the helper. ]*/
+        result = malloc(sizeof(CLDS_HAZARD_POINTERS_THREAD_HELPER));
+
+        if (result == NULL)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_005: [ If there are any errors then clds_hazard_pointers_thread_helper_create shall fail and return NULL. ]*/
+            LogError("malloc CLDS_HAZARD_POINTERS_THREAD_HELPER failed");
+        }
+        else
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_001: [ On Linux, clds_hazard_pointers_thread_helper_create shall allocate the thread local storage key for the hazard pointers by calling pthread_key_create with clds_hazard_pointers_thread_helper_thread_exit as destructor. ]*/
+            int pthread_result = pthread_key_create(&result->tls_key, clds_hazard_pointers_thread_helper_thread_exit);
+            if (pthread_result != 0)
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_005: [ If there are any errors then clds_hazard_pointers_thread_helper_create shall fail and return NULL. ]*/
+                LogError("pthread_key_create failed with %d", pthread_result);
+            }
+            else
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_004: [ clds_hazard_pointers_thread_helper_create shall succeed and return the helper. ]*/
+                result->hazard_pointers = hazard_pointers;
+
+                goto all_ok;
+            }
+
+            free(result);
+            result = NULL;
+        }
+    }
+all_ok:
+    return result;
+}
+
+void clds_hazard_pointers_thread_helper_destroy(CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE hazard_pointers_helper)
+{
+    if (hazard_pointers_helper == NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_006: [ If hazard_pointers_helper is NULL then clds_hazard_pointers_thread_helper_destroy shall return. ]*/
+        LogError("Invalid args: CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE hazard_pointers_helper = %p", hazard_pointers_helper);
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_002: [ On Linux, clds_hazard_pointers_thread_helper_destroy shall free the thread local storage key by calling pthread_key_delete. ]*/
+        // after this the destructor does not run anymore for threads that exit, same as unregistering the thread notifications target on Windows
+        (void)pthread_key_delete(hazard_pointers_helper->tls_key);
+
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_008: [ clds_hazard_pointers_thread_helper_destroy shall free the helper. ]*/
+        free(hazard_pointers_helper);
+    }
+}
+
+CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_helper_get_thread(CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE hazard_pointers_helper)
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE result;
+
+    if (hazard_pointers_helper == NULL)
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_009: [ If hazard_pointers_helper is NULL then clds_hazard_pointers_thread_helper_get_thread shall fail and return NULL. ]*/
+        LogError("Invalid args: CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE hazard_pointers_helper = %p", hazard_pointers_helper);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_003: [ On Linux, clds_hazard_pointers_thread_helper_get_thread shall get the thread local handle by calling pthread_getspecific. ]*/
+        // hot path: for the keys handed out first this is a load from the thread descriptor
+        result = pthread_getspecific(hazard_pointers_helper->tls_key);
+        if (result == NULL)
+        {
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_011: [ If no thread local handle exists then: ]*/
+
+            /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_012: [ clds_hazard_pointers_thread_helper_get_thread shall create one by calling clds_hazard_pointers_register_thread. ]*/
+            result = clds_hazard_pointers_register_thread(hazard_pointers_helper->hazard_pointers);
+            if (result == NULL)
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_015: [ If there are any errors then clds_hazard_pointers_thread_helper_get_thread shall fail and return NULL. ]*/
+                LogError("Cannot create clds hazard pointers thread");
+            }
+            else
+            {
+                /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_004: [ On Linux, clds_hazard_pointers_thread_helper_get_thread shall store the new handle by calling pthread_setspecific. ]*/
+                int pthread_result = pthread_setspecific(hazard_pointers_helper->tls_key, result);
+                if (pthread_result != 0)
+                {
+                    /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_015: [ If there are any errors then clds_hazard_pointers_thread_helper_get_thread shall fail and return NULL. ]*/
+                    LogError("pthread_setspecific failed with %d", pthread_result);
+                }
+                else
+                {
+                    /*Codes_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_014: [ clds_hazard_pointers_thread_helper_get_thread shall return the thread local handle. ]*/
+                    goto all_ok;
+                }
+
+                clds_hazard_pointers_unregister_thread(result);
+                result = NULL;
+            }
+        }
+    }
+all_ok:
+    return result;
+}
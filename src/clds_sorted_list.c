@@ -20,27 +20,20 @@
 
 MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_COUNT_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
 
 /* this is a lock free sorted list implementation */
 
-typedef struct CLDS_SORTED_LIST_TAG
+// a list created with clds_sorted_list_create owns its configuration
+typedef struct SORTED_LIST_WITH_CONFIG_TAG
 {
-    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
-    volatile_atomic CLDS_SORTED_LIST_ITEM* head;
-    SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb;
-    void* get_item_key_cb_context;
-    SORTED_LIST_KEY_COMPARE_CB key_compare_cb;
-    void* key_compare_cb_context;
-    volatile_atomic int64_t* sequence_number;
-    SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
-    void* skipped_seq_no_cb_context;
-
-    // Support for locking the list for writes
-    volatile_atomic int32_t locked_for_write;
-    volatile_atomic int32_t pending_write_operations;
-} CLDS_SORTED_LIST;
+    // the list is the first member, so that the handle is also the address of the allocation
+    CLDS_SORTED_LIST sorted_list;
+    CLDS_SORTED_LIST_CONFIG config;
+} SORTED_LIST_WITH_CONFIG;
 
 typedef int(*SORTED_LIST_ITEM_COMPARE_CB)(void* context, CLDS_SORTED_LIST_ITEM* item1, void* item_compare_target);
 
@@ -56,7 +49,8 @@ static int compare_item_by_ptr(void* context, CLDS_SORTED_LIST_ITEM* item, void*
     }
     else
     {
-        result = 1;
+        // there is no order between pointers, so keep looking until the end of the list
+        result = -1;
     }
 
     return result;
@@ -66,8 +60,8 @@ static int compare_item_by_key(void* context, CLDS_SORTED_LIST_ITEM* item, void*
 {
     CLDS_SORTED_LIST_HANDLE clds_sorted_list = context;
     // get item key
-    void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, item);
-    return clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, item_key, item_compare_target);
+    void* item_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, item);
+    return clds_sorted_list->config->key_compare_cb(clds_sorted_list->config->key_compare_cb_context, item_key, item_compare_target);
 }
 
 static void internal_node_destroy(CLDS_SORTED_LIST_ITEM* item)
@@ -77,7 +71,7 @@ static void internal_node_destroy(CLDS_SORTED_LIST_ITEM* item)
         /* Codes_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
         if (item->item_cleanup_callback != NULL)
         {
-            /* Codes_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+            /* Codes_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
             item->item_cleanup_callback(item->item_cleanup_callback_context, item);
         }
 
@@ -85,9 +79,12 @@ static void internal_node_destroy(CLDS_SORTED_LIST_ITEM* item)
     }
 }
 
-static void reclaim_list_node(void* node)
+static void reclaim_list_nodes(void** nodes, size_t node_count)
 {
-    internal_node_destroy((CLDS_SORTED_LIST_ITEM*)node);
+    for (size_t i = 0; i < node_count; i++)
+    {
+        internal_node_destroy((CLDS_SORTED_LIST_ITEM*)nodes[i]);
+    }
 }
 
 static void check_lock_and_begin_write_operation(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
@@ -100,8 +97,11 @@ static void check_lock_and_begin_write_operation(CLDS_SORTED_LIST_HANDLE clds_so
         if (locked_for_write != 0)
         {
             (void)interlocked_decrement(&clds_sorted_list->pending_write_operations);
-            wake_by_address_all(&clds_sorted_list->pending_write_operations);
-    
+            if (interlocked_add(&clds_sorted_list->write_lock_waiters, 0) != 0)
+            {
+                wake_by_address_all(&clds_sorted_list->pending_write_operations);
+            }
+
             // Wait for unlock
             (void)wait_on_address(&clds_sorted_list->locked_for_write, locked_for_write, UINT32_MAX);
         }
@@ -111,7 +111,12 @@ static void check_lock_and_begin_write_operation(CLDS_SORTED_LIST_HANDLE clds_so
 static void end_write_operation(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
 {
     (void)interlocked_decrement(&clds_sorted_list->pending_write_operations);
-    wake_by_address_all(&clds_sorted_list->pending_write_operations);
+
+    // the waiter registers itself before reading the pending count, so either it sees the decrement or we see the waiter
+    if (interlocked_add(&clds_sorted_list->write_lock_waiters, 0) != 0)
+    {
+        wake_by_address_all(&clds_sorted_list->pending_write_operations);
+    }
 }
 
 static void internal_lock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
@@ -120,16 +125,23 @@ static void internal_lock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     (void)interlocked_increment(&clds_sorted_list->locked_for_write);
     
     /*Codes_SRS_CLDS_SORTED_LIST_42_032: [ clds_sorted_list_lock_writes shall wait for all pending write operations to complete. ]*/
-    int32_t pending_writes;
-    do
+    int32_t pending_writes = interlocked_add(&clds_sorted_list->pending_write_operations, 0);
+    if (pending_writes != 0)
     {
-        pending_writes = interlocked_add(&clds_sorted_list->pending_write_operations, 0);
-        if (pending_writes != 0)
+        (void)interlocked_increment(&clds_sorted_list->write_lock_waiters);
+
+        do
         {
-            // Wait for writes
-            (void)wait_on_address(&clds_sorted_list->pending_write_operations, pending_writes, UINT32_MAX);
-        }
-    } while (pending_writes != 0);
+            pending_writes = interlocked_add(&clds_sorted_list->pending_write_operations, 0);
+            if (pending_writes != 0)
+            {
+                // Wait for writes
+                (void)wait_on_address(&clds_sorted_list->pending_write_operations, pending_writes, UINT32_MAX);
+            }
+        } while (pending_writes != 0);
+
+        (void)interlocked_decrement(&clds_sorted_list->write_lock_waiters);
+    }
 }
 
 static void internal_unlock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
@@ -250,9 +262,9 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
 
                                 /* Codes_SRS_CLDS_SORTED_LIST_01_070: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
                                 /* Codes_SRS_CLDS_SORTED_LIST_01_071: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-                                if (clds_sorted_list->sequence_number != NULL)
+                                if (clds_sorted_list->config->sequence_number != NULL)
                                 {
-                                    local_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+                                    local_seq_no = interlocked_increment_64(clds_sorted_list->config->sequence_number);
                                 }
 
                                 // the current node is marked for deletion, now try to change the previous link to the next value
@@ -273,11 +285,11 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         if (
-                                            (clds_sorted_list->sequence_number != NULL) &&
-                                            (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                            (clds_sorted_list->config->sequence_number != NULL) &&
+                                            (clds_sorted_list->config->skipped_seq_no_cb != NULL)
                                             )
                                         {
-                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                                            clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
                                         }
 
                                         restart_needed = true;
@@ -285,7 +297,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                     }
                                     else
                                     {
-                                        if (clds_sorted_list->sequence_number != NULL)
+                                        if (clds_sorted_list->config->sequence_number != NULL)
                                         {
                                             /* Codes_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
                                             /* Codes_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
@@ -302,8 +314,8 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+                                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_nodes);
                                         restart_needed = false;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
@@ -325,11 +337,11 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         if (
-                                            (clds_sorted_list->sequence_number != NULL) &&
-                                            (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                            (clds_sorted_list->config->sequence_number != NULL) &&
+                                            (clds_sorted_list->config->skipped_seq_no_cb != NULL)
                                             )
                                         {
-                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                                            clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
                                         }
 
                                         restart_needed = true;
@@ -337,7 +349,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                     }
                                     else
                                     {
-                                        if (clds_sorted_list->sequence_number != NULL)
+                                        if (clds_sorted_list->config->sequence_number != NULL)
                                         {
                                             /* Codes_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
                                             /* Codes_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
@@ -356,8 +368,8 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+                                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_nodes);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
@@ -369,6 +381,22 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                 }
                             }
                         }
+                        else if (compare_result > 0)
+                        {
+                            // the list is sorted, so the item cannot be further down the list
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = false;
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_07_023: [ clds_sorted_list_delete_key shall stop looking for the key and return CLDS_SORTED_LIST_DELETE_NOT_FOUND when it reaches an item with a greater key. ]*/
+                            result = CLDS_SORTED_LIST_DELETE_NOT_FOUND;
+                            break;
+                        }
                         else
                         {
                             // we have a stable pointer to the current item, now simply set the previous to be this
@@ -497,10 +525,10 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                 int64_t local_seq_no = 0;
 
                                 /* Codes_SRS_CLDS_SORTED_LIST_01_073: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-                                if (clds_sorted_list->sequence_number != NULL)
+                                if (clds_sorted_list->config->sequence_number != NULL)
                                 {
                                     /* Codes_SRS_CLDS_SORTED_LIST_01_074: [ If the sequence_number argument passed to clds_sorted_list_remove_key is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
-                                    local_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+                                    local_seq_no = interlocked_increment_64(clds_sorted_list->config->sequence_number);
                                 }
 
                                 // the current node is marked for deletion, now try to change the previous link to the next value
@@ -519,11 +547,11 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         if (
-                                            (clds_sorted_list->sequence_number != NULL) &&
-                                            (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                            (clds_sorted_list->config->sequence_number != NULL) &&
+                                            (clds_sorted_list->config->skipped_seq_no_cb != NULL)
                                             )
                                         {
-                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                                            clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
                                         }
 
                                         restart_needed = true;
@@ -535,7 +563,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         *item = (CLDS_SORTED_LIST_ITEM*)current_item;
                                         clds_sorted_list_node_inc_ref(*item);
 
-                                        if (clds_sorted_list->sequence_number != NULL)
+                                        if (clds_sorted_list->config->sequence_number != NULL)
                                         {
                                             if (sequence_number != NULL)
                                             {
@@ -549,8 +577,8 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+                                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_nodes);
                                         restart_needed = false;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
@@ -570,11 +598,11 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         if (
-                                            (clds_sorted_list->sequence_number != NULL) &&
-                                            (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                            (clds_sorted_list->config->sequence_number != NULL) &&
+                                            (clds_sorted_list->config->skipped_seq_no_cb != NULL)
                                             )
                                         {
-                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                                            clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
                                         }
 
                                         restart_needed = true;
@@ -586,7 +614,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         *item = (CLDS_SORTED_LIST_ITEM*)current_item;
                                         clds_sorted_list_node_inc_ref(*item);
 
-                                        if (clds_sorted_list->sequence_number != NULL)
+                                        if (clds_sorted_list->config->sequence_number != NULL)
                                         {
                                             if (sequence_number != NULL)
                                             {
@@ -601,8 +629,8 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+                                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_nodes);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
                                         result = CLDS_SORTED_LIST_REMOVE_OK;
@@ -613,6 +641,22 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                 }
                             }
                         }
+                        else if (compare_result > 0)
+                        {
+                            // the list is sorted, so the item cannot be further down the list
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = false;
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_07_024: [ clds_sorted_list_remove_key shall stop looking for the key and return CLDS_SORTED_LIST_REMOVE_NOT_FOUND when it reaches an item with a greater key. ]*/
+                            result = CLDS_SORTED_LIST_REMOVE_NOT_FOUND;
+                            break;
+                        }
                         else
                         {
                             // we have a stable pointer to the current item, now simply set the previous to be this
@@ -635,6 +679,45 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
     return result;
 }
 
+static void internal_config_init(CLDS_SORTED_LIST_CONFIG* config, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb, void* get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB key_compare_cb, void* key_compare_cb_context, volatile_atomic int64_t* start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    config->clds_hazard_pointers = clds_hazard_pointers;
+    config->get_item_key_cb = get_item_key_cb;
+    config->get_item_key_cb_context = get_item_key_cb_context;
+    config->key_compare_cb = key_compare_cb;
+    config->key_compare_cb_context = key_compare_cb_context;
+    config->skipped_seq_no_cb = skipped_seq_no_cb;
+    config->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+    config->sequence_number = start_sequence_number;
+}
+
+static void internal_init(CLDS_SORTED_LIST* clds_sorted_list, const CLDS_SORTED_LIST_CONFIG* config)
+{
+    clds_sorted_list->config = config;
+
+    (void)interlocked_exchange(&clds_sorted_list->locked_for_write, 0);
+    (void)interlocked_exchange(&clds_sorted_list->pending_write_operations, 0);
+    (void)interlocked_exchange(&clds_sorted_list->write_lock_waiters, 0);
+
+    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL);
+}
+
+static void internal_free_items(CLDS_SORTED_LIST* clds_sorted_list)
+{
+    CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL, NULL);
+
+    // go through all the items and free them
+    while (current_item != NULL)
+    {
+        CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL) & ~0x1);
+
+        internal_node_destroy(current_item);
+        current_item = next_item;
+    }
+
+    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL);
+}
+
 CLDS_SORTED_LIST_HANDLE clds_sorted_list_create(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb, void* get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB key_compare_cb, void* key_compare_cb_context, volatile_atomic int64_t* start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
 {
     CLDS_SORTED_LIST_HANDLE clds_sorted_list;
@@ -664,30 +747,21 @@ CLDS_SORTED_LIST_HANDLE clds_sorted_list_create(CLDS_HAZARD_POINTERS_HANDLE clds
     else
     {
         /* Codes_SRS_CLDS_SORTED_LIST_01_001: [ clds_sorted_list_create shall create a new sorted list object and on success it shall return a non-NULL handle to the newly created list. ]*/
-        clds_sorted_list = malloc(sizeof(CLDS_SORTED_LIST));
-        if (clds_sorted_list == NULL)
+        SORTED_LIST_WITH_CONFIG* sorted_list_with_config = malloc(sizeof(SORTED_LIST_WITH_CONFIG));
+        if (sorted_list_with_config == NULL)
         {
             /* Codes_SRS_CLDS_SORTED_LIST_01_002: [ If any error happens, clds_sorted_list_create shall fail and return NULL. ]*/
             LogError("malloc failed");
+            clds_sorted_list = NULL;
         }
         else
         {
             // all ok
-            clds_sorted_list->clds_hazard_pointers = clds_hazard_pointers;
-            clds_sorted_list->get_item_key_cb = get_item_key_cb;
-            clds_sorted_list->get_item_key_cb_context = get_item_key_cb_context;
-            clds_sorted_list->key_compare_cb = key_compare_cb;
-            clds_sorted_list->key_compare_cb_context = key_compare_cb_context;
-            clds_sorted_list->skipped_seq_no_cb = skipped_seq_no_cb;
-            clds_sorted_list->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
-
-            (void)interlocked_exchange(&clds_sorted_list->locked_for_write, 0);
-            (void)interlocked_exchange(&clds_sorted_list->pending_write_operations, 0);
-
             /* Codes_SRS_CLDS_SORTED_LIST_01_058: [ start_sequence_number shall be used by the sorted list to compute the sequence number of each operation. ]*/
-            clds_sorted_list->sequence_number = start_sequence_number;
+            internal_config_init(&sorted_list_with_config->config, clds_hazard_pointers, get_item_key_cb, get_item_key_cb_context, key_compare_cb, key_compare_cb_context, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+            internal_init(&sorted_list_with_config->sorted_list, &sorted_list_with_config->config);
 
-            (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL);
+            clds_sorted_list = &sorted_list_with_config->sorted_list;
         }
     }
 
@@ -703,147 +777,251 @@ void clds_sorted_list_destroy(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     }
     else
     {
-        CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL, NULL);
-
         /* Codes_SRS_CLDS_SORTED_LIST_01_039: [ Any items still present in the list shall be freed. ]*/
-        // go through all the items and free them
-        while (current_item != NULL)
-        {
-            CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL) & ~0x1);
-
-            /* Codes_SRS_CLDS_SORTED_LIST_01_040: [ For each item that is freed, the callback item_cleanup_callback passed to clds_sorted_list_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-            /* Codes_SRS_CLDS_SORTED_LIST_01_041: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
-            internal_node_destroy(current_item);
-            current_item = next_item;
-        }
+        /* Codes_SRS_CLDS_SORTED_LIST_01_040: [ For each item that is freed, the callback item_cleanup_callback passed to clds_sorted_list_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_041: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
+        internal_free_items(clds_sorted_list);
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_004: [ clds_sorted_list_destroy shall free all resources associated with the sorted list instance. ]*/
+        // the list is the first member of the allocation made by clds_sorted_list_create
         free(clds_sorted_list);
     }
 }
 
-CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+int clds_sorted_list_config_init(CLDS_SORTED_LIST_CONFIG* config, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb, void* get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB key_compare_cb, void* key_compare_cb_context, volatile_atomic int64_t* start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
 {
-    CLDS_SORTED_LIST_INSERT_RESULT result;
+    int result;
+
+    /* Codes_SRS_CLDS_SORTED_LIST_07_015: [ get_item_key_cb_context, key_compare_cb_context, start_sequence_number, skipped_seq_no_cb and skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
 
     if (
-        /* Codes_SRS_CLDS_SORTED_LIST_01_011: [ If clds_sorted_list is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_07_010: [ If config is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+        (config == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_011: [ If clds_hazard_pointers is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_012: [ If get_item_key_cb is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+        (get_item_key_cb == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_013: [ If key_compare_cb is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+        (key_compare_cb == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_014: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_CONFIG* config=%p, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb=%p, void* get_item_key_cb_context=%p, SORTED_LIST_KEY_COMPARE_CB key_compare_cb=%p, void* key_compare_cb_context=%p, volatile_atomic int64_t* start_sequence_number=%p, SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            config, clds_hazard_pointers, get_item_key_cb, get_item_key_cb_context, key_compare_cb, key_compare_cb_context, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_07_016: [ clds_sorted_list_config_init shall store the hazard pointers instance, the callbacks with their contexts and start_sequence_number in config and return 0. ]*/
+        internal_config_init(config, clds_hazard_pointers, get_item_key_cb, get_item_key_cb_context, key_compare_cb, key_compare_cb_context, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        result = 0;
+    }
+
+    return result;
+}
+
+void clds_sorted_list_init(CLDS_SORTED_LIST* clds_sorted_list, const CLDS_SORTED_LIST_CONFIG* config)
+{
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_07_017: [ If clds_sorted_list is NULL, clds_sorted_list_init shall return. ]*/
         (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_012: [ If item is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        (item == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_013: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        /* Codes_SRS_CLDS_SORTED_LIST_07_018: [ If config is NULL, clds_sorted_list_init shall return. ]*/
+        (config == NULL)
         )
     {
-        LogError("Invalid arguments: clds_sorted_list = %p, item = %p, clds_hazard_pointers_thread = %p, sequence_number = %p",
-            clds_sorted_list, item, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_SORTED_LIST_INSERT_ERROR;
+        LogError("Invalid arguments: CLDS_SORTED_LIST* clds_sorted_list=%p, const CLDS_SORTED_LIST_CONFIG* config=%p", clds_sorted_list, config);
     }
     else
     {
-        /*Codes_SRS_CLDS_SORTED_LIST_42_001: [ clds_sorted_list_insert shall try the following until it acquires a write lock for the list: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_002: [ clds_sorted_list_insert shall increment the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_003: [ If the counter to lock the list for writes is non-zero then: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_004: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_005: [ clds_sorted_list_insert shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_sorted_list);
+        /* Codes_SRS_CLDS_SORTED_LIST_07_019: [ clds_sorted_list_init shall initialize clds_sorted_list as an empty list that is not locked for writes and that uses the callbacks and the sequence number in config. ]*/
+        internal_init(clds_sorted_list, config);
+    }
+}
 
-        bool restart_needed;
-        void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, item);
-        int64_t local_seq_no = 0;
+void clds_sorted_list_deinit(CLDS_SORTED_LIST* clds_sorted_list)
+{
+    if (clds_sorted_list == NULL)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_07_020: [ If clds_sorted_list is NULL, clds_sorted_list_deinit shall return. ]*/
+        LogError("Invalid arguments: CLDS_SORTED_LIST* clds_sorted_list=%p", clds_sorted_list);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_07_021: [ Any items still present in the list shall be freed, calling for each the item_cleanup_callback passed to clds_sorted_list_node_create (if not NULL). ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_07_022: [ clds_sorted_list_deinit shall leave clds_sorted_list as an empty list and shall not free the memory of clds_sorted_list. ]*/
+        internal_free_items(clds_sorted_list);
+    }
+}
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_069: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-        if (clds_sorted_list->sequence_number != NULL)
+static CLDS_SORTED_LIST_ITEM* create_item_to_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, void* key, SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context, int64_t local_seq_no)
+{
+    /* Codes_SRS_CLDS_SORTED_LIST_07_047: [ clds_sorted_list_compute_if_absent shall call item_factory with item_factory_context and key to create the new item only when it reaches the position where key would be inserted. ]*/
+    CLDS_SORTED_LIST_ITEM* result = item_factory(item_factory_context, key);
+    if (result == NULL)
+    {
+        if (clds_sorted_list->config->skipped_seq_no_cb != NULL)
         {
-            /* Codes_SRS_CLDS_SORTED_LIST_01_060: [ For each insert the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-            local_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+            /* Codes_SRS_CLDS_SORTED_LIST_01_079: [If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
+            clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
+        }
 
-            /* Codes_SRS_CLDS_SORTED_LIST_01_061: [ If the sequence_number argument passed to clds_sorted_list_insert is NULL, the computed sequence number for the insert shall still be computed but it shall not be provided to the user. ]*/
-            if (sequence_number != NULL)
-            {
-                *sequence_number = local_seq_no;
-            }
+        /* Codes_SRS_CLDS_SORTED_LIST_07_048: [ If item_factory returns NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        LogError("item_factory=%p failed creating the item for key=%p", item_factory, key);
+    }
+    else
+    {
+        // one reference is owned by the list, the other one is handed to the caller
+        (void)interlocked_increment(&result->ref_count);
+    }
+
+    return result;
+}
+
+// item is NULL when the item is created by item_factory, result_item receives the existing item (get or insert)
+// or the item that ends up in the list (compute if absent), with a reference taken for the caller
+static CLDS_SORTED_LIST_INSERT_RESULT internal_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM* item, SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_SORTED_LIST_ITEM** result_item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    /*Codes_SRS_CLDS_SORTED_LIST_42_001: [ clds_sorted_list_insert shall try the following until it acquires a write lock for the list: ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_002: [ clds_sorted_list_insert shall increment the count of pending write operations. ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_003: [ If the counter to lock the list for writes is non-zero then: ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_004: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_005: [ clds_sorted_list_insert shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+    check_lock_and_begin_write_operation(clds_sorted_list);
+
+    bool restart_needed;
+    // when there is no item yet (compute if absent) the key is given separately
+    void* new_item_key = (item != NULL) ? clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, item) : key;
+    bool item_from_factory = (item == NULL);
+    int64_t local_seq_no = 0;
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_069: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
+    if (clds_sorted_list->config->sequence_number != NULL)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_060: [ For each insert the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+        local_seq_no = interlocked_increment_64(clds_sorted_list->config->sequence_number);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_061: [ If the sequence_number argument passed to clds_sorted_list_insert is NULL, the computed sequence number for the insert shall still be computed but it shall not be provided to the user. ]*/
+        if (sequence_number != NULL)
+        {
+            *sequence_number = local_seq_no;
         }
+    }
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_047: [ clds_sorted_list_insert shall insert the item at its correct location making sure that items in the list are sorted according to the order given by item keys. ]*/
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_047: [ clds_sorted_list_insert shall insert the item at its correct location making sure that items in the list are sorted according to the order given by item keys. ]*/
+    do
+    {
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        CLDS_SORTED_LIST_ITEM* previous_item = NULL;
+        CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&clds_sorted_list->head;
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+        uint64_t iteration_count = 0;
 
         do
         {
-            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
-            CLDS_SORTED_LIST_ITEM* previous_item = NULL;
-            CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&clds_sorted_list->head;
-            result = CLDS_SORTED_LIST_INSERT_ERROR;
-            uint64_t iteration_count = 0;
+            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+            {
+                LogInfo("clds_sorted_list_insert spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+                iteration_count = 0;
+            }
 
-            do
+            // get the current_item value
+            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+
+            // clear any delete lock bit from what we read
+            current_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~0x1);
+
+            // check if the item is NULL
+            if (current_item == NULL)
             {
-                if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+                if ((item == NULL) && ((item = create_item_to_insert(clds_sorted_list, key, item_factory, item_factory_context, local_seq_no)) == NULL))
                 {
-                    LogInfo("clds_sorted_list_insert spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
-                    iteration_count = 0;
-                }
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
 
-                // get the current_item value
-                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_INSERT_ERROR;
+                    break;
+                }
 
-                // clear any delete lock bit from what we read
-                current_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~0x1);
+                item->next = NULL;
 
-                // check if the item is NULL
-                if (current_item == NULL)
+                // not found, so insert it here
+                if (previous_item != NULL)
                 {
-                    item->next = NULL;
-
-                    // not found, so insert it here
-                    if (previous_item != NULL)
+                    // have a previous item, try to replace the NULL with the new item
+                    // if there is something else than NULL there, restart, there were some major changes
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != NULL)
                     {
-                        // have a previous item, try to replace the NULL with the new item
-                        // if there is something else than NULL there, restart, there were some major changes
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != NULL)
-                        {
-                            // let go of previous hazard pointer
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            restart_needed = true;
-                            break;
-                        }
-                        else
-                        {
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            restart_needed = false;
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        restart_needed = true;
+                        break;
+                    }
+                    else
+                    {
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        restart_needed = false;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                            result = CLDS_SORTED_LIST_INSERT_OK;
-                            break;
-                        }
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                        result = CLDS_SORTED_LIST_INSERT_OK;
+                        break;
+                    }
+                }
+                else
+                {
+                    // no previous item, replace the head, make sure it is a "clean" NULL, no lock bit set
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, item, NULL) != NULL)
+                    {
+                        restart_needed = true;
+                        break;
                     }
                     else
                     {
-                        // no previous item, replace the head, make sure it is a "clean" NULL, no lock bit set
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, item, NULL) != NULL)
-                        {
-                            restart_needed = true;
-                            break;
-                        }
-                        else
-                        {
-                            // insert done
-                            restart_needed = false;
+                        // insert done
+                        restart_needed = false;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                            result = CLDS_SORTED_LIST_INSERT_OK;
-                            break;
-                        }
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                        result = CLDS_SORTED_LIST_INSERT_OK;
+                        break;
                     }
+                }
 
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    if (clds_sorted_list->config->skipped_seq_no_cb != NULL)
+                    {
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_079: [If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
+                        clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
+                    }
+
+                    LogError("Cannot acquire hazard pointer");
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_INSERT_ERROR;
                     break;
                 }
                 else
                 {
-                    // acquire hazard pointer
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
-                    if (current_item_hp == NULL)
+                    // now make sure the item has not changed. This also takes care of checking that the delete lock bit is not set
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL) != (void*)current_item)
                     {
                         if (previous_hp != NULL)
                         {
@@ -851,132 +1029,236 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                         }
 
-                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                        {
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_079: [If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
-                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                        }
+                        // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                        LogError("Cannot acquire hazard pointer");
-                        restart_needed = false;
-                        result = CLDS_SORTED_LIST_INSERT_ERROR;
+                        restart_needed = true;
                         break;
                     }
                     else
                     {
-                        // now make sure the item has not changed. This also takes care of checking that the delete lock bit is not set
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL) != (void*)current_item)
+                        // we are in a stable state, at this point the previous node does not have a delete lock bit set
+                        // compare the current item key to our key
+                        void* current_item_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                        int compare_result = clds_sorted_list->config->key_compare_cb(clds_sorted_list->config->key_compare_cb_context, new_item_key, current_item_key);
+
+                        if (compare_result == 0)
                         {
-                            if (previous_hp != NULL)
+                            // item already in the list
+                            if (previous_item != NULL)
                             {
-                                // let go of previous hazard pointer
                                 clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
 
-                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                            if (result_item != NULL)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_07_040: [ If an item with the same key already exists in the list, clds_sorted_list_get_or_insert shall increment its reference count, store it in result_item and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+                                /* Codes_SRS_CLDS_SORTED_LIST_07_050: [ If an item with key already exists in the list, clds_sorted_list_compute_if_absent shall increment its reference count, store it in item and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+                                // the hazard pointer keeps the item alive until the reference is taken
+                                (void)interlocked_increment(&current_item->ref_count);
+                                *result_item = current_item;
+                            }
+
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = false;
 
-                            restart_needed = true;
+                            if (clds_sorted_list->config->skipped_seq_no_cb != NULL)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_079: [If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
+                                clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, local_seq_no);
+                            }
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_048: [ If the item with the given key already exists in the list, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+                            result = CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS;
                             break;
                         }
-                        else
+                        else if (compare_result < 0)
                         {
-                            // we are in a stable state, at this point the previous node does not have a delete lock bit set
-                            // compare the current item key to our key
-                            void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
-
-                            if (compare_result == 0)
+                            if ((item == NULL) && ((item = create_item_to_insert(clds_sorted_list, key, item_factory, item_factory_context, local_seq_no)) == NULL))
                             {
-                                // item already in the list
-                                if (previous_item != NULL)
+                                if (previous_hp != NULL)
                                 {
+                                    // let go of previous hazard pointer
                                     clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                                 }
 
                                 clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
                                 restart_needed = false;
-
-                                if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                {
-                                    /* Codes_SRS_CLDS_SORTED_LIST_01_079: [If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
-                                    clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                                }
-
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_048: [ If the item with the given key already exists in the list, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
-                                result = CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS;
+                                result = CLDS_SORTED_LIST_INSERT_ERROR;
                                 break;
                             }
-                            else if (compare_result < 0)
-                            {
-                                // need to insert between the previous and current node, since current node's key is higher than what we want to insert
-                                item->next = current_item;
 
-                                if (previous_item != NULL)
-                                {
-                                    // have a previous item
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != (void*)current_item)
-                                    {
-                                        // let go of both hazard pointers
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = true;
-                                        break;
-                                    }
-                                    else
-                                    {
-                                        // let go of both hazard pointers
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = false;
+                            // need to insert between the previous and current node, since current node's key is higher than what we want to insert
+                            item->next = current_item;
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                                        result = CLDS_SORTED_LIST_INSERT_OK;
-                                        break;
-                                    }
+                            if (previous_item != NULL)
+                            {
+                                // have a previous item
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != (void*)current_item)
+                                {
+                                    // let go of both hazard pointers
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = true;
+                                    break;
                                 }
                                 else
                                 {
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)item, (void*)current_item) != current_item)
-                                    {
-                                        // let go of the hazard pointer
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = true;
-                                        break;
-                                    }
-                                    else
-                                    {
-                                        // let go of the hazard pointer
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = false;
+                                    // let go of both hazard pointers
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = false;
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                                        result = CLDS_SORTED_LIST_INSERT_OK;
-                                        break;
-                                    }
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                                    result = CLDS_SORTED_LIST_INSERT_OK;
+                                    break;
                                 }
                             }
-                            else // item is less than the current, so move on
+                            else
                             {
-                                // we have a stable pointer to the current item, now simply set the previous to be this
-                                if (previous_hp != NULL)
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)item, (void*)current_item) != current_item)
                                 {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    // let go of the hazard pointer
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = true;
+                                    break;
                                 }
+                                else
+                                {
+                                    // let go of the hazard pointer
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = false;
 
-                                previous_hp = current_item_hp;
-                                previous_item = current_item;
-                                current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&current_item->next;
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                                    result = CLDS_SORTED_LIST_INSERT_OK;
+                                    break;
+                                }
                             }
                         }
+                        else // item is less than the current, so move on
+                        {
+                            // we have a stable pointer to the current item, now simply set the previous to be this
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            previous_hp = current_item_hp;
+                            previous_item = current_item;
+                            current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&current_item->next;
+                        }
                     }
                 }
-            } while (1);
-        } while (restart_needed);
+            }
+        } while (1);
+    } while (restart_needed);
 
-        /*Codes_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_sorted_list);
+    if (item_from_factory && (item != NULL))
+    {
+        if (result == CLDS_SORTED_LIST_INSERT_OK)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_07_049: [ On success clds_sorted_list_compute_if_absent shall store the new item in item, with its reference count incremented for the caller, and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+            *result_item = item;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_07_051: [ If the item created by item_factory was not inserted, clds_sorted_list_compute_if_absent shall release it. ]*/
+            // nobody else has seen the item, drop both the list and the caller reference
+            (void)interlocked_decrement(&item->ref_count);
+            internal_node_destroy(item);
+        }
+    }
+
+    /*Codes_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+    end_write_operation(clds_sorted_list);
+
+    return result;
+}
+
+CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_011: [ If clds_sorted_list is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_012: [ If item is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_013: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: clds_sorted_list = %p, item = %p, clds_hazard_pointers_thread = %p, sequence_number = %p",
+            clds_sorted_list, item, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+    }
+    else
+    {
+        result = internal_insert(clds_sorted_list, clds_hazard_pointers_thread, NULL, item, NULL, NULL, NULL, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_get_or_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, CLDS_SORTED_LIST_ITEM** existing_item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_07_034: [ If clds_sorted_list is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_035: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_036: [ If item is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_037: [ If existing_item is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (existing_item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_038: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, CLDS_SORTED_LIST_ITEM** existing_item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, item, existing_item, sequence_number);
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_07_039: [ Otherwise clds_sorted_list_get_or_insert shall insert item in the list in the same way as clds_sorted_list_insert and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+        result = internal_insert(clds_sorted_list, clds_hazard_pointers_thread, NULL, item, NULL, NULL, existing_item, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_compute_if_absent(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_07_041: [ If clds_sorted_list is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_042: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_043: [ If key is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_044: [ If item_factory is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (item_factory == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_045: [ If item is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_046: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, SORTED_LIST_ITEM_FACTORY_CB item_factory=%p, void* item_factory_context=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key, item_factory, item_factory_context, item, sequence_number);
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+    }
+    else
+    {
+        result = internal_insert(clds_sorted_list, clds_hazard_pointers_thread, key, NULL, item_factory, item_factory_context, item, sequence_number);
     }
 
     return result;
@@ -994,7 +1276,7 @@ CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_item(CLDS_SORTED_LIST_HAN
         /* Codes_SRS_CLDS_SORTED_LIST_01_017: [ If item is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
         (item == NULL) ||
         /* Codes_SRS_CLDS_SORTED_LIST_01_065: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
         )
     {
         LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, int64_t* sequence_number=%p",
@@ -1032,7 +1314,7 @@ CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_key(CLDS_SORTED_LIST_HAND
         /* Codes_SRS_CLDS_SORTED_LIST_01_022: [ If key is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
         (key == NULL) ||
         /* Codes_SRS_CLDS_SORTED_LIST_01_068: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
         )
     {
         LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
@@ -1070,7 +1352,7 @@ CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_key(CLDS_SORTED_LIST_HAND
         /* Codes_SRS_CLDS_SORTED_LIST_01_056: [ If key is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         (key == NULL) ||
         /* Codes_SRS_CLDS_SORTED_LIST_01_075: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
         )
     {
         LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
@@ -1096,51 +1378,56 @@ CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_key(CLDS_SORTED_LIST_HAND
     return result;
 }
 
-CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+// when visit_cb is NULL the found item is returned with its reference count incremented,
+// otherwise visit_cb is called for it under the hazard pointer and the returned pointer must not be used after the call
+static CLDS_SORTED_LIST_ITEM* internal_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, SORTED_LIST_FIND_VISIT_CB visit_cb, void* visit_cb_context)
 {
     CLDS_SORTED_LIST_ITEM* result;
 
-    /* Codes_SRS_CLDS_SORTED_LIST_01_028: [ If clds_sorted_list is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
-    if (
-        (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_030: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_031: [ If key is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
-        (key == NULL)
-        )
-    {
-        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
-            clds_sorted_list, clds_hazard_pointers_thread, key);
-        result = NULL;
-    }
-    else
-    {
-        /* Codes_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
+    /* Codes_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
 
-        bool restart_needed;
-        result = NULL;
-        uint64_t iteration_count = 0;
+    bool restart_needed;
+    result = NULL;
+    uint64_t iteration_count = 0;
 
-        do
+    do
+    {
+        if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
         {
-            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
-            {
-                LogInfo("clds_sorted_list_find_key spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
-                iteration_count = 0;
-            }
+            LogInfo("clds_sorted_list_find_key spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+            iteration_count = 0;
+        }
+
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
+
+        do
+        {
+            // get the current_item value
+            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
 
-            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
-            volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
+            // clear any delete lock bit from what we read
+            current_item = (void*)((uintptr_t)current_item & ~0x1);
 
-            do
+            if (current_item == NULL)
             {
-                // get the current_item value
-                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+                if (previous_hp != NULL)
+                {
+                    // let go of previous hazard pointer
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                }
 
-                // clear any delete lock bit from what we read
-                current_item = (void*)((uintptr_t)current_item & ~0x1);
+                restart_needed = false;
 
-                if (current_item == NULL)
+                /* Codes_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
+                result = NULL;
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
                 {
                     if (previous_hp != NULL)
                     {
@@ -1148,6 +1435,7 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                         clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                     }
 
+                    LogError("Cannot acquire hazard pointer");
                     restart_needed = false;
 
                     /* Codes_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
@@ -1156,9 +1444,8 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                 }
                 else
                 {
-                    // acquire hazard pointer
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
-                    if (current_item_hp == NULL)
+                    // now make sure the item has not changed
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
                     {
                         if (previous_hp != NULL)
                         {
@@ -1166,17 +1453,16 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                         }
 
-                        LogError("Cannot acquire hazard pointer");
-                        restart_needed = false;
-
-                        /* Codes_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
-                        result = NULL;
+                        // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                        restart_needed = true;
                         break;
                     }
                     else
                     {
-                        // now make sure the item has not changed
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
+                        void* item_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                        int compare_result = clds_sorted_list->config->key_compare_cb(clds_sorted_list->config->key_compare_cb_context, key, item_key);
+                        if (compare_result == 0)
                         {
                             if (previous_hp != NULL)
                             {
@@ -1184,50 +1470,119 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                                 clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
 
-                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                            // found it
+                            if (visit_cb == NULL)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_034: [ clds_sorted_list_find_key shall return a pointer to the item with the reference count already incremented so that it can be safely used by the caller. ]*/
+                                (void)interlocked_increment(&current_item->ref_count);
+                            }
+                            else
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_07_030: [ clds_sorted_list_find_key_and_visit shall call visit_cb with visit_cb_context and the found item while the item is protected only by the hazard pointer of clds_hazard_pointers_thread. ]*/
+                                /* Codes_SRS_CLDS_SORTED_LIST_07_031: [ clds_sorted_list_find_key_and_visit shall not increment the reference count of the found item. ]*/
+                                visit_cb(visit_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                            }
+
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                            restart_needed = true;
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
+                            result = (CLDS_SORTED_LIST_ITEM*)current_item;
+                            restart_needed = false;
                             break;
                         }
-                        else
+                        else if (compare_result < 0)
                         {
-                            void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, key, item_key);
-                            if (compare_result == 0)
+                            // the list is sorted, so the key cannot be further down the list
+                            if (previous_hp != NULL)
                             {
-                                if (previous_hp != NULL)
-                                {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                }
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
 
-                                // found it
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_034: [ clds_sorted_list_find_key shall return a pointer to the item with the reference count already incremented so that it can be safely used by the caller. ]*/
-                                (void)interlocked_increment(&current_item->ref_count);
-                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = false;
 
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
-                                result = (CLDS_SORTED_LIST_ITEM*)current_item;
-                                restart_needed = false;
-                                break;
-                            }
-                            else
+                            /* Codes_SRS_CLDS_SORTED_LIST_07_025: [ clds_sorted_list_find_key shall stop looking for the key and return NULL when it reaches an item with a greater key. ]*/
+                            result = NULL;
+                            break;
+                        }
+                        else
+                        {
+                            // we have a stable pointer to the current item, now simply set the previous to be this
+                            if (previous_hp != NULL)
                             {
-                                // we have a stable pointer to the current item, now simply set the previous to be this
-                                if (previous_hp != NULL)
-                                {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                }
-
-                                previous_hp = current_item_hp;
-                                current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
+
+                            previous_hp = current_item_hp;
+                            current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
                         }
                     }
                 }
-            } while (1);
-        } while (restart_needed);
+            }
+        } while (1);
+    } while (restart_needed);
+
+    return result;
+}
+
+CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_SORTED_LIST_ITEM* result;
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_028: [ If clds_sorted_list is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
+    if (
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_030: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_031: [ If key is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        result = internal_find_key(clds_sorted_list, clds_hazard_pointers_thread, key, NULL, NULL);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT clds_sorted_list_find_key_and_visit(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, SORTED_LIST_FIND_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_07_026: [ If clds_sorted_list is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_027: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_028: [ If key is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_07_029: [ If visit_cb is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+        (visit_cb == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, SORTED_LIST_FIND_VISIT_CB visit_cb=%p, void* visit_cb_context=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key, visit_cb, visit_cb_context);
+        result = CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR;
+    }
+    else
+    {
+        if (internal_find_key(clds_sorted_list, clds_hazard_pointers_thread, key, visit_cb, visit_cb_context) == NULL)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_07_033: [ If no item matching key is found in the list, clds_sorted_list_find_key_and_visit shall return CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND without calling visit_cb. ]*/
+            result = CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_07_032: [ On success clds_sorted_list_find_key_and_visit shall return CLDS_SORTED_LIST_FIND_AND_VISIT_OK. ]*/
+            result = CLDS_SORTED_LIST_FIND_AND_VISIT_OK;
+        }
     }
 
     return result;
@@ -1249,7 +1604,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
         /* Codes_SRS_CLDS_SORTED_LIST_01_085: [ If old_item is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
         (old_item == NULL) ||
         /* Codes_SRS_CLDS_SORTED_LIST_01_086: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        ((sequence_number != NULL) && (clds_sorted_list->config->sequence_number == NULL))
         )
     {
         LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_SORTED_LIST_ITEM** old_item=%p, int64_t* sequence_number=%p",
@@ -1266,14 +1621,14 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
         check_lock_and_begin_write_operation(clds_sorted_list);
 
         bool restart_needed;
-        void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, new_item);
+        void* new_item_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, new_item);
         int64_t insert_seq_no = 0;
         
         /* Codes_SRS_CLDS_SORTED_LIST_01_091: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-        if (clds_sorted_list->sequence_number != NULL)
+        if (clds_sorted_list->config->sequence_number != NULL)
         {
             /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-            insert_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+            insert_seq_no = interlocked_increment_64(clds_sorted_list->config->sequence_number);
 
             /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
             if (sequence_number != NULL)
@@ -1409,9 +1764,9 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                         else
                         {
                             // we are in a stable state, compare the current item key to our key
-                            void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                            void* current_item_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
 
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
+                            int compare_result = clds_sorted_list->config->key_compare_cb(clds_sorted_list->config->key_compare_cb_context, new_item_key, current_item_key);
                             if (compare_result == 0)
                             {
                                 if (condition_check_func != NULL)
@@ -1489,17 +1844,17 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                     break;
                                 }
 
-                                if (clds_sorted_list->sequence_number != NULL)
+                                if (clds_sorted_list->config->sequence_number != NULL)
                                 {
-                                    if (interlocked_add_64(clds_sorted_list->sequence_number, 0) != insert_seq_no)
+                                    if (interlocked_add_64(clds_sorted_list->config->sequence_number, 0) != insert_seq_no)
                                     {
-                                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                        if (clds_sorted_list->config->skipped_seq_no_cb != NULL)
                                         {
-                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, insert_seq_no);
+                                            clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, insert_seq_no);
                                         }
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                        insert_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+                                        insert_seq_no = interlocked_increment_64(clds_sorted_list->config->sequence_number);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
                                         if (sequence_number != NULL)
@@ -1587,7 +1942,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                         *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
                                         (void)clds_sorted_list_node_inc_ref(*old_item);
 
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_nodes);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
                                         result = CLDS_SORTED_LIST_SET_VALUE_OK;
@@ -1623,7 +1978,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                         *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
                                         (void)clds_sorted_list_node_inc_ref(*old_item);
 
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_nodes);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
                                         result = CLDS_SORTED_LIST_SET_VALUE_OK;
@@ -1731,9 +2086,9 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
         if (result != CLDS_SORTED_LIST_SET_VALUE_OK)
         {
             // the insert as part of set value did not really materialize
-            if (clds_sorted_list->skipped_seq_no_cb != NULL)
+            if (clds_sorted_list->config->skipped_seq_no_cb != NULL)
             {
-                clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, insert_seq_no);
+                clds_sorted_list->config->skipped_seq_no_cb(clds_sorted_list->config->skipped_seq_no_cb_context, insert_seq_no);
             }
         }
     }
@@ -1904,6 +2259,166 @@ CLDS_SORTED_LIST_GET_ALL_RESULT clds_sorted_list_get_all(CLDS_SORTED_LIST_HANDLE
     return result;
 }
 
+CLDS_SORTED_LIST_VISIT_RESULT clds_sorted_list_visit(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    CLDS_SORTED_LIST_VISIT_RESULT result;
+
+    if (
+        /*Codes_SRS_CLDS_SORTED_LIST_07_001: [ If clds_sorted_list is NULL then clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /*Codes_SRS_CLDS_SORTED_LIST_07_002: [ If clds_hazard_pointers_thread is NULL then clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /*Codes_SRS_CLDS_SORTED_LIST_07_003: [ If visit_cb is NULL then clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+        (visit_cb == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, SORTED_LIST_VISIT_CB visit_cb=%p, void* visit_cb_context=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, visit_cb, visit_cb_context);
+        result = CLDS_SORTED_LIST_VISIT_ERROR;
+    }
+    else
+    {
+        // the last visited item is kept under a hazard pointer when the walk restarts, so that the items up to its key are not visited again
+        CLDS_SORTED_LIST_ITEM* last_visited_item = NULL;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE last_visited_hp = NULL;
+        bool restart_needed;
+        uint64_t iteration_count = 0;
+
+        do
+        {
+            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+            {
+                LogInfo("clds_sorted_list_visit spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+                iteration_count = 0;
+            }
+
+            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+            volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
+
+            do
+            {
+                // get the current_item value
+                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+
+                // clear any delete lock bit from what we read
+                current_item = (void*)((uintptr_t)current_item & ~0x1);
+
+                if (current_item == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    /*Codes_SRS_CLDS_SORTED_LIST_07_008: [ When the end of the list is reached clds_sorted_list_visit shall succeed and return CLDS_SORTED_LIST_VISIT_OK. ]*/
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_VISIT_OK;
+                    break;
+                }
+
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    /*Codes_SRS_CLDS_SORTED_LIST_07_009: [ If any error occurs, clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+                    LogError("Cannot acquire hazard pointer");
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_VISIT_ERROR;
+                    break;
+                }
+
+                // now make sure the item has not changed
+                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
+                {
+                    // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                    if (previous_hp != NULL)
+                    {
+                        if (last_visited_hp == NULL)
+                        {
+                            // the previous item is the last visited one, keep it protected while catching up
+                            last_visited_hp = previous_hp;
+                        }
+                        else
+                        {
+                            // let go of previous hazard pointer
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        }
+                    }
+
+                    restart_needed = true;
+                    break;
+                }
+
+                bool already_visited = false;
+                if (last_visited_hp != NULL)
+                {
+                    /*Codes_SRS_CLDS_SORTED_LIST_07_006: [ If the walk has to be restarted because the list changed, clds_sorted_list_visit shall skip the items with a key lower or equal to the key of the last visited item. ]*/
+                    void* last_visited_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, last_visited_item);
+                    void* current_item_key = clds_sorted_list->config->get_item_key_cb(clds_sorted_list->config->get_item_key_cb_context, current_item);
+                    if (clds_sorted_list->config->key_compare_cb(clds_sorted_list->config->key_compare_cb_context, current_item_key, last_visited_key) <= 0)
+                    {
+                        already_visited = true;
+                    }
+                    else
+                    {
+                        // caught up with where the walk was before the restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, last_visited_hp);
+                        last_visited_hp = NULL;
+                    }
+                }
+
+                if (!already_visited)
+                {
+                    /*Codes_SRS_CLDS_SORTED_LIST_07_004: [ clds_sorted_list_visit shall walk the items of the list in key order, while protecting each item with a hazard pointer. ]*/
+                    /*Codes_SRS_CLDS_SORTED_LIST_07_005: [ For each item, clds_sorted_list_visit shall call visit_cb with visit_cb_context and the item. ]*/
+                    if (!visit_cb(visit_cb_context, current_item))
+                    {
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                        if (previous_hp != NULL)
+                        {
+                            // let go of previous hazard pointer
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        }
+
+                        /*Codes_SRS_CLDS_SORTED_LIST_07_007: [ If visit_cb returns false, clds_sorted_list_visit shall stop and return CLDS_SORTED_LIST_VISIT_STOPPED. ]*/
+                        restart_needed = false;
+                        result = CLDS_SORTED_LIST_VISIT_STOPPED;
+                        break;
+                    }
+
+                    last_visited_item = current_item;
+                }
+
+                // we have a stable pointer to the current item, now simply set the previous to be this
+                if (previous_hp != NULL)
+                {
+                    // let go of previous hazard pointer
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                }
+
+                previous_hp = current_item_hp;
+                current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
+            } while (1);
+        } while (restart_needed);
+
+        if (last_visited_hp != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, last_visited_hp);
+        }
+    }
+
+    return result;
+}
+
 CLDS_SORTED_LIST_ITEM* clds_sorted_list_node_create(size_t node_size, SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
 {
     /* Codes_SRS_CLDS_SORTED_LIST_01_036: [ item_cleanup_callback shall be allowed to be NULL. ]*/
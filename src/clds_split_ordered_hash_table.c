@@ -0,0 +1,1128 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "c_logging/logger.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/sync.h"
+#include "c_pal/interlocked.h"
+#include "c_pal/thandle.h"
+#include "c_util/cancellation_token.h"
+
+#include "clds/clds_sorted_list.h"
+#include "clds/clds_hazard_pointers.h"
+
+#include "clds/clds_split_ordered_hash_table.h"
+
+/* this is a split ordered list hash table implementation (Shalev/Shavit) */
+
+// All the items live in one sorted list, ordered by their bit reversed hash.
+// Each bucket is a sorted list whose head points to a bucket start node that is part of that one list,
+// so growing the table only means adding more bucket start nodes, items are never moved.
+
+MU_DEFINE_ENUM_STRINGS(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+
+// the pending write operations are counted in several counters, so that writers on different threads do not contend on one cache line
+#define PENDING_WRITE_OPERATIONS_STRIPE_BITS 4
+#define PENDING_WRITE_OPERATIONS_STRIPE_COUNT (1 << PENDING_WRITE_OPERATIONS_STRIPE_BITS)
+#define CACHE_LINE_SIZE 64
+
+// segment 0 holds the buckets 0 and 1, segment i (i > 0) holds the buckets [2^i, 2^(i+1))
+#define SEGMENT_COUNT 30
+#define MAX_BUCKET_COUNT ((int32_t)1 << SEGMENT_COUNT)
+
+typedef struct PENDING_WRITE_OPERATIONS_STRIPE_TAG
+{
+    volatile_atomic int32_t count;
+    uint8_t padding[CACHE_LINE_SIZE - sizeof(int32_t)];
+} PENDING_WRITE_OPERATIONS_STRIPE;
+
+typedef struct CLDS_SPLIT_ORDERED_HASH_TABLE_TAG
+{
+    COMPUTE_HASH_FUNC compute_hash;
+    KEY_COMPARE_FUNC key_compare_func;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    volatile_atomic int64_t* sequence_number;
+    SPLIT_ORDERED_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
+    void* skipped_seq_no_cb_context;
+
+    // callbacks and sequence number shared by the lists of all the buckets
+    CLDS_SORTED_LIST_CONFIG sorted_list_config;
+
+    // the bucket count only grows, a bucket gets its start node the first time it is used
+    volatile_atomic int32_t bucket_count;
+    volatile_atomic int32_t item_count;
+    CLDS_SORTED_LIST* volatile_atomic segments[SEGMENT_COUNT];
+
+    // Support for locking the table for writes
+    volatile_atomic int32_t locked_for_write;
+    volatile_atomic int32_t write_lock_waiters; // writers only wake when someone waits in internal_lock_writes
+    PENDING_WRITE_OPERATIONS_STRIPE pending_write_operations[PENDING_WRITE_OPERATIONS_STRIPE_COUNT];
+} CLDS_SPLIT_ORDERED_HASH_TABLE;
+
+typedef struct SET_VALUE_CONDITION_CHECK_CONTEXT_TAG
+{
+    CONDITION_CHECK_CB condition_check_func;
+    void* condition_check_context;
+} SET_VALUE_CONDITION_CHECK_CONTEXT;
+
+typedef struct SNAPSHOT_CONTEXT_TAG
+{
+    THANDLE(CANCELLATION_TOKEN) cancellation_token;
+    CLDS_SORTED_LIST_ITEM** items;
+    uint64_t item_capacity;
+    uint64_t item_count;
+    bool is_cancelled;
+} SNAPSHOT_CONTEXT;
+
+static volatile_atomic int32_t* get_pending_write_operations(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    // the hazard pointers thread handle is unique per thread, so it is used to pick the counter (Fibonacci hashing of the address)
+    uint32_t stripe_index = ((uint32_t)((uintptr_t)clds_hazard_pointers_thread >> 4) * 2654435761U) >> (32 - PENDING_WRITE_OPERATIONS_STRIPE_BITS);
+    return &clds_split_ordered_hash_table->pending_write_operations[stripe_index].count;
+}
+
+static void wake_write_lock_waiters(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, volatile_atomic int32_t* pending_write_operations)
+{
+    // the waiter registers itself before reading the pending counts, so either it sees the decrement or we see the waiter
+    if (interlocked_add(&clds_split_ordered_hash_table->write_lock_waiters, 0) != 0)
+    {
+        wake_by_address_all(pending_write_operations);
+    }
+}
+
+static void check_lock_and_begin_write_operation(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    volatile_atomic int32_t* pending_write_operations = get_pending_write_operations(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+    int32_t locked_for_write;
+    do
+    {
+        (void)interlocked_increment(pending_write_operations);
+        locked_for_write = interlocked_add(&clds_split_ordered_hash_table->locked_for_write, 0);
+        if (locked_for_write != 0)
+        {
+            (void)interlocked_decrement(pending_write_operations);
+            wake_write_lock_waiters(clds_split_ordered_hash_table, pending_write_operations);
+
+            // Wait for unlock
+            (void)wait_on_address(&clds_split_ordered_hash_table->locked_for_write, locked_for_write, UINT32_MAX);
+        }
+    } while (locked_for_write != 0);
+}
+
+static void end_write_operation(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    volatile_atomic int32_t* pending_write_operations = get_pending_write_operations(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+    (void)interlocked_decrement(pending_write_operations);
+    wake_write_lock_waiters(clds_split_ordered_hash_table, pending_write_operations);
+}
+
+static void internal_lock_writes(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_054: [ clds_split_ordered_hash_table_snapshot shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+    (void)interlocked_increment(&clds_split_ordered_hash_table->locked_for_write);
+
+    bool registered_as_waiter = false;
+    for (uint32_t i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
+    {
+        volatile_atomic int32_t* pending_write_operations = &clds_split_ordered_hash_table->pending_write_operations[i].count;
+        int32_t pending_writes;
+        while ((pending_writes = interlocked_add(pending_write_operations, 0)) != 0)
+        {
+            if (!registered_as_waiter)
+            {
+                // register and read the count again, so that the wake for the last write is not missed
+                (void)interlocked_increment(&clds_split_ordered_hash_table->write_lock_waiters);
+                registered_as_waiter = true;
+            }
+            else
+            {
+                // Wait for writes
+                (void)wait_on_address(pending_write_operations, pending_writes, UINT32_MAX);
+            }
+        }
+    }
+
+    if (registered_as_waiter)
+    {
+        (void)interlocked_decrement(&clds_split_ordered_hash_table->write_lock_waiters);
+    }
+}
+
+static void internal_unlock_writes(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_060: [ clds_split_ordered_hash_table_snapshot shall unlock the table for writes. ]*/
+    (void)interlocked_decrement(&clds_split_ordered_hash_table->locked_for_write);
+    wake_by_address_all(&clds_split_ordered_hash_table->locked_for_write);
+}
+
+static uint64_t reverse_bits(uint64_t value)
+{
+    value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+    value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    value = ((value >> 8) & 0x00FF00FF00FF00FFULL) | ((value & 0x00FF00FF00FF00FFULL) << 8);
+    value = ((value >> 16) & 0x0000FFFF0000FFFFULL) | ((value & 0x0000FFFF0000FFFFULL) << 16);
+    return (value >> 32) | (value << 32);
+}
+
+static uint64_t get_item_split_order_hash(uint64_t hash)
+{
+    // the lowest bit is set so that an item always sorts after the start node of its bucket
+    return reverse_bits(hash) | 1;
+}
+
+static uint64_t get_bucket_split_order_hash(uint32_t bucket_index)
+{
+    return reverse_bits(bucket_index);
+}
+
+static bool is_bucket_start(const SPLIT_ORDERED_HASH_TABLE_KEY* key)
+{
+    return (key->split_order_hash & 1) == 0;
+}
+
+static uint32_t get_segment_index(uint32_t bucket_index)
+{
+    // position of the highest bit that is set, buckets 0 and 1 are both in segment 0
+    uint32_t segment_index = 0;
+    while ((bucket_index >>= 1) != 0)
+    {
+        segment_index++;
+    }
+
+    return segment_index;
+}
+
+static uint32_t get_segment_first_bucket(uint32_t segment_index)
+{
+    return (segment_index == 0) ? 0 : ((uint32_t)1 << segment_index);
+}
+
+static uint32_t get_segment_size(uint32_t segment_index)
+{
+    return (segment_index == 0) ? 2 : ((uint32_t)1 << segment_index);
+}
+
+static void* get_item_key_cb(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, item);
+    (void)context;
+    return &split_ordered_hash_table_item->key;
+}
+
+static int key_compare_cb(void* context, void* key1, void* key2)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table = context;
+    SPLIT_ORDERED_HASH_TABLE_KEY* split_ordered_key_1 = key1;
+    SPLIT_ORDERED_HASH_TABLE_KEY* split_ordered_key_2 = key2;
+    int result;
+
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_003: [ The items shall be kept in one sorted list, ordered by the bit reversed hash of their key and then by key_compare_func. ]*/
+    if (split_ordered_key_1->split_order_hash < split_ordered_key_2->split_order_hash)
+    {
+        result = -1;
+    }
+    else if (split_ordered_key_1->split_order_hash > split_ordered_key_2->split_order_hash)
+    {
+        result = 1;
+    }
+    else if (is_bucket_start(split_ordered_key_1))
+    {
+        // bucket start nodes have no user key
+        result = 0;
+    }
+    else
+    {
+        result = clds_split_ordered_hash_table->key_compare_func(split_ordered_key_1->key, split_ordered_key_2->key);
+    }
+
+    return result;
+}
+
+static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequence_no)
+{
+    if (context == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_061: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
+        LogError("Invalid arguments: void* context=%p, int64_t skipped_sequence_no=%" PRId64,
+            context, skipped_sequence_no);
+    }
+    else
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table = context;
+        if (clds_split_ordered_hash_table->skipped_seq_no_cb == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_062: [ If the sequence number callback passed to clds_split_ordered_hash_table_create was NULL, on_sorted_list_skipped_seq_no shall return. ]*/
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_063: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_split_ordered_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
+            clds_split_ordered_hash_table->skipped_seq_no_cb(clds_split_ordered_hash_table->skipped_seq_no_cb_context, skipped_sequence_no);
+        }
+    }
+}
+
+static CLDS_SORTED_LIST_ITEM* create_bucket_start_node(uint32_t bucket_index)
+{
+    CLDS_SORTED_LIST_ITEM* result = CLDS_SORTED_LIST_NODE_CREATE(SPLIT_ORDERED_HASH_TABLE_ITEM, NULL, NULL);
+    if (result == NULL)
+    {
+        LogError("CLDS_SORTED_LIST_NODE_CREATE failed for the start node of bucket %" PRIu32 "", bucket_index);
+    }
+    else
+    {
+        SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, result);
+        split_ordered_hash_table_item->item_cleanup_callback = NULL;
+        split_ordered_hash_table_item->item_cleanup_callback_context = NULL;
+        split_ordered_hash_table_item->key.split_order_hash = get_bucket_split_order_hash(bucket_index);
+        split_ordered_hash_table_item->key.key = NULL;
+    }
+
+    return result;
+}
+
+static CLDS_SORTED_LIST* get_segment(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, uint32_t segment_index)
+{
+    CLDS_SORTED_LIST* result = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->segments[segment_index], NULL, NULL);
+    if (result == NULL)
+    {
+        uint32_t segment_size = get_segment_size(segment_index);
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_005: [ The bucket lists shall be allocated in segments that double in size, the first time a bucket in the segment is used. ]*/
+        CLDS_SORTED_LIST* new_segment = malloc_2(segment_size, sizeof(CLDS_SORTED_LIST));
+        if (new_segment == NULL)
+        {
+            LogError("malloc_2(segment_size=%" PRIu32 ", sizeof(CLDS_SORTED_LIST)=%zu) failed", segment_size, sizeof(CLDS_SORTED_LIST));
+        }
+        else
+        {
+            for (uint32_t i = 0; i < segment_size; i++)
+            {
+                clds_sorted_list_init(&new_segment[i], &clds_split_ordered_hash_table->sorted_list_config);
+            }
+
+            result = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->segments[segment_index], new_segment, NULL);
+            if (result == NULL)
+            {
+                result = new_segment;
+            }
+            else
+            {
+                // another thread installed the segment first, use that one
+                free(new_segment);
+            }
+        }
+    }
+
+    return result;
+}
+
+static CLDS_SORTED_LIST_HANDLE get_bucket_list(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t bucket_index);
+
+static int initialize_bucket(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_HANDLE bucket_list, uint32_t bucket_index)
+{
+    int result;
+
+    // the parent is the bucket that this bucket splits from, the bucket index without its highest bit
+    uint32_t parent_bucket_index = bucket_index & ~((uint32_t)1 << get_segment_index(bucket_index));
+    CLDS_SORTED_LIST_HANDLE parent_bucket_list = get_bucket_list(clds_split_ordered_hash_table, clds_hazard_pointers_thread, parent_bucket_index);
+    if (parent_bucket_list == NULL)
+    {
+        LogError("Cannot get the list of bucket %" PRIu32 ", parent of bucket %" PRIu32 "", parent_bucket_index, bucket_index);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        CLDS_SORTED_LIST_ITEM* bucket_start = create_bucket_start_node(bucket_index);
+        if (bucket_start == NULL)
+        {
+            LogError("create_bucket_start_node failed");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            int64_t sequence_number;
+            int64_t* sequence_number_ptr = (clds_split_ordered_hash_table->sequence_number == NULL) ? NULL : &sequence_number;
+
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_006: [ When a bucket is used for the first time, a bucket start node shall be inserted in the list of its parent bucket (the bucket index without its highest bit set) by calling clds_sorted_list_insert. ]*/
+            CLDS_SORTED_LIST_INSERT_RESULT insert_result = clds_sorted_list_insert(parent_bucket_list, clds_hazard_pointers_thread, bucket_start, sequence_number_ptr);
+            if (insert_result == CLDS_SORTED_LIST_INSERT_OK)
+            {
+                if (sequence_number_ptr != NULL)
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_007: [ The sequence number consumed by inserting a bucket start node shall be reported as skipped by calling the skipped sequence number callback passed to clds_split_ordered_hash_table_create (if not NULL). ]*/
+                    if (clds_split_ordered_hash_table->skipped_seq_no_cb != NULL)
+                    {
+                        clds_split_ordered_hash_table->skipped_seq_no_cb(clds_split_ordered_hash_table->skipped_seq_no_cb_context, sequence_number);
+                    }
+                }
+            }
+            else
+            {
+                clds_sorted_list_node_release(bucket_start);
+
+                if (insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_008: [ If another thread already inserted the bucket start node, the existing node shall be looked up by calling clds_sorted_list_find_key. ]*/
+                    SPLIT_ORDERED_HASH_TABLE_KEY bucket_start_key = { get_bucket_split_order_hash(bucket_index), NULL };
+                    bucket_start = clds_sorted_list_find_key(parent_bucket_list, clds_hazard_pointers_thread, &bucket_start_key);
+                    if (bucket_start == NULL)
+                    {
+                        LogError("Cannot find the start node of bucket %" PRIu32 "", bucket_index);
+                    }
+                    else
+                    {
+                        // bucket start nodes are never removed, so the node stays valid without the reference
+                        clds_sorted_list_node_release(bucket_start);
+                    }
+                }
+                else
+                {
+                    LogError("clds_sorted_list_insert failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_INSERT_RESULT, insert_result));
+                    bucket_start = NULL;
+                }
+            }
+
+            if (bucket_start == NULL)
+            {
+                result = MU_FAILURE;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_009: [ The head of the bucket list shall be set to the bucket start node, so that the operations on the bucket start walking the list from there. ]*/
+                // all the threads racing here set the same node, so whoever is first wins
+                (void)interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_list->head, bucket_start, NULL);
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+static CLDS_SORTED_LIST_HANDLE get_bucket_list(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t bucket_index)
+{
+    CLDS_SORTED_LIST_HANDLE result;
+    uint32_t segment_index = get_segment_index(bucket_index);
+    CLDS_SORTED_LIST* segment = get_segment(clds_split_ordered_hash_table, segment_index);
+    if (segment == NULL)
+    {
+        LogError("Cannot get segment %" PRIu32 " for bucket %" PRIu32 "", segment_index, bucket_index);
+        result = NULL;
+    }
+    else
+    {
+        result = &segment[bucket_index - get_segment_first_bucket(segment_index)];
+        if (
+            (interlocked_compare_exchange_pointer((void* volatile_atomic*)&result->head, NULL, NULL) == NULL) &&
+            (initialize_bucket(clds_split_ordered_hash_table, clds_hazard_pointers_thread, result, bucket_index) != 0)
+            )
+        {
+            LogError("initialize_bucket failed for bucket %" PRIu32 "", bucket_index);
+            result = NULL;
+        }
+    }
+
+    return result;
+}
+
+static CLDS_SORTED_LIST_HANDLE get_bucket_list_for_hash(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_004: [ The bucket of a key shall be the hash of the key masked with the bucket count minus 1. ]*/
+    int32_t bucket_count = interlocked_add(&clds_split_ordered_hash_table->bucket_count, 0);
+    return get_bucket_list(clds_split_ordered_hash_table, clds_hazard_pointers_thread, (uint32_t)(hash & (uint64_t)(bucket_count - 1)));
+}
+
+static void grow_if_needed(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, int32_t item_count)
+{
+    int32_t bucket_count = interlocked_add(&clds_split_ordered_hash_table->bucket_count, 0);
+    if ((item_count >= bucket_count) && (bucket_count < MAX_BUCKET_COUNT))
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_019: [ If the number of items reaches the number of buckets, clds_split_ordered_hash_table_insert shall double the number of buckets. ]*/
+        // no item moves, the new buckets get their start nodes when they are first used
+        (void)interlocked_compare_exchange(&clds_split_ordered_hash_table->bucket_count, bucket_count * 2, bucket_count);
+    }
+}
+
+static CLDS_CONDITION_CHECK_RESULT set_value_condition_check(void* context, void* new_key, void* old_key)
+{
+    SET_VALUE_CONDITION_CHECK_CONTEXT* condition_check_context = context;
+
+    // the list keys are the split ordered keys, the user callback gets the keys it passed in
+    return condition_check_context->condition_check_func(condition_check_context->condition_check_context, ((SPLIT_ORDERED_HASH_TABLE_KEY*)new_key)->key, ((SPLIT_ORDERED_HASH_TABLE_KEY*)old_key)->key);
+}
+
+static bool add_item_to_snapshot(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    bool result;
+    SNAPSHOT_CONTEXT* snapshot_context = context;
+    SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, item);
+
+    if (is_bucket_start(&split_ordered_hash_table_item->key))
+    {
+        if (
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_058: [ If cancellation_token is non-NULL and cancellation_token_is_canceled returns true for cancellation_token, clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+            (snapshot_context->cancellation_token != NULL) &&
+            (cancellation_token_is_canceled(snapshot_context->cancellation_token))
+            )
+        {
+            LogVerbose("snapshot cancelled");
+            snapshot_context->is_cancelled = true;
+            result = false;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_057: [ clds_split_ordered_hash_table_snapshot shall skip the bucket start nodes. ]*/
+            result = true;
+        }
+    }
+    else if (snapshot_context->item_count == snapshot_context->item_capacity)
+    {
+        LogError("More items in the table than counted: %" PRIu64 "", snapshot_context->item_capacity);
+        result = false;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_056: [ clds_split_ordered_hash_table_snapshot shall walk the list by calling clds_sorted_list_visit and add each item to the array, incrementing its reference count. ]*/
+        (void)clds_sorted_list_node_inc_ref(item);
+        snapshot_context->items[snapshot_context->item_count++] = item;
+        result = true;
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, SPLIT_ORDERED_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table;
+
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_010: [ start_sequence_number, skipped_seq_no_cb and skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_011: [ If compute_hash is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_012: [ If key_compare_func is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_013: [ If initial_bucket_size is 0, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size == 0) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_014: [ If clds_hazard_pointers is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_015: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+        )
+    {
+        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p, SPLIT_ORDERED_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_001: [ clds_split_ordered_hash_table_create shall create a new split ordered hash table object and on success it shall return a non-NULL handle to the newly created table. ]*/
+        clds_split_ordered_hash_table = malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE));
+        if (clds_split_ordered_hash_table == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_002: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+            LogError("Cannot allocate memory for split ordered hash table");
+        }
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_016: [ clds_split_ordered_hash_table_create shall initialize the sorted list configuration shared by all the buckets by calling clds_sorted_list_config_init, passing start_sequence_number to it. ]*/
+        else if (clds_sorted_list_config_init(&clds_split_ordered_hash_table->sorted_list_config, clds_hazard_pointers, get_item_key_cb, clds_split_ordered_hash_table, key_compare_cb, clds_split_ordered_hash_table, start_sequence_number, start_sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_split_ordered_hash_table) != 0)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_002: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+            LogError("clds_sorted_list_config_init failed");
+        }
+        else
+        {
+            uint32_t i;
+
+            clds_split_ordered_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+            clds_split_ordered_hash_table->compute_hash = compute_hash;
+            clds_split_ordered_hash_table->key_compare_func = key_compare_func;
+            clds_split_ordered_hash_table->sequence_number = start_sequence_number;
+            clds_split_ordered_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
+            clds_split_ordered_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+
+            for (i = 0; i < PENDING_WRITE_OPERATIONS_STRIPE_COUNT; i++)
+            {
+                (void)interlocked_exchange(&clds_split_ordered_hash_table->pending_write_operations[i].count, 0);
+            }
+            (void)interlocked_exchange(&clds_split_ordered_hash_table->write_lock_waiters, 0);
+            (void)interlocked_exchange(&clds_split_ordered_hash_table->locked_for_write, 0);
+
+            for (i = 0; i < SEGMENT_COUNT; i++)
+            {
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->segments[i], NULL);
+            }
+
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_017: [ The bucket count shall be initial_bucket_size rounded up to a power of 2 (at least 2). ]*/
+            int32_t bucket_count = 2;
+            while (((size_t)bucket_count < initial_bucket_size) && (bucket_count < MAX_BUCKET_COUNT))
+            {
+                bucket_count *= 2;
+            }
+            (void)interlocked_exchange(&clds_split_ordered_hash_table->bucket_count, bucket_count);
+            (void)interlocked_exchange(&clds_split_ordered_hash_table->item_count, 0);
+
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_018: [ clds_split_ordered_hash_table_create shall allocate the first segment of buckets and the start node of bucket 0, which is the head of the list that holds all the items. ]*/
+            CLDS_SORTED_LIST* first_segment = get_segment(clds_split_ordered_hash_table, 0);
+            if (first_segment == NULL)
+            {
+                LogError("get_segment failed for segment 0");
+            }
+            else
+            {
+                CLDS_SORTED_LIST_ITEM* bucket_start = create_bucket_start_node(0);
+                if (bucket_start == NULL)
+                {
+                    LogError("create_bucket_start_node failed for bucket 0");
+                    free(first_segment);
+                }
+                else
+                {
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&first_segment[0].head, bucket_start);
+
+                    goto all_ok;
+                }
+            }
+        }
+
+        free(clds_split_ordered_hash_table);
+    }
+
+    clds_split_ordered_hash_table = NULL;
+
+all_ok:
+    return clds_split_ordered_hash_table;
+}
+
+static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, item);
+
+    (void)context;
+    if (split_ordered_hash_table_item->item_cleanup_callback != NULL)
+    {
+        split_ordered_hash_table_item->item_cleanup_callback(split_ordered_hash_table_item->item_cleanup_callback_context, (void*)item);
+    }
+}
+
+void clds_split_ordered_hash_table_destroy(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    if (clds_split_ordered_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_020: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p", clds_split_ordered_hash_table);
+    }
+    else
+    {
+        uint32_t i;
+        CLDS_SORTED_LIST* first_segment = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->segments[0], NULL, NULL);
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_021: [ clds_split_ordered_hash_table_destroy shall release all the items and bucket start nodes by walking the list once, starting at bucket 0. ]*/
+        // the bucket lists share their nodes, so they are not deinitialized one by one
+        CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&first_segment[0].head, NULL, NULL);
+        while (current_item != NULL)
+        {
+            CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL) & ~0x1);
+
+            clds_sorted_list_node_release(current_item);
+            current_item = next_item;
+        }
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_022: [ clds_split_ordered_hash_table_destroy shall free all resources associated with the table. ]*/
+        for (i = 0; i < SEGMENT_COUNT; i++)
+        {
+            CLDS_SORTED_LIST* segment = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->segments[i], NULL, NULL);
+            if (segment != NULL)
+            {
+                free(segment);
+            }
+        }
+
+        free(clds_split_ordered_hash_table);
+    }
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT clds_split_ordered_hash_table_insert(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_023: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_024: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_025: [ If key is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_026: [ If value is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_027: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_028: [ clds_split_ordered_hash_table_insert shall wait until the table is not locked for writes and count the insert as a pending write operation. ]*/
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+
+        SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, value);
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_029: [ clds_split_ordered_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_split_ordered_hash_table_create. ]*/
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        split_ordered_hash_table_item->key.split_order_hash = get_item_split_order_hash(hash);
+        split_ordered_hash_table_item->key.key = key;
+
+        CLDS_SORTED_LIST_HANDLE bucket_list = get_bucket_list_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_list == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_032: [ If any error is encountered while inserting the item, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot get the bucket list for hash %" PRIu64 "", hash);
+            result = CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_030: [ clds_split_ordered_hash_table_insert shall insert the item in the list of its bucket by calling clds_sorted_list_insert, passing sequence_number to it. ]*/
+            CLDS_SORTED_LIST_INSERT_RESULT list_insert_result = clds_sorted_list_insert(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
+            if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_031: [ If the key already exists in the table, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+            }
+            else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_032: [ If any error is encountered while inserting the item, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+                LogError("clds_sorted_list_insert failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_INSERT_RESULT, list_insert_result));
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR;
+            }
+            else
+            {
+                grow_if_needed(clds_split_ordered_hash_table, interlocked_increment(&clds_split_ordered_hash_table->item_count));
+
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_033: [ On success clds_split_ordered_hash_table_insert shall return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK. ]*/
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK;
+            }
+        }
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_034: [ clds_split_ordered_hash_table_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT clds_split_ordered_hash_table_delete(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_035: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_036: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_037: [ If key is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_038: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, sequence_number);
+        result = CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_039: [ clds_split_ordered_hash_table_delete shall wait until the table is not locked for writes and count the delete as a pending write operation. ]*/
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        SPLIT_ORDERED_HASH_TABLE_KEY search_key = { get_item_split_order_hash(hash), key };
+
+        CLDS_SORTED_LIST_HANDLE bucket_list = get_bucket_list_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_list == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_043: [ If any error is encountered, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+            LogError("Cannot get the bucket list for hash %" PRIu64 "", hash);
+            result = CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_040: [ clds_split_ordered_hash_table_delete shall delete the key from the list of its bucket by calling clds_sorted_list_delete_key, passing sequence_number to it. ]*/
+            CLDS_SORTED_LIST_DELETE_RESULT list_delete_result = clds_sorted_list_delete_key(bucket_list, clds_hazard_pointers_thread, &search_key, sequence_number);
+            if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_041: [ If the key is not found, clds_split_ordered_hash_table_delete shall return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_NOT_FOUND;
+            }
+            else if (list_delete_result != CLDS_SORTED_LIST_DELETE_OK)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_043: [ If any error is encountered, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+                LogError("clds_sorted_list_delete_key failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_DELETE_RESULT, list_delete_result));
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR;
+            }
+            else
+            {
+                (void)interlocked_decrement(&clds_split_ordered_hash_table->item_count);
+
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_042: [ On success clds_split_ordered_hash_table_delete shall return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_OK. ]*/
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_OK;
+            }
+        }
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_044: [ clds_split_ordered_hash_table_delete shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT clds_split_ordered_hash_table_remove(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_045: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_046: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_047: [ If key is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_048: [ If item is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_049: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, item, sequence_number);
+        result = CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_050: [ clds_split_ordered_hash_table_remove shall wait until the table is not locked for writes and count the remove as a pending write operation. ]*/
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        SPLIT_ORDERED_HASH_TABLE_KEY search_key = { get_item_split_order_hash(hash), key };
+
+        CLDS_SORTED_LIST_HANDLE bucket_list = get_bucket_list_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_list == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_053: [ If any error is encountered, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+            LogError("Cannot get the bucket list for hash %" PRIu64 "", hash);
+            result = CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_051: [ clds_split_ordered_hash_table_remove shall remove the key from the list of its bucket by calling clds_sorted_list_remove_key, passing sequence_number to it, and return the removed item in item. ]*/
+            CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, &search_key, (void*)item, sequence_number);
+            if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_052: [ If the key is not found, clds_split_ordered_hash_table_remove shall return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_NOT_FOUND;
+            }
+            else if (list_remove_result != CLDS_SORTED_LIST_REMOVE_OK)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_053: [ If any error is encountered, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+                LogError("clds_sorted_list_remove_key failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_REMOVE_RESULT, list_remove_result));
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR;
+            }
+            else
+            {
+                (void)interlocked_decrement(&clds_split_ordered_hash_table->item_count);
+
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_OK;
+            }
+        }
+
+        end_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT clds_split_ordered_hash_table_set_value(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_064: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_065: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_066: [ If key is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_067: [ If new_item is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_068: [ If old_item is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_069: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
+        result = CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_070: [ clds_split_ordered_hash_table_set_value shall wait until the table is not locked for writes and count the set value as a pending write operation. ]*/
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+
+        SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, new_item);
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        split_ordered_hash_table_item->key.split_order_hash = get_item_split_order_hash(hash);
+        split_ordered_hash_table_item->key.key = key;
+
+        CLDS_SORTED_LIST_HANDLE bucket_list = get_bucket_list_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_list == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_074: [ If any error is encountered, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+            LogError("Cannot get the bucket list for hash %" PRIu64 "", hash);
+            result = CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR;
+        }
+        else
+        {
+            SET_VALUE_CONDITION_CHECK_CONTEXT set_value_condition_check_context = { condition_check_func, condition_check_context };
+
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_071: [ clds_split_ordered_hash_table_set_value shall call clds_sorted_list_set_value on the list of the bucket of the key, passing new_item, old_item, sequence_number and only_if_exists set to false. ]*/
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_072: [ If condition_check_func is not NULL, it shall be called with condition_check_context and the keys of the new and old items. ]*/
+            CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, &split_ordered_hash_table_item->key, (void*)new_item,
+                (condition_check_func == NULL) ? NULL : set_value_condition_check, &set_value_condition_check_context, (void*)old_item, sequence_number, false);
+            if (sorted_list_set_value_result == CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_073: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+                LogError("Condition not met during set value - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
+            }
+            else if (sorted_list_set_value_result != CLDS_SORTED_LIST_SET_VALUE_OK)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_074: [ If any error is encountered, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                LogError("Cannot set key in sorted list - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR;
+            }
+            else
+            {
+                if (*old_item == NULL)
+                {
+                    grow_if_needed(clds_split_ordered_hash_table, interlocked_increment(&clds_split_ordered_hash_table->item_count));
+                }
+
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_075: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_split_ordered_hash_table_set_value shall succeed and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_OK. ]*/
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_OK;
+            }
+        }
+
+        end_write_operation(clds_split_ordered_hash_table, clds_hazard_pointers_thread);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* clds_split_ordered_hash_table_find(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_076: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_077: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_078: [ If key is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        SPLIT_ORDERED_HASH_TABLE_KEY search_key = { get_item_split_order_hash(hash), key };
+
+        CLDS_SORTED_LIST_HANDLE bucket_list = get_bucket_list_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_list == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_081: [ If any error occurs, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+            LogError("Cannot get the bucket list for hash %" PRIu64 "", hash);
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_079: [ clds_split_ordered_hash_table_find shall find the key in the list of its bucket by calling clds_sorted_list_find_key and return the item with its reference count incremented. ]*/
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_080: [ If the key is not found, clds_split_ordered_hash_table_find shall return NULL. ]*/
+            result = (void*)clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, &search_key);
+        }
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT clds_split_ordered_hash_table_snapshot(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*** items, uint64_t* item_count, THANDLE(CANCELLATION_TOKEN) cancellation_token)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_082: [ If clds_split_ordered_hash_table is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_083: [ If clds_hazard_pointers_thread is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_084: [ If items is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_085: [ If item_count is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, THANDLE(CANCELLATION_TOKEN) cancellation_token=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, items, item_count, cancellation_token);
+        result = CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        internal_lock_writes(clds_split_ordered_hash_table);
+
+        uint64_t temp_item_count = (uint64_t)interlocked_add(&clds_split_ordered_hash_table->item_count, 0);
+        if (temp_item_count == 0)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_086: [ If there are no items then clds_split_ordered_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK. ]*/
+            *items = NULL;
+            *item_count = 0;
+            result = CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_055: [ clds_split_ordered_hash_table_snapshot shall allocate an array of CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* sized by the item count of the table. ]*/
+            CLDS_SORTED_LIST_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+            if (items_to_return == NULL)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_087: [ If there are any other failures then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
+                    (size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+                result = CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else
+            {
+                SNAPSHOT_CONTEXT snapshot_context;
+                snapshot_context.cancellation_token = cancellation_token;
+                snapshot_context.items = items_to_return;
+                snapshot_context.item_capacity = temp_item_count;
+                snapshot_context.item_count = 0;
+                snapshot_context.is_cancelled = false;
+
+                // bucket 0 starts the list that has all the items
+                CLDS_SORTED_LIST* first_segment = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->segments[0], NULL, NULL);
+                CLDS_SORTED_LIST_VISIT_RESULT visit_result = clds_sorted_list_visit(&first_segment[0], clds_hazard_pointers_thread, add_item_to_snapshot, &snapshot_context);
+                if (visit_result != CLDS_SORTED_LIST_VISIT_OK)
+                {
+                    if (snapshot_context.is_cancelled)
+                    {
+                        result = CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ABANDONED;
+                    }
+                    else
+                    {
+                        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_087: [ If there are any other failures then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                        LogError("clds_sorted_list_visit failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_VISIT_RESULT, visit_result));
+                        result = CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR;
+                    }
+
+                    for (uint64_t i = 0; i < snapshot_context.item_count; i++)
+                    {
+                        clds_sorted_list_node_release(items_to_return[i]);
+                    }
+                    free(items_to_return);
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_059: [ clds_split_ordered_hash_table_snapshot shall store the allocated array of items in items and the count of items in item_count and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    *items = (CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM**)items_to_return;
+                    *item_count = snapshot_context.item_count;
+                    result = CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK;
+                }
+            }
+        }
+
+        internal_unlock_writes(clds_split_ordered_hash_table);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* clds_split_ordered_hash_table_node_create(size_t node_size, SPLIT_ORDERED_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_088: [ clds_split_ordered_hash_table_node_create shall allocate a node of node_size bytes, store item_cleanup_callback and item_cleanup_callback_context in it and set its reference count to 1. ]*/
+    void* result = malloc(node_size);
+
+    if (result == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_089: [ If any error happens, clds_split_ordered_hash_table_node_create shall fail and return NULL. ]*/
+        LogError("malloc(node_size=%zu) failed", node_size);
+    }
+    else
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = result;
+        SPLIT_ORDERED_HASH_TABLE_ITEM* split_ordered_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(SPLIT_ORDERED_HASH_TABLE_ITEM, item);
+        split_ordered_hash_table_item->item_cleanup_callback = item_cleanup_callback;
+        split_ordered_hash_table_item->item_cleanup_callback_context = item_cleanup_callback_context;
+        split_ordered_hash_table_item->key.split_order_hash = 1;
+        split_ordered_hash_table_item->key.key = NULL;
+        item->item.item_cleanup_callback = sorted_list_item_cleanup;
+        item->item.item_cleanup_callback_context = (void*)item;
+        (void)interlocked_exchange(&item->item.ref_count, 1);
+        (void)interlocked_exchange_pointer((void* volatile_atomic*)&item->item.next, NULL);
+    }
+
+    return result;
+}
+
+int clds_split_ordered_hash_table_node_inc_ref(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item)
+{
+    int result;
+
+    if (item == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_090: [ If item is NULL, clds_split_ordered_hash_table_node_inc_ref shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item=%p", item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_091: [ clds_split_ordered_hash_table_node_inc_ref shall increment the reference count of item by calling clds_sorted_list_node_inc_ref. ]*/
+        if (clds_sorted_list_node_inc_ref((void*)item) != 0)
+        {
+            LogError("clds_sorted_list_node_inc_ref failed");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+void clds_split_ordered_hash_table_node_release(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item)
+{
+    if (item == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_092: [ If item is NULL, clds_split_ordered_hash_table_node_release shall return. ]*/
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item=%p", item);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_093: [ clds_split_ordered_hash_table_node_release shall release the item by calling clds_sorted_list_node_release, which calls item_cleanup_callback when the reference count reaches 0. ]*/
+        clds_sorted_list_node_release((void*)item);
+    }
+}
@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/threadapi.h"
+#include "c_pal/interlocked.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#include "clds/clds_flat_hash_map.h"
+
+#define THREAD_COUNT 4
+
+#ifdef _MSC_VER
+// on Windows run with more iterations. Normally this should be passed as an argument, but this should also do for now.
+#define INSERT_COUNT 100000
+#else
+// setting this way lower as we run with Helgrind on Linux and that is ... slow
+#define INSERT_COUNT 10000
+#endif
+
+// number of keys all the threads fight over in the contention test
+#define SHARED_KEY_COUNT 16
+
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_RESULT_VALUES);
+
+typedef struct TEST_ITEM_TAG
+{
+    uint64_t key;
+} TEST_ITEM;
+
+DECLARE_FLAT_HASH_MAP_NODE_TYPE(TEST_ITEM)
+
+typedef struct THREAD_DATA_TAG
+{
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers;
+    uint32_t thread_index;
+} THREAD_DATA;
+
+static CLDS_FLAT_HASH_MAP_ITEM* create_test_item(uint64_t key)
+{
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    ASSERT_IS_NOT_NULL(item, "Cannot create item for key %" PRIu64 "", key);
+    TEST_ITEM* test_item = CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, item);
+    test_item->key = key;
+    return item;
+}
+
+static int insert_find_delete_own_keys_thread(void* arg)
+{
+    THREAD_DATA* thread_data = arg;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(thread_data->hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        uint64_t key = ((uint64_t)thread_data->thread_index << 32) | (i + 1);
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, clds_flat_hash_map_insert(thread_data->flat_hash_map, hazard_pointers_thread, key, create_test_item(key)));
+    }
+
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        uint64_t key = ((uint64_t)thread_data->thread_index << 32) | (i + 1);
+        CLDS_FLAT_HASH_MAP_ITEM* item = clds_flat_hash_map_find(thread_data->flat_hash_map, hazard_pointers_thread, key);
+        ASSERT_IS_NOT_NULL(item, "Key %" PRIu64 " not found", key);
+        ASSERT_ARE_EQUAL(uint64_t, key, CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, item)->key);
+        CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        uint64_t key = ((uint64_t)thread_data->thread_index << 32) | (i + 1);
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_OK, clds_flat_hash_map_delete(thread_data->flat_hash_map, hazard_pointers_thread, key));
+        ASSERT_IS_NULL(clds_flat_hash_map_find(thread_data->flat_hash_map, hazard_pointers_thread, key));
+    }
+
+    clds_hazard_pointers_unregister_thread(hazard_pointers_thread);
+
+    return 0;
+}
+
+static int insert_find_delete_shared_keys_thread(void* arg)
+{
+    THREAD_DATA* thread_data = arg;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(thread_data->hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        uint64_t key = ((i + thread_data->thread_index) % SHARED_KEY_COUNT) + 1;
+
+        CLDS_FLAT_HASH_MAP_ITEM* new_item = create_test_item(key);
+        CLDS_FLAT_HASH_MAP_INSERT_RESULT insert_result = clds_flat_hash_map_insert(thread_data->flat_hash_map, hazard_pointers_thread, key, new_item);
+        if (insert_result != CLDS_FLAT_HASH_MAP_INSERT_OK)
+        {
+            // somebody else owns the key right now
+            ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS, insert_result);
+            CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, new_item);
+        }
+
+        CLDS_FLAT_HASH_MAP_ITEM* item = clds_flat_hash_map_find(thread_data->flat_hash_map, hazard_pointers_thread, key);
+        if (item != NULL)
+        {
+            // whatever item we got has to stay valid and belong to the key until we release it
+            ASSERT_ARE_EQUAL(uint64_t, key, CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, item)->key);
+            CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+        }
+
+        CLDS_FLAT_HASH_MAP_DELETE_RESULT delete_result = clds_flat_hash_map_delete(thread_data->flat_hash_map, hazard_pointers_thread, key);
+        ASSERT_IS_TRUE((delete_result == CLDS_FLAT_HASH_MAP_DELETE_OK) || (delete_result == CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND));
+    }
+
+    clds_hazard_pointers_unregister_thread(hazard_pointers_thread);
+
+    return 0;
+}
+
+static int insert_find_delete_new_keys_thread(void* arg)
+{
+    THREAD_DATA* thread_data = arg;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(thread_data->hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        // every key is new, so it can only get a slot that another key left behind
+        uint64_t key = ((uint64_t)thread_data->thread_index << 32) | (i + 1);
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, clds_flat_hash_map_insert(thread_data->flat_hash_map, hazard_pointers_thread, key, create_test_item(key)));
+
+        CLDS_FLAT_HASH_MAP_ITEM* item = clds_flat_hash_map_find(thread_data->flat_hash_map, hazard_pointers_thread, key);
+        ASSERT_IS_NOT_NULL(item, "Key %" PRIu64 " not found", key);
+        ASSERT_ARE_EQUAL(uint64_t, key, CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, item)->key);
+        CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_OK, clds_flat_hash_map_delete(thread_data->flat_hash_map, hazard_pointers_thread, key));
+    }
+
+    clds_hazard_pointers_unregister_thread(hazard_pointers_thread);
+
+    return 0;
+}
+
+static void run_threads(THREAD_START_FUNC thread_func, CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map, CLDS_HAZARD_POINTERS_HANDLE hazard_pointers)
+{
+    THREAD_HANDLE threads[THREAD_COUNT];
+    THREAD_DATA thread_data[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        thread_data[i].flat_hash_map = flat_hash_map;
+        thread_data[i].hazard_pointers = hazard_pointers;
+        thread_data[i].thread_index = i;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&threads[i], thread_func, &thread_data[i]));
+    }
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(threads[i], &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Thread %" PRIu32 " failed", i);
+    }
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, gballoc_hl_init(NULL, NULL));
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+TEST_FUNCTION(clds_flat_hash_map_insert_find_delete_from_multiple_threads_on_distinct_keys_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(THREAD_COUNT * INSERT_COUNT * 2, hazard_pointers);
+    ASSERT_IS_NOT_NULL(flat_hash_map);
+
+    // act
+    // assert
+    run_threads(insert_find_delete_own_keys_thread, flat_hash_map, hazard_pointers);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_flat_hash_map_insert_find_delete_from_multiple_threads_on_the_same_keys_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(SHARED_KEY_COUNT, hazard_pointers);
+    ASSERT_IS_NOT_NULL(flat_hash_map);
+
+    // act
+    // assert
+    // the map has exactly one slot per key, so this only works if deleted slots are recycled
+    run_threads(insert_find_delete_shared_keys_thread, flat_hash_map, hazard_pointers);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_flat_hash_map_insert_find_delete_from_multiple_threads_on_new_keys_never_fills_the_map)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(THREAD_COUNT, hazard_pointers);
+    ASSERT_IS_NOT_NULL(flat_hash_map);
+
+    // act
+    // assert
+    // each thread has at most one live key, so the map never fills up although it sees THREAD_COUNT * INSERT_COUNT distinct keys
+    run_threads(insert_find_delete_new_keys_thread, flat_hash_map, hazard_pointers);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
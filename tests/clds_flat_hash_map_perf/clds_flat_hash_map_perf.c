@@ -0,0 +1,375 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "c_logging/logger.h"
+
+#include "c_pal/threadapi.h"
+#include "c_pal/timer.h"
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "clds/clds_flat_hash_map.h"
+
+#include "clds_flat_hash_map_perf.h"
+
+#define THREAD_COUNT 8
+#define INSERT_COUNT 100000
+
+typedef struct TEST_ITEM_TAG
+{
+    uint64_t key;
+} TEST_ITEM;
+
+DECLARE_FLAT_HASH_MAP_NODE_TYPE(TEST_ITEM)
+
+typedef struct THREAD_DATA_TAG
+{
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    CLDS_FLAT_HASH_MAP_ITEM* items[INSERT_COUNT];
+    double runtime;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+} THREAD_DATA;
+
+static int insert_thread(void* arg)
+{
+    size_t i;
+    THREAD_DATA* thread_data = arg;
+    int result;
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < INSERT_COUNT; i++)
+    {
+        TEST_ITEM* test_item = CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, thread_data->items[i]);
+        if (clds_flat_hash_map_insert(thread_data->flat_hash_map, thread_data->clds_hazard_pointers_thread, test_item->key, thread_data->items[i]) != CLDS_FLAT_HASH_MAP_INSERT_OK)
+        {
+            LogError("Error inserting");
+            break;
+        }
+    }
+
+    if (i < INSERT_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int delete_thread(void* arg)
+{
+    size_t i;
+    THREAD_DATA* thread_data = arg;
+    int result;
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < INSERT_COUNT; i++)
+    {
+        TEST_ITEM* test_item = CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, thread_data->items[i]);
+        if (clds_flat_hash_map_delete(thread_data->flat_hash_map, thread_data->clds_hazard_pointers_thread, test_item->key) != CLDS_FLAT_HASH_MAP_DELETE_OK)
+        {
+            LogError("Error deleting");
+            break;
+        }
+    }
+
+    if (i < INSERT_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int find_thread(void* arg)
+{
+    size_t i;
+    THREAD_DATA* thread_data = arg;
+    int result;
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < INSERT_COUNT; i++)
+    {
+        TEST_ITEM* test_item = CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, thread_data->items[i]);
+        CLDS_FLAT_HASH_MAP_ITEM* found_item = clds_flat_hash_map_find(thread_data->flat_hash_map, thread_data->clds_hazard_pointers_thread, test_item->key);
+        if (found_item == NULL)
+        {
+            LogError("Error finding");
+            break;
+        }
+        else
+        {
+            CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, found_item);
+        }
+    }
+
+    if (i < INSERT_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    return result;
+}
+
+static void clds_flat_hash_map_perf_run(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    THREAD_HANDLE threads[THREAD_COUNT];
+    THREAD_DATA* thread_data;
+    size_t i;
+    size_t j;
+
+    LogInfo("Running with reclamation mode %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, reclamation_mode));
+
+    clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(reclamation_mode);
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Error creating hazard pointers");
+    }
+    else
+    {
+        // keep the load factor at 50% so that probe sequences stay short
+        flat_hash_map = clds_flat_hash_map_create(THREAD_COUNT * INSERT_COUNT * 2, clds_hazard_pointers);
+        if (flat_hash_map == NULL)
+        {
+            LogError("Error creating flat hash map");
+        }
+        else
+        {
+            LogInfo("Generating data");
+
+            thread_data = malloc_2(THREAD_COUNT, sizeof(THREAD_DATA));
+            if (thread_data == NULL)
+            {
+                LogError("Error allocating thread data array");
+            }
+            else
+            {
+                for (i = 0; i < THREAD_COUNT; i++)
+                {
+                    thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+                    thread_data[i].flat_hash_map = flat_hash_map;
+
+                    for (j = 0; j < INSERT_COUNT; j++)
+                    {
+                        thread_data[i].items[j] = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+                        if (thread_data[i].items[j] == NULL)
+                        {
+                            LogError("Error allocating test item");
+                            break;
+                        }
+                        else
+                        {
+                            // unique non-zero key per thread and item
+                            TEST_ITEM* test_item = CLDS_FLAT_HASH_MAP_GET_VALUE(TEST_ITEM, thread_data[i].items[j]);
+                            test_item->key = ((uint64_t)i << 32) | (uint64_t)(j + 1);
+                        }
+                    }
+
+                    if (j < INSERT_COUNT)
+                    {
+                        size_t k;
+
+                        for (k = 0; k < j; k++)
+                        {
+                            CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, thread_data[i].items[k]);
+                        }
+                    }
+                }
+
+                if (i < THREAD_COUNT)
+                {
+                    LogError("Error creating test thread data");
+                }
+                else
+                {
+                    // insert test
+
+                    LogInfo("Starting test");
+
+                    for (i = 0; i < THREAD_COUNT; i++)
+                    {
+                        if (ThreadAPI_Create(&threads[i], insert_thread, &thread_data[i]) != THREADAPI_OK)
+                        {
+                            LogError("Error spawning test thread");
+                            break;
+                        }
+                    }
+
+                    if (i < THREAD_COUNT)
+                    {
+                        for (j = 0; j < i; j++)
+                        {
+                            int dont_care;
+                            (void)ThreadAPI_Join(threads[j], &dont_care);
+                        }
+                    }
+                    else
+                    {
+                        bool is_error = false;
+                        double runtime = 0.0;
+
+                        for (i = 0; i < THREAD_COUNT; i++)
+                        {
+                            int thread_result;
+                            (void)ThreadAPI_Join(threads[i], &thread_result);
+                            if (thread_result != 0)
+                            {
+                                is_error = true;
+                            }
+                            else
+                            {
+                                runtime += thread_data[i].runtime;
+                            }
+                        }
+
+                        if (!is_error)
+                        {
+                            LogInfo("Insert test done in %.02f ms, %.02f inserts/s/thread, %.02f inserts/s on all threads",
+                                runtime,
+                                ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                                ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+
+                            // find test
+
+                            for (i = 0; i < THREAD_COUNT; i++)
+                            {
+                                if (ThreadAPI_Create(&threads[i], find_thread, &thread_data[i]) != THREADAPI_OK)
+                                {
+                                    LogError("Error spawning test thread");
+                                    break;
+                                }
+                            }
+
+                            if (i < THREAD_COUNT)
+                            {
+                                for (j = 0; j < i; j++)
+                                {
+                                    int dont_care;
+                                    (void)ThreadAPI_Join(threads[j], &dont_care);
+                                }
+                            }
+                            else
+                            {
+                                is_error = false;
+                                runtime = 0;
+
+                                for (i = 0; i < THREAD_COUNT; i++)
+                                {
+                                    int thread_result;
+                                    (void)ThreadAPI_Join(threads[i], &thread_result);
+                                    if (thread_result != 0)
+                                    {
+                                        is_error = true;
+                                    }
+                                    else
+                                    {
+                                        runtime += thread_data[i].runtime;
+                                    }
+                                }
+
+                                if (!is_error)
+                                {
+                                    LogInfo("Find test done in %.02f ms, %.02f finds/s/thread, %.02f finds/s on all threads",
+                                        runtime,
+                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                }
+
+                                // delete test
+
+                                for (i = 0; i < THREAD_COUNT; i++)
+                                {
+                                    if (ThreadAPI_Create(&threads[i], delete_thread, &thread_data[i]) != THREADAPI_OK)
+                                    {
+                                        LogError("Error spawning test thread");
+                                        break;
+                                    }
+                                }
+
+                                if (i < THREAD_COUNT)
+                                {
+                                    for (j = 0; j < i; j++)
+                                    {
+                                        int dont_care;
+                                        (void)ThreadAPI_Join(threads[j], &dont_care);
+                                    }
+                                }
+                                else
+                                {
+                                    is_error = false;
+                                    runtime = 0;
+
+                                    for (i = 0; i < THREAD_COUNT; i++)
+                                    {
+                                        int thread_result;
+                                        (void)ThreadAPI_Join(threads[i], &thread_result);
+                                        if (thread_result != 0)
+                                        {
+                                            is_error = true;
+                                        }
+                                        else
+                                        {
+                                            runtime += thread_data[i].runtime;
+                                        }
+                                    }
+
+                                    if (!is_error)
+                                    {
+                                        LogInfo("Delete test done in %.02f ms, %.02f deletes/s/thread, %.02f deletes/s on all threads",
+                                            runtime,
+                                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    for (i = 0; i < THREAD_COUNT; i++)
+                    {
+                        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                    }
+
+                    free(thread_data);
+                }
+            }
+
+            clds_flat_hash_map_destroy(flat_hash_map);
+        }
+
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
+}
+
+int clds_flat_hash_map_perf_main(void)
+{
+    // same workload as clds_hash_table_perf (with 64 bit keys) so that the two can be compared
+    clds_flat_hash_map_perf_run(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+    clds_flat_hash_map_perf_run(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+
+    return 0;
+}
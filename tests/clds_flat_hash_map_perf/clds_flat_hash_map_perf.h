@@ -0,0 +1,10 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_FLAT_HASH_MAP_PERF_H
+#define CLDS_FLAT_HASH_MAP_PERF_H
+
+
+int clds_flat_hash_map_perf_main(void);
+
+
+#endif /* CLDS_FLAT_HASH_MAP_PERF_H */
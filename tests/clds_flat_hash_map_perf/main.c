@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+
+#include "c_logging/logger.h"
+
+#include "clds_flat_hash_map_perf.h"
+
+int main(void)
+{
+    (void)logger_init();
+
+    clds_flat_hash_map_perf_main();
+
+    logger_deinit();
+
+    return 0;
+}
@@ -0,0 +1,1293 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include "clds_flat_hash_map_ut_pch.h"
+
+void* real_malloc(size_t size)
+{
+    return real_gballoc_ll_malloc(size);
+}
+void real_free(void* ptr)
+{
+    real_gballoc_ll_free(ptr);
+}
+
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, CLDS_FLAT_HASH_MAP_ITEM*, item)
+MOCK_FUNCTION_END()
+
+typedef struct TEST_ITEM_TAG
+{
+    uint32_t dummy;
+} TEST_ITEM;
+
+DECLARE_FLAT_HASH_MAP_NODE_TYPE(TEST_ITEM)
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    ASSERT_ARE_EQUAL(int, 0, real_gballoc_hl_init(NULL, NULL));
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init failed");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types failed");
+
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+
+    REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+
+    REGISTER_TYPE(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_RESULT);
+    REGISTER_TYPE(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_RESULT);
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_BATCH_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    real_gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+/* clds_flat_hash_map_create */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_001: [ clds_flat_hash_map_create shall create a new flat hash map object with an array of slot_count slots and on success it shall return a non-NULL handle to the newly created flat hash map. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_006: [ clds_flat_hash_map_create shall initialize all slots as empty. ]*/
+TEST_FUNCTION(clds_flat_hash_map_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+
+    // act
+    flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(flat_hash_map);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_002: [ If capacity is 0, clds_flat_hash_map_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_create_with_0_capacity_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    umock_c_reset_all_calls();
+
+    // act
+    flat_hash_map = clds_flat_hash_map_create(0, hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_map);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_003: [ If capacity is greater than 2^31, clds_flat_hash_map_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_create_with_capacity_greater_than_2_to_the_31_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    umock_c_reset_all_calls();
+
+    // act
+    flat_hash_map = clds_flat_hash_map_create(((uint32_t)1 << 31) + 1, hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_map);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_004: [ If clds_hazard_pointers is NULL, clds_flat_hash_map_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_create_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+
+    // act
+    flat_hash_map = clds_flat_hash_map_create(4, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_map);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_005: [ clds_flat_hash_map_create shall round capacity up to the next power of 2. ]*/
+TEST_FUNCTION(clds_flat_hash_map_create_rounds_capacity_up_to_a_power_of_2)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 8, IGNORED_ARG));
+
+    // act
+    flat_hash_map = clds_flat_hash_map_create(5, hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(flat_hash_map);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_007: [ If any error happens, clds_flat_hash_map_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_clds_flat_hash_map_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_map);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_map_destroy */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_008: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_destroy shall return. ]*/
+TEST_FUNCTION(clds_flat_hash_map_destroy_with_NULL_handle_returns)
+{
+    // arrange
+
+    // act
+    clds_flat_hash_map_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_010: [ clds_flat_hash_map_destroy shall free all resources associated with the flat hash map instance. ]*/
+TEST_FUNCTION(clds_flat_hash_map_destroy_frees_the_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(flat_hash_map));
+
+    // act
+    clds_flat_hash_map_destroy(flat_hash_map);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_009: [ For each item still in the flat hash map, clds_flat_hash_map_destroy shall release the reference held by the flat hash map. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_010: [ clds_flat_hash_map_destroy shall free all resources associated with the flat hash map instance. ]*/
+TEST_FUNCTION(clds_flat_hash_map_destroy_releases_the_items_in_the_map)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(free(flat_hash_map));
+
+    // act
+    clds_flat_hash_map_destroy(flat_hash_map);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_009: [ For each item still in the flat hash map, clds_flat_hash_map_destroy shall release the reference held by the flat hash map. ]*/
+TEST_FUNCTION(clds_flat_hash_map_destroy_does_not_free_items_still_referenced_by_the_user)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    (void)CLDS_FLAT_HASH_MAP_NODE_INC_REF(TEST_ITEM, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(flat_hash_map));
+
+    // act
+    clds_flat_hash_map_destroy(flat_hash_map);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_map_insert */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_011: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_with_NULL_clds_flat_hash_map_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(NULL, hazard_pointers_thread, 0x42, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_012: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, NULL, 0x42, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_013: [ If key is CLDS_FLAT_HASH_MAP_EMPTY_KEY, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_with_the_empty_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, CLDS_FLAT_HASH_MAP_EMPTY_KEY, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_014: [ If item is NULL, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_015: [ clds_flat_hash_map_insert shall hash key and probe linearly the slots starting at the slot given by the hash. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_016: [ If no tombstoned slot was probed and an empty slot was found, clds_flat_hash_map_insert shall claim it for key by using interlocked_compare_exchange_64, retrying the insert if another key claimed it in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_018: [ If the slot for key holds no item or a tombstone left by a delete, clds_flat_hash_map_insert shall set item in the slot by using interlocked_compare_exchange_pointer, retrying if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_019: [ On success clds_flat_hash_map_insert shall return CLDS_FLAT_HASH_MAP_INSERT_OK. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_015: [ clds_flat_hash_map_insert shall hash key and probe linearly the slots starting at the slot given by the hash. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_019: [ On success clds_flat_hash_map_insert shall return CLDS_FLAT_HASH_MAP_INSERT_OK. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_fills_all_the_slots)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* items[4];
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT results[4];
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        items[i] = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        results[i] = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, i + 1, items[i]);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, results[i]);
+    }
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_017: [ If the slot for key holds a live item, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_with_a_key_that_already_exists_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item_1 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_2 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_1);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_KEY_ALREADY_EXISTS, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_018: [ If the slot for key holds no item or a tombstone left by a delete, clds_flat_hash_map_insert shall set item in the slot by using interlocked_compare_exchange_pointer, retrying if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_019: [ On success clds_flat_hash_map_insert shall return CLDS_FLAT_HASH_MAP_INSERT_OK. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_reuses_the_tombstoned_slot_of_a_deleted_key)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(1, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item_1 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_2 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* found_item;
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_1);
+    (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, result);
+    found_item = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x42);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_020: [ If all the slots were probed without finding the slot of key, an empty slot or a tombstoned slot, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_FULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_in_a_full_map_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(2, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item_1 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_2 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_3 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x43, item_2);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x44, item_3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_FULL, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item_3);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_049: [ If the slot for key was not found, clds_flat_hash_map_insert shall take the claim sequence of the stripe of the start slot by changing it with interlocked_compare_exchange from the even value read before probing to the next odd value, retrying the insert if the claim sequence was odd or has changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_050: [ If a tombstoned slot was probed, clds_flat_hash_map_insert shall reuse the first tombstoned slot by replacing its tombstone with a claimed marker by using interlocked_compare_exchange_pointer, retrying the insert if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_051: [ clds_flat_hash_map_insert shall increment the generation of the reused slot, set key in it and then set item in it. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_052: [ clds_flat_hash_map_insert shall release the claim sequence by setting it to the next even value. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_reuses_the_tombstoned_slot_of_another_key)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(1, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item_1 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_2 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* found_item;
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_1);
+    (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x43, item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, result);
+    ASSERT_IS_NULL(clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x42));
+    found_item = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x43);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_050: [ If a tombstoned slot was probed, clds_flat_hash_map_insert shall reuse the first tombstoned slot by replacing its tombstone with a claimed marker by using interlocked_compare_exchange_pointer, retrying the insert if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_020: [ If all the slots were probed without finding the slot of key, an empty slot or a tombstoned slot, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_FULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_in_a_map_where_all_keys_were_deleted_reuses_all_the_slots)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* items[5];
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT results[5];
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, i + 1, CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL));
+    }
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, i + 1);
+    }
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        items[i] = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        results[i] = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, i + 0x100, items[i]);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_OK, results[i]);
+    }
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_FULL, results[4]);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, items[4]);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_020: [ If all the slots were probed without finding the slot of key, an empty slot or a tombstoned slot, clds_flat_hash_map_insert shall fail and return CLDS_FLAT_HASH_MAP_INSERT_FULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_insert_of_a_deleted_key_whose_slot_was_reused_by_another_key_in_a_full_map_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(1, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item_1 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_2 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_3 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_INSERT_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_1);
+    (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x43, item_2);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_INSERT_RESULT, CLDS_FLAT_HASH_MAP_INSERT_FULL, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item_3);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_map_delete */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_021: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_with_NULL_clds_flat_hash_map_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(NULL, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_022: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, NULL, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_023: [ If key is CLDS_FLAT_HASH_MAP_EMPTY_KEY, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_with_the_empty_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, CLDS_FLAT_HASH_MAP_EMPTY_KEY);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_024: [ clds_flat_hash_map_delete shall look for the slot of key by probing the slots in the same order as clds_flat_hash_map_insert. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_053: [ clds_flat_hash_map_delete shall acquire a hazard pointer on the item and check that the slot still holds the item for key, retrying if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_054: [ clds_flat_hash_map_delete shall release the hazard pointer. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_027: [ clds_flat_hash_map_delete shall replace the item in the slot with a tombstone tagged with the generation of the slot by using interlocked_compare_exchange_pointer, retrying if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_028: [ clds_flat_hash_map_delete shall indicate the deleted item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched, with a reclaim function that releases the reference held by the flat hash map. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_029: [ On success clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_OK. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_OK, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_028: [ clds_flat_hash_map_delete shall indicate the deleted item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched, with a reclaim function that releases the reference held by the flat hash map. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_does_not_free_an_item_still_referenced_by_the_user)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    (void)CLDS_FLAT_HASH_MAP_NODE_INC_REF(TEST_ITEM, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_OK, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_025: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_on_an_empty_map_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_025: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_on_a_full_map_without_the_key_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(1, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x43);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_026: [ If the slot for key does not hold a live item, clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_of_an_already_deleted_key_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_055: [ If acquiring the hazard pointer fails, clds_flat_hash_map_delete shall fail and return CLDS_FLAT_HASH_MAP_DELETE_ERROR. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_fails_clds_flat_hash_map_delete_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* found_item;
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_ERROR, result);
+    found_item = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x42);
+    ASSERT_ARE_EQUAL(void_ptr, item, found_item);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_025: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_delete shall return CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_flat_hash_map_delete_of_a_key_whose_slot_was_reused_by_another_key_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(1, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item_1 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* item_2 = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* found_item;
+    CLDS_FLAT_HASH_MAP_DELETE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item_1);
+    (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x43, item_2);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_MAP_DELETE_RESULT, CLDS_FLAT_HASH_MAP_DELETE_NOT_FOUND, result);
+    found_item = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x43);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_map_find */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_030: [ If clds_flat_hash_map is NULL, clds_flat_hash_map_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_with_NULL_clds_flat_hash_map_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_find(NULL, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_031: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_map_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_find(flat_hash_map, NULL, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_032: [ If key is CLDS_FLAT_HASH_MAP_EMPTY_KEY, clds_flat_hash_map_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_with_the_empty_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, CLDS_FLAT_HASH_MAP_EMPTY_KEY);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_033: [ clds_flat_hash_map_find shall look for the slot of key by probing the slots in the same order as clds_flat_hash_map_insert. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_036: [ clds_flat_hash_map_find shall acquire a hazard pointer on the item and check that the slot still holds the item for key, retrying if the slot changed in the meanwhile. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_037: [ On success clds_flat_hash_map_find shall increment the reference count of the item, release the hazard pointer and return the item. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, result);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_033: [ clds_flat_hash_map_find shall look for the slot of key by probing the slots in the same order as clds_flat_hash_map_insert. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_037: [ On success clds_flat_hash_map_find shall increment the reference count of the item, release the hazard pointer and return the item. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_finds_each_item_of_a_full_map)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* items[4];
+    CLDS_FLAT_HASH_MAP_ITEM* results[4];
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        items[i] = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, i + 1, items[i]);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        results[i] = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, i + 1);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        ASSERT_ARE_EQUAL(void_ptr, items[i], results[i]);
+    }
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, results[i]);
+    }
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_034: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_find shall return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_on_an_empty_map_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_034: [ If an empty slot is reached or all the slots were probed, clds_flat_hash_map_find shall return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_on_a_full_map_without_the_key_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(1, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x43);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_035: [ If the slot for key does not hold a live item, clds_flat_hash_map_find shall return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_find_of_a_deleted_key_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_MAP_HANDLE flat_hash_map = clds_flat_hash_map_create(4, hazard_pointers);
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_MAP_ITEM* result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_flat_hash_map_insert(flat_hash_map, hazard_pointers_thread, 0x42, item);
+    (void)clds_flat_hash_map_delete(flat_hash_map, hazard_pointers_thread, 0x42);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_find(flat_hash_map, hazard_pointers_thread, 0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_map_destroy(flat_hash_map);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_map_node_create */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_038: [ clds_flat_hash_map_node_create shall allocate a node of node_size bytes, store item_cleanup_callback and item_cleanup_callback_context in it and set its reference count to 1. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_create_succeeds)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(sizeof(FLAT_HASH_MAP_NODE_TEST_ITEM)));
+
+    // act
+    item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+    ASSERT_ARE_EQUAL(int32_t, 1, item->ref_count);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_039: [ item_cleanup_callback shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_create_with_NULL_item_cleanup_callback_succeeds)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_040: [ item_cleanup_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_create_with_NULL_item_cleanup_callback_context_succeeds)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_041: [ If any error happens, clds_flat_hash_map_node_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_malloc_fails_clds_flat_hash_map_node_create_fails)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(item);
+}
+
+/* clds_flat_hash_map_node_inc_ref */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_042: [ If item is NULL, clds_flat_hash_map_node_inc_ref shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_inc_ref_with_NULL_item_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_flat_hash_map_node_inc_ref(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_043: [ clds_flat_hash_map_node_inc_ref shall increment the reference count of item and return 0. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_inc_ref_increments_the_reference_count)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_map_node_inc_ref(item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int32_t, 2, item->ref_count);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* clds_flat_hash_map_node_release */
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_044: [ If item is NULL, clds_flat_hash_map_node_release shall return. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_release_with_NULL_item_returns)
+{
+    // arrange
+
+    // act
+    clds_flat_hash_map_node_release(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_045: [ clds_flat_hash_map_node_release shall decrement the reference count of item. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_release_with_2_references_does_not_free_the_item)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)CLDS_FLAT_HASH_MAP_NODE_INC_REF(TEST_ITEM, item);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_flat_hash_map_node_release(item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int32_t, 1, item->ref_count);
+
+    // cleanup
+    CLDS_FLAT_HASH_MAP_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_045: [ clds_flat_hash_map_node_release shall decrement the reference count of item. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_046: [ When the reference count reaches 0, the user callback item_cleanup_callback that was passed to clds_flat_hash_map_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments, and then the item shall be freed. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_release_frees_the_item_when_the_last_reference_is_released)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    clds_flat_hash_map_node_release(item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_MAP_07_047: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed item. ]*/
+TEST_FUNCTION(clds_flat_hash_map_node_release_with_NULL_item_cleanup_callback_only_frees_the_item)
+{
+    // arrange
+    CLDS_FLAT_HASH_MAP_ITEM* item = CLDS_FLAT_HASH_MAP_NODE_CREATE(TEST_ITEM, NULL, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    clds_flat_hash_map_node_release(item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+// Precompiled header for clds_flat_hash_map_ut
+
+#ifndef CLDS_FLAT_HASH_MAP_UT_PCH_H
+#define CLDS_FLAT_HASH_MAP_UT_PCH_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "real_gballoc_ll.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "c_pal/interlocked.h"
+
+#include "umock_c/umock_c_ENABLE_MOCKS.h" // ============================== ENABLE_MOCKS
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "clds/clds_hazard_pointers.h"
+
+#include "umock_c/umock_c_DISABLE_MOCKS.h" // ============================== DISABLE_MOCKS
+
+#include "real_gballoc_hl.h"
+
+#include "clds/clds_flat_hash_map.h"
+#include "../reals/real_clds_hazard_pointers.h"
+
+#endif // CLDS_FLAT_HASH_MAP_UT_PCH_H
@@ -2,6 +2,7 @@
 // Licensed under the MIT license.See LICENSE file in the project root for full license information.
 
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <stdbool.h>
 #include <time.h>
@@ -42,6 +43,11 @@ TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESU
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(SEQ_NO_STATE, SEQ_NO_STATE_VALUES);
 TEST_DEFINE_ENUM_TYPE(INTERLOCKED_HL_RESULT, INTERLOCKED_HL_RESULT_VALUES);
@@ -287,6 +293,53 @@ static int continuous_delete_key_value_thread(void* arg)
     return result;
 }
 
+// Like continuous_delete_key_value_thread, but drops the reference taken by the find before deleting, so the table holds the only reference to the item being deleted
+static int continuous_delete_key_value_without_reference_thread(void* arg)
+{
+    THREAD_DATA* thread_data = arg;
+    int result;
+
+    uint32_t i = thread_data->key;
+
+    do
+    {
+        while ((uint32_t)interlocked_add(&thread_data->shared->last_written_key, 0) < i)
+        {
+            if (interlocked_add(&thread_data->stop, 0) != 0)
+            {
+                // Don't wait forever if the insert thread isn't running any more
+                break;
+            }
+            // Spin
+        }
+
+        if (interlocked_add(&thread_data->stop, 0) != 0)
+        {
+            break;
+        }
+
+        // only this thread deletes the keys of its residue class, so the item stays in the table until the delete below
+        CLDS_HASH_TABLE_ITEM* item = clds_hash_table_find(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, (void*)(uintptr_t)(i + 1));
+        ASSERT_IS_NOT_NULL(item);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+
+        CLDS_HASH_TABLE_DELETE_RESULT delete_result;
+        int64_t seq_no;
+        delete_result = clds_hash_table_delete_key_value(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, (void*)(uintptr_t)(i + 1), item, &seq_no);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, delete_result);
+
+        i += thread_data->increment;
+
+#ifdef USE_VALGRIND
+        // yield
+        ThreadAPI_Sleep(0);
+#endif
+    } while (interlocked_add(&thread_data->stop, 0) == 0);
+
+    result = 0;
+    return result;
+}
+
 static int continuous_remove_thread(void* arg)
 {
     THREAD_DATA* thread_data = arg;
@@ -408,6 +461,44 @@ static int continuous_find_thread(void* arg)
 
 
 
+static void copy_visited_key(void* context, CLDS_HASH_TABLE_ITEM* item)
+{
+    uint32_t* visited_key = context;
+    *visited_key = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key;
+}
+
+static int continuous_find_and_visit_thread(void* arg)
+{
+    THREAD_DATA* thread_data = arg;
+    int result;
+
+    uint32_t i = thread_data->key;
+
+    do
+    {
+        // Just loop over everything forever
+        if ((uint32_t)interlocked_add(&thread_data->shared->last_written_key, 0) < i)
+        {
+            i = thread_data->key;
+        }
+
+        uint32_t visited_key = UINT32_MAX;
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_OK, clds_hash_table_find_and_visit(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, (void*)(uintptr_t)(i + 1), copy_visited_key, &visited_key));
+        ASSERT_ARE_EQUAL(uint32_t, i, visited_key);
+
+        i += thread_data->increment;
+
+#ifdef USE_VALGRIND
+        // yield
+        ThreadAPI_Sleep(0);
+#endif
+    } while (interlocked_add(&thread_data->stop, 0) == 0);
+
+    result = 0;
+
+    return result;
+}
+
 static void fill_hash_table_sequentially(CLDS_HASH_TABLE_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread, uint32_t count)
 {
     for (uint32_t i = 0; i < count; i++)
@@ -516,6 +607,69 @@ static void cleanup_snapshot(CLDS_HASH_TABLE_ITEM** items, uint64_t item_count)
     free(items);
 }
 
+typedef struct TEST_IMAGE_BUFFER_TAG
+{
+    unsigned char* buffer;
+    uint64_t size;
+} TEST_IMAGE_BUFFER;
+
+static uint32_t test_get_record_size(void* context, CLDS_HASH_TABLE_ITEM* item)
+{
+    (void)context;
+    (void)item;
+    return sizeof(TEST_ITEM);
+}
+
+static int test_serialize_record(void* context, CLDS_HASH_TABLE_ITEM* item, unsigned char* record, uint32_t record_size)
+{
+    (void)context;
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(TEST_ITEM), record_size);
+    (void)memcpy(record, CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item), sizeof(TEST_ITEM));
+    return 0;
+}
+
+static int test_write_image(void* context, uint64_t offset, const void* buffer, size_t buffer_size)
+{
+    int result;
+    TEST_IMAGE_BUFFER* image_buffer = context;
+
+    if (offset + buffer_size > image_buffer->size)
+    {
+        // the image is written in pieces, grow the buffer to fit the piece
+        unsigned char* new_buffer = realloc(image_buffer->buffer, (size_t)(offset + buffer_size));
+        ASSERT_IS_NOT_NULL(new_buffer);
+        image_buffer->buffer = new_buffer;
+        image_buffer->size = offset + buffer_size;
+    }
+
+    (void)memcpy(image_buffer->buffer + offset, buffer, buffer_size);
+    result = 0;
+
+    return result;
+}
+
+static CLDS_HASH_TABLE_ITEM* test_deserialize_record(void* context, const unsigned char* record, uint32_t record_size, void** key)
+{
+    (void)context;
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(TEST_ITEM), record_size);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    ASSERT_IS_NOT_NULL(item);
+    TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+    (void)memcpy(test_item, record, sizeof(TEST_ITEM));
+    // same keys as fill_hash_table_sequentially
+    *key = (void*)(uintptr_t)(test_item->key + 1);
+    return item;
+}
+
+static bool test_record_match(void* context, void* key, const unsigned char* record, uint32_t record_size)
+{
+    (void)context;
+    TEST_ITEM test_item;
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(TEST_ITEM), record_size);
+    (void)memcpy(&test_item, record, sizeof(TEST_ITEM));
+    return (uintptr_t)(test_item.key + 1) == (uintptr_t)key;
+}
+
 typedef struct CHAOS_THREAD_DATA_TAG
 {
     CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
@@ -830,6 +984,138 @@ TEST_FUNCTION(clds_hash_table_snapshot_works_with_10000_sequential_key_items)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+TEST_FUNCTION(clds_hash_table_insert_find_delete_batch_with_1000_keys_while_growing_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t key_count = 1000;
+    void** keys = malloc(sizeof(void*) * key_count);
+    ASSERT_IS_NOT_NULL(keys);
+    CLDS_HASH_TABLE_ITEM** items = malloc(sizeof(CLDS_HASH_TABLE_ITEM*) * key_count);
+    ASSERT_IS_NOT_NULL(items);
+    CLDS_HASH_TABLE_INSERT_RESULT* insert_results = malloc(sizeof(CLDS_HASH_TABLE_INSERT_RESULT) * key_count);
+    ASSERT_IS_NOT_NULL(insert_results);
+    CLDS_HASH_TABLE_DELETE_RESULT* delete_results = malloc(sizeof(CLDS_HASH_TABLE_DELETE_RESULT) * key_count);
+    ASSERT_IS_NOT_NULL(delete_results);
+
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        keys[i] = (void*)(uintptr_t)(i + 1);
+        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(items[i]);
+        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i]);
+        test_item->key = i + 1;
+    }
+
+    // act
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, key_count, insert_results, NULL));
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, insert_results[i], "Inserting key %" PRIu32 " failed", i + 1);
+    }
+
+    // the table grew while the batch was inserted, so the keys are spread over several bucket arrays
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, key_count, items));
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        ASSERT_IS_NOT_NULL(items[i], "Key %" PRIu32 " not found", i + 1);
+        ASSERT_ARE_EQUAL(uint32_t, i + 1, CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i])->key);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_delete_batch(hash_table, hazard_pointers_thread, keys, key_count, delete_results, NULL));
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, delete_results[i], "Deleting key %" PRIu32 " failed", i + 1);
+    }
+
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, key_count, items));
+    for (uint32_t i = 0; i < key_count; i++)
+    {
+        ASSERT_IS_NULL(items[i], "Key %" PRIu32 " still found after delete", i + 1);
+    }
+
+    // cleanup
+    free(delete_results);
+    free(insert_results);
+    free(items);
+    free(keys);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_restore_with_multiple_workers_of_an_image_of_10000_items_restores_all_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+
+    TEST_IMAGE_BUFFER image_buffer = { NULL, 0 };
+    uint64_t image_size;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_snapshot_image_write(hash_table, items, item_count, interlocked_add_64(&sequence_number, 0), test_get_record_size, test_serialize_record, NULL, test_write_image, &image_buffer, &image_size));
+    ASSERT_ARE_EQUAL(uint64_t, image_buffer.size, image_size);
+    cleanup_snapshot(items, item_count);
+
+    volatile_atomic int64_t restored_sequence_number = 0;
+    CLDS_HASH_TABLE_HANDLE restored_hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &restored_sequence_number, test_skipped_seq_no_ignore, NULL);
+    ASSERT_IS_NOT_NULL(restored_hash_table);
+    int64_t image_sequence_number;
+
+    // act
+    int result = clds_hash_table_restore(restored_hash_table, hazard_pointers_thread, THREAD_COUNT, image_buffer.buffer, image_size, test_deserialize_record, NULL, &image_sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, interlocked_add_64(&sequence_number, 0), image_sequence_number);
+    ASSERT_ARE_EQUAL(int64_t, image_sequence_number, interlocked_add_64(&restored_sequence_number, 0));
+
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(restored_hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present(original_count, items, item_count);
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        ASSERT_ARE_EQUAL(uint32_t, 42, CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i])->appendix);
+    }
+    cleanup_snapshot(items, item_count);
+
+    for (uint32_t i = 0; i < original_count; i++)
+    {
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(restored_hash_table, hazard_pointers_thread, (void*)(uintptr_t)(i + 1));
+        ASSERT_IS_NOT_NULL(found_item, "Key %" PRIu32 " not restored", i + 1);
+        ASSERT_ARE_EQUAL(uint32_t, i, CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, found_item)->key);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
+
+    const unsigned char* record;
+    uint32_t record_size;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_OK, clds_hash_table_snapshot_image_find(restored_hash_table, image_buffer.buffer, image_size, (void*)(uintptr_t)4242, test_record_match, NULL, &record, &record_size));
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(TEST_ITEM), record_size);
+
+    // cleanup
+    free(image_buffer.buffer);
+    clds_hash_table_destroy(restored_hash_table);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* Tests_SRS_CLDS_HASH_TABLE_42_017: [ clds_hash_table_snapshot shall increment a counter to lock the table for writes. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_018: [ clds_hash_table_snapshot shall wait for the ongoing write operations to complete. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_030: [ clds_hash_table_snapshot shall decrement the counter to unlock the table for writes. ]*/
@@ -1360,6 +1646,804 @@ TEST_FUNCTION(clds_hash_table_snapshot_works_with_multiple_concurrent_find)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+// Each delete thread deletes the keys of its residue class in increasing order, so the items that were in the table at the cut of a concurrent snapshot
+// are, for each residue class, all the keys from the first one not deleted yet to the end
+static void verify_concurrent_snapshot_with_ordered_deletes(uint32_t original_count, uint32_t thread_count, CLDS_HASH_TABLE_ITEM** items, uint64_t item_count)
+{
+    bool* found_array = malloc_2(original_count, sizeof(bool));
+    ASSERT_IS_NOT_NULL(found_array);
+
+    for (uint32_t i = 0; i < original_count; i++)
+    {
+        found_array[i] = false;
+    }
+
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i]);
+        ASSERT_IS_TRUE(test_item->key < original_count, "Found invalid key %" PRIu32, test_item->key);
+        ASSERT_IS_FALSE(found_array[test_item->key], "Found duplicate item with key %" PRIu32, test_item->key);
+        found_array[test_item->key] = true;
+    }
+
+    for (uint32_t i = thread_count; i < original_count; i++)
+    {
+        if (found_array[i - thread_count])
+        {
+            ASSERT_IS_TRUE(found_array[i], "Item with key %" PRIu32 " is missing from the snapshot, but key %" PRIu32 " which was deleted before it is there", i, i - thread_count);
+        }
+    }
+
+    free(found_array);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_040: [ The array shall also hold the items that were removed from the hash table while the snapshot was in progress, added by the writers that removed them. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_045: [ While a concurrent snapshot is in progress, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall increment the ref count of each item they take out of the table that the snapshot did not take yet and add it to the array of the snapshot. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_works_with_multiple_concurrent_deletes)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 100000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads that delete the items that the snapshot should return
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA delete_thread_data[THREAD_COUNT];
+    THREAD_HANDLE delete_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&delete_thread_data[i], &shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&delete_thread[i], continuous_delete_thread, &delete_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning delete test thread %" PRIu32, i);
+        }
+    }
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t snapshot_sequence_number;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, hazard_pointers_thread, &items, &item_count, &snapshot_sequence_number, NULL);
+
+    // Stop deletes
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&delete_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(delete_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    // each delete done before the cut took one sequence number
+    ASSERT_ARE_EQUAL(int64_t, 45 + (int64_t)original_count + (int64_t)(original_count - item_count), snapshot_sequence_number);
+    verify_concurrent_snapshot_with_ordered_deletes(original_count, THREAD_COUNT, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_268: [ While a concurrent snapshot is in progress, clds_hash_table_delete_key_value shall increment the ref count of value before deleting it and release it after preserving it for the snapshot. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_works_with_multiple_concurrent_delete_key_values)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 100000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads that delete by value the items that the snapshot should return, without holding a reference of their own
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA delete_thread_data[THREAD_COUNT];
+    THREAD_HANDLE delete_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&delete_thread_data[i], &shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&delete_thread[i], continuous_delete_key_value_without_reference_thread, &delete_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning delete test thread %" PRIu32, i);
+        }
+    }
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // Stop deletes
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&delete_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(delete_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    // reads the key of every item, including the ones deleted while the snapshot was in progress
+    verify_concurrent_snapshot_with_ordered_deletes(original_count, THREAD_COUNT, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_037: [ For each non-empty bucket in each bucket array, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and, for each visited item that was in the table when the snapshot epoch started and that was not taken by the snapshot yet, increment its ref count and add it to the array. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_works_with_multiple_concurrent_inserts_and_deletes)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // Write additional items that will get deleted
+    uint32_t original_count = 10000;
+    uint32_t next_insert = original_count + 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, next_insert);
+
+    // Start threads to insert additional items and delete
+    THREAD_DATA insert_thread_data[THREAD_COUNT];
+    THREAD_HANDLE insert_thread[THREAD_COUNT];
+
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA delete_thread_data[THREAD_COUNT];
+    THREAD_HANDLE delete_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, next_insert - 1);
+
+        initialize_thread_data(&insert_thread_data[i], &shared[i], hash_table, hazard_pointers, next_insert + i, THREAD_COUNT);
+
+        initialize_thread_data(&delete_thread_data[i], &shared[i], hash_table, hazard_pointers, next_insert + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&insert_thread[i], continuous_insert_thread, &insert_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+
+        if (ThreadAPI_Create(&delete_thread[i], continuous_delete_thread, &delete_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning delete test thread %" PRIu32, i);
+        }
+    }
+
+    // Make sure inserts and deletes have started
+    ThreadAPI_Sleep(1000);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // Inserts and deletes continue to run a bit longer to make sure we are in a good state
+    ThreadAPI_Sleep(1000);
+
+    // Stop inserts
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&delete_thread_data[i].stop, 1);
+        (void)interlocked_exchange(&insert_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(delete_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+
+        (void)ThreadAPI_Join(insert_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+static void migrate_until_complete(CLDS_HASH_TABLE_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread, uint32_t bucket_budget)
+{
+    CLDS_HASH_TABLE_MIGRATE_RESULT result;
+
+    do
+    {
+        result = clds_hash_table_migrate(hash_table, hazard_pointers_thread, bucket_budget);
+        ASSERT_IS_TRUE((result == CLDS_HASH_TABLE_MIGRATE_OK) || (result == CLDS_HASH_TABLE_MIGRATE_COMPLETE) || (result == CLDS_HASH_TABLE_MIGRATE_BUSY),
+            "Unexpected migrate result %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_HASH_TABLE_MIGRATE_RESULT, result));
+    } while (result != CLDS_HASH_TABLE_MIGRATE_COMPLETE);
+}
+
+TEST_FUNCTION(clds_hash_table_migrate_works_with_multiple_concurrent_find)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // starting with 1 bucket, this leaves the items spread over many bucket arrays
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads to find the existing items, find asserts that every item is found
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA find_thread_data[THREAD_COUNT];
+    THREAD_HANDLE find_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&find_thread_data[i], &shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&find_thread[i], continuous_find_thread, &find_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning find test thread %" PRIu32, i);
+        }
+    }
+
+    // Make sure find has started
+    ThreadAPI_Sleep(1000);
+
+    LogInfo("Migrating");
+
+    // act
+    migrate_until_complete(hash_table, hazard_pointers_thread, 16);
+
+    LogInfo("Migration complete");
+
+    // Find threads continue to run a bit longer to make sure we are in a good state
+    ThreadAPI_Sleep(1000);
+
+    // Stop find threads
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&find_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(find_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_migrate_works_with_multiple_concurrent_find_and_visit)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads that look at the existing items without taking references on them
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA find_thread_data[THREAD_COUNT];
+    THREAD_HANDLE find_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&find_thread_data[i], &shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&find_thread[i], continuous_find_and_visit_thread, &find_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning find and visit test thread %" PRIu32, i);
+        }
+    }
+
+    // Make sure the lookups have started
+    ThreadAPI_Sleep(1000);
+
+    // act
+    migrate_until_complete(hash_table, hazard_pointers_thread, 16);
+
+    ThreadAPI_Sleep(1000);
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&find_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(find_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_migrate_works_with_multiple_concurrent_find_while_inserts_and_deletes_add_bucket_arrays)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads to find the existing items, find asserts that every item is found
+    SHARED_KEY_INFO find_shared[THREAD_COUNT];
+    THREAD_DATA find_thread_data[THREAD_COUNT];
+    THREAD_HANDLE find_thread[THREAD_COUNT];
+
+    // Start threads to insert and delete additional items, so that new bucket arrays keep being added while buckets are moved
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+    THREAD_DATA insert_thread_data[THREAD_COUNT];
+    THREAD_HANDLE insert_thread[THREAD_COUNT];
+    THREAD_DATA delete_thread_data[THREAD_COUNT];
+    THREAD_HANDLE delete_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&find_shared[i].last_written_key, original_count - 1);
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&find_thread_data[i], &find_shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+        initialize_thread_data(&insert_thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+        initialize_thread_data(&delete_thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&find_thread[i], continuous_find_thread, &find_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning find test thread %" PRIu32, i);
+        }
+
+        if (ThreadAPI_Create(&insert_thread[i], continuous_insert_thread, &insert_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+
+        if (ThreadAPI_Create(&delete_thread[i], continuous_delete_thread, &delete_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning delete test thread %" PRIu32, i);
+        }
+    }
+
+    // act
+    // keep moving buckets for a while, the inserts keep adding bucket arrays on top of the ones being emptied
+    double start_time = timer_global_get_elapsed_ms();
+    while (timer_global_get_elapsed_ms() - start_time < 2000)
+    {
+        CLDS_HASH_TABLE_MIGRATE_RESULT migrate_result = clds_hash_table_migrate(hash_table, hazard_pointers_thread, 16);
+        ASSERT_IS_TRUE((migrate_result == CLDS_HASH_TABLE_MIGRATE_OK) || (migrate_result == CLDS_HASH_TABLE_MIGRATE_COMPLETE) || (migrate_result == CLDS_HASH_TABLE_MIGRATE_BUSY),
+            "Unexpected migrate result %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_HASH_TABLE_MIGRATE_RESULT, migrate_result));
+    }
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&delete_thread_data[i].stop, 1);
+        (void)interlocked_exchange(&insert_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(delete_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+
+        (void)ThreadAPI_Join(insert_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    migrate_until_complete(hash_table, hazard_pointers_thread, 16);
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&find_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(find_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_inserts_with_migration_budget_work_with_multiple_concurrent_inserts)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_budget(hash_table, 1));
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads to insert additional items, each insert also moves a bucket
+    THREAD_DATA thread_data[THREAD_COUNT];
+    THREAD_HANDLE thread[THREAD_COUNT];
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&thread[i], continuous_insert_thread, &thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+    }
+
+    // act
+    ThreadAPI_Sleep(2000);
+
+    // Stop inserts
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    migrate_until_complete(hash_table, hazard_pointers_thread, UINT32_MAX);
+
+    // assert
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_shrink_works_with_multiple_concurrent_inserts_deletes_and_finds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // grow the table with items that are deleted right away, so that it has far more buckets than items
+    uint32_t temporary_key_start = 1000000;
+    uint32_t temporary_count = 400000;
+    for (uint32_t i = temporary_key_start; i < temporary_key_start + temporary_count; i++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key = i;
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(i + 1), item, NULL));
+    }
+    for (uint32_t i = temporary_key_start; i < temporary_key_start + temporary_count; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(i + 1), NULL));
+    }
+
+    // Start threads to find the existing items, find asserts that every item is found
+    SHARED_KEY_INFO find_shared[THREAD_COUNT];
+    THREAD_DATA find_thread_data[THREAD_COUNT];
+    THREAD_HANDLE find_thread[THREAD_COUNT];
+
+    // Start threads to insert and delete additional items, delete asserts that every item inserted is found
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+    THREAD_DATA insert_thread_data[THREAD_COUNT];
+    THREAD_HANDLE insert_thread[THREAD_COUNT];
+    THREAD_DATA delete_thread_data[THREAD_COUNT];
+    THREAD_HANDLE delete_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&find_shared[i].last_written_key, original_count - 1);
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&find_thread_data[i], &find_shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+        initialize_thread_data(&insert_thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+        initialize_thread_data(&delete_thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&find_thread[i], continuous_find_thread, &find_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning find test thread %" PRIu32, i);
+        }
+
+        if (ThreadAPI_Create(&insert_thread[i], continuous_insert_thread, &insert_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+
+        if (ThreadAPI_Create(&delete_thread[i], continuous_delete_thread, &delete_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning delete test thread %" PRIu32, i);
+        }
+    }
+
+    ThreadAPI_Sleep(100);
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT shrink_result;
+    do
+    {
+        shrink_result = clds_hash_table_shrink(hash_table, hazard_pointers_thread);
+    } while (shrink_result == CLDS_HASH_TABLE_SHRINK_BUSY);
+
+    // the shrink moved the items into the smaller bucket array, the inserts that keep going can grow it again
+    double start_time = timer_global_get_elapsed_ms();
+    while (timer_global_get_elapsed_ms() - start_time < 1000)
+    {
+        CLDS_HASH_TABLE_MIGRATE_RESULT migrate_result = clds_hash_table_migrate(hash_table, hazard_pointers_thread, 16);
+        ASSERT_IS_TRUE((migrate_result == CLDS_HASH_TABLE_MIGRATE_OK) || (migrate_result == CLDS_HASH_TABLE_MIGRATE_COMPLETE) || (migrate_result == CLDS_HASH_TABLE_MIGRATE_BUSY),
+            "Unexpected migrate result %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_HASH_TABLE_MIGRATE_RESULT, migrate_result));
+    }
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&delete_thread_data[i].stop, 1);
+        (void)interlocked_exchange(&insert_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(delete_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+
+        (void)ThreadAPI_Join(insert_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    migrate_until_complete(hash_table, hazard_pointers_thread, 16);
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&find_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(find_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_OK, shrink_result);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_reserve_works_with_multiple_concurrent_inserts)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads to insert additional items while room is reserved
+    THREAD_DATA thread_data[THREAD_COUNT];
+    THREAD_HANDLE thread[THREAD_COUNT];
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&thread[i], continuous_insert_thread, &thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+    }
+
+    ThreadAPI_Sleep(500);
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result;
+    do
+    {
+        // the inserts may be in the middle of allocating a bucket array themselves
+        result = clds_hash_table_reserve(hash_table, hazard_pointers_thread, 1000000);
+    } while (result == CLDS_HASH_TABLE_RESERVE_BUSY);
+
+    ThreadAPI_Sleep(1000);
+
+    // Stop inserts
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    migrate_until_complete(hash_table, hazard_pointers_thread, UINT32_MAX);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_OK, result);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_bulk_load_with_multiple_workers_works_with_multiple_concurrent_inserts)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile_atomic int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 100000;
+    void** keys = malloc_2(original_count, sizeof(void*));
+    ASSERT_IS_NOT_NULL(keys);
+    CLDS_HASH_TABLE_ITEM** values = malloc_2(original_count, sizeof(CLDS_HASH_TABLE_ITEM*));
+    ASSERT_IS_NOT_NULL(values);
+    CLDS_HASH_TABLE_INSERT_RESULT* results = malloc_2(original_count, sizeof(CLDS_HASH_TABLE_INSERT_RESULT));
+    ASSERT_IS_NOT_NULL(results);
+
+    for (uint32_t i = 0; i < original_count; i++)
+    {
+        values[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(values[i]);
+        CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, values[i])->key = i;
+        keys[i] = (void*)(uintptr_t)(i + 1);
+    }
+
+    // Start threads to insert other keys while the load runs
+    THREAD_DATA thread_data[THREAD_COUNT];
+    THREAD_HANDLE thread[THREAD_COUNT];
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&thread_data[i], &shared[i], hash_table, hazard_pointers, original_count + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&thread[i], continuous_insert_thread, &thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+    }
+
+    // act
+    int result = clds_hash_table_bulk_load(hash_table, hazard_pointers_thread, THREAD_COUNT, keys, values, original_count, results, NULL);
+
+    // Stop inserts
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)interlocked_exchange(&thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    for (uint32_t i = 0; i < original_count; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[i], "Loading key %" PRIu32 " failed", i);
+    }
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count, NULL));
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    free(results);
+    free(values);
+    free(keys);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 typedef struct TEST_ITEM2_KEY_TAG {
     uint32_t key;
     UUID_T etag;
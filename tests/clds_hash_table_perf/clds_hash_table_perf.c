@@ -5,9 +5,11 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <inttypes.h>
 
 #include "c_logging/logger.h"
 
+#include "c_pal/sysinfo.h"
 #include "c_pal/threadapi.h"
 #include "c_pal/timer.h"
 #include "c_pal/gballoc_hl.h"
@@ -23,6 +25,11 @@
 
 #define THREAD_COUNT 8
 #define INSERT_COUNT 100000
+#define FIND_BATCH_SIZE 64
+
+// the oversubscribed insert test runs this many threads per processor, starting from a single bucket so that the table resizes often
+#define OVERSUBSCRIPTION_FACTOR 4
+#define OVERSUBSCRIBED_INSERT_COUNT 20000
 
 typedef struct TEST_ITEM_TAG
 {
@@ -137,12 +144,257 @@ static int find_thread(void* arg)
     return result;
 }
 
+static int find_batch_thread(void* arg)
+{
+    size_t i;
+    THREAD_DATA* thread_data = arg;
+    int result;
+    void* keys[FIND_BATCH_SIZE];
+    CLDS_HASH_TABLE_ITEM* found_items[FIND_BATCH_SIZE];
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < INSERT_COUNT; i += FIND_BATCH_SIZE)
+    {
+        uint32_t batch_size = ((INSERT_COUNT - i) < FIND_BATCH_SIZE) ? (uint32_t)(INSERT_COUNT - i) : FIND_BATCH_SIZE;
+        uint32_t j;
+
+        for (j = 0; j < batch_size; j++)
+        {
+            keys[j] = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, thread_data->items[i + j])->key;
+        }
+
+        if (clds_hash_table_find_batch(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, keys, batch_size, found_items) != 0)
+        {
+            LogError("Error finding batch");
+            break;
+        }
+
+        bool all_found = true;
+        for (j = 0; j < batch_size; j++)
+        {
+            if (found_items[j] == NULL)
+            {
+                all_found = false;
+            }
+            else
+            {
+                CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_items[j]);
+            }
+        }
+
+        if (!all_found)
+        {
+            LogError("Error finding");
+            break;
+        }
+    }
+
+    if (i < INSERT_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    return result;
+}
+
 static int key_compare_func(void* key_1, void* key_2)
 {
     return strcmp((const char*)key_1, (const char*)key_2);
 }
 
-int clds_hash_table_perf_main(void)
+typedef struct OVERSUBSCRIBED_THREAD_DATA_TAG
+{
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    uint64_t first_key;
+    double* latencies_us; // OVERSUBSCRIBED_INSERT_COUNT entries in the array shared by all threads
+} OVERSUBSCRIBED_THREAD_DATA;
+
+static uint64_t integer_key_compute_hash(void* key)
+{
+    return (uint64_t)(uintptr_t)key;
+}
+
+static int integer_key_compare_func(void* key_1, void* key_2)
+{
+    int result;
+
+    if ((uintptr_t)key_1 < (uintptr_t)key_2)
+    {
+        result = -1;
+    }
+    else if ((uintptr_t)key_1 > (uintptr_t)key_2)
+    {
+        result = 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+static int compare_latencies(const void* latency_1, const void* latency_2)
+{
+    double value_1 = *(const double*)latency_1;
+    double value_2 = *(const double*)latency_2;
+
+    return (value_1 < value_2) ? -1 : ((value_1 > value_2) ? 1 : 0);
+}
+
+static int oversubscribed_insert_thread(void* arg)
+{
+    OVERSUBSCRIBED_THREAD_DATA* thread_data = arg;
+    int result = 0;
+
+    for (uint32_t i = 0; i < OVERSUBSCRIBED_INSERT_COUNT; i++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        if (item == NULL)
+        {
+            LogError("Error allocating test item");
+            result = MU_FAILURE;
+            break;
+        }
+
+        double start_time = timer_global_get_elapsed_us();
+        CLDS_HASH_TABLE_INSERT_RESULT insert_result = clds_hash_table_insert(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, (void*)(uintptr_t)(thread_data->first_key + i), item, NULL);
+        thread_data->latencies_us[i] = timer_global_get_elapsed_us() - start_time;
+
+        if (insert_result != CLDS_HASH_TABLE_INSERT_OK)
+        {
+            LogError("Error inserting");
+            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+            result = MU_FAILURE;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// more threads than processors insert in a table that keeps resizing, so inserts often find a lower level bucket array with inserts in progress
+// from threads that got preempted, which shows in the latency tail
+static void clds_hash_table_oversubscribed_insert_perf_run(void)
+{
+    uint32_t thread_count = sysinfo_get_processor_count() * OVERSUBSCRIPTION_FACTOR;
+
+    LogInfo("Running oversubscribed insert test with %" PRIu32 " threads", thread_count);
+
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Error creating hazard pointers");
+    }
+    else
+    {
+        CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create_with_hash_finalizer(integer_key_compute_hash, integer_key_compare_func, 1, clds_hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_HASH_FINALIZER_MIX64);
+        if (hash_table == NULL)
+        {
+            LogError("Error creating hash table");
+        }
+        else
+        {
+            THREAD_HANDLE* threads = malloc_2(thread_count, sizeof(THREAD_HANDLE));
+            OVERSUBSCRIBED_THREAD_DATA* thread_data = malloc_2(thread_count, sizeof(OVERSUBSCRIBED_THREAD_DATA));
+            double* latencies_us = malloc_2((size_t)thread_count * OVERSUBSCRIBED_INSERT_COUNT, sizeof(double));
+            if (
+                (threads == NULL) ||
+                (thread_data == NULL) ||
+                (latencies_us == NULL)
+                )
+            {
+                LogError("Error allocating test data");
+            }
+            else
+            {
+                uint32_t i;
+
+                for (i = 0; i < thread_count; i++)
+                {
+                    thread_data[i].hash_table = hash_table;
+                    thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+                    thread_data[i].first_key = 1 + ((uint64_t)i * OVERSUBSCRIBED_INSERT_COUNT);
+                    thread_data[i].latencies_us = &latencies_us[(size_t)i * OVERSUBSCRIBED_INSERT_COUNT];
+                    if (thread_data[i].clds_hazard_pointers_thread == NULL)
+                    {
+                        LogError("Error registering hazard pointers thread");
+                        break;
+                    }
+                }
+
+                if (i < thread_count)
+                {
+                    for (uint32_t j = 0; j < i; j++)
+                    {
+                        clds_hazard_pointers_unregister_thread(thread_data[j].clds_hazard_pointers_thread);
+                    }
+                }
+                else
+                {
+                    double start_time = timer_global_get_elapsed_ms();
+
+                    for (i = 0; i < thread_count; i++)
+                    {
+                        if (ThreadAPI_Create(&threads[i], oversubscribed_insert_thread, &thread_data[i]) != THREADAPI_OK)
+                        {
+                            LogError("Error spawning test thread");
+                            break;
+                        }
+                    }
+
+                    bool is_error = (i < thread_count);
+                    for (uint32_t j = 0; j < i; j++)
+                    {
+                        int thread_result;
+                        (void)ThreadAPI_Join(threads[j], &thread_result);
+                        if (thread_result != 0)
+                        {
+                            is_error = true;
+                        }
+                    }
+
+                    double runtime = timer_global_get_elapsed_ms() - start_time;
+
+                    if (!is_error)
+                    {
+                        size_t latency_count = (size_t)thread_count * OVERSUBSCRIBED_INSERT_COUNT;
+                        qsort(latencies_us, latency_count, sizeof(double), compare_latencies);
+
+                        LogInfo("Oversubscribed insert test done in %.02f ms, insert latency p50=%.02f us, p99=%.02f us, p99.9=%.02f us, max=%.02f us",
+                            runtime,
+                            latencies_us[latency_count / 2],
+                            latencies_us[latency_count * 99 / 100],
+                            latencies_us[latency_count * 999 / 1000],
+                            latencies_us[latency_count - 1]);
+                    }
+
+                    for (i = 0; i < thread_count; i++)
+                    {
+                        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                    }
+                }
+            }
+
+            free(latencies_us);
+            free(thread_data);
+            free(threads);
+
+            clds_hash_table_destroy(hash_table);
+        }
+
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
+}
+
+static void clds_hash_table_perf_run(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode)
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
     CLDS_HASH_TABLE_HANDLE hash_table;
@@ -151,7 +403,9 @@ int clds_hash_table_perf_main(void)
     size_t i;
     size_t j;
 
-    clds_hazard_pointers = clds_hazard_pointers_create();
+    LogInfo("Running with reclamation mode %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, reclamation_mode));
+
+    clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(reclamation_mode);
     if (clds_hazard_pointers == NULL)
     {
         LogError("Error creating hazard pointers");
@@ -323,6 +577,53 @@ int clds_hash_table_perf_main(void)
                                         ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
                                 }
 
+                                // batched find test, same keys looked up in batches of FIND_BATCH_SIZE
+
+                                for (i = 0; i < THREAD_COUNT; i++)
+                                {
+                                    if (ThreadAPI_Create(&threads[i], find_batch_thread, &thread_data[i]) != THREADAPI_OK)
+                                    {
+                                        LogError("Error spawning test thread");
+                                        break;
+                                    }
+                                }
+
+                                if (i < THREAD_COUNT)
+                                {
+                                    for (j = 0; j < i; j++)
+                                    {
+                                        int dont_care;
+                                        (void)ThreadAPI_Join(threads[j], &dont_care);
+                                    }
+                                }
+                                else
+                                {
+                                    is_error = false;
+                                    runtime = 0;
+
+                                    for (i = 0; i < THREAD_COUNT; i++)
+                                    {
+                                        int thread_result;
+                                        (void)ThreadAPI_Join(threads[i], &thread_result);
+                                        if (thread_result != 0)
+                                        {
+                                            is_error = true;
+                                        }
+                                        else
+                                        {
+                                            runtime += thread_data[i].runtime;
+                                        }
+                                    }
+
+                                    if (!is_error)
+                                    {
+                                        LogInfo("Batched find test done in %.02f ms, %.02f finds/s/thread, %.02f finds/s on all threads",
+                                            runtime,
+                                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                    }
+                                }
+
                                 // delete test
 
                                 for (i = 0; i < THREAD_COUNT; i++)
@@ -387,6 +688,15 @@ int clds_hash_table_perf_main(void)
 
         clds_hazard_pointers_destroy(clds_hazard_pointers);
     }
+}
+
+int clds_hash_table_perf_main(void)
+{
+    // same workload with both reclamation engines so that they can be compared
+    clds_hash_table_perf_run(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+    clds_hash_table_perf_run(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+
+    clds_hash_table_oversubscribed_insert_perf_run();
 
     return 0;
 }
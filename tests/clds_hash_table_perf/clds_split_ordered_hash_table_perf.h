@@ -0,0 +1,10 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_SPLIT_ORDERED_HASH_TABLE_PERF_H
+#define CLDS_SPLIT_ORDERED_HASH_TABLE_PERF_H
+
+
+int clds_split_ordered_hash_table_perf_main(void);
+
+
+#endif /* CLDS_SPLIT_ORDERED_HASH_TABLE_PERF_H */
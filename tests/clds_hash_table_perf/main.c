@@ -6,12 +6,14 @@
 #include "c_logging/logger.h"
 
 #include "clds_hash_table_perf.h"
+#include "clds_split_ordered_hash_table_perf.h"
 
 int main(void)
 {
     (void)logger_init();
 
     clds_hash_table_perf_main();
+    clds_split_ordered_hash_table_perf_main();
 
     logger_deinit();
 
@@ -162,4 +162,77 @@ TEST_FUNCTION(clds_hash_table_snapshot_perf_with_cancellation_token_is_decent)
     THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
 }
 
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_perf_scales_with_the_worker_count)
+{
+    // The test measures how long the writes are locked by a parallel snapshot with different worker counts, compared to a serial snapshot
+    // arrange
+    volatile_atomic int64_t sequence_number;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    static const uint32_t worker_counts[] = { 1, 2, 4, 8 };
+
+    clds_hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+
+    clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers_thread);
+
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1024 * 1024, clds_hazard_pointers, &sequence_number, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    for (uint32_t i = 0; i < TEST_ITEM_COUNT; i++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+
+        test_item->key = i + 1;
+
+        int64_t insert_sequence_number;
+        CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_insert(hash_table, clds_hazard_pointers_thread, (void*)(uintptr_t)test_item->key, (void*)item, &insert_sequence_number);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    }
+
+    CLDS_HASH_TABLE_ITEM** items = NULL;
+    uint64_t item_count;
+
+    double start_time = timer_global_get_elapsed_ms();
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot(hash_table, clds_hazard_pointers_thread, &items, &item_count, NULL));
+    double serial_time = timer_global_get_elapsed_ms() - start_time;
+
+    LogInfo("Serial snapshot took %.02f ms", serial_time);
+
+    for (uint64_t j = 0; j < item_count; j++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[j]);
+    }
+    free(items);
+
+    for (size_t i = 0; i < sizeof(worker_counts) / sizeof(worker_counts[0]); i++)
+    {
+        // act
+        start_time = timer_global_get_elapsed_ms();
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot_parallel(hash_table, clds_hazard_pointers_thread, worker_counts[i], &items, &item_count, NULL));
+        double parallel_time = timer_global_get_elapsed_ms() - start_time;
+
+        LogInfo("Parallel snapshot with %" PRIu32 " workers took %.02f ms (%.02fx the serial snapshot)", worker_counts[i], parallel_time, serial_time / parallel_time);
+
+        // assert
+        ASSERT_ARE_EQUAL(uint64_t, TEST_ITEM_COUNT, item_count);
+        ASSERT_IS_TRUE(parallel_time < 1000, "Parallel snapshot with %" PRIu32 " workers took %.02f ms", worker_counts[i], parallel_time);
+
+        for (uint64_t j = 0; j < item_count; j++)
+        {
+            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[j]);
+        }
+        free(items);
+    }
+
+    // cleanup
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
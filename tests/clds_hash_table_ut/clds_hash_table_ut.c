@@ -12,6 +12,10 @@ TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RE
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT_VALUES);
 
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
@@ -23,8 +27,22 @@ TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALU
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
 MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
@@ -41,13 +59,34 @@ static void test_reclaim_function(void* node)
 MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, struct CLDS_HASH_TABLE_ITEM_TAG*, item)
 MOCK_FUNCTION_END()
 
+// records the order of the calls that the batch APIs make while a test enables it: 'A' hazard pointer acquire, 'R' hazard pointer release, 'H' compute hash, 'F' bucket list look up
+static char g_call_log[256];
+static size_t g_call_log_length;
+static bool g_call_log_enabled;
+
+static void log_call(char call)
+{
+    if (g_call_log_enabled && (g_call_log_length < sizeof(g_call_log) - 1))
+    {
+        g_call_log[g_call_log_length++] = call;
+        g_call_log[g_call_log_length] = '\0';
+    }
+}
+
 MOCK_FUNCTION_WITH_CODE(, uint64_t, test_compute_hash, void*, key)
-    (void)key;
+    log_call('H');
 MOCK_FUNCTION_END((uint64_t)key)
 
 MOCK_FUNCTION_WITH_CODE(, void, test_skipped_seq_no_cb, void*, context, int64_t, skipped_seq_no)
 MOCK_FUNCTION_END()
 
+MOCK_FUNCTION_WITH_CODE(, void, test_find_visit_cb, void*, context, CLDS_HASH_TABLE_ITEM*, item)
+MOCK_FUNCTION_END()
+
+static CLDS_HASH_TABLE_ITEM* g_factory_item;
+MOCK_FUNCTION_WITH_CODE(, CLDS_HASH_TABLE_ITEM*, test_item_factory, void*, context, void*, key)
+MOCK_FUNCTION_END(g_factory_item)
+
 static CLDS_CONDITION_CHECK_RESULT g_condition_check_result = CLDS_CONDITION_CHECK_OK;
 MOCK_FUNCTION_WITH_CODE(, CLDS_CONDITION_CHECK_RESULT, test_item_condition_check, void*, context, void*, new_key, void*, old_key)
 MOCK_FUNCTION_END(g_condition_check_result)
@@ -78,6 +117,269 @@ typedef struct TEST_ITEM_TAG
 
 DECLARE_HASH_TABLE_NODE_TYPE(TEST_ITEM)
 
+static CLDS_HASH_TABLE_HANDLE g_delete_in_visit_hash_table;
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE g_delete_in_visit_hazard_pointers_thread;
+static void* g_delete_in_visit_key;
+static CLDS_HASH_TABLE_ITEM* g_delete_in_visit_value;
+
+// simulates a writer deleting an item while clds_hash_table_snapshot_concurrent walks the table
+static CLDS_SORTED_LIST_VISIT_RESULT hook_clds_sorted_list_visit_with_delete(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    if (g_delete_in_visit_key != NULL)
+    {
+        if (g_delete_in_visit_value != NULL)
+        {
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete_key_value(g_delete_in_visit_hash_table, g_delete_in_visit_hazard_pointers_thread, g_delete_in_visit_key, g_delete_in_visit_value, NULL));
+            g_delete_in_visit_value = NULL;
+        }
+        else
+        {
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(g_delete_in_visit_hash_table, g_delete_in_visit_hazard_pointers_thread, g_delete_in_visit_key, NULL));
+        }
+        g_delete_in_visit_key = NULL;
+    }
+
+    return real_clds_sorted_list_visit(clds_sorted_list, clds_hazard_pointers_thread, visit_cb, visit_cb_context);
+}
+
+// the hooks below simulate another thread doing one operation on the hash table while a bucket list function is called
+typedef void (*TEST_HOOK_ACTION)(void);
+static TEST_HOOK_ACTION g_hook_action;
+static CLDS_HASH_TABLE_HANDLE g_hook_hash_table;
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE g_hook_hazard_pointers_thread;
+static void* g_hook_key;
+static CLDS_HASH_TABLE_ITEM* g_hook_item;
+static CLDS_HASH_TABLE_MIGRATE_RESULT g_hook_migrate_result;
+static CLDS_HASH_TABLE_INSERT_RESULT g_hook_insert_result;
+static CLDS_HASH_TABLE_ITEM* g_hook_found_item;
+static CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT g_hook_find_and_visit_result;
+static CLDS_HASH_TABLE_RESERVE_RESULT g_hook_reserve_result;
+
+static void run_hook_action(void)
+{
+    // the action only runs once, since it can end up calling the hooked function again
+    TEST_HOOK_ACTION hook_action = g_hook_action;
+    g_hook_action = NULL;
+    if (hook_action != NULL)
+    {
+        hook_action();
+    }
+}
+
+static void migrate_hook_action(void)
+{
+    g_hook_migrate_result = clds_hash_table_migrate(g_hook_hash_table, g_hook_hazard_pointers_thread, 1);
+}
+
+static void find_hook_action(void)
+{
+    g_hook_found_item = clds_hash_table_find(g_hook_hash_table, g_hook_hazard_pointers_thread, g_hook_key);
+}
+
+static void find_and_visit_hook_action(void)
+{
+    g_hook_find_and_visit_result = clds_hash_table_find_and_visit(g_hook_hash_table, g_hook_hazard_pointers_thread, g_hook_key, test_find_visit_cb, (void*)0x4243);
+}
+
+static void insert_hook_action(void)
+{
+    g_hook_insert_result = clds_hash_table_insert(g_hook_hash_table, g_hook_hazard_pointers_thread, g_hook_key, g_hook_item, NULL);
+}
+
+static void reserve_hook_action(void)
+{
+    g_hook_reserve_result = clds_hash_table_reserve(g_hook_hash_table, g_hook_hazard_pointers_thread, 1024);
+}
+
+// the insert that waits for the inserts in progress in a lower level bucket array runs on a real thread, since it goes to sleep until they complete
+static THREAD_HANDLE g_waiting_insert_thread;
+static THREADAPI_RESULT g_waiting_insert_thread_create_result;
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE g_waiting_insert_hazard_pointers_thread;
+static volatile_atomic int32_t g_waiting_insert_done;
+static int32_t g_waiting_insert_done_before_release;
+
+static int waiting_insert_thread_func(void* arg)
+{
+    (void)arg;
+    g_hook_insert_result = clds_hash_table_insert(g_hook_hash_table, g_waiting_insert_hazard_pointers_thread, g_hook_key, g_hook_item, NULL);
+    (void)interlocked_exchange(&g_waiting_insert_done, 1);
+    return 0;
+}
+
+static void start_waiting_insert_hook_action(void)
+{
+    g_waiting_insert_thread_create_result = real_ThreadAPI_Create(&g_waiting_insert_thread, waiting_insert_thread_func, NULL);
+    // the waiting insert only spins for a short while, so it is asleep long before this insert goes on
+    real_ThreadAPI_Sleep(1000);
+    g_waiting_insert_done_before_release = interlocked_add(&g_waiting_insert_done, 0);
+}
+
+static CLDS_SORTED_LIST_INSERT_RESULT hook_clds_sorted_list_insert_with_action(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    run_hook_action();
+    return real_clds_sorted_list_insert(clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number);
+}
+
+static CLDS_SORTED_LIST_ITEM* hook_clds_sorted_list_find_key_with_action(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    run_hook_action();
+    return real_clds_sorted_list_find_key(clds_sorted_list, clds_hazard_pointers_thread, key);
+}
+
+static CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT hook_clds_sorted_list_find_key_and_visit_with_action(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, SORTED_LIST_FIND_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    run_hook_action();
+    return real_clds_sorted_list_find_key_and_visit(clds_sorted_list, clds_hazard_pointers_thread, key, visit_cb, visit_cb_context);
+}
+
+static CLDS_SORTED_LIST_GET_ALL_RESULT hook_clds_sorted_list_get_all_with_action(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count, CLDS_SORTED_LIST_ITEM** items, uint64_t* retrieved_item_count, bool require_locked_list)
+{
+    run_hook_action();
+    return real_clds_sorted_list_get_all(clds_sorted_list, clds_hazard_pointers_thread, item_count, items, retrieved_item_count, require_locked_list);
+}
+
+static bool g_fail_next_hazard_pointers_acquire;
+
+static CLDS_HAZARD_POINTER_RECORD_HANDLE hook_clds_hazard_pointers_acquire_with_log(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node)
+{
+    CLDS_HAZARD_POINTER_RECORD_HANDLE result;
+
+    log_call('A');
+    if (g_fail_next_hazard_pointers_acquire)
+    {
+        g_fail_next_hazard_pointers_acquire = false;
+        result = NULL;
+    }
+    else
+    {
+        result = real_clds_hazard_pointers_acquire(clds_hazard_pointers_thread, node);
+    }
+
+    return result;
+}
+
+static void hook_clds_hazard_pointers_release_with_log(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record)
+{
+    log_call('R');
+    real_clds_hazard_pointers_release(clds_hazard_pointers_thread, clds_hazard_pointer_record);
+}
+
+static CLDS_SORTED_LIST_ITEM* hook_clds_sorted_list_find_key_with_log(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    log_call('F');
+    return real_clds_sorted_list_find_key(clds_sorted_list, clds_hazard_pointers_thread, key);
+}
+
+// the worker threads of clds_hash_table_snapshot_parallel run to completion when they are created, so that the calls they make are deterministic
+static THREADAPI_RESULT hook_ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg)
+{
+    *threadHandle = (THREAD_HANDLE)0x4243;
+    (void)func(arg);
+    return THREADAPI_OK;
+}
+
+static THREADAPI_RESULT hook_ThreadAPI_Join(THREAD_HANDLE threadHandle, int* res)
+{
+    (void)threadHandle;
+    *res = 0;
+    return THREADAPI_OK;
+}
+
+// a record of the snapshot image tests is the 8 bytes of the key of the item
+static uint32_t test_get_record_size(void* context, CLDS_HASH_TABLE_ITEM* item)
+{
+    (void)context;
+    (void)item;
+    return sizeof(uint64_t);
+}
+
+static int test_serialize_record(void* context, CLDS_HASH_TABLE_ITEM* item, unsigned char* record, uint32_t record_size)
+{
+    uint64_t key = (uint64_t)(uintptr_t)CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item)->key;
+    (void)context;
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(uint64_t), record_size);
+    (void)memcpy(record, &key, sizeof(key));
+    return 0;
+}
+
+static int g_write_image_result;
+static int test_write_image(void* context, uint64_t offset, const void* buffer, size_t buffer_size)
+{
+    if (g_write_image_result == 0)
+    {
+        (void)memcpy((unsigned char*)context + offset, buffer, buffer_size);
+    }
+
+    return g_write_image_result;
+}
+
+static uint32_t g_deserialized_item_count;
+static CLDS_HASH_TABLE_ITEM* test_deserialize_record(void* context, const unsigned char* record, uint32_t record_size, void** key)
+{
+    uint64_t record_key;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)context;
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(uint64_t), record_size);
+    (void)memcpy(&record_key, record, sizeof(record_key));
+    *key = (void*)(uintptr_t)record_key;
+    g_deserialized_item_count++;
+    return item;
+}
+
+static CLDS_HASH_TABLE_ITEM* test_failing_deserialize_record(void* context, const unsigned char* record, uint32_t record_size, void** key)
+{
+    (void)context;
+    (void)record;
+    (void)record_size;
+    (void)key;
+    return NULL;
+}
+
+static uint32_t test_get_too_large_record_size(void* context, CLDS_HASH_TABLE_ITEM* item)
+{
+    (void)context;
+    (void)item;
+    return UINT32_MAX;
+}
+
+static CLDS_HASH_TABLE_ITEM* test_deserialize_record_with_NULL_key(void* context, const unsigned char* record, uint32_t record_size, void** key)
+{
+    (void)context;
+    (void)record;
+    (void)record_size;
+    *key = NULL;
+    return CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+}
+
+static bool test_record_match(void* context, void* key, const unsigned char* record, uint32_t record_size)
+{
+    uint64_t record_key;
+    (void)context;
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(uint64_t), record_size);
+    (void)memcpy(&record_key, record, sizeof(record_key));
+    return (record_key == (uint64_t)(uintptr_t)key);
+}
+
+// writes an image of 2 items with keys 0x1 and 0x2 (in 2 buckets) in g_test_image_buffer
+// the image is the 64 bytes header, the directory entries of the 2 buckets and of the end of the records, then the record of 0x2 and the record of 0x1
+static uint64_t g_test_image_buffer[64];
+#define TEST_IMAGE_BUCKET_1_RECORDS_OFFSET_INDEX 10
+#define TEST_IMAGE_FIRST_RECORD_SIZE_INDEX 15
+static uint64_t write_test_image(CLDS_HASH_TABLE_HANDLE hash_table, int64_t sequence_number)
+{
+    uint64_t image_size;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* items[] = { item_1, item_2 };
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key = (void*)0x1;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_2)->key = (void*)0x2;
+    (void)memset(g_test_image_buffer, 0, sizeof(g_test_image_buffer));
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_snapshot_image_write(hash_table, items, 2, sequence_number, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size));
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    return image_size;
+}
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -99,10 +401,18 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_get_count, CLDS_SORTED_LIST_GET_COUNT_ERROR);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_get_all, CLDS_SORTED_LIST_GET_ALL_ERROR);
 
+    REGISTER_GLOBAL_MOCK_HOOK(ThreadAPI_Create, hook_ThreadAPI_Create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(ThreadAPI_Create, THREADAPI_ERROR);
+    REGISTER_GLOBAL_MOCK_HOOK(ThreadAPI_Join, hook_ThreadAPI_Join);
+
     REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_BATCH_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST_CONFIG*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const CLDS_SORTED_LIST_CONFIG*, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_ITEM_CLEANUP_CB, void*);
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_GET_ITEM_KEY_CB, void*);
@@ -112,18 +422,29 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_SKIPPED_SEQ_NO_CB, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_KEY_COMPARE_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CONDITION_CHECK_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_VISIT_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_FIND_VISIT_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_ITEM_FACTORY_CB, void*);
     REGISTER_UMOCK_ALIAS_TYPE(THANDLE(CANCELLATION_TOKEN), void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_START_FUNC, void*);
 
     REGISTER_TYPE(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_RESULT);
     REGISTER_TYPE(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_RESULT);
     REGISTER_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RESULT);
     REGISTER_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT);
+    REGISTER_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT);
+    REGISTER_TYPE(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT);
     REGISTER_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT);
     REGISTER_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT);
     REGISTER_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT);
     REGISTER_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT);
     REGISTER_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_RESULT);
     REGISTER_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT);
+    REGISTER_TYPE(THREADAPI_RESULT, THREADAPI_RESULT);
 
     ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
 }
@@ -139,6 +460,15 @@ TEST_SUITE_CLEANUP(suite_cleanup)
 TEST_FUNCTION_INITIALIZE(method_init)
 {
     g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+    g_factory_item = NULL;
+    g_write_image_result = 0;
+    g_deserialized_item_count = 0;
+    g_hook_action = NULL;
+    g_call_log_length = 0;
+    g_call_log[0] = '\0';
+    g_call_log_enabled = false;
+    g_fail_next_hazard_pointers_acquire = false;
+    g_delete_in_visit_value = NULL;
     umock_c_reset_all_calls();
 }
 
@@ -175,6 +505,9 @@ static void destroy_test_context(CLDS_HASH_TABLE_TEST_CONTEXT* test_context)
 /* Tests_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_087: [ clds_hash_table_create shall initialize the sorted list configuration shared by all the buckets by calling clds_sorted_list_config_init. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ The start sequence number passed to clds_hash_table_create shall be passed as the start_sequence_number argument to clds_sorted_list_config_init. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_088: [ clds_hash_table_create shall initialize the list of each bucket in place by calling clds_sorted_list_init. ]*/
 TEST_FUNCTION(clds_hash_table_create_succeeds)
 {
     // arrange
@@ -185,6 +518,8 @@ TEST_FUNCTION(clds_hash_table_create_succeeds)
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
@@ -211,6 +546,8 @@ TEST_FUNCTION(clds_hash_table_create_succeeds_with_NULL_skipped_seq_no_cb)
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
@@ -227,6 +564,7 @@ TEST_FUNCTION(clds_hash_table_create_succeeds_with_NULL_skipped_seq_no_cb)
 /* Tests_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ The start sequence number passed to clds_hash_table_create shall be passed as the start_sequence_number argument to clds_sorted_list_config_init. ]*/
 TEST_FUNCTION(clds_hash_table_create_succeeds_with_NULL_sequence_number_and_skipped_seq_no_cb)
 {
     // arrange
@@ -236,6 +574,8 @@ TEST_FUNCTION(clds_hash_table_create_succeeds_with_NULL_sequence_number_and_skip
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
@@ -314,6 +654,32 @@ TEST_FUNCTION(when_allocating_memory_for_the_hash_table_array_fails_clds_hash_ta
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* Tests_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_clds_sorted_list_config_init_fails_clds_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(MU_FAILURE);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* Tests_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
 TEST_FUNCTION(clds_hash_table_create_with_NULL_compute_hash_function_fails)
 {
@@ -395,9 +761,13 @@ TEST_FUNCTION(two_hash_tables_can_be_created_with_the_same_hazard_pointer_instan
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table_1 = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
@@ -427,9 +797,13 @@ TEST_FUNCTION(two_hash_tables_can_be_created_with_different_hazard_pointer_insta
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table_1 = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers_1, NULL, NULL, NULL);
@@ -458,6 +832,9 @@ TEST_FUNCTION(clds_hash_table_create_with_initial_size_2_succeeds)
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
@@ -482,6 +859,8 @@ TEST_FUNCTION(clds_hash_table_create_with_non_NULL_start_sequence_number_succeed
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
@@ -495,205 +874,360 @@ TEST_FUNCTION(clds_hash_table_create_with_non_NULL_start_sequence_number_succeed
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_destroy */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
-TEST_FUNCTION(clds_hash_table_destroy_frees_the_hash_table_resources)
+/* Tests_SRS_CLDS_HASH_TABLE_07_168: [ clds_hash_table_create shall round initial_bucket_size up to the next power of two, so that the bucket of a hash is obtained by masking the hash instead of dividing it. ]*/
+TEST_FUNCTION(clds_hash_table_create_rounds_initial_bucket_size_up_to_a_power_of_two)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    }
 
     // act
-    clds_hash_table_destroy(hash_table);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
-TEST_FUNCTION(clds_hash_table_destroy_with_NULL_hash_table_returns)
-{
-    // arrange
-
-    // act
-    clds_hash_table_destroy(NULL);
-
-    // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-}
-
-/* clds_hash_table_insert */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_019: [ If no sorted list exists at the determined bucket index then a new list shall be created. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
-TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair)
+/* Tests_SRS_CLDS_HASH_TABLE_07_165: [ clds_hash_table_create shall create a hash table that uses the hash computed by compute_hash as is (CLDS_HASH_TABLE_HASH_FINALIZER_NONE). ]*/
+TEST_FUNCTION(clds_hash_table_create_picks_the_bucket_with_the_hash_computed_by_compute_hash)
 {
     // arrange
+    // without a finalizer 0x10 and 0x20 both land in bucket 0 of 16 buckets (with MIX64 they would land in buckets 4 and 13)
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 16, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x10, item_1, NULL));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // 0x20 lands in the bucket of 0x10, so the bucket list is searched
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x20));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x20));
+    // 0x11 lands in an empty bucket
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x11));
 
     // act
-    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* result_1 = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x20);
+    CLDS_HASH_TABLE_ITEM* result_2 = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x11);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_IS_NULL(result_1);
+    ASSERT_IS_NULL(result_2);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
-TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair_with_non_NULL_start_sequence_no)
+/* Tests_SRS_CLDS_HASH_TABLE_07_166: [ If initial_bucket_size is greater than 2^29, clds_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_initial_bucket_size_too_big_fails)
 {
     // arrange
-    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
-    setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-    volatile_atomic int64_t sequence_number = 42;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
-
     // act
-    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, ((size_t)1 << 29) + 1, hazard_pointers, NULL, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_IS_NULL(hash_table);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
-    destroy_test_context(&test_context);
+    clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_NULL_hash_table_fails)
+/* clds_hash_table_create_with_hash_finalizer */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_169: [ clds_hash_table_create_with_hash_finalizer shall create a hash table that applies hash_finalizer to every hash computed by compute_hash. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_hash_finalizer_succeeds)
 {
     // arrange
-    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
-    setup_test_context(&test_context);
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t sequence_number = 55;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_insert(NULL, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    hash_table = clds_hash_table_create_with_hash_finalizer(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556, CLDS_HASH_TABLE_HASH_FINALIZER_MIX64);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_IS_NOT_NULL(hash_table);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
-    clds_hazard_pointers_destroy(test_context.hazard_pointers);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_167: [ If hash_finalizer is not a valid CLDS_HASH_TABLE_HASH_FINALIZER value, clds_hash_table_create_with_hash_finalizer shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_hash_finalizer_with_invalid_hash_finalizer_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_insert(hash_table, NULL, (void*)0x1, item, NULL);
+    hash_table = clds_hash_table_create_with_hash_finalizer(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL, (CLDS_HASH_TABLE_HASH_FINALIZER)0x42);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_IS_NULL(hash_table);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_170: [ If hash_finalizer is CLDS_HASH_TABLE_HASH_FINALIZER_MIX64, the value returned by compute_hash shall be mixed with the 64 bit MurmurHash3 finalizer before it is used to pick a bucket. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_hash_finalizer_MIX64_picks_the_bucket_with_the_MurmurHash3_fmix64_value)
 {
     // arrange
+    // fmix64(0x1) = 0xb456bcfc34c2cb2c and fmix64(0x28C) = 0x57972181e5d22b2c share the low 10 bits (0x32C), fmix64(0x2) = 0x3abf2a20650683e7 does not
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create_with_hash_finalizer(test_compute_hash, test_key_compare_func, 1024, test_context.hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_HASH_FINALIZER_MIX64);
+    ASSERT_IS_NOT_NULL(hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // 0x28C lands in the bucket of 0x1, so the bucket list is searched
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x28C));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x28C));
+    // 0x2 lands in an empty bucket
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+
     // act
-    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, NULL, item, NULL);
+    CLDS_HASH_TABLE_ITEM* result_1 = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x28C);
+    CLDS_HASH_TABLE_ITEM* result_2 = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x2);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_IS_NULL(result_1);
+    ASSERT_IS_NULL(result_2);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-TEST_FUNCTION(when_creating_the_singly_linked_list_fails_clds_hash_table_insert_fails)
+/* clds_hash_table_destroy */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
+TEST_FUNCTION(clds_hash_table_destroy_frees_the_hash_table_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_089: [ clds_hash_table_destroy shall free the items of each non-empty bucket by calling clds_sorted_list_deinit. ]*/
+TEST_FUNCTION(clds_hash_table_destroy_deinitializes_only_the_non_empty_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_deinit(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
+TEST_FUNCTION(clds_hash_table_destroy_with_NULL_hash_table_returns)
+{
+    // arrange
+
+    // act
+    clds_hash_table_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* clds_hash_table_insert */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_019: [ The sorted list embedded in the bucket array at the determined bucket index shall be used for the insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
+TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair_with_non_NULL_start_sequence_no)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
 
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert(NULL, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(test_context.hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert(hash_table, NULL, (void*)0x1, item, NULL);
+
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, NULL, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     destroy_test_context(&test_context);
 }
 
@@ -709,7 +1243,6 @@ TEST_FUNCTION(when_inserting_the_singly_linked_list_item_fails_clds_hash_table_i
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
         .SetReturn(CLDS_SORTED_LIST_INSERT_ERROR);
 
@@ -731,7 +1264,7 @@ TEST_FUNCTION(when_inserting_the_singly_linked_list_item_fails_clds_hash_table_i
 /* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_does_not_create_another_list)
+TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_inserts_in_the_same_list)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
@@ -770,12 +1303,11 @@ TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_does_not_cr
 /* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_a_different_bucket_creates_another_list)
+TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_a_different_bucket_inserts_in_another_list)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
@@ -784,10 +1316,7 @@ TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_a_different_bucket_creates_
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -807,7 +1336,6 @@ TEST_FUNCTION(clds_hash_table_insert_when_the_number_of_items_reaches_number_of_
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
@@ -818,13 +1346,12 @@ TEST_FUNCTION(clds_hash_table_insert_when_the_number_of_items_reaches_number_of_
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -838,6 +1365,118 @@ TEST_FUNCTION(clds_hash_table_insert_when_the_number_of_items_reaches_number_of_
     destroy_test_context(&test_context);
 }
 
+static void insert_keys_in_hash_table(CLDS_HASH_TABLE_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread, uintptr_t first_key, uintptr_t last_key)
+{
+    for (uintptr_t key = first_key; key <= last_key; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, item, NULL));
+    }
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+TEST_FUNCTION(clds_hash_table_insert_counts_the_items_inserted_from_all_threads_when_deciding_to_allocate_another_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(test_context.hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread_2);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 512, test_context.hazard_pointers, NULL, NULL, NULL);
+    // the last item is inserted from another thread, so it is counted in another stripe than the others
+    insert_keys_in_hash_table(hash_table, test_context.hazard_pointers_thread, 1, 511);
+    insert_keys_in_hash_table(hash_table, hazard_pointers_thread_2, 512, 512);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)513));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 512, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)513));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)513, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_items_inserted_from_2_threads_below_the_number_of_buckets_does_not_allocate_another_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(test_context.hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread_2);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 512, test_context.hazard_pointers, NULL, NULL, NULL);
+    insert_keys_in_hash_table(hash_table, test_context.hazard_pointers_thread, 1, 255);
+    insert_keys_in_hash_table(hash_table, hazard_pointers_thread_2, 256, 511);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)512));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)512, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+TEST_FUNCTION(clds_hash_table_insert_counts_the_items_deleted_from_other_threads_when_deciding_to_allocate_another_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(test_context.hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread_2);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 512, test_context.hazard_pointers, NULL, NULL, NULL);
+    insert_keys_in_hash_table(hash_table, test_context.hazard_pointers_thread, 1, 512);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, hazard_pointers_thread_2, (void*)1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
 /* Tests_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
 TEST_FUNCTION(clds_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREADY_EXISTS)
 {
@@ -877,7 +1516,6 @@ TEST_FUNCTION(clds_hash_table_insert_passes_the_sequence_number_to_the_sorted_li
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     volatile_atomic int64_t sequence_number = 42;
     int64_t insert_seq_no = 0;
@@ -886,10 +1524,7 @@ TEST_FUNCTION(clds_hash_table_insert_passes_the_sequence_number_to_the_sorted_li
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, &insert_seq_no))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, &insert_seq_no));
 
     // act
     result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &insert_seq_no);
@@ -929,544 +1564,513 @@ TEST_FUNCTION(clds_hash_table_insert_with_non_NULL_sequence_no_but_NULL_start_se
     destroy_test_context(&test_context);
 }
 
-/* clds_hash_table_delete */
+/* clds_hash_table_get_or_insert */
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-TEST_FUNCTION(clds_hash_table_delete_deletes_the_key)
+/* Tests_SRS_CLDS_HASH_TABLE_07_111: [ If clds_hash_table is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
-    // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(NULL, test_context.hazard_pointers_thread, (void*)0x1, item, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_112: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
+    umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(NULL, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, NULL, (void*)0x1, item, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_113: [ If key is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(hash_table, NULL, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, NULL, item, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_114: [ If value is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_value_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, NULL, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_not_in_the_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_115: [ If existing_item is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_existing_item_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_already_deleted_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_116: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_non_NULL_sequence_no_but_NULL_start_sequence_no_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
-    (void)clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
+    int64_t insert_seq_no = 0;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &existing_item, &insert_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_117: [ Otherwise clds_hash_table_get_or_insert shall insert value in the same way as clds_hash_table_insert, by calling clds_sorted_list_get_or_insert, and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_when_the_key_is_not_in_the_table_inserts_the_item)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
-        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_or_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, IGNORED_ARG, NULL));
 
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_IS_NULL(existing_item);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-TEST_FUNCTION(delete_looks_in_2_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_07_118: [ If the key already exists in any of the bucket arrays, clds_hash_table_get_or_insert shall store the existing item, with its reference count incremented, in existing_item and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_when_the_key_is_in_the_table_returns_the_existing_item)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_or_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, IGNORED_ARG, NULL));
 
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_2, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, existing_item);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, existing_item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-TEST_FUNCTION(delete_looks_in_3_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_07_118: [ If the key already exists in any of the bucket arrays, clds_hash_table_get_or_insert shall store the existing item, with its reference count incremented, in existing_item and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_when_the_key_is_in_the_2nd_array_of_buckets_returns_the_existing_item)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    // 1st bucket array has 1 bucket
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 2nd bucket array has 2 buckets
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 3rd bucket array has 4 buckets
-    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_4, NULL);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1));
 
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_get_or_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, existing_item);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, existing_item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_delete_returns_NOT_FOUND)
+/* clds_hash_table_compute_if_absent */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_119: [ If clds_hash_table is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3, NULL));
-
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x3, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(NULL, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-TEST_FUNCTION(clds_hash_table_delete_deletes_the_key_and_stamps_the_sequence_no)
+/* Tests_SRS_CLDS_HASH_TABLE_07_120: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    volatile_atomic int64_t sequence_number = 42;
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, &delete_seq_no));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, NULL, (void*)0x1, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
-    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_121: [ If key is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, NULL, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* clds_hash_table_delete_key_value */
-
-/* Tests_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key)
+/* Tests_SRS_CLDS_HASH_TABLE_07_122: [ If item_factory is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_with_NULL_item_factory_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_123: [ If item is NULL, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_with_NULL_item_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(NULL, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_124: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_with_non_NULL_sequence_no_but_NULL_start_sequence_no_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
+    int64_t insert_seq_no = 0;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, NULL, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, &item, &insert_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_125: [ clds_hash_table_compute_if_absent shall call clds_sorted_list_compute_if_absent on the bucket list, so that item_factory is called with item_factory_context and key only when the key is not in the bucket. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_127: [ On success clds_hash_table_compute_if_absent shall store the new item, with a reference count incremented for the caller, in item and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_when_the_key_is_not_in_the_table_creates_and_inserts_the_item)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    g_factory_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_compute_if_absent(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4244, (void*)0x1));
+
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, NULL, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, g_factory_item, item);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x1, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item)->key);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_value_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_126: [ If item_factory fails or any other error occurs, clds_hash_table_compute_if_absent shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_when_item_factory_fails_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_compute_if_absent(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4244, (void*)0x1));
+
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_IS_NULL(item);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_not_in_the_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_128: [ If the key already exists in any of the bucket arrays, clds_hash_table_compute_if_absent shall store the existing item, with its reference count incremented, in item and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_when_the_key_is_in_the_table_returns_the_existing_item_without_calling_item_factory)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_compute_if_absent(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, item);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_already_deleted_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_128: [ If the key already exists in any of the bucket arrays, clds_hash_table_compute_if_absent shall store the existing item, with its reference count incremented, in item and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_compute_if_absent_when_the_key_is_in_the_2nd_array_of_buckets_returns_the_existing_item_without_calling_item_factory)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
-    (void)clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_compute_if_absent(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, item);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_key_value_fails)
+/* clds_hash_table_delete */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+TEST_FUNCTION(clds_hash_table_delete_deletes_the_key)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
@@ -1477,160 +2081,141 @@ TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
-        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_2_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    umock_c_reset_all_calls();
+    int result;
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // act
+    result = clds_hash_table_delete(NULL, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    result = clds_hash_table_delete(hash_table, NULL, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_3_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    // 1st bucket array has 1 bucket
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 2nd bucket array has 2 buckets
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 3rd bucket array has 4 buckets
-    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_4, NULL);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_not_in_the_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     destroy_test_context(&test_context);
 }
 
-
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND_even_when_key_is_found_but_different_value)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_does_not_look_in_the_bucket_of_a_lower_level_array_whose_items_were_all_deleted)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
     CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    // 0x1 goes in the 1 bucket array, 0x2 in the 2 buckets array, then the 1 bucket array is emptied
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL));
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, NULL);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1638,60 +2223,54 @@ TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_va
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key_and_stamps_the_sequence_no)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_already_deleted_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    volatile_atomic int64_t sequence_number = 42;
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    (void)clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, &delete_seq_no));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
-    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    int64_t delete_seq_no = 0;
     CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
+        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
+
     // act
-    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1702,208 +2281,346 @@ TEST_FUNCTION(clds_hash_table_delete_key_value_with_non_NULL_sequence_no_but_NUL
     destroy_test_context(&test_context);
 }
 
-/* clds_hash_table_remove */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove. ]*/
-TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list)
+/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+TEST_FUNCTION(delete_looks_in_2_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove. ]*/
-TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list_with_non_NULL_sequence_no)
+/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+TEST_FUNCTION(delete_looks_in_3_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    volatile_atomic int64_t sequence_number = 42;
-    int64_t remove_seq_no;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    // 1st bucket array has 1 bucket
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 2nd bucket array has 2 buckets
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 3rd bucket array has 4 buckets
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_4, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, &remove_seq_no));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
-    ASSERT_ARE_EQUAL(int64_t, 44, remove_seq_no);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_delete_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    umock_c_reset_all_calls();
 
-    // act
-    result = clds_hash_table_remove(NULL, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3, NULL));
+
+    // act
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+TEST_FUNCTION(clds_hash_table_delete_deletes_the_key_and_stamps_the_sequence_no)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, &delete_seq_no));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_remove(hash_table, NULL, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_key_fails)
+/* clds_hash_table_delete_key_value */
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, NULL, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_item_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_key_value(NULL, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, NULL, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_not_in_the_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* removed_item;
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, NULL, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_value_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_not_in_the_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_already_deleted_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_already_deleted_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     (void)clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
@@ -1912,56 +2629,55 @@ TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_already_deleted_fails)
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_remove_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_key_value_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .SetReturn(CLDS_SORTED_LIST_REMOVE_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
+        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-TEST_FUNCTION(remove_looks_in_2_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_2_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -1970,31 +2686,32 @@ TEST_FUNCTION(remove_looks_in_2_buckets)
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    // due to resize it is only one
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-TEST_FUNCTION(remove_looks_in_3_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_3_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     // 1st bucket array has 1 bucket
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     // 2nd bucket array has 2 buckets
@@ -2002,7 +2719,6 @@ TEST_FUNCTION(remove_looks_in_3_buckets)
     CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     // 3rd bucket array has 4 buckets
     CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -2013,35 +2729,35 @@ TEST_FUNCTION(remove_looks_in_3_buckets)
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    // due to resize, only too lists are there
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_remove_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -2050,1841 +2766,8937 @@ TEST_FUNCTION(when_item_is_not_found_in_any_bucket_remove_returns_NOT_FOUND)
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
 
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x3, &removed_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_non_NULL_sequence_no_and_NULL_start_sequence_no_fails)
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND_even_when_key_is_found_but_different_value)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    int64_t remove_seq_no;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+
     // act
-    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     destroy_test_context(&test_context);
 }
 
-/* clds_hash_table_find */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
-TEST_FUNCTION(clds_hash_table_find_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key_and_stamps_the_sequence_no)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, &delete_seq_no));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_find_2nd_item_out_of_3_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_key_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_remove */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove. ]*/
+TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x2);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_find_3rd_item_out_of_3_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove. ]*/
+TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list_with_non_NULL_sequence_no)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t remove_seq_no;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, &remove_seq_no));
 
     // act
-    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x3);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, remove_seq_no);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_hash_table_find_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* removed_item;
 
     // act
-    result = clds_hash_table_find(NULL, test_context.hazard_pointers_thread, (void*)0x3);
+    result = clds_hash_table_remove(NULL, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_hash_table_find_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_find(hash_table, NULL, (void*)0x3);
+    result = clds_hash_table_remove(hash_table, NULL, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_hash_table_find_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, NULL);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, NULL, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
-TEST_FUNCTION(clds_hash_table_find_looks_up_in_the_2nd_array_of_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_item_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // act
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_not_in_the_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
 
     // act
-    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
-TEST_FUNCTION(when_key_is_not_found_in_any_bucket_levels_clds_hash_table_find_yields_NULL)
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_remove_does_not_look_in_the_bucket_of_a_lower_level_array_whose_items_were_all_deleted)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    // 0x1 goes in the 1 bucket array, 0x2 in the 2 buckets array, then the 1 bucket array is emptied
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL));
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x4));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x4));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
 
     // act
-    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x4);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x3, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* clds_hash_table_set_value */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_already_deleted_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    umock_c_reset_all_calls();
-
-    // act
-    result = clds_hash_table_set_value(NULL, test_context.hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
-
-    // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
-
-    // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
-    destroy_test_context(&test_context);
-}
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_clds_hazard_pointers_thread_fails)
-{
-    // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    (void)clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
     // act
-    result = clds_hash_table_set_value(hash_table, NULL, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
-    clds_hazard_pointers_destroy(hazard_pointers);
+    destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_remove_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(CLDS_SORTED_LIST_REMOVE_ERROR);
+
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, NULL, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_new_item_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+TEST_FUNCTION(remove_looks_in_2_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    // due to resize it is only one
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x4, NULL, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_old_item_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+TEST_FUNCTION(remove_looks_in_3_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    // 1st bucket array has 1 bucket
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    // 2nd bucket array has 2 buckets
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 3rd bucket array has 4 buckets
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_4, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    // due to resize, only too lists are there
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, NULL, &set_value_seq_no);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     destroy_test_context(&test_context);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_non_NULL_sequence_number_when_a_starting_sequence_number_was_not_specified)
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_remove_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3, IGNORED_ARG, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x3, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array)
+/* Tests_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_non_NULL_sequence_no_and_NULL_start_sequence_no_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    int64_t remove_seq_no;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
-
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array_with_condition_check)
+/* clds_hash_table_find */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
+TEST_FUNCTION(clds_hash_table_find_succeeds)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-PARAMETERIZED_TEST_FUNCTION(when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails,
-    ARGS(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_result, CLDS_HASH_TABLE_SET_VALUE_RESULT, set_value_result, CONDITION_CHECK_CB, condition_check_cb, void*, condition_check_context),
-    CASE((CLDS_SORTED_LIST_SET_VALUE_ERROR, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL), ERROR),
-    CASE((CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL), NOT_FOUND),
-    CASE((CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, test_item_condition_check, (void*)0x42), CONDITION_NOT_MET))
+/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+TEST_FUNCTION(clds_hash_table_find_2nd_item_out_of_3_succeeds)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, condition_check_cb, condition_check_context, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list)
-        .SetReturn(sorted_list_result);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x2));
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, condition_check_cb, condition_check_context, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x2);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, set_value_result, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(when_underlying_calls_fail_clds_hash_table_set_value_with_empty_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+TEST_FUNCTION(clds_hash_table_find_3rd_item_out_of_3_succeeds)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1))
-        .CallCannotFail();
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list)
-        .SetFailReturn(NULL);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list)
-        .SetFailReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    umock_c_reset_all_calls();
 
-    umock_c_negative_tests_snapshot();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3));
 
-            // act
-            result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+    // act
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x3);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-TEST_FUNCTION(when_there_is_no_sorted_list_in_lower_level_bucket_no_find_is_done_by_clds_hash_table_set_value)
+/* Tests_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    size_t i;
-
-    CLDS_HASH_TABLE_ITEM* dummy_items[4];
-    for (i = 0; i < 4; i++)
-    {
-        dummy_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-        ASSERT_IS_NOT_NULL(dummy_items[i]);
-        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)((4 * i) + 2), dummy_items[i], NULL));
-    }
-
-    CLDS_HASH_TABLE_ITEM* new_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_IS_NOT_NULL(new_item);
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x3, (CLDS_SORTED_LIST_ITEM*)new_item, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    CLDS_HASH_TABLE_ITEM* result;
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x3, new_item, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_find(NULL, test_context.hazard_pointers_thread, (void*)0x3);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_bucket_looks_for_the_item_in_the_lower_levels)
+/* Tests_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x2, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
-
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_3, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, NULL, (void*)0x3);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_finds_the_item_and_replaces_it_in_the_lower_levels)
+/* Tests_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true));
-
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_condition_check_cb_has_cb_called)
+/* Tests_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
+TEST_FUNCTION(clds_hash_table_find_looks_up_in_the_2nd_array_of_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
     STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
-    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_not_met)
+/* Tests_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(when_key_is_not_found_in_any_bucket_levels_clds_hash_table_find_yields_NULL)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
-    g_condition_check_result = CLDS_CONDITION_CHECK_NOT_MET;
-    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x4));
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x4);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_error)
+/* Tests_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_does_not_look_in_the_bucket_of_a_lower_level_array_whose_items_were_all_deleted)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    // 0x1 goes in the 1 bucket array, 0x2 in the 2 buckets array, then the 1 bucket array is emptied
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL));
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
-    g_condition_check_result = CLDS_CONDITION_CHECK_ERROR;
-    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x3);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(when_clds_sorted_list_set_value_in_lower_layer_fails_clds_hash_table_set_value_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_019: [ clds_hash_table_find shall acquire a hazard pointer for each bucket array that it looks up the key in. ]*/
+TEST_FUNCTION(clds_hash_table_find_acquires_a_hazard_pointer_for_each_bucket_array)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_6 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x2 and 0x4 end up in the 2 buckets array, 0x6 in the 4 buckets array, so bucket 1 is empty in both
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_4, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x6, item_6, NULL));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true))
-        .SetReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(test_context.hazard_pointers_thread, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+    CLDS_HASH_TABLE_ITEM* result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     destroy_test_context(&test_context);
 }
 
-/* on_sorted_list_skipped_seq_no */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_075: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
-TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_returns)
+/* Tests_SRS_CLDS_HASH_TABLE_07_020: [ clds_hash_table_find shall look up the key without waiting for the bucket migrations in progress. ]*/
+TEST_FUNCTION(clds_hash_table_find_while_the_bucket_of_the_key_is_migrated_finds_the_key_without_waiting)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    // the find runs while the migration collects the items of the bucket holding 0x1
+    // (the test runs on one thread, so it would never return if the find waited for the move)
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_key = (void*)0x1;
+    g_hook_found_item = NULL;
+    g_hook_action = find_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, hook_clds_sorted_list_get_all_with_action);
     umock_c_reset_all_calls();
 
     // act
-    test_on_sorted_list_skipped_seq_no(NULL, 1);
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, result);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)g_hook_found_item);
 
     // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, real_clds_sorted_list_get_all);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, g_hook_found_item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_076: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
-TEST_FUNCTION(on_sorted_list_skipped_seq_no_calls_the_hash_table_skipped_seq_no)
+/* Tests_SRS_CLDS_HASH_TABLE_07_021: [ If the key is not found and a bucket that can hold the key was being migrated while looking up the key, clds_hash_table_find shall wait for the bucket migration to complete and restart the look up. ]*/
+TEST_FUNCTION(clds_hash_table_find_restarts_the_look_up_when_the_key_is_migrated_while_it_is_looked_up)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
-    void* test_on_sorted_list_skipped_seq_no_context;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    // 0x1 is moved to the 2 buckets array right before the find looks it up in the 1 bucket array, so the first look up misses it
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_migrate_result = CLDS_HASH_TABLE_MIGRATE_ERROR;
+    g_hook_action = migrate_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_find_key, hook_clds_sorted_list_find_key_with_action);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
-        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
-    umock_c_reset_all_calls();
+    // act
+    CLDS_HASH_TABLE_ITEM* result = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
 
-    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb(NULL, 1));
+    // assert
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, g_hook_migrate_result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_find_key, real_clds_sorted_list_find_key);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_find_and_visit */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_100: [ If clds_hash_table is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
 
     // act
-    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 1);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(NULL, test_context.hazard_pointers_thread, (void*)0x1, test_find_visit_cb, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR, result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_113: [ If the sequence number callback passed to clds_hash_table_create was NULL, on_sorted_list_skipped_seq_no shall return. ]*/
-TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_hash_table_skipped_seq_no_returns)
+/* Tests_SRS_CLDS_HASH_TABLE_07_101: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
-    void* test_on_sorted_list_skipped_seq_no_context;
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
-        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 1);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, NULL, (void*)0x1, test_find_visit_cb, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* clds_hash_table_snapshot */
-
-/* Tests_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_102: [ If key is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_with_NULL_key_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(NULL, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, NULL, test_find_visit_cb, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR, result);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_103: [ If visit_cb is NULL, clds_hash_table_find_and_visit shall fail and return CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_with_NULL_visit_cb_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, NULL, &items, &item_count, NULL);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_items_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_104: [ clds_hash_table_find_and_visit shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_105: [ clds_hash_table_find_and_visit shall look up the key in the bucket lists the same way as clds_hash_table_find, but by calling clds_sorted_list_find_key_and_visit so that no reference is taken on the found item. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_106: [ For the found item clds_hash_table_find_and_visit shall call visit_cb with visit_cb_context and the item. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_110: [ Otherwise clds_hash_table_find_and_visit shall succeed and return CLDS_HASH_TABLE_FIND_AND_VISIT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_2nd_item_out_of_3_succeeds)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    uint64_t item_count;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key_and_visit(IGNORED_ARG, IGNORED_ARG, (void*)0x2, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_find_visit_cb((void*)0x4243, item_2));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, NULL, &item_count, NULL);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, (void*)0x2, test_find_visit_cb, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_item_count_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_07_105: [ clds_hash_table_find_and_visit shall look up the key in the bucket lists the same way as clds_hash_table_find, but by calling clds_sorted_list_find_key_and_visit so that no reference is taken on the found item. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_does_not_take_a_reference_on_the_item)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_OK, clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_find_visit_cb, (void*)0x4243));
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_sorted_list_deinit(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG)).IgnoreAllCalls();
+
+    // the list held the only reference, so destroying the table frees the item
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, NULL, NULL);
+    clds_hash_table_destroy(hash_table);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK.]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_empty_table_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_07_105: [ clds_hash_table_find_and_visit shall look up the key in the bucket lists the same way as clds_hash_table_find, but by calling clds_sorted_list_find_key_and_visit so that no reference is taken on the found item. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_looks_up_in_the_2nd_array_of_buckets)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key_and_visit(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key_and_visit(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_find_visit_cb((void*)0x4243, item_1));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_find_visit_cb, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
-    ASSERT_IS_NULL(items);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_07_107: [ clds_hash_table_find_and_visit shall look up the key without waiting for the bucket migrations in progress. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_while_the_bucket_of_the_key_is_migrated_visits_the_item_without_waiting)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    // the find and visit runs while the migration collects the items of the bucket holding 0x1
+    // (the test runs on one thread, so it would never return if the find and visit waited for the move)
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_key = (void*)0x1;
+    g_hook_find_and_visit_result = CLDS_HASH_TABLE_FIND_AND_VISIT_ERROR;
+    g_hook_action = find_and_visit_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, hook_clds_sorted_list_get_all_with_action);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, result);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_OK, g_hook_find_and_visit_result);
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, real_clds_sorted_list_get_all);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_108: [ If the key is not found and a bucket that can hold the key was being migrated while looking up the key, clds_hash_table_find_and_visit shall wait for the bucket migration to complete and restart the look up. ]*/
+TEST_FUNCTION(clds_hash_table_find_and_visit_restarts_the_look_up_when_the_key_is_migrated_while_it_is_looked_up)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    // 0x1 is moved to the 2 buckets array right before it is looked up in the 1 bucket array, so the first look up misses it
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_migrate_result = CLDS_HASH_TABLE_MIGRATE_ERROR;
+    g_hook_action = migrate_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_find_key_and_visit, hook_clds_sorted_list_find_key_and_visit_with_action);
+    umock_c_reset_all_calls();
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, (void*)0x1, test_find_visit_cb, (void*)0x4243);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
-    ASSERT_IS_NOT_NULL(items);
-
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, g_hook_migrate_result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_OK, result);
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_find_key_and_visit, real_clds_sorted_list_find_key_and_visit);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_07_109: [ If the key is not found, clds_hash_table_find_and_visit shall return CLDS_HASH_TABLE_FIND_AND_VISIT_NOT_FOUND without calling visit_cb. ]*/
+TEST_FUNCTION(when_key_is_not_found_in_any_bucket_levels_clds_hash_table_find_and_visit_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 20, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* original_items[10];
-    bool found_originals[10];
-    uint32_t number_of_items = 10;
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)((20 * i) + 1), original_items[i], NULL);
-        found_originals[i] = false;
-    }
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key_and_visit(IGNORED_ARG, IGNORED_ARG, (void*)0x4, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key_and_visit(IGNORED_ARG, IGNORED_ARG, (void*)0x4, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT result = clds_hash_table_find_and_visit(hash_table, test_context.hazard_pointers_thread, (void*)0x4, test_find_visit_cb, (void*)0x4243);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < 10; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
-
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT, CLDS_HASH_TABLE_FIND_AND_VISIT_NOT_FOUND, result);
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_succeeds)
+/* clds_hash_table_set_value */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(NULL, test_context.hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, NULL, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, NULL, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_new_item_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x4, NULL, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_old_item_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, NULL, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_non_NULL_sequence_number_when_a_starting_sequence_number_was_not_specified)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array_with_condition_check)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+PARAMETERIZED_TEST_FUNCTION(when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails,
+    ARGS(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_result, CLDS_HASH_TABLE_SET_VALUE_RESULT, set_value_result, CONDITION_CHECK_CB, condition_check_cb, void*, condition_check_context),
+    CASE((CLDS_SORTED_LIST_SET_VALUE_ERROR, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL), ERROR),
+    CASE((CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL), NOT_FOUND),
+    CASE((CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, test_item_condition_check, (void*)0x42), CONDITION_NOT_MET))
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, condition_check_cb, condition_check_context, IGNORED_ARG, NULL, false))
+        .SetReturn(sorted_list_result);
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, condition_check_cb, condition_check_context, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, set_value_result, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_underlying_calls_fail_clds_hash_table_set_value_with_empty_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1))
+        .CallCannotFail();
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false))
+        .SetFailReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_107: [ If the bucket identified by the hash of the key is empty, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+TEST_FUNCTION(when_the_lower_level_bucket_is_empty_no_find_is_done_by_clds_hash_table_set_value)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    size_t i;
+
+    CLDS_HASH_TABLE_ITEM* dummy_items[4];
+    for (i = 0; i < 4; i++)
+    {
+        dummy_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_IS_NOT_NULL(dummy_items[i]);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)((4 * i) + 2), dummy_items[i], NULL));
+    }
+
+    CLDS_HASH_TABLE_ITEM* new_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_IS_NOT_NULL(new_item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x3, (CLDS_SORTED_LIST_ITEM*)new_item, NULL, NULL, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x3, new_item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_108: [ If the bucket identified by the hash of the key is not empty, clds_hash_table_set_value shall find the key in the list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_bucket_looks_for_the_item_in_the_lower_levels)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x2, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_finds_the_item_and_replaces_it_in_the_lower_levels)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_condition_check_cb_has_cb_called)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_not_met)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
+    g_condition_check_result = CLDS_CONDITION_CHECK_NOT_MET;
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_error)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
+    g_condition_check_result = CLDS_CONDITION_CHECK_ERROR;
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_set_value_in_lower_layer_fails_clds_hash_table_set_value_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true))
+        .SetReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+
+    // act
+    result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_find_batch */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_129: [ If clds_hash_table is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(NULL, test_context.hazard_pointers_thread, keys, 2, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_130: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, NULL, keys, 2, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_131: [ If keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_keys_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, NULL, 2, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_132: [ If key_count is 0, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_0_key_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 0, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_133: [ If items is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_items_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_134: [ If any of the keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_a_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, NULL };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 2, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_135: [ clds_hash_table_find_batch shall process the keys in groups of up to BATCH_PIPELINE_DEPTH keys, hashing all the keys of a group by calling compute_hash before looking up any of them. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_137: [ clds_hash_table_find_batch shall look up each key the same way as clds_hash_table_find and store the found item, or NULL if the key is not found, at the same index in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_138: [ On success clds_hash_table_find_batch shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_finds_the_keys_that_are_in_the_table)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2, (void*)0x3 };
+    CLDS_HASH_TABLE_ITEM* items[3];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3));
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 3, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)items[0]);
+    ASSERT_IS_NULL(items[1]);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)items[2]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[2]);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_135: [ clds_hash_table_find_batch shall process the keys in groups of up to BATCH_PIPELINE_DEPTH keys, hashing all the keys of a group by calling compute_hash before looking up any of them. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_more_keys_than_a_group_looks_up_the_first_group_before_hashing_the_next_one)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_17 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 32, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)17, item_17, NULL);
+    void* keys[17];
+    CLDS_HASH_TABLE_ITEM* items[17];
+    for (uint32_t i = 0; i < 17; i++)
+    {
+        keys[i] = (void*)(uintptr_t)(i + 1);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        STRICT_EXPECTED_CALL(test_compute_hash(keys[i]));
+    }
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)17));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)17));
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 17, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)items[0]);
+    for (uint32_t i = 1; i < 16; i++)
+    {
+        ASSERT_IS_NULL(items[i]);
+    }
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_17, (void*)items[16]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[16]);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_136: [ clds_hash_table_find_batch shall prefetch the bucket slots and the heads of the bucket lists in the first bucket array for all the keys of a group before looking up any of them. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_protects_the_first_bucket_array_while_hashing_and_prefetching_the_group_before_looking_up_any_key)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2, (void*)0x3 };
+    CLDS_HASH_TABLE_ITEM* items[3];
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_acquire, hook_clds_hazard_pointers_acquire_with_log);
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_release, hook_clds_hazard_pointers_release_with_log);
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_find_key, hook_clds_sorted_list_find_key_with_log);
+    umock_c_reset_all_calls();
+    g_call_log_enabled = true;
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 3, items);
+
+    // assert
+    g_call_log_enabled = false;
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // the first bucket array is protected, all the keys are hashed and their buckets prefetched and only then the protection is dropped and the keys looked up
+    ASSERT_IS_TRUE(g_call_log_length > 5);
+    ASSERT_ARE_EQUAL(int, 0, strncmp(g_call_log, "AHHHR", 5), "call log: %s", g_call_log);
+    ASSERT_IS_NOT_NULL(strchr(g_call_log + 5, 'F'), "call log: %s", g_call_log);
+    ASSERT_IS_NULL(strchr(g_call_log + 5, 'H'), "call log: %s", g_call_log);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)items[0]);
+    ASSERT_IS_NULL(items[1]);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)items[2]);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_acquire, real_clds_hazard_pointers_acquire);
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_release, real_clds_hazard_pointers_release);
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_find_key, real_clds_sorted_list_find_key);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[2]);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_136: [ clds_hash_table_find_batch shall prefetch the bucket slots and the heads of the bucket lists in the first bucket array for all the keys of a group before looking up any of them. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_137: [ clds_hash_table_find_batch shall look up each key the same way as clds_hash_table_find and store the found item, or NULL if the key is not found, at the same index in items. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_when_protecting_the_first_bucket_array_for_the_prefetch_fails_still_finds_the_keys)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2, (void*)0x3 };
+    CLDS_HASH_TABLE_ITEM* items[3];
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_acquire, hook_clds_hazard_pointers_acquire_with_log);
+    umock_c_reset_all_calls();
+    g_fail_next_hazard_pointers_acquire = true;
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3));
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, test_context.hazard_pointers_thread, keys, 3, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_FALSE(g_fail_next_hazard_pointers_acquire);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)items[0]);
+    ASSERT_IS_NULL(items[1]);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)items[2]);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_acquire, real_clds_hazard_pointers_acquire);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[2]);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_insert_batch */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_139: [ If clds_hash_table is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(NULL, test_context.hazard_pointers_thread, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_140: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, NULL, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_141: [ If keys is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_keys_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, NULL, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_142: [ If values is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_values_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, NULL, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_143: [ If key_count is 0, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_0_key_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 0, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_144: [ If results is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_results_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_145: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_non_NULL_sequence_numbers_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int64_t sequence_numbers[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, sequence_numbers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_146: [ If any of the keys is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_a_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, NULL };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_147: [ clds_hash_table_insert_batch shall begin one write operation for the whole batch, in the same way as clds_hash_table_insert does for one key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_148: [ clds_hash_table_insert_batch shall hash and prefetch the keys in groups in the same way as clds_hash_table_find_batch. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_149: [ clds_hash_table_insert_batch shall insert each key and value the same way as clds_hash_table_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_150: [ clds_hash_table_insert_batch shall end the write operation after all the keys were inserted. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_152: [ On success clds_hash_table_insert_batch shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_inserts_all_the_keys)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_149: [ clds_hash_table_insert_batch shall insert each key and value the same way as clds_hash_table_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_a_key_that_exists_returns_KEY_ALREADY_EXISTS_for_that_key)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_3, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_149: [ clds_hash_table_insert_batch shall insert each key and value the same way as clds_hash_table_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_stamps_the_sequence_numbers)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int64_t sequence_numbers[2] = { 0, 0 };
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, &sequence_numbers[0]));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, &sequence_numbers[1]));
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, sequence_numbers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 43, sequence_numbers[0]);
+    ASSERT_ARE_EQUAL(int64_t, 44, sequence_numbers[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_151: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_insert_batch shall migrate up to the migration bucket budget buckets once for the whole batch. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_migration_budget_migrates_buckets_once_for_the_whole_batch)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 and 0x2 end up in the 2 buckets array (one in each bucket), 0x3 in the 4 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL));
+    CLDS_HASH_TABLE_ITEM* item_5 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4245);
+    CLDS_HASH_TABLE_ITEM* item_6 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4246);
+    void* keys[] = { (void*)0x5, (void*)0x6 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_5, item_6 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_budget(hash_table, 1));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x5));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x6));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x5));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_5, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x6));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_6, NULL));
+    // the whole batch is followed by moving only 1 bucket (the one holding 0x2) out of the oldest bucket array
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x2, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_151: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_insert_batch shall migrate up to the migration bucket budget buckets once for the whole batch. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_the_default_migration_budget_does_not_migrate_buckets)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 and 0x2 end up in the 2 buckets array (one in each bucket), 0x3 in the 4 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL));
+    CLDS_HASH_TABLE_ITEM* item_5 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4245);
+    CLDS_HASH_TABLE_ITEM* item_6 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4246);
+    void* keys[] = { (void*)0x5, (void*)0x6 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_5, item_6 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x5));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x6));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x5));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_5, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x6));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_6, NULL));
+
+    // act
+    result = clds_hash_table_insert_batch(hash_table, test_context.hazard_pointers_thread, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_delete_batch */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_153: [ If clds_hash_table is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(NULL, test_context.hazard_pointers_thread, keys, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_154: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, NULL, keys, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_155: [ If keys is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_NULL_keys_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, test_context.hazard_pointers_thread, NULL, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_156: [ If key_count is 0, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_0_key_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, test_context.hazard_pointers_thread, keys, 0, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_157: [ If results is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_NULL_results_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, test_context.hazard_pointers_thread, keys, 2, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_158: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_non_NULL_sequence_numbers_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int64_t sequence_numbers[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, test_context.hazard_pointers_thread, keys, 2, results, sequence_numbers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_159: [ If any of the keys is NULL, clds_hash_table_delete_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_with_a_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    void* keys[] = { (void*)0x1, NULL };
+    CLDS_HASH_TABLE_DELETE_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, test_context.hazard_pointers_thread, keys, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_160: [ clds_hash_table_delete_batch shall begin one write operation for the whole batch, in the same way as clds_hash_table_delete does for one key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_161: [ clds_hash_table_delete_batch shall hash and prefetch the keys in groups in the same way as clds_hash_table_find_batch. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_162: [ clds_hash_table_delete_batch shall delete each key the same way as clds_hash_table_delete, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_163: [ clds_hash_table_delete_batch shall end the write operation after all the keys were deleted. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_164: [ On success clds_hash_table_delete_batch shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_delete_batch_deletes_the_keys_that_are_in_the_table)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    void* keys[] = { (void*)0x1, (void*)0x3, (void*)0x2 };
+    CLDS_HASH_TABLE_DELETE_RESULT results[3];
+    int64_t sequence_numbers[3] = { 0, 0, 0 };
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, &sequence_numbers[0]));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x2, &sequence_numbers[2]));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_delete_batch(hash_table, test_context.hazard_pointers_thread, keys, 3, results, sequence_numbers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, results[1]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, results[2]);
+    ASSERT_ARE_EQUAL(int64_t, 45, sequence_numbers[0]);
+    ASSERT_ARE_EQUAL(int64_t, 46, sequence_numbers[2]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* on_sorted_list_skipped_seq_no */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_075: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_returns)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no);
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    test_on_sorted_list_skipped_seq_no(NULL, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_076: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_calls_the_hash_table_skipped_seq_no)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    void* test_on_sorted_list_skipped_seq_no_context;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
+        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb(NULL, 1));
+
+    // act
+    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_113: [ If the sequence number callback passed to clds_hash_table_create was NULL, on_sorted_list_skipped_seq_no shall return. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_hash_table_skipped_seq_no_returns)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    void* test_on_sorted_list_skipped_seq_no_context;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
+        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_snapshot */
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(NULL, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, NULL, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_items_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, NULL, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK.]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_empty_table_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+    ASSERT_IS_NULL(items);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 32, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+    bool found_originals[10];
+    uint32_t number_of_items = 10;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)((32 * i) + 1), original_items[i], NULL);
+        found_originals[i] = false;
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < 10; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+    bool found_originals[10];
+    uint32_t number_of_items = 10;
+
+    const uint32_t number_of_sorted_lists = 10;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+        found_originals[i] = false;
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    }
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < number_of_items; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_after_an_insert_and_delete_multiple_buckets_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    CLDS_HASH_TABLE_ITEM* original_items[1];
+    bool found_originals[1];
+    uint32_t number_of_items = 1;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL));
+        found_originals[i] = false;
+    }
+
+    // insert the extra item to create a new list
+    CLDS_HASH_TABLE_ITEM* extra_item;
+    extra_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4243));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)0x2, extra_item, NULL));
+
+    // delete the extra item
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)0x2, NULL));
+
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    // the bucket emptied by the delete is skipped
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < number_of_items; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_100_items_multiple_buckets_different_hashes_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[100];
+    bool found_originals[100];
+    uint32_t number_of_items = 100;
+
+    const uint32_t number_of_sorted_lists = 100;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+
+        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
+            .SetReturn(i);
+        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+        found_originals[i] = false;
+        umock_c_reset_all_calls();
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    }
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < number_of_items; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_fails_when_underlying_functions_fail)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 32, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + (32 * i)), original_items[i], NULL);
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_fails_when_underlying_functions_fail)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+
+    const uint32_t number_of_sorted_lists = 10;
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    }
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_20_items_multiple_buckets_different_hashes_fails_when_underlying_functions_fail)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[20];
+    uint32_t number_of_items = 20;
+
+    const uint32_t number_of_sorted_lists = 20;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+
+        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
+            .SetReturn(i);
+        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+        umock_c_reset_all_calls();
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    }
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_022: [ clds_hash_table_snapshot shall wait for any migration in progress to complete and prevent new migrations from starting. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_023: [ clds_hash_table_snapshot shall allow migrations to start again. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_prevents_migrations_while_it_collects_the_items)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    // a migration is attempted while the snapshot collects the items of the first bucket
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_migrate_result = CLDS_HASH_TABLE_MIGRATE_ERROR;
+    g_hook_action = migrate_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, hook_clds_sorted_list_get_all_with_action);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_BUSY, g_hook_migrate_result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    // once the snapshot is done migrations can start again
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, real_clds_sorted_list_get_all);
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_115: [ If cancellation_token is non-NULL and cancellation_token_is_cancelled returns true for cancellation_token, clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_and_abandoned_cancellation_token_is_abandoned)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_IS_NOT_NULL(item);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+
+    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(true);
+    ASSERT_IS_NOT_NULL(cancellation_token);
+
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_115: [ If cancellation_token is non-NULL and cancellation_token_is_cancelled returns true for cancellation_token, clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_2_items_same_bucket_cancels_after_the_first_item)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    CLDS_HASH_TABLE_ITEM* original_items[2];
+
+    // insert 1st item
+    original_items[0] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + 0));
+    ASSERT_IS_NOT_NULL(original_items[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)1, original_items[0], NULL));
+
+    // insert 2nd item
+    original_items[1] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + 1));
+    ASSERT_IS_NOT_NULL(original_items[1]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)2, original_items[1], NULL));
+
+    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(false);
+    ASSERT_IS_NOT_NULL(cancellation_token);
+
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token))
+        .SetReturn(true); // fake cancellation
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_succeeds_with_non_NULL_cancellation_token)
+{
+    // this test is cloned from the succesfull test written in ancient times, but it uses a cancellation token
+    // the cancellation token is not signalled, we simply want to make sure that snapshot still works fine when passing
+    // a cancellation token
+
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    CLDS_HASH_TABLE_ITEM* original_items[3];
+    bool found_originals[3];
+    uint32_t number_of_items = 3;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        ASSERT_IS_NOT_NULL(original_items[i]);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL));
+        found_originals[i] = false;
+    }
+    
+    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(false);
+    ASSERT_IS_NOT_NULL(cancellation_token);
+
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    // the level with more buckets has no lists
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < number_of_items; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
+}
+
+/* clds_hash_table_snapshot_concurrent */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_024: [ If clds_hash_table is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_null_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(NULL, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_025: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_null_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, NULL, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_026: [ If items is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_null_items_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, NULL, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_027: [ If item_count is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_null_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_028: [ If sequence_number is non-NULL and no start sequence number was specified in clds_hash_table_create, clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, &sequence_number, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_031: [ clds_hash_table_snapshot_concurrent shall determine the number of items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_033: [ If sequence_number is non-NULL, clds_hash_table_snapshot_concurrent shall store in sequence_number the current sequence number of the hash table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_035: [ If there are no items then clds_hash_table_snapshot_concurrent shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_empty_table_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, &sequence_number, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+    ASSERT_IS_NULL(items);
+    ASSERT_ARE_EQUAL(int64_t, 0, sequence_number);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_029: [ clds_hash_table_snapshot_concurrent shall wait for any migration or snapshot in progress to complete and prevent new ones from starting. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_030: [ clds_hash_table_snapshot_concurrent shall lock the table for writes and wait for the write operations in progress to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_031: [ clds_hash_table_snapshot_concurrent shall determine the number of items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_032: [ clds_hash_table_snapshot_concurrent shall start a new snapshot epoch, items inserted from then on are not part of the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_033: [ If sequence_number is non-NULL, clds_hash_table_snapshot_concurrent shall store in sequence_number the current sequence number of the hash table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_034: [ clds_hash_table_snapshot_concurrent shall unlock the table for writes. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_036: [ clds_hash_table_snapshot_concurrent shall allocate an array of CLDS_HASH_TABLE_ITEM* large enough for all the items in the hash table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_037: [ For each non-empty bucket in each bucket array, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and, for each visited item that was in the table when the snapshot epoch started and that was not taken by the snapshot yet, increment its ref count and add it to the array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_039: [ clds_hash_table_snapshot_concurrent shall lock the table for writes, stop the writers from adding removed items to the array and unlock the table for writes. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_041: [ clds_hash_table_snapshot_concurrent shall store the allocated array of items in items, the count of items in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_043: [ clds_hash_table_snapshot_concurrent shall allow migrations and snapshots to start again. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_1_item_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int64_t insert_sequence_number;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &insert_sequence_number));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_inc_ref(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(test_context.hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, &sequence_number, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    ASSERT_IS_NOT_NULL(items);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+    ASSERT_ARE_EQUAL(int64_t, insert_sequence_number, sequence_number);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_032: [ clds_hash_table_snapshot_concurrent shall start a new snapshot epoch, items inserted from then on are not part of the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_046: [ clds_hash_table_insert and clds_hash_table_set_value shall tag the new item with the current snapshot epoch. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_twice_returns_the_items_each_time)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL));
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    free(items);
+
+    // inserted in the epoch of the first snapshot
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(
+        ((items[0] == item_1) && (items[1] == item_2)) ||
+        ((items[0] == item_2) && (items[1] == item_1)));
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_040: [ The array shall also hold the items that were removed from the hash table while the snapshot was in progress, added by the writers that removed them. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_044: [ While a concurrent snapshot is in progress, clds_hash_table_delete shall remove the item by calling clds_sorted_list_remove_key instead of clds_sorted_list_delete_key and release it after preserving it for the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_045: [ While a concurrent snapshot is in progress, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall increment the ref count of each item they take out of the table that the snapshot did not take yet and add it to the array of the snapshot. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_returns_an_item_deleted_during_the_snapshot)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    g_delete_in_visit_hash_table = hash_table;
+    g_delete_in_visit_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_delete_in_visit_key = (void*)0x2;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_visit, hook_clds_sorted_list_visit_with_delete);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(g_delete_in_visit_key);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(
+        ((items[0] == item_1) && (items[1] == item_2)) ||
+        ((items[0] == item_2) && (items[1] == item_1)));
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x2));
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_visit, real_clds_sorted_list_visit);
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_045: [ While a concurrent snapshot is in progress, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall increment the ref count of each item they take out of the table that the snapshot did not take yet and add it to the array of the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_268: [ While a concurrent snapshot is in progress, clds_hash_table_delete_key_value shall increment the ref count of value before deleting it and release it after preserving it for the snapshot. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_returns_an_item_deleted_by_value_during_the_snapshot)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+
+    // the table holds the only reference to item_2 when it is deleted
+    g_delete_in_visit_hash_table = hash_table;
+    g_delete_in_visit_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_delete_in_visit_key = (void*)0x2;
+    g_delete_in_visit_value = item_2;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_visit, hook_clds_sorted_list_visit_with_delete);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(g_delete_in_visit_key);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(
+        ((items[0] == item_1) && (items[1] == item_2)) ||
+        ((items[0] == item_2) && (items[1] == item_1)));
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x2));
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_visit, real_clds_sorted_list_visit);
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_042: [ If there are any other failures then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_when_malloc_2_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_042: [ If there are any other failures then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_when_clds_sorted_list_visit_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(CLDS_SORTED_LIST_VISIT_ERROR);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_038: [ If cancellation_token is non-NULL and cancellation_token_is_canceled returns true for cancellation_token, clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_with_cancelled_cancellation_token_is_abandoned)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+
+    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(true);
+    ASSERT_IS_NOT_NULL(cancellation_token);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL, cancellation_token);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
+}
+
+/* clds_hash_table_snapshot_parallel */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_068: [ If clds_hash_table is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_NULL_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(NULL, test_context.hazard_pointers_thread, 2, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_069: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, NULL, 2, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_070: [ If worker_count is 0 then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_0_worker_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 0, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_071: [ If items is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_NULL_items_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 2, NULL, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_072: [ If item_count is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_NULL_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 2, &items, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_073: [ clds_hash_table_snapshot_parallel shall wait for any migration or snapshot in progress to complete, prevent new ones from starting, lock the table for writes and wait for the write operations in progress to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_074: [ clds_hash_table_snapshot_parallel shall determine the number of items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_075: [ If there are no items then clds_hash_table_snapshot_parallel shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_085: [ clds_hash_table_snapshot_parallel shall unlock the table for writes and allow migrations and snapshots to start again. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_empty_table_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items = (CLDS_HASH_TABLE_ITEM**)0x4242;
+    uint64_t item_count = 42;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 4, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(items);
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+    ASSERT_ARE_NOT_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_BUSY, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_076: [ clds_hash_table_snapshot_parallel shall allocate an array of CLDS_HASH_TABLE_ITEM* large enough for all the items in the hash table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_080: [ Each worker shall repeatedly claim the next chunk of buckets that no worker claimed yet, until all the chunks of all the bucket arrays are claimed. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_081: [ For each chunk, the worker shall count the items in the non-empty buckets of the chunk with clds_sorted_list_visit, claim a range of the allocated array for them and call clds_sorted_list_get_all for each non-empty bucket of the chunk with the next portion of that range and false as require_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_084: [ clds_hash_table_snapshot_parallel shall store the allocated array of items in items, the count of items in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_1_worker_and_1_item_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, false));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 1, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_077: [ clds_hash_table_snapshot_parallel shall start worker_count - 1 worker threads by calling ThreadAPI_Create and collect the items together with them, the calling thread being the last worker. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_079: [ Each worker thread shall register a thread with the hazard pointers instance of the hash table by calling clds_hazard_pointers_register_thread and unregister it when done. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_083: [ clds_hash_table_snapshot_parallel shall wait for the worker threads to complete by calling ThreadAPI_Join. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_2_workers_and_1_item_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    // the worker thread takes the only chunk
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_context.hazard_pointers));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, IGNORED_ARG, 1, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_unregister_thread(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 2, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_080: [ Each worker shall repeatedly claim the next chunk of buckets that no worker claimed yet, until all the chunks of all the bucket arrays are claimed. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_081: [ For each chunk, the worker shall count the items in the non-empty buckets of the chunk with clds_sorted_list_visit, claim a range of the allocated array for them and call clds_sorted_list_get_all for each non-empty bucket of the chunk with the next portion of that range and false as require_locked_list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_084: [ clds_hash_table_snapshot_parallel shall store the allocated array of items in items, the count of items in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_4_workers_and_1000_items_in_multiple_bucket_arrays_returns_each_item_once)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    // the table grows while the items are inserted, so the items end up in several bucket arrays and chunks
+    CLDS_HASH_TABLE_ITEM* original_items[1000];
+    bool found[1000];
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(i + 1), original_items[i], NULL));
+        found[i] = false;
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 4, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1000, item_count);
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        uint32_t j;
+        for (j = 0; j < 1000; j++)
+        {
+            if (items[i] == original_items[j])
+            {
+                break;
+            }
+        }
+        ASSERT_IS_TRUE(j < 1000, "item %" PRIu64 " is not one of the inserted items", i);
+        ASSERT_IS_FALSE(found[j], "item %" PRIu32 " returned twice", j);
+        found[j] = true;
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_078: [ If ThreadAPI_Create fails, clds_hash_table_snapshot_parallel shall collect the items with the workers started so far. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_when_ThreadAPI_Create_fails_collects_the_items_on_the_calling_thread)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(THREAD_HANDLE)));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(THREADAPI_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 3, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_when_malloc_2_for_the_items_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 2, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_when_malloc_2_for_the_worker_threads_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(3, sizeof(THREAD_HANDLE)))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 4, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_when_clds_sorted_list_visit_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(CLDS_SORTED_LIST_VISIT_ERROR);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 1, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_086: [ If there are any other failures then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_when_clds_sorted_list_get_all_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, false))
+        .SetReturn(CLDS_SORTED_LIST_GET_ALL_ERROR);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 1, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_082: [ If cancellation_token is non-NULL and cancellation_token_is_canceled returns true for cancellation_token, clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_with_cancelled_cancellation_token_is_abandoned)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+
+    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(true);
+    ASSERT_IS_NOT_NULL(cancellation_token);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, test_context.hazard_pointers_thread, 1, &items, &item_count, cancellation_token);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
+}
+
+/* clds_hash_table_iterate_begin */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_047: [ If clds_hash_table is NULL, clds_hash_table_iterate_begin shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_begin_with_NULL_clds_hash_table_fails)
+{
+    // arrange
+
+    // act
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(iterator);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_048: [ clds_hash_table_iterate_begin shall allocate memory for the iterator. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_269: [ clds_hash_table_iterate_begin shall set the walk to start at the first bucket of the oldest bucket array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_275: [ clds_hash_table_iterate_begin shall not hold off migrations, snapshots, shrinks or reservations until clds_hash_table_iterate_end is called. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_052: [ clds_hash_table_iterate_begin shall succeed and return the iterator. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_begin_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(iterator);
+    // nothing is locked while the walk is in progress
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_051: [ If any error occurs, clds_hash_table_iterate_begin shall fail and return NULL. ]*/
+TEST_FUNCTION(when_malloc_fails_clds_hash_table_iterate_begin_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(iterator);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_iterate_next */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_053: [ If iterator is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_with_NULL_iterator_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(NULL, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_054: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, NULL, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_055: [ If items is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_with_NULL_items_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    uint32_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, NULL, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_056: [ If max_item_count is 0, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_with_0_max_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 0, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_057: [ If item_count is NULL, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_with_NULL_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_063: [ If all the bucket arrays have been walked and no item was stored in items, clds_hash_table_iterate_next shall set item_count to 0 and return CLDS_HASH_TABLE_ITERATE_END. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_on_empty_table_returns_END)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count = 42;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_END, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0, item_count);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_270: [ clds_hash_table_iterate_next shall acquire a hazard pointer on each bucket array it looks at, walking the list of bucket arrays from the top level one, and release them all before returning. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_058: [ clds_hash_table_iterate_next shall go through the buckets of each bucket array, starting where the previous call stopped and calling clds_sorted_list_visit for each non-empty bucket, until max_item_count items are stored in items or all the bucket arrays have been walked. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_059: [ For each visited item with a key greater than the key of the last item returned from the same bucket, clds_hash_table_iterate_next shall increment the ref count of the item and store it in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_062: [ clds_hash_table_iterate_next shall store the number of items stored in items in item_count and return CLDS_HASH_TABLE_ITERATE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_276: [ When it is done with a bucket, clds_hash_table_iterate_next shall wait for a move of the bucket that is in progress to complete. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_with_1_item_returns_the_item)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    // the only bucket array
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_inc_ref(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(test_context.hazard_pointers_thread, IGNORED_ARG));
+    // looking for a newer bucket array finds that this one is the top level one
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(test_context.hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, item, items[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_END, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count));
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_059: [ For each visited item with a key greater than the key of the last item returned from the same bucket, clds_hash_table_iterate_next shall increment the ref count of the item and store it in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_060: [ If the page is full before the end of a bucket, clds_hash_table_iterate_next shall keep a reference to the last item stored in items, so that the next call resumes the bucket after its key. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_resumes_in_the_middle_of_a_bucket)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    // 8 buckets, the 3 keys all go in bucket 0
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 8, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* original_items[3];
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(8 * (i + 1)), original_items[i], NULL));
+    }
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result_1 = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result_1);
+    ASSERT_ARE_EQUAL(uint32_t, 2, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, original_items[0], items[0]);
+    ASSERT_ARE_EQUAL(void_ptr, original_items[1], items[1]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[1]);
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result_2 = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result_2);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, original_items[2], items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result_3 = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_END, result_3);
+    ASSERT_ARE_EQUAL(uint32_t, 0, item_count);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_060: [ If the page is full before the end of a bucket, clds_hash_table_iterate_next shall keep a reference to the last item stored in items, so that the next call resumes the bucket after its key. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_resumes_after_the_last_returned_item_was_deleted)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 8, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* original_items[3];
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(8 * (i + 1)), original_items[i], NULL));
+    }
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+
+    CLDS_HASH_TABLE_ITEM* items[1];
+    uint32_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count));
+    ASSERT_ARE_EQUAL(void_ptr, original_items[0], items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)8, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, original_items[1], items[0]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_058: [ clds_hash_table_iterate_next shall go through the buckets of each bucket array, starting where the previous call stopped and calling clds_sorted_list_visit for each non-empty bucket, until max_item_count items are stored in items or all the bucket arrays have been walked. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_returns_the_items_from_all_bucket_arrays)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    // 20 items in a table that starts with 2 buckets end up in several bucket arrays
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* original_items[20];
+    bool found[20] = { 0 };
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(i + 1), original_items[i], NULL));
+    }
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[3];
+    uint32_t item_count;
+    uint32_t total_item_count = 0;
+    CLDS_HASH_TABLE_ITERATE_RESULT result;
+
+    // act
+    while ((result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 3, &item_count)) == CLDS_HASH_TABLE_ITERATE_OK)
+    {
+        for (uint32_t i = 0; i < item_count; i++)
+        {
+            uint32_t j;
+            for (j = 0; j < 20; j++)
+            {
+                if (original_items[j] == items[i])
+                {
+                    break;
+                }
+            }
+            ASSERT_IS_TRUE(j < 20);
+            ASSERT_IS_FALSE(found[j]);
+            found[j] = true;
+            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+        }
+        total_item_count += item_count;
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_END, result);
+    ASSERT_ARE_EQUAL(uint32_t, 20, total_item_count);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_061: [ If clds_sorted_list_visit fails, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_visit_fails_clds_hash_table_iterate_next_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(CLDS_SORTED_LIST_VISIT_ERROR);
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_274: [ If acquiring a hazard pointer fails, clds_hash_table_iterate_next shall fail and return CLDS_HASH_TABLE_ITERATE_ERROR. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_on_the_bucket_array_fails_clds_hash_table_iterate_next_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(test_context.hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_ERROR, result);
+    // the walk can go on once hazard pointers can be acquired again
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count));
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, item, items[0]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_269: [ clds_hash_table_iterate_begin shall set the walk to start at the first bucket of the oldest bucket array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_271: [ clds_hash_table_iterate_next shall resume the walk in the bucket array where the previous call stopped, at the bucket where it stopped. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_273: [ When all the buckets of a bucket array have been walked, clds_hash_table_iterate_next shall go on with the bucket array right above it, or with the oldest bucket array if it is not in the list of bucket arrays anymore. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_walks_the_oldest_bucket_array_first)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM* items[1];
+    uint32_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result_1 = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result_1);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result_2 = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result_2);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_END, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count));
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_272: [ If the bucket array where the previous call stopped is not in the list of bucket arrays anymore, clds_hash_table_iterate_next shall resume the walk at the first bucket of the oldest bucket array. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_next_after_the_bucket_array_was_migrated_resumes_at_the_oldest_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    // the walk stops in the 1 bucket array, which the migration then empties and unlinks
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count));
+    ASSERT_ARE_EQUAL(void_ptr, item_1, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 2));
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_ITERATE_RESULT result = clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    // 0x1 was moved to the 2 buckets array, so it is returned again
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, result);
+    ASSERT_ARE_EQUAL(uint32_t, 2, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, items[0]);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, items[1]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[1]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_END, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 2, &item_count));
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_275: [ clds_hash_table_iterate_begin shall not hold off migrations, snapshots, shrinks or reservations until clds_hash_table_iterate_end is called. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_on_the_thread_walking_the_table_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_iterate_end */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_064: [ If iterator is NULL, clds_hash_table_iterate_end shall return. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_end_with_NULL_iterator_returns)
+{
+    // arrange
+
+    // act
+    clds_hash_table_iterate_end(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_065: [ clds_hash_table_iterate_end shall release the reference to the last item returned from the bucket where the walk stopped. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_067: [ clds_hash_table_iterate_end shall free the iterator. ]*/
+TEST_FUNCTION(clds_hash_table_iterate_end_in_the_middle_of_a_bucket_releases_the_last_item_and_frees_the_iterator)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 8, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* original_items[2];
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(8 * (i + 1)), original_items[i], NULL));
+    }
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    CLDS_HASH_TABLE_ITEM* items[1];
+    uint32_t item_count;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_ITERATE_RESULT, CLDS_HASH_TABLE_ITERATE_OK, clds_hash_table_iterate_next(iterator, test_context.hazard_pointers_thread, items, 1, &item_count));
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(iterator));
+
+    // act
+    clds_hash_table_iterate_end(iterator);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_migrate */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_002: [ If clds_hash_table is NULL, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(NULL, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_003: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, NULL, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_004: [ If bucket_budget is 0, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_with_0_bucket_budget_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_010: [ If only the top level bucket array is left, clds_hash_table_migrate shall return CLDS_HASH_TABLE_MIGRATE_COMPLETE. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_with_only_one_bucket_array_returns_COMPLETE)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_001: [ clds_hash_table_migrate shall move the items in at most bucket_budget buckets of the oldest bucket array to the top level bucket array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_005: [ The oldest bucket array shall be the last bucket array in the list of bucket arrays. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_007: [ Before moving a bucket, clds_hash_table_migrate shall hold up new write operations on the keys that can be in the bucket and wait for the ongoing write operations on those keys to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_008: [ For each bucket, up to bucket_budget buckets, clds_hash_table_migrate shall move all the items in the next not yet migrated bucket of the oldest bucket array to the top level bucket array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_012: [ Otherwise clds_hash_table_migrate shall succeed and return CLDS_HASH_TABLE_MIGRATE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_013: [ After moving a bucket, clds_hash_table_migrate shall let the write operations on the keys that can be in the bucket proceed. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_moves_one_bucket_to_the_top_level_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_009: [ When all the buckets of the oldest bucket array have been moved, clds_hash_table_migrate shall unlink the oldest bucket array and reclaim it by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_010: [ If only the top level bucket array is left, clds_hash_table_migrate shall return CLDS_HASH_TABLE_MIGRATE_COMPLETE. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_unlinks_and_reclaims_the_emptied_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_008: [ For each bucket, up to bucket_budget buckets, clds_hash_table_migrate shall move all the items in the next not yet migrated bucket of the oldest bucket array to the top level bucket array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_010: [ If only the top level bucket array is left, clds_hash_table_migrate shall return CLDS_HASH_TABLE_MIGRATE_COMPLETE. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_with_big_budget_moves_all_items_to_the_top_level_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL));
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, UINT32_MAX);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, result);
+
+    // all items are found by looking only in the top level bucket array
+    for (uintptr_t key = 1; key <= 3; key++)
+    {
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+        STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+        STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+        STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+        STRICT_EXPECTED_CALL(test_compute_hash((void*)key));
+        STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)key));
+
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)key);
+
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_IS_NOT_NULL(found_item);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_008: [ For each bucket, up to bucket_budget buckets, clds_hash_table_migrate shall move all the items in the next not yet migrated bucket of the oldest bucket array to the top level bucket array. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_reports_the_sequence_numbers_used_by_the_move_as_skipped)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int64_t insert_seq_no;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, &insert_seq_no));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, &insert_seq_no));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb(NULL, 3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb(NULL, 4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_011: [ If any error occurs, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+TEST_FUNCTION(when_allocating_the_items_array_fails_clds_hash_table_migrate_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_011: [ If any error occurs, clds_hash_table_migrate shall fail and return CLDS_HASH_TABLE_MIGRATE_ERROR. ]*/
+TEST_FUNCTION(when_inserting_in_the_target_list_fails_clds_hash_table_migrate_fails_and_the_item_stays_in_the_old_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL))
+        .SetReturn(CLDS_SORTED_LIST_INSERT_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_ERROR, result);
+    CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)found_item);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_275: [ clds_hash_table_iterate_begin shall not hold off migrations, snapshots, shrinks or reservations until clds_hash_table_iterate_end is called. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_while_an_iterator_is_open_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_007: [ Before moving a bucket, clds_hash_table_migrate shall hold up new write operations on the keys that can be in the bucket and wait for the ongoing write operations on those keys to complete. ]*/
+TEST_FUNCTION(clds_hash_table_migrate_does_not_hold_up_the_writers_of_keys_that_cannot_be_in_the_bucket_being_moved)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_6 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x2 and 0x4 end up in bucket 0 of the 2 buckets array, 0x6 in the 4 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x4, item_4, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x6, item_6, NULL));
+
+    // 0x3 cannot be in bucket 0 of the 2 buckets array, so inserting it while that bucket is moved does not wait
+    // (the test runs on one thread, so it would never return if the insert waited for the move)
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_key = (void*)0x3;
+    g_hook_item = item_3;
+    g_hook_insert_result = CLDS_HASH_TABLE_INSERT_ERROR;
+    g_hook_action = insert_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, hook_clds_sorted_list_get_all_with_action);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_MIGRATE_RESULT result = clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, result);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, g_hook_insert_result);
+    for (uintptr_t key = 2; key <= 6; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)key);
+        ASSERT_IS_TRUE((found_item != NULL) == (key != 5));
+        if (found_item != NULL)
+        {
+            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+        }
+    }
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_get_all, real_clds_sorted_list_get_all);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_set_migration_budget */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_014: [ If clds_hash_table is NULL, clds_hash_table_set_migration_budget shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_set_migration_budget_with_NULL_hash_table_fails)
+{
+    // arrange
+
+    // act
+    int result = clds_hash_table_set_migration_budget(NULL, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_015: [ clds_hash_table_set_migration_budget shall set the number of buckets that each insert and set value operation migrates and succeed, returning 0. ]*/
+TEST_FUNCTION(clds_hash_table_set_migration_budget_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hash_table_set_migration_budget(hash_table, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+TEST_FUNCTION(clds_hash_table_insert_waits_for_the_inserts_in_progress_in_the_lower_level_bucket_array_by_spinning_and_then_sleeping)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    g_waiting_insert_hazard_pointers_thread = clds_hazard_pointers_register_thread(test_context.hazard_pointers);
+    ASSERT_IS_NOT_NULL(g_waiting_insert_hazard_pointers_thread);
+
+    // while 0x1 is being inserted in the 1 bucket array, another thread inserts 0x2 in a new 2 buckets array,
+    // which has to wait for the insert of 0x1 before looking up 0x2 in the 1 bucket array
+    // (the calls made by the 2 threads are not checked, as their order is not deterministic)
+    g_hook_hash_table = hash_table;
+    g_hook_key = (void*)0x2;
+    g_hook_item = item_2;
+    g_hook_insert_result = CLDS_HASH_TABLE_INSERT_ERROR;
+    g_waiting_insert_thread_create_result = THREADAPI_ERROR;
+    (void)interlocked_exchange(&g_waiting_insert_done, 0);
+    g_waiting_insert_done_before_release = 1;
+    g_hook_action = start_waiting_insert_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, hook_clds_sorted_list_insert_with_action);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, g_waiting_insert_thread_create_result);
+    int thread_result;
+    ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, real_ThreadAPI_Join(g_waiting_insert_thread, &thread_result));
+    ASSERT_ARE_EQUAL(int, 0, thread_result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(int32_t, 0, g_waiting_insert_done_before_release, "the insert of 0x2 should not complete while 0x1 is being inserted");
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, g_hook_insert_result);
+    CLDS_HASH_TABLE_ITEM* found_item_1 = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)found_item_1);
+    CLDS_HASH_TABLE_ITEM* found_item_2 = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x2);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)found_item_2);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, real_clds_sorted_list_insert);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_017: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_insert shall migrate up to the migration bucket budget buckets as described in clds_hash_table_migrate. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_migration_budget_migrates_buckets)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_budget(hash_table, 1));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+    // the insert is followed by moving 1 bucket out of the oldest bucket array
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_016: [ By default the migration bucket budget shall be 0, which means that insert and set value operations do not migrate any buckets. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_the_default_migration_budget_does_not_migrate_buckets)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    // nothing was moved, 0x1 is still in the 1 bucket array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_OK, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_018: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_set_value shall migrate up to the migration bucket budget buckets as described in clds_hash_table_migrate. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_migration_budget_migrates_buckets)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_budget(hash_table, 1));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x3, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, false));
+    // the set value is followed by moving 1 bucket out of the oldest bucket array
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result = clds_hash_table_set_value(hash_table, test_context.hazard_pointers_thread, (void*)0x3, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(old_item);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_shrink */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_090: [ If clds_hash_table is NULL, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(NULL, test_context.hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_277: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_275: [ clds_hash_table_iterate_begin shall not hold off migrations, snapshots, shrinks or reservations until clds_hash_table_iterate_end is called. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_while_iterating_does_not_return_BUSY)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread);
+
+    // assert
+    // the table is already at its initial size
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_NOT_NEEDED, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_094: [ If the number of items is less than a quarter of the number of buckets in the top level bucket array, clds_hash_table_shrink shall halve the number of buckets for as long as the result holds at least twice the number of items and is not less than the initial_bucket_size passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_095: [ If the number of buckets would not change, clds_hash_table_shrink shall return CLDS_HASH_TABLE_SHRINK_NOT_NEEDED. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_with_the_initial_bucket_count_returns_NOT_NEEDED)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_NOT_NEEDED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_093: [ clds_hash_table_shrink shall count the items in all the bucket arrays. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_095: [ If the number of buckets would not change, clds_hash_table_shrink shall return CLDS_HASH_TABLE_SHRINK_NOT_NEEDED. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_when_the_table_is_loaded_returns_NOT_NEEDED)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 4 items spread over the 1, 2 and 4 buckets arrays
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)key, item, NULL));
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_NOT_NEEDED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_092: [ clds_hash_table_shrink shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_094: [ If the number of items is less than a quarter of the number of buckets in the top level bucket array, clds_hash_table_shrink shall halve the number of buckets for as long as the result holds at least twice the number of items and is not less than the initial_bucket_size passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_096: [ clds_hash_table_shrink shall allocate a new bucket array with the computed number of buckets and initialize the list of each bucket by calling clds_sorted_list_init. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_097: [ clds_hash_table_shrink shall make the new bucket array the top level bucket array, with all the existing bucket arrays below it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_099: [ clds_hash_table_shrink shall unlock the table for writes. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_278: [ clds_hash_table_shrink shall move all the items of the older bucket arrays to the new bucket array and reclaim the older bucket arrays as described in clds_hash_table_migrate. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_279: [ clds_hash_table_shrink shall succeed and return CLDS_HASH_TABLE_SHRINK_OK. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_after_deleting_all_items_goes_back_to_the_initial_bucket_count)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)key, item, NULL));
+    }
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)key, NULL));
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    // the 1, 2 and 4 buckets arrays are empty, so they are only unlinked and reclaimed
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    }
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_OK, result);
+    // only the new bucket array is left
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+    // the 4 buckets array is gone, so the table can shrink no further
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_NOT_NEEDED, clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_094: [ If the number of items is less than a quarter of the number of buckets in the top level bucket array, clds_hash_table_shrink shall halve the number of buckets for as long as the result holds at least twice the number of items and is not less than the initial_bucket_size passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_278: [ clds_hash_table_shrink shall move all the items of the older bucket arrays to the new bucket array and reclaim the older bucket arrays as described in clds_hash_table_migrate. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_moves_the_remaining_items_to_the_smaller_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    // 8 items grow the table to 8 buckets
+    for (uintptr_t key = 1; key <= 8; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)key, item, NULL));
+    }
+    for (uintptr_t key = 2; key <= 8; key++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)key, NULL));
+    }
+    umock_c_reset_all_calls();
+
+    // 1 item left, 2 buckets leave room for it to double
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    // 0x1 is in the 1 bucket array
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // the emptied 1, 2, 4 and 8 buckets arrays are reclaimed
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    }
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+    CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    ASSERT_IS_NOT_NULL(found_item);
+
+    // cleanup
+    clds_hash_table_node_release(found_item);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_098: [ If any error occurs, clds_hash_table_shrink shall fail and return CLDS_HASH_TABLE_SHRINK_ERROR. ]*/
+TEST_FUNCTION(when_malloc_flex_fails_clds_hash_table_shrink_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)key, item, NULL));
+    }
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)key, NULL));
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_SHRINK_RESULT result = clds_hash_table_shrink(hash_table, test_context.hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SHRINK_RESULT, CLDS_HASH_TABLE_SHRINK_ERROR, result);
+    // the table was unlocked
+    ASSERT_ARE_NOT_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_BUSY, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_reserve */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_171: [ If clds_hash_table is NULL, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(NULL, test_context.hazard_pointers_thread, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_172: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, NULL, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_173: [ If item_count is 0, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_0_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_174: [ If item_count is greater than 2^29, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_item_count_greater_than_2_to_the_29_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, ((uint64_t)1 << 29) + 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_275: [ clds_hash_table_iterate_begin shall not hold off migrations, snapshots, shrinks or reservations until clds_hash_table_iterate_end is called. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_while_iterating_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    CLDS_HASH_TABLE_ITERATOR_HANDLE iterator = clds_hash_table_iterate_begin(hash_table);
+    ASSERT_IS_NOT_NULL(iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_OK, result);
+
+    // cleanup
+    clds_hash_table_iterate_end(iterator);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_177: [ clds_hash_table_reserve shall round item_count up to the next power of two to obtain the number of buckets and if the top level bucket array already has at least that many buckets, clds_hash_table_reserve shall return CLDS_HASH_TABLE_RESERVE_NOT_NEEDED. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_enough_buckets_returns_NOT_NEEDED)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_NOT_NEEDED, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_176: [ clds_hash_table_reserve shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_177: [ clds_hash_table_reserve shall round item_count up to the next power of two to obtain the number of buckets and if the top level bucket array already has at least that many buckets, clds_hash_table_reserve shall return CLDS_HASH_TABLE_RESERVE_NOT_NEEDED. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_178: [ clds_hash_table_reserve shall allocate a new bucket array with the computed number of buckets and initialize the list of each bucket by calling clds_sorted_list_init. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_179: [ If the hash table holds no items, clds_hash_table_reserve shall make the new bucket array the only bucket array of the hash table, reclaim the existing bucket arrays by calling clds_hazard_pointers_reclaim and return CLDS_HASH_TABLE_RESERVE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_182: [ clds_hash_table_reserve shall unlock the table for writes and allow migrations and snapshots to start again. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_on_an_empty_table_replaces_the_bucket_arrays)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 8, IGNORED_ARG));
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 5);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_OK, result);
+    // only the new bucket array is left and the table is unlocked
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_NOT_NEEDED, clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 8));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_180: [ Otherwise clds_hash_table_reserve shall make the new bucket array the top level bucket array, with all the existing bucket arrays below it, and return CLDS_HASH_TABLE_RESERVE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_on_a_table_with_items_keeps_the_existing_bucket_arrays_below_the_new_one)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    }
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_COMPLETE, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, UINT32_MAX));
+    CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item, found_item);
+
+    // cleanup
+    clds_hash_table_node_release(found_item);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_181: [ If any error occurs, clds_hash_table_reserve shall fail and return CLDS_HASH_TABLE_RESERVE_ERROR. ]*/
+TEST_FUNCTION(when_malloc_flex_fails_clds_hash_table_reserve_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_RESERVE_RESULT result = clds_hash_table_reserve(hash_table, test_context.hazard_pointers_thread, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_ERROR, result);
+    // the table was unlocked
+    ASSERT_ARE_NOT_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_BUSY, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_bulk_load */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_183: [ If clds_hash_table is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(NULL, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_184: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, NULL, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_185: [ If worker_count is 0, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_0_worker_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 0, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_186: [ If keys is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_NULL_keys_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, NULL, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_187: [ If values is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_NULL_values_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, NULL, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_188: [ If key_count is 0, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_0_key_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 0, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_189: [ If results is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_NULL_results_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_190: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_non_NULL_sequence_numbers_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int64_t sequence_numbers[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, sequence_numbers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_191: [ If any of the keys is NULL, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_a_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, NULL };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_192: [ clds_hash_table_bulk_load shall wait for any migration or snapshot in progress to complete, prevent new ones from starting, lock the table for writes and wait for the write operations in progress to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_193: [ clds_hash_table_bulk_load shall count the items in all the bucket arrays and reserve room in the top level bucket array for them and for key_count more items (but no more than 2^29 items) in the same way as clds_hash_table_reserve. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_195: [ clds_hash_table_bulk_load shall allocate memory for the hashes of the keys and for grouping the keys by ranges of buckets of the top level bucket array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_198: [ Each worker shall repeatedly claim the next chunk of keys that no worker claimed yet and hash the keys of the chunk by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_199: [ clds_hash_table_bulk_load shall group the keys by ranges of buckets of the top level bucket array, keeping the order of the keys within each range. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_203: [ For each range, the worker shall insert the values of the keys in the range, in the order of the keys, in the bucket lists of the top level bucket array by calling clds_sorted_list_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_208: [ clds_hash_table_bulk_load shall stop counting itself as an insert in progress in the top level bucket array and allow migrations and snapshots to start again. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_210: [ On success clds_hash_table_bulk_load shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_1_worker_inserts_the_keys_range_by_range)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x2, (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // the 4 buckets are already enough and each bucket is a range
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    // the key in bucket 1 goes in before the key in bucket 2
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+    // the table was unlocked
+    ASSERT_ARE_NOT_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_BUSY, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_267: [ Once room is reserved, clds_hash_table_bulk_load shall count itself as an insert in progress in the top level bucket array and unlock the table for writes, so that the other write operations run concurrently with the load. ]*/
+TEST_FUNCTION(clds_hash_table_insert_while_clds_hash_table_bulk_load_inserts_the_items_does_not_wait_for_the_load)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x2, (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+
+    // 0x3 is inserted while the load inserts its first item
+    // (the test runs on one thread, so it would never return if the insert waited for the load)
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_key = (void*)0x3;
+    g_hook_item = item_3;
+    g_hook_insert_result = CLDS_HASH_TABLE_INSERT_ERROR;
+    g_hook_action = insert_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, hook_clds_sorted_list_insert_with_action);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, g_hook_insert_result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+    CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x3);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)found_item);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, real_clds_sorted_list_insert);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_192: [ clds_hash_table_bulk_load shall wait for any migration or snapshot in progress to complete, prevent new ones from starting, lock the table for writes and wait for the write operations in progress to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_175: [ If a migration or a snapshot is in progress, clds_hash_table_reserve shall return CLDS_HASH_TABLE_RESERVE_BUSY. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_while_clds_hash_table_bulk_load_inserts_the_items_returns_BUSY)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x2, (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+
+    g_hook_hash_table = hash_table;
+    g_hook_hazard_pointers_thread = test_context.hazard_pointers_thread;
+    g_hook_reserve_result = CLDS_HASH_TABLE_RESERVE_ERROR;
+    g_hook_action = reserve_hook_action;
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, hook_clds_sorted_list_insert_with_action);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(g_hook_action);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_RESERVE_RESULT, CLDS_HASH_TABLE_RESERVE_BUSY, g_hook_reserve_result);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, real_clds_sorted_list_insert);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_194: [ If reserving room fails, clds_hash_table_bulk_load shall insert the items in the existing top level bucket array. ]*/
+TEST_FUNCTION(when_reserving_room_fails_clds_hash_table_bulk_load_inserts_the_items_in_the_existing_top_level_bucket_array)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 2, IGNORED_ARG))
+        .SetReturn(NULL);
+    // the 1 bucket array is a single range
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_205: [ If inserting a key fails, the worker shall store CLDS_HASH_TABLE_INSERT_ERROR for it and continue with the next key. ]*/
+TEST_FUNCTION(when_inserting_a_key_fails_clds_hash_table_bulk_load_stores_INSERT_ERROR_for_it_and_inserts_the_next_key)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x2, (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL))
+        .SetReturn(CLDS_SORTED_LIST_INSERT_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_209: [ If the migration bucket budget is not 0 and there are lower level bucket arrays, clds_hash_table_bulk_load shall migrate up to the migration bucket budget buckets once. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_migration_budget_migrates_buckets)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 0x1 ends up in the 1 bucket array, 0x2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_budget(hash_table, 1));
+    void* keys[] = { (void*)0x3 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_3 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // 2 items in the table and 1 more make a 4 buckets array on top of the existing ones
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // the load is followed by moving 1 bucket out of the oldest bucket array
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, 1, IGNORED_ARG, IGNORED_ARG, true));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 1, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_196: [ clds_hash_table_bulk_load shall start worker_count - 1 worker threads by calling ThreadAPI_Create, once for hashing the keys and once for inserting the items, the calling thread being the last worker each time. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_200: [ Each worker thread that inserts items shall register a thread with the hazard pointers instance of the hash table by calling clds_hazard_pointers_register_thread and unregister it when done. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_201: [ Each worker shall repeatedly claim the next range of buckets that no worker claimed yet, so that no two workers insert in the same bucket. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_206: [ clds_hash_table_bulk_load shall wait for the worker threads to complete by calling ThreadAPI_Join. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_2_workers_and_1_key_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)));
+    // the worker thread hashes the only chunk of keys
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    // the worker thread takes all the ranges
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_context.hazard_pointers));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_unregister_thread(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 2, keys, values, 1, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_197: [ If ThreadAPI_Create fails, clds_hash_table_bulk_load shall continue with the workers started so far. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_when_ThreadAPI_Create_fails_loads_the_items_on_the_calling_thread)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(THREAD_HANDLE)));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(THREADAPI_ERROR);
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(THREADAPI_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 3, keys, values, 1, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_193: [ clds_hash_table_bulk_load shall count the items in all the bucket arrays and reserve room in the top level bucket array for them and for key_count more items (but no more than 2^29 items) in the same way as clds_hash_table_reserve. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_202: [ If the lower level bucket arrays hold any items, the worker shall first look up the key in them by calling clds_sorted_list_find_key and store CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS for the key if it is found. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_a_key_in_a_lower_level_bucket_array_returns_KEY_ALREADY_EXISTS_for_that_key)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // key 1 ends up in the 1 bucket array and key 2 in the 2 buckets array
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    void* keys[] = { (void*)0x1, (void*)0x3 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_3, item_4 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // 2 items in the table and 2 more make a 4 buckets array on top of the existing ones
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    // bucket 1 of the 2 buckets array is empty, so only the 1 bucket array is looked up
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, (void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_4, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_204: [ If a key is already in the top level bucket array or appears earlier in keys, the worker shall store CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS for it. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_with_a_key_that_appears_twice_returns_KEY_ALREADY_EXISTS_for_the_second_one)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, results[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_203: [ For each range, the worker shall insert the values of the keys in the range, in the order of the keys, in the bucket lists of the top level bucket array by calling clds_sorted_list_insert, store the result at the same index in results and, if sequence_numbers is non-NULL, the sequence number at the same index in sequence_numbers. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_stamps_the_sequence_numbers)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1, item_2 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int64_t sequence_numbers[2] = { 0, 0 };
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_1, &sequence_numbers[0]));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, &sequence_numbers[1]));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 2, results, sequence_numbers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 43, sequence_numbers[0]);
+    ASSERT_ARE_EQUAL(int64_t, 44, sequence_numbers[1]);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_207: [ If any other error occurs, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_when_malloc_2_for_the_hashes_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 1, keys, values, 1, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    // the table was unlocked
+    ASSERT_ARE_NOT_EQUAL(CLDS_HASH_TABLE_MIGRATE_RESULT, CLDS_HASH_TABLE_MIGRATE_BUSY, clds_hash_table_migrate(hash_table, test_context.hazard_pointers_thread, 1));
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_207: [ If any other error occurs, clds_hash_table_bulk_load shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_bulk_load_when_malloc_2_for_the_worker_threads_fails_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    void* keys[] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* values[] = { item_1 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_bulk_load(hash_table, test_context.hazard_pointers_thread, 2, keys, values, 1, results, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_snapshot_image_write */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_211: [ If clds_hash_table is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    uint64_t image_size;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_write(NULL, items, 1, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_212: [ If items is NULL and item_count is not 0, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_NULL_items_and_non_zero_item_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, NULL, 1, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_280: [ If any of the first item_count entries of items is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_a_NULL_item_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* items[] = { item_1, NULL };
+    uint64_t image_size;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key = (void*)0x1;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 2, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_213: [ If get_record_size is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_NULL_get_record_size_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    uint64_t image_size;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, NULL, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_214: [ If serialize_record is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_NULL_serialize_record_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    uint64_t image_size;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, test_get_record_size, NULL, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_215: [ If write_image is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_NULL_write_image_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    uint64_t image_size;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, test_get_record_size, test_serialize_record, NULL, NULL, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_216: [ If image_size is NULL, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_NULL_image_size_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_217: [ clds_hash_table_snapshot_image_write shall lay out the image with item_count rounded up to a power of two buckets (at least 1 and at most 2^29). ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_218: [ clds_hash_table_snapshot_image_write shall allocate memory for the hashes and record sizes of the items, for the bucket directory of the image and for placing the records in their buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_219: [ For each item, clds_hash_table_snapshot_image_write shall compute the hash of its key in the same way as the hash table does and get the size of its record by calling get_record_size. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_221: [ For each item, clds_hash_table_snapshot_image_write shall call serialize_record to fill the record of the item and call write_image to write the record header, the record and its padding at the next free offset in the bucket of the item. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_223: [ clds_hash_table_snapshot_image_write shall then call write_image to write the bucket directory and, last, the header holding the version of the format, sequence_number, the hash finalizer of the table and the layout of the image. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_224: [ clds_hash_table_snapshot_image_write shall store the size of the image in image_size. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_225: [ On success clds_hash_table_snapshot_image_write shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_2_items_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* items[] = { item_1, item_2 };
+    uint64_t image_size;
+    uint64_t record_count;
+    int64_t sequence_number;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key = (void*)0x1;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_2)->key = (void*)0x2;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 2, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // 64 bytes of header, 3 directory entries of 16 bytes and 2 records of 24 bytes
+    ASSERT_ARE_EQUAL(uint64_t, 160, image_size);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_snapshot_image_get_info(g_test_image_buffer, image_size, &record_count, &sequence_number));
+    ASSERT_ARE_EQUAL(uint64_t, 2, record_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_217: [ clds_hash_table_snapshot_image_write shall lay out the image with item_count rounded up to a power of two buckets (at least 1 and at most 2^29). ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_write_with_0_items_writes_an_image_with_1_bucket)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size;
+    uint64_t record_count;
+    int64_t sequence_number;
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, NULL, 0, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 96, image_size);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_snapshot_image_get_info(g_test_image_buffer, image_size, &record_count, &sequence_number));
+    ASSERT_ARE_EQUAL(uint64_t, 0, record_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_222: [ If serialize_record or write_image fail, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_write_image_fails_clds_hash_table_snapshot_image_write_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* items[] = { item_1 };
+    uint64_t image_size;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key = (void*)0x1;
+    g_write_image_result = 1;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_226: [ If any other error occurs, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_malloc_2_for_the_hashes_fails_clds_hash_table_snapshot_image_write_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* items[] = { item_1 };
+    uint64_t image_size;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key = (void*)0x1;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_220: [ If the size of a record is greater than UINT32_MAX minus the size of the record header and padding, clds_hash_table_snapshot_image_write shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_a_record_is_too_large_clds_hash_table_snapshot_image_write_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* items[] = { item_1 };
+    uint64_t image_size;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key = (void*)0x1;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_snapshot_image_write(hash_table, items, 1, 42, test_get_too_large_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_snapshot_image_get_info */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_227: [ If image is NULL, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_get_info_with_NULL_image_fails)
+{
+    // arrange
+    uint64_t record_count;
+    int64_t sequence_number;
+    int result;
+
+    // act
+    result = clds_hash_table_snapshot_image_get_info(NULL, sizeof(g_test_image_buffer), &record_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_228: [ If record_count is NULL, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_get_info_with_NULL_record_count_fails)
+{
+    // arrange
+    int64_t sequence_number;
+    int result;
+
+    // act
+    result = clds_hash_table_snapshot_image_get_info(g_test_image_buffer, sizeof(g_test_image_buffer), NULL, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_229: [ If sequence_number is NULL, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_get_info_with_NULL_sequence_number_fails)
+{
+    // arrange
+    uint64_t record_count;
+    int result;
+
+    // act
+    result = clds_hash_table_snapshot_image_get_info(g_test_image_buffer, sizeof(g_test_image_buffer), &record_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_230: [ clds_hash_table_snapshot_image_get_info shall validate that image is aligned to 8 bytes, starts with a header of a supported version and that the bucket directory and the records fit in image_size and cover all the records. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_232: [ On success clds_hash_table_snapshot_image_get_info shall store the number of records and the sequence number of the image in record_count and sequence_number and return 0. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_get_info_returns_the_record_count_and_the_sequence_number)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    uint64_t record_count;
+    int64_t sequence_number;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_get_info(g_test_image_buffer, image_size, &record_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, record_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_231: [ If the image is not valid, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_get_info_with_a_corrupted_header_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    uint64_t record_count;
+    int64_t sequence_number;
+    int result;
+    // flip a bit of the magic number
+    ((unsigned char*)g_test_image_buffer)[0] ^= 1;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_get_info(g_test_image_buffer, image_size, &record_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_231: [ If the image is not valid, clds_hash_table_snapshot_image_get_info shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_get_info_with_a_truncated_image_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    uint64_t record_count;
+    int64_t sequence_number;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_get_info(g_test_image_buffer, image_size - 1, &record_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_snapshot_image_find */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_233: [ If clds_hash_table is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_NULL_hash_table_fails)
+{
+    // arrange
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+
+    // act
+    result = clds_hash_table_snapshot_image_find(NULL, g_test_image_buffer, sizeof(g_test_image_buffer), (void*)0x1, test_record_match, NULL, &record, &record_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_234: [ If image is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_NULL_image_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, NULL, sizeof(g_test_image_buffer), (void*)0x1, test_record_match, NULL, &record, &record_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_235: [ If key is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, sizeof(g_test_image_buffer), NULL, test_record_match, NULL, &record, &record_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_236: [ If record_match is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_NULL_record_match_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, sizeof(g_test_image_buffer), (void*)0x1, NULL, NULL, &record, &record_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_237: [ If record is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_NULL_record_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, sizeof(g_test_image_buffer), (void*)0x1, test_record_match, NULL, NULL, &record_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_238: [ If record_size is NULL, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_NULL_record_size_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    const unsigned char* record;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, sizeof(g_test_image_buffer), (void*)0x1, test_record_match, NULL, &record, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_239: [ clds_hash_table_snapshot_image_find shall validate the header of the image in the same way as clds_hash_table_snapshot_image_get_info, without walking the whole bucket directory. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_241: [ clds_hash_table_snapshot_image_find shall compute the hash of key in the same way as the hash table does and look at the records of the bucket of the image that the hash maps to. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_242: [ For each record of the bucket with the same hash, clds_hash_table_snapshot_image_find shall call record_match and if it returns true store the record and its size in record and record_size and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_finds_the_record_of_a_key)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    const unsigned char* record;
+    uint32_t record_size;
+    uint64_t record_key;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, image_size, (void*)0x2, test_record_match, NULL, &record, &record_size);
 
-    CLDS_HASH_TABLE_ITEM* original_items[10];
-    bool found_originals[10];
-    uint32_t number_of_items = 10;
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_OK, result);
+    ASSERT_ARE_EQUAL(uint32_t, sizeof(uint64_t), record_size);
+    (void)memcpy(&record_key, record, sizeof(record_key));
+    ASSERT_ARE_EQUAL(uint64_t, 0x2, record_key);
 
-    const uint32_t number_of_sorted_lists = 10;
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-        found_originals[i] = false;
-    }
+/* Tests_SRS_CLDS_HASH_TABLE_07_244: [ If no record matches, clds_hash_table_snapshot_image_find shall return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_a_key_not_in_the_image_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // 0x3 maps to the bucket of 0x1
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, image_size, (void*)0x3, test_record_match, NULL, &record, &record_size);
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_NOT_FOUND, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_240: [ If the header is not valid or the image was written by a table with a different hash finalizer, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_an_image_written_with_a_different_hash_finalizer_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE mix64_hash_table = clds_hash_table_create_with_hash_finalizer(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_HASH_FINALIZER_MIX64);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    umock_c_reset_all_calls();
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    result = clds_hash_table_snapshot_image_find(mix64_hash_table, g_test_image_buffer, image_size, (void*)0x2, test_record_match, NULL, &record, &record_size);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
 
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
+    // cleanup
+    clds_hash_table_destroy(mix64_hash_table);
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < number_of_items; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
+/* Tests_SRS_CLDS_HASH_TABLE_07_243: [ If a record does not fit in its bucket, clds_hash_table_snapshot_image_find shall fail and return CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_image_find_with_a_record_that_does_not_fit_in_its_bucket_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    const unsigned char* record;
+    uint32_t record_size;
+    CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT result;
+    // the record of 0x2 claims to be larger than its bucket
+    g_test_image_buffer[TEST_IMAGE_FIRST_RECORD_SIZE_INDEX] = 100;
+    umock_c_reset_all_calls();
 
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+
+    // act
+    result = clds_hash_table_snapshot_image_find(hash_table, g_test_image_buffer, image_size, (void*)0x2, test_record_match, NULL, &record, &record_size);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT, CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_hash_table_restore */
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_245: [ If clds_hash_table is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_restore(NULL, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_246: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_restore(hash_table, NULL, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_247: [ If worker_count is 0, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_0_worker_count_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 0, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_248: [ If image is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_NULL_image_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, NULL, image_size, test_deserialize_record, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_249: [ If deserialize_record is NULL, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_NULL_deserialize_record_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_250: [ clds_hash_table_restore shall validate the image in the same way as clds_hash_table_snapshot_image_get_info. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_251: [ If the image is not valid or has more than UINT32_MAX records, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_a_corrupted_image_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    ((unsigned char*)g_test_image_buffer)[0] ^= 1;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_253: [ clds_hash_table_restore shall allocate memory for the keys, items and insert results of the records and for the worker thread handles. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_256: [ Each worker shall repeatedly claim the next chunk of buckets of the image that no worker claimed yet. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_257: [ For each record of the buckets of the chunk, the worker shall call deserialize_record to create the item and store the item and its key at the index of the record. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_260: [ clds_hash_table_restore shall insert the items in the table by calling clds_hash_table_bulk_load with worker_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_263: [ If the hash table has a start sequence number, clds_hash_table_restore shall set it to the sequence number of the image, or back to the sequence number the table had before the load if that one is higher. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_264: [ If sequence_number is not NULL, clds_hash_table_restore shall store the sequence number of the image in it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_265: [ On success clds_hash_table_restore shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_1_worker_inserts_the_records_and_carries_over_the_sequence_number)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int64_t sequence_number;
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    // the record of 0x2 is in bucket 0 of the image, the record of 0x1 in bucket 1
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 2, g_deserialized_item_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+    ASSERT_ARE_EQUAL(int64_t, 42, interlocked_add_64(&test_context.start_seq_no, 0));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_07_254: [ clds_hash_table_restore shall start worker_count - 1 worker threads by calling ThreadAPI_Create to deserialize the records, the calling thread being the last worker. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_256: [ Each worker shall repeatedly claim the next chunk of buckets of the image that no worker claimed yet. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_259: [ clds_hash_table_restore shall wait for the worker threads to complete by calling ThreadAPI_Join. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_260: [ clds_hash_table_restore shall insert the items in the table by calling clds_hash_table_bulk_load with worker_count. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_2_workers_deserializes_the_records_on_the_worker_thread)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int64_t sequence_number;
+    int result;
+    g_deserialized_item_count = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)));
+    // the worker thread takes the only chunk of buckets of the image
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    // clds_hash_table_bulk_load with 2 workers
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_context.hazard_pointers));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_unregister_thread(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // the worker thread handles, results, items and keys of clds_hash_table_restore
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 2, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
 
-    // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 2, g_deserialized_item_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
 
+    // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_after_an_insert_and_delete_multiple_buckets_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_07_255: [ If ThreadAPI_Create fails, clds_hash_table_restore shall continue with the workers started so far. ]*/
+TEST_FUNCTION(clds_hash_table_restore_when_ThreadAPI_Create_fails_deserializes_the_records_on_the_calling_thread)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-    ASSERT_IS_NOT_NULL(hash_table);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int64_t sequence_number;
+    int result;
+    g_deserialized_item_count = 0;
+    umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM* original_items[1];
-    bool found_originals[1];
-    uint32_t number_of_items = 1;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(THREADAPI_ERROR);
+    // the calling thread deserializes all the records and there is no thread to join
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    // clds_hash_table_bulk_load with 2 workers
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(THREAD_HANDLE)));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_context.hazard_pointers));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_unregister_thread(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Join((THREAD_HANDLE)0x4243, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL));
-        found_originals[i] = false;
-    }
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 2, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
 
-    // insert the extra item to create a new list
-    CLDS_HASH_TABLE_ITEM* extra_item;
-    extra_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4243));
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)0x2, extra_item, NULL));
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 2, g_deserialized_item_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
 
-    // delete the extra item
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)0x2, NULL));
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
 
+/* Tests_SRS_CLDS_HASH_TABLE_07_261: [ If clds_hash_table_bulk_load fails or any item could not be inserted for a reason other than its key already being in the table, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_265: [ On success clds_hash_table_restore shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_restore_of_a_key_already_in_the_table_keeps_the_existing_item_and_succeeds)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    CLDS_HASH_TABLE_ITEM* existing_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* found_item;
+    int result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, existing_item, NULL));
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    // only the first bucket is used
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    // the 4 buckets are enough for the item in the table and the 2 records
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // the restored item of 0x1 is released
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < number_of_items; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
-
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    ASSERT_ARE_EQUAL(int, 0, result);
+    found_item = clds_hash_table_find(hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, existing_item, found_item);
+    ASSERT_ARE_EQUAL(int64_t, 42, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_100_items_multiple_buckets_different_hashes_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_07_261: [ If clds_hash_table_bulk_load fails or any item could not be inserted for a reason other than its key already being in the table, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+TEST_FUNCTION(when_inserting_a_record_fails_clds_hash_table_restore_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* original_items[100];
-    bool found_originals[100];
-    uint32_t number_of_items = 100;
-
-    const uint32_t number_of_sorted_lists = 100;
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-
-        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
-            .SetReturn(i);
-        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-        found_originals[i] = false;
-        umock_c_reset_all_calls();
-    }
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    }
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(malloc_2(5, sizeof(uint32_t)));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    // inserting the record of 0x1 fails, the record of 0x2 is still inserted
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(CLDS_SORTED_LIST_INSERT_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < number_of_items; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
-
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    // the sequence number is only carried over on success
+    ASSERT_ARE_EQUAL(int64_t, 0, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_fails_when_underlying_functions_fail)
+/* Tests_SRS_CLDS_HASH_TABLE_07_261: [ If clds_hash_table_bulk_load fails or any item could not be inserted for a reason other than its key already being in the table, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+TEST_FUNCTION(when_clds_hash_table_bulk_load_fails_clds_hash_table_restore_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 20, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* original_items[10];
-
-    for (uint32_t i = 0; i < 10; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + (20 * i)), original_items[i], NULL);
-    }
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-
-    umock_c_negative_tests_snapshot();
-
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint64_t)))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
-            // act
-            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 0, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_fails_when_underlying_functions_fail)
+/* Tests_SRS_CLDS_HASH_TABLE_07_252: [ If the image has no records, clds_hash_table_restore shall only carry over the sequence number of the image. ]*/
+TEST_FUNCTION(clds_hash_table_restore_with_an_image_with_no_records_only_carries_over_the_sequence_number)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* original_items[10];
-
-    const uint32_t number_of_sorted_lists = 10;
-
-    for (uint32_t i = 0; i < 10; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-    }
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size;
+    int64_t sequence_number;
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_snapshot_image_write(hash_table, NULL, 0, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size));
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    }
-
-    umock_c_negative_tests_snapshot();
-
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
-
-            // act
-            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+    ASSERT_ARE_EQUAL(int64_t, 42, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_20_items_multiple_buckets_different_hashes_fails_when_underlying_functions_fail)
+/* Tests_SRS_CLDS_HASH_TABLE_07_263: [ If the hash table has a start sequence number, clds_hash_table_restore shall set it to the sequence number of the image, or back to the sequence number the table had before the load if that one is higher. ]*/
+TEST_FUNCTION(clds_hash_table_restore_sets_the_sequence_number_of_the_image_and_not_the_one_left_by_the_load)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    // the 2 inserts of the load move the sequence number of the table past the one of the image
+    uint64_t image_size = write_test_image(hash_table, 1);
+    int64_t sequence_number;
+    int result;
 
-    CLDS_HASH_TABLE_ITEM* original_items[20];
-    uint32_t number_of_items = 20;
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
 
-    const uint32_t number_of_sorted_lists = 20;
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 1, sequence_number);
+    ASSERT_ARE_EQUAL(int64_t, 1, interlocked_add_64(&test_context.start_seq_no, 0));
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
 
-        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
-            .SetReturn(i);
-        (void)clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-        umock_c_reset_all_calls();
-    }
+/* Tests_SRS_CLDS_HASH_TABLE_07_263: [ If the hash table has a start sequence number, clds_hash_table_restore shall set it to the sequence number of the image, or back to the sequence number the table had before the load if that one is higher. ]*/
+TEST_FUNCTION(clds_hash_table_restore_does_not_lower_the_sequence_number_of_the_table)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size;
+    int64_t sequence_number;
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_snapshot_image_write(hash_table, NULL, 0, 42, test_get_record_size, test_serialize_record, NULL, test_write_image, g_test_image_buffer, &image_size));
+    (void)interlocked_exchange_64(&test_context.start_seq_no, 100);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    }
-
-    umock_c_negative_tests_snapshot();
-
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
-
-            // act
-            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+    ASSERT_ARE_EQUAL(int64_t, 100, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_115: [ If cancellation_token is non-NULL and cancellation_token_is_cancelled returns true for cancellation_token, clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_and_abandoned_cancellation_token_is_abandoned)
+/* Tests_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+TEST_FUNCTION(when_deserialize_record_fails_clds_hash_table_restore_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-    ASSERT_IS_NOT_NULL(hash_table);
-
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_IS_NOT_NULL(item);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL));
-
-    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(true);
-    ASSERT_IS_NOT_NULL(cancellation_token);
-
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_failing_deserialize_record, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 0, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
-    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_115: [ If cancellation_token is non-NULL and cancellation_token_is_cancelled returns true for cancellation_token, clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_2_items_same_bucket_cancels_after_the_first_item)
+/* Tests_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_07_262: [ clds_hash_table_restore shall release the items that were not inserted in the table. ]*/
+TEST_FUNCTION(when_deserialize_record_returns_a_NULL_key_clds_hash_table_restore_fails)
 {
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-    ASSERT_IS_NOT_NULL(hash_table);
-
-    CLDS_HASH_TABLE_ITEM* original_items[2];
-
-    // insert 1st item
-    original_items[0] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + 0));
-    ASSERT_IS_NOT_NULL(original_items[0]);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)1, original_items[0], NULL));
-
-    // insert 2nd item
-    original_items[1] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + 1));
-    ASSERT_IS_NOT_NULL(original_items[1]);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)2, original_items[1], NULL));
-
-    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(false);
-    ASSERT_IS_NOT_NULL(cancellation_token);
-
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-
-    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token))
-        .SetReturn(true); // fake cancellation
-
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    // the worker stops at the first record
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record_with_NULL_key, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 0, interlocked_add_64(&test_context.start_seq_no, 0));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
-    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_snapshot shall determine all the items in the hash table by summing up the item count for all bucket arrays in all levels. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array and false as required_locked_list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_succeeds_with_non_NULL_cancellation_token)
+/* Tests_SRS_CLDS_HASH_TABLE_07_258: [ If deserialize_record returns NULL or a NULL key, or the records of a bucket do not match the bucket directory, the worker shall stop and clds_hash_table_restore shall fail. ]*/
+TEST_FUNCTION(when_the_records_of_a_bucket_do_not_match_the_bucket_directory_clds_hash_table_restore_fails)
 {
-    // this test is cloned from the succesfull test written in ancient times, but it uses a cancellation token
-    // the cancellation token is not signalled, we simply want to make sure that snapshot still works fine when passing
-    // a cancellation token
-
     // arrange
     CLDS_HASH_TABLE_TEST_CONTEXT test_context;
     setup_test_context(&test_context);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, NULL);
-    ASSERT_IS_NOT_NULL(hash_table);
-
-    CLDS_HASH_TABLE_ITEM* original_items[3];
-    bool found_originals[3];
-    uint32_t number_of_items = 3;
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        ASSERT_IS_NOT_NULL(original_items[i]);
-        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, test_context.hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL));
-        found_originals[i] = false;
-    }
-    
-    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(false);
-    ASSERT_IS_NOT_NULL(cancellation_token);
-
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int result;
+    // bucket 0 ends in the middle of its record, the directory is still well formed
+    g_test_image_buffer[TEST_IMAGE_BUCKET_1_RECORDS_OFFSET_INDEX] = 16;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-
-    // the level with more buckets has no lists
-    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
-    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, false));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_ITEM*)));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_HASH_TABLE_INSERT_RESULT)));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int64_t, 0, interlocked_add_64(&test_context.start_seq_no, 0));
 
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    destroy_test_context(&test_context);
+}
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < number_of_items; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
+/* Tests_SRS_CLDS_HASH_TABLE_07_266: [ If any other error occurs, clds_hash_table_restore shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_malloc_2_for_the_keys_fails_clds_hash_table_restore_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    uint64_t image_size = write_test_image(hash_table, 42);
+    int64_t sequence_number = 0;
+    int result;
+    umock_c_reset_all_calls();
 
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(void*)))
+        .SetReturn(NULL);
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    // act
+    result = clds_hash_table_restore(hash_table, test_context.hazard_pointers_thread, 1, g_test_image_buffer, image_size, test_deserialize_record, NULL, &sequence_number);
 
-    // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    // the sequence number is only carried over on success
+    ASSERT_ARE_EQUAL(int64_t, 0, sequence_number);
+    ASSERT_ARE_EQUAL(int64_t, 0, interlocked_add_64(&test_context.start_seq_no, 0));
 
+    // cleanup
     clds_hash_table_destroy(hash_table);
     destroy_test_context(&test_context);
-    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
 }
 
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
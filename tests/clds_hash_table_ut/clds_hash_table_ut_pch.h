@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "macro_utils/macro_utils.h"
 #include "testrunnerswitcher.h"
@@ -26,6 +27,7 @@
 #include "c_pal/gballoc_hl.h"
 #include "c_pal/gballoc_hl_redirect.h"
 #include "c_pal/thandle.h"
+#include "c_pal/threadapi.h"
 
 #include "c_util/cancellation_token.h"
 
@@ -36,6 +38,7 @@
 #include "umock_c/umock_c_DISABLE_MOCKS.h" // ============================== DISABLE_MOCKS
 
 #include "real_gballoc_hl.h"
+#include "real_threadapi.h"
 
 #include "../reals/real_clds_st_hash_set.h"
 #include "../reals/real_clds_hazard_pointers.h"
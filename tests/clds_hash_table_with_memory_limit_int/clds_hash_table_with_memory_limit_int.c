@@ -109,7 +109,8 @@ TEST_FUNCTION(clds_hash_table_insert_same_block_again_does_not_leak_item_count)
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     ASSERT_IS_NOT_NULL(hazard_pointers_thread);
     volatile_atomic int64_t sequence_number = 45;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 500, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    // the identity hash keeps only the low bits of the keys once masked, the finalizer spreads them over the buckets
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create_with_hash_finalizer(test_compute_hash, test_key_compare, 500, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556, CLDS_HASH_TABLE_HASH_FINALIZER_MIX64);
     ASSERT_IS_NOT_NULL(hash_table);
     int64_t insert_seq_no;
     CLDS_HASH_TABLE_ITEM* already_exists_item;
@@ -175,4 +175,79 @@ TEST_FUNCTION(pending_node_is_reclaimed_by_a_later_reclaim_cycle)
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
+// Epoch mode. Does the following:
+// - reader_thread acquires (enters a critical section) and keeps it
+// - retiring_thread retires node and a second node, none can be reclaimed while the reader is in its critical section
+// - reader_thread releases, then retiring_thread retires a third node
+// Expect: node is reclaimed by that cycle, the other 2 nodes are reclaimed on destroy.
+TEST_FUNCTION(epoch_mode_reclaims_only_after_readers_leave_their_critical_section)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE reader_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    ASSERT_IS_NOT_NULL(reader_thread);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    ASSERT_IS_NOT_NULL(retiring_thread);
+    int* node = malloc(sizeof(int));
+    ASSERT_IS_NOT_NULL(node);
+    int* second_node = malloc(sizeof(int));
+    ASSERT_IS_NOT_NULL(second_node);
+    int* third_node = malloc(sizeof(int));
+    ASSERT_IS_NOT_NULL(third_node);
+
+    CLDS_HAZARD_POINTER_RECORD_HANDLE held_record = clds_hazard_pointers_acquire(reader_thread, node);
+    ASSERT_IS_NOT_NULL(held_record);
+
+    // act
+    clds_hazard_pointers_reclaim(retiring_thread, node, test_reclaim);
+    clds_hazard_pointers_reclaim(retiring_thread, second_node, test_reclaim);
+    ASSERT_ARE_EQUAL(int32_t, 0, interlocked_add(&g_reclaim_count, 0), "node must not be reclaimed while a reader is in its critical section");
+
+    clds_hazard_pointers_release(reader_thread, held_record);
+    clds_hazard_pointers_reclaim(retiring_thread, third_node, test_reclaim);
+    ASSERT_ARE_EQUAL(int32_t, 1, interlocked_add(&g_reclaim_count, 0), "node was not reclaimed once the reader left");
+
+    clds_hazard_pointers_unregister_thread(reader_thread);
+    clds_hazard_pointers_unregister_thread(retiring_thread);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(int32_t, 3, interlocked_add(&g_reclaim_count, 0), "retired nodes were not reclaimed on destroy (leak)");
+}
+
+// With async reclaim the retiring thread only hands the nodes off (once it holds 64 of them), the cleanup
+// worker reclaims them shortly after, off the retiring thread.
+TEST_FUNCTION(async_reclaim_nodes_are_reclaimed_by_the_worker)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 1000));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    ASSERT_IS_NOT_NULL(retiring_thread);
+
+    // act
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        int* node = malloc(sizeof(int));
+        ASSERT_IS_NOT_NULL(node);
+        clds_hazard_pointers_reclaim(retiring_thread, node, test_reclaim);
+    }
+
+    // assert
+    uint32_t waited_ms = 0;
+    while ((interlocked_add(&g_reclaim_count, 0) < 64) &&
+        (waited_ms < CLEANUP_WORKER_GRACE_MS))
+    {
+        ThreadAPI_Sleep(10);
+        waited_ms += 10;
+    }
+    ASSERT_ARE_EQUAL(int32_t, 64, interlocked_add(&g_reclaim_count, 0), "nodes were not reclaimed by the worker");
+
+    // cleanup
+    clds_hazard_pointers_unregister_thread(retiring_thread);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
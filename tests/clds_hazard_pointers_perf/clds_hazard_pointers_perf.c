@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "testrunnerswitcher.h"
+
+#include "macro_utils/macro_utils.h"
+
+#include "c_logging/logger.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "c_pal/interlocked.h"
+#include "c_pal/sync.h"
+#include "c_pal/threadapi.h"
+#include "c_pal/timer.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    gballoc_hl_init(NULL, NULL);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+// How long each thread count is measured
+#define TEST_RUNTIME                (2000) // ms
+
+// How many retires should be done before checking if the thread should stop
+#define TEST_THREAD_EXECUTION_BATCH 1000
+
+// How many hazard pointers each thread keeps while retiring, so that reclaim cycles have something to scan
+#define TEST_HELD_HAZARD_POINTER_COUNT 4
+
+#define MAX_TEST_THREAD_COUNT 32
+
+typedef struct RETIRE_PERF_TEST_CONTEXT_TAG
+{
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers;
+    volatile_atomic int32_t start;
+    volatile_atomic int32_t stop_requested;
+    volatile_atomic int64_t total_retires;
+} RETIRE_PERF_TEST_CONTEXT;
+
+static void reclaim_test_node(void* node)
+{
+    free(node);
+}
+
+static int retire_thread_func(void* arg)
+{
+    RETIRE_PERF_TEST_CONTEXT* perf_test_context = arg;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE held_hazard_pointers[TEST_HELD_HAZARD_POINTER_COUNT];
+    void* held_nodes[TEST_HELD_HAZARD_POINTER_COUNT];
+    int64_t retires = 0;
+
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(perf_test_context->hazard_pointers);
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers_thread);
+
+    // hold a few hazard pointers for the whole run, like readers that are in the middle of a traversal
+    for (uint32_t i = 0; i < TEST_HELD_HAZARD_POINTER_COUNT; i++)
+    {
+        held_nodes[i] = malloc(1);
+        ASSERT_IS_NOT_NULL(held_nodes[i]);
+        held_hazard_pointers[i] = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, held_nodes[i]);
+        ASSERT_IS_NOT_NULL(held_hazard_pointers[i]);
+    }
+
+    // wait for all threads to be ready
+    while (interlocked_add(&perf_test_context->start, 0) == 0)
+    {
+        (void)wait_on_address(&perf_test_context->start, 0, UINT32_MAX);
+    }
+
+    while (interlocked_add(&perf_test_context->stop_requested, 0) == 0)
+    {
+        for (uint32_t i = 0; i < TEST_THREAD_EXECUTION_BATCH; i++)
+        {
+            // protect, unprotect and retire a node, the way a list delete does it
+            void* node = malloc(1);
+            ASSERT_IS_NOT_NULL(node);
+            CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, node);
+            ASSERT_IS_NOT_NULL(hazard_pointer);
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+            clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, node, reclaim_test_node);
+        }
+
+        retires += TEST_THREAD_EXECUTION_BATCH;
+    }
+
+    (void)interlocked_add_64(&perf_test_context->total_retires, retires);
+
+    for (uint32_t i = 0; i < TEST_HELD_HAZARD_POINTER_COUNT; i++)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, held_hazard_pointers[i]);
+        free(held_nodes[i]);
+    }
+
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
+
+    return 0;
+}
+
+// max_reclaim_threshold 0 means the reclaim threshold is fixed
+static double measure_retires_per_second(uint32_t thread_count, size_t reclaim_threshold, size_t max_reclaim_threshold, uint64_t* reclaim_backlog)
+{
+    RETIRE_PERF_TEST_CONTEXT perf_test_context;
+    THREAD_HANDLE threads[MAX_TEST_THREAD_COUNT];
+
+    perf_test_context.hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(perf_test_context.hazard_pointers);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_reclaim_threshold(perf_test_context.hazard_pointers, reclaim_threshold));
+    if (max_reclaim_threshold != 0)
+    {
+        ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_adaptive_reclaim_threshold(perf_test_context.hazard_pointers, max_reclaim_threshold));
+    }
+
+    (void)interlocked_exchange(&perf_test_context.start, 0);
+    (void)interlocked_exchange(&perf_test_context.stop_requested, 0);
+    (void)interlocked_exchange_64(&perf_test_context.total_retires, 0);
+
+    for (uint32_t i = 0; i < thread_count; i++)
+    {
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&threads[i], retire_thread_func, &perf_test_context));
+    }
+
+    // start all threads at once
+    double start_time = timer_global_get_elapsed_ms();
+    (void)interlocked_exchange(&perf_test_context.start, 1);
+    wake_by_address_all(&perf_test_context.start);
+
+    ThreadAPI_Sleep(TEST_RUNTIME);
+
+    (void)interlocked_exchange(&perf_test_context.stop_requested, 1);
+
+    for (uint32_t i = 0; i < thread_count; i++)
+    {
+        int dont_care;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(threads[i], &dont_care));
+    }
+
+    double elapsed_ms = timer_global_get_elapsed_ms() - start_time;
+
+    int64_t total_retires = interlocked_add_64(&perf_test_context.total_retires, 0);
+    ASSERT_IS_TRUE(total_retires > 0, "No retires done with %" PRIu32 " threads", thread_count);
+
+    // what was left behind by the threads for the next reclaim cycles
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_get_reclaim_backlog(perf_test_context.hazard_pointers, reclaim_backlog));
+
+    // destroy reclaims whatever is still pending
+    clds_hazard_pointers_destroy(perf_test_context.hazard_pointers);
+
+    return (double)total_retires * 1000.0 / elapsed_ms;
+}
+
+static void measure_retire_throughput_for_thread_counts(size_t reclaim_threshold, size_t max_reclaim_threshold)
+{
+    for (uint32_t thread_count = 1; thread_count <= MAX_TEST_THREAD_COUNT; thread_count *= 2)
+    {
+        uint64_t reclaim_backlog;
+        double retires_per_second = measure_retires_per_second(thread_count, reclaim_threshold, max_reclaim_threshold, &reclaim_backlog);
+        LogInfo("reclaim_threshold=%zu, max_reclaim_threshold=%zu, threads=%" PRIu32 ", retires/s=%.02f, retires/s per thread=%.02f, reclaim backlog=%" PRIu64 "",
+            reclaim_threshold, max_reclaim_threshold, thread_count, retires_per_second, retires_per_second / thread_count, reclaim_backlog);
+    }
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_throughput_with_default_reclaim_threshold)
+{
+    // Every retire triggers a reclaim cycle that scans the hazard pointers of all threads
+    measure_retire_throughput_for_thread_counts(1, 0);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_throughput_with_batched_reclaim)
+{
+    // Reclaim cycles are amortized over a batch of retires
+    measure_retire_throughput_for_thread_counts(64, 0);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_throughput_with_adaptive_reclaim_threshold)
+{
+    // Reclaim cycles run every 2x (number of hazard pointers) retires, so the scan cost per retire stays constant as threads are added
+    measure_retire_throughput_for_thread_counts(1, 4096);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <pthread.h>
+
+#define pthread_key_create mocked_pthread_key_create
+#define pthread_key_delete mocked_pthread_key_delete
+#define pthread_getspecific mocked_pthread_getspecific
+#define pthread_setspecific mocked_pthread_setspecific
+
+typedef void(*TLS_KEY_DESTRUCTOR_FUNC)(void*);
+
+extern int pthread_key_create(
+    pthread_key_t* key,
+    TLS_KEY_DESTRUCTOR_FUNC destructor
+);
+
+extern int pthread_key_delete(
+    pthread_key_t key
+);
+
+extern void* pthread_getspecific(
+    pthread_key_t key
+);
+
+extern int pthread_setspecific(
+    pthread_key_t key,
+    const void* value
+);
+
+#include "../../src/clds_hazard_pointers_thread_helper_linux.c"
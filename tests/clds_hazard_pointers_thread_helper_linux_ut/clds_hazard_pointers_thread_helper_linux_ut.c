@@ -0,0 +1,312 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include "clds_hazard_pointers_thread_helper_linux_ut_pch.h"
+
+typedef void(*TLS_KEY_DESTRUCTOR_FUNC)(void*);
+
+static pthread_key_t default_tls_key = 42;
+static TLS_KEY_DESTRUCTOR_FUNC test_tls_key_destructor;
+
+MOCK_FUNCTION_WITH_CODE(, int, mocked_pthread_key_create, pthread_key_t*, key, TLS_KEY_DESTRUCTOR_FUNC, destructor)
+    *key = default_tls_key;
+    test_tls_key_destructor = destructor;
+MOCK_FUNCTION_END(0)
+MOCK_FUNCTION_WITH_CODE(, int, mocked_pthread_key_delete, pthread_key_t, key)
+MOCK_FUNCTION_END(0)
+MOCK_FUNCTION_WITH_CODE(, void*, mocked_pthread_getspecific, pthread_key_t, key)
+MOCK_FUNCTION_END(NULL)
+MOCK_FUNCTION_WITH_CODE(, int, mocked_pthread_setspecific, pthread_key_t, key, const void*, value)
+MOCK_FUNCTION_END(0)
+
+static CLDS_HAZARD_POINTERS_HANDLE test_hazard_pointers = (CLDS_HAZARD_POINTERS_HANDLE)0x1234;
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE test_hazard_pointers_thread = (CLDS_HAZARD_POINTERS_THREAD_HANDLE)0xabcd;
+
+static CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE test_create(void)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mocked_pthread_key_create(IGNORED_ARG, IGNORED_ARG));
+
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = clds_hazard_pointers_thread_helper_create(test_hazard_pointers);
+
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(helper);
+
+    umock_c_reset_all_calls();
+
+    return helper;
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, real_gballoc_hl_init(NULL, NULL));
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(on_umock_c_error), "umock_c_init");
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types(), "umocktypes_stdint_register_types");
+
+    REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(malloc, NULL);
+
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mocked_pthread_key_create, EAGAIN);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mocked_pthread_setspecific, ENOMEM);
+    REGISTER_GLOBAL_MOCK_RETURNS(clds_hazard_pointers_register_thread, test_hazard_pointers_thread, NULL);
+
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(TLS_KEY_DESTRUCTOR_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(pthread_key_t, unsigned int);
+    REGISTER_UMOCK_ALIAS_TYPE(pthread_key_t*, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    real_gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    umock_c_reset_all_calls();
+    umock_c_negative_tests_init();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    umock_c_negative_tests_deinit();
+}
+
+//
+// clds_hazard_pointers_thread_helper_create
+//
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_001: [ If hazard_pointers is NULL then clds_hazard_pointers_thread_helper_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_create_with_NULL_hazard_pointers_fails)
+{
+    // arrange
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = clds_hazard_pointers_thread_helper_create(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(helper);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_002: [ clds_hazard_pointers_thread_helper_create shall allocate memory for the helper. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_001: [ On Linux, clds_hazard_pointers_thread_helper_create shall allocate the thread local storage key for the hazard pointers by calling pthread_key_create with clds_hazard_pointers_thread_helper_thread_exit as destructor. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_004: [ clds_hazard_pointers_thread_helper_create shall succeed and return the helper. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_create_succeeds)
+{
+    // arrange
+    test_tls_key_destructor = NULL;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mocked_pthread_key_create(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = clds_hazard_pointers_thread_helper_create(test_hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(helper);
+    ASSERT_IS_NOT_NULL(test_tls_key_destructor);
+
+    // cleanup
+    clds_hazard_pointers_thread_helper_destroy(helper);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_005: [ If there are any errors then clds_hazard_pointers_thread_helper_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_create_fails_when_underlying_functions_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mocked_pthread_key_create(IGNORED_ARG, IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = clds_hazard_pointers_thread_helper_create(test_hazard_pointers);
+
+            // assert
+            ASSERT_IS_NULL(helper);
+        }
+    }
+}
+
+//
+// clds_hazard_pointers_thread_helper_destroy
+//
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_006: [ If hazard_pointers_helper is NULL then clds_hazard_pointers_thread_helper_destroy shall return. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_destroy_with_NULL_hazard_pointers_helper_returns)
+{
+    // arrange
+
+    // act
+    clds_hazard_pointers_thread_helper_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_002: [ On Linux, clds_hazard_pointers_thread_helper_destroy shall free the thread local storage key by calling pthread_key_delete. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_008: [ clds_hazard_pointers_thread_helper_destroy shall free the helper. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_destroy_frees_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = test_create();
+
+    STRICT_EXPECTED_CALL(mocked_pthread_key_delete(default_tls_key));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_thread_helper_destroy(helper);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+//
+// clds_hazard_pointers_thread_helper_get_thread
+//
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_009: [ If hazard_pointers_helper is NULL then clds_hazard_pointers_thread_helper_get_thread shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_get_thread_with_NULL_hazard_pointers_helper_fails)
+{
+    // arrange
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_thread_helper_get_thread(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hazard_pointers_thread);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_003: [ On Linux, clds_hazard_pointers_thread_helper_get_thread shall get the thread local handle by calling pthread_getspecific. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_011: [ If no thread local handle exists then: ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_012: [ clds_hazard_pointers_thread_helper_get_thread shall create one by calling clds_hazard_pointers_register_thread. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_004: [ On Linux, clds_hazard_pointers_thread_helper_get_thread shall store the new handle by calling pthread_setspecific. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_014: [ clds_hazard_pointers_thread_helper_get_thread shall return the thread local handle. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_get_thread_first_time_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = test_create();
+
+    STRICT_EXPECTED_CALL(mocked_pthread_getspecific(default_tls_key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_hazard_pointers));
+    STRICT_EXPECTED_CALL(mocked_pthread_setspecific(default_tls_key, test_hazard_pointers_thread));
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_thread_helper_get_thread(helper);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, test_hazard_pointers_thread, hazard_pointers_thread);
+
+    // cleanup
+    clds_hazard_pointers_thread_helper_destroy(helper);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_003: [ On Linux, clds_hazard_pointers_thread_helper_get_thread shall get the thread local handle by calling pthread_getspecific. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_014: [ clds_hazard_pointers_thread_helper_get_thread shall return the thread local handle. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_get_thread_second_time_only_reads_the_thread_local_handle)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = test_create();
+
+    STRICT_EXPECTED_CALL(mocked_pthread_getspecific(default_tls_key))
+        .SetReturn((void*)test_hazard_pointers_thread);
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_thread_helper_get_thread(helper);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, test_hazard_pointers_thread, hazard_pointers_thread);
+
+    // cleanup
+    clds_hazard_pointers_thread_helper_destroy(helper);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_015: [ If there are any errors then clds_hazard_pointers_thread_helper_get_thread shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_get_thread_fails_when_clds_hazard_pointers_register_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = test_create();
+
+    STRICT_EXPECTED_CALL(mocked_pthread_getspecific(default_tls_key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_hazard_pointers))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_thread_helper_get_thread(helper);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hazard_pointers_thread);
+
+    // cleanup
+    clds_hazard_pointers_thread_helper_destroy(helper);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_42_015: [ If there are any errors then clds_hazard_pointers_thread_helper_get_thread shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_get_thread_fails_when_pthread_setspecific_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = test_create();
+
+    STRICT_EXPECTED_CALL(mocked_pthread_getspecific(default_tls_key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_register_thread(test_hazard_pointers));
+    STRICT_EXPECTED_CALL(mocked_pthread_setspecific(default_tls_key, test_hazard_pointers_thread))
+        .SetReturn(ENOMEM);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_unregister_thread(test_hazard_pointers_thread));
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_thread_helper_get_thread(helper);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hazard_pointers_thread);
+
+    // cleanup
+    clds_hazard_pointers_thread_helper_destroy(helper);
+}
+
+/* clds_hazard_pointers_thread_helper_thread_exit */
+
+/* Tests_SRS_CLDS_HAZARD_POINTERS_THREAD_HELPER_07_005: [ When a thread that has a thread local handle exits, clds_hazard_pointers_thread_helper_thread_exit shall call clds_hazard_pointers_unregister_thread with the thread local handle. ]*/
+TEST_FUNCTION(clds_hazard_pointers_thread_helper_thread_exit_unregisters_the_thread)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_THREAD_HELPER_HANDLE helper = test_create();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_unregister_thread(test_hazard_pointers_thread));
+
+    // act
+    test_tls_key_destructor(test_hazard_pointers_thread);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_thread_helper_destroy(helper);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
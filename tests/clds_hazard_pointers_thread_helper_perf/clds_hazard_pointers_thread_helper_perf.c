@@ -23,7 +23,9 @@
 #include "c_pal/timer.h"
 #include "c_pal/threadapi.h"
 
+#ifdef _MSC_VER
 #include "c_util/thread_notifications_dispatcher.h"
+#endif
 
 #include "clds/clds_hazard_pointers_thread_helper.h"
 #include "clds/clds_hazard_pointers.h"
@@ -40,12 +42,16 @@ BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 TEST_SUITE_INITIALIZE(suite_init)
 {
     gballoc_hl_init(NULL, NULL);
+#ifdef _MSC_VER
     ASSERT_ARE_EQUAL(int, 0, thread_notifications_dispatcher_init());
+#endif
 }
 
 TEST_SUITE_CLEANUP(suite_cleanup)
 {
+#ifdef _MSC_VER
     thread_notifications_dispatcher_deinit();
+#endif
     gballoc_hl_deinit();
 }
 
@@ -25,6 +25,9 @@ MOCK_FUNCTION_END()
 
 static WORKER_THREAD_HANDLE test_worker_thread = (WORKER_THREAD_HANDLE)0x4242;
 
+// Matches the number of fixed hazard pointer slots per thread in clds_hazard_pointers.c
+#define TEST_HAZARD_POINTER_SLOT_COUNT 8
+
 // Plain (non-mock) reclaim callback used by the global pending reclaim list tests below. Those tests
 // assert how many reclaims ran (and on which node) across the multi-thread hand-off and sweep paths,
 // which is clearer with a counter than with strict mock-call accounting over those paths. The node
@@ -37,6 +40,30 @@ static void count_reclaim(void* node)
     g_pending_reclaim_count++;
 }
 
+// Plain batch reclaim callback, records how it was called so the tests can check the batching
+#define TEST_MAX_RECLAIM_BATCH_NODES 16
+static int g_reclaim_batch_call_count;
+static size_t g_last_reclaim_batch_node_count;
+static void* g_last_reclaim_batch_nodes[TEST_MAX_RECLAIM_BATCH_NODES];
+static void count_reclaim_batch(void** nodes, size_t node_count)
+{
+    ASSERT_IS_TRUE(node_count <= TEST_MAX_RECLAIM_BATCH_NODES);
+    for (size_t i = 0; i < node_count; i++)
+    {
+        g_last_reclaim_batch_nodes[i] = nodes[i];
+    }
+    g_last_reclaim_batch_node_count = node_count;
+    g_reclaim_batch_call_count++;
+}
+
+// Counts the allocations, so that the pooling tests can check the steady state does not allocate
+static size_t g_malloc_count;
+static void* hook_count_malloc(size_t size)
+{
+    g_malloc_count++;
+    return real_gballoc_hl_malloc(size);
+}
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -78,6 +105,7 @@ TEST_FUNCTION_CLEANUP(method_cleanup)
 /* clds_hazard_pointers_create */
 
 /*Tests_SRS_CLDS_HAZARD_POINTERS_01_001: [ clds_hazard_pointers_create shall create a new hazard pointers instance and on success return a non-NULL handle to it. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_008: [ clds_hazard_pointers_create shall create an instance that uses hazard pointers for reclamation. ]*/
 TEST_FUNCTION(clds_hazard_pointers_create_succeeds)
 {
     // arrange
@@ -113,6 +141,63 @@ TEST_FUNCTION(clds_hazard_pointers_create_when_malloc_fails_returns_NULL)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
+/* clds_hazard_pointers_create_with_reclamation_mode */
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_010: [ clds_hazard_pointers_create_with_reclamation_mode shall create a new instance that uses the engine selected by reclamation_mode and on success return a non-NULL handle to it. ]*/
+TEST_FUNCTION(clds_hazard_pointers_create_with_reclamation_mode_HAZARD_POINTERS_succeeds)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_create(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_open(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(TQUEUE_CREATE(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(THANDLE_INITIALIZE_MOVE(TQUEUE_TYPEDEF_NAME(CLDS_HP_INACTIVE_THREAD))(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+
+    // assert
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_010: [ clds_hazard_pointers_create_with_reclamation_mode shall create a new instance that uses the engine selected by reclamation_mode and on success return a non-NULL handle to it. ]*/
+TEST_FUNCTION(clds_hazard_pointers_create_with_reclamation_mode_EPOCH_succeeds)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_create(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_open(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(TQUEUE_CREATE(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(THANDLE_INITIALIZE_MOVE(TQUEUE_TYPEDEF_NAME(CLDS_HP_INACTIVE_THREAD))(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+
+    // assert
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_009: [ If reclamation_mode is not a valid CLDS_HAZARD_POINTERS_RECLAMATION_MODE value, clds_hazard_pointers_create_with_reclamation_mode shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hazard_pointers_create_with_reclamation_mode_with_invalid_mode_fails)
+{
+    // arrange
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode((CLDS_HAZARD_POINTERS_RECLAMATION_MODE)0x42);
+
+    // assert
+    ASSERT_IS_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
 /* clds_hazard_pointers_destroy */
 
 /*Tests_SRS_CLDS_HAZARD_POINTERS_01_004: [ clds_hazard_pointers_destroy shall free all resources associated with the hazard pointers instance. ]*/
@@ -150,6 +235,7 @@ TEST_FUNCTION(clds_hazard_pointers_destroy_with_NULL_handle_returns)
 /* clds_hazard_pointers_register_thread */
 
 /*Tests_SRS_CLDS_HAZARD_POINTERS_01_006: [ clds_hazard_pointers_register_thread shall register the current thread with the hazard pointers instance clds_hazard_pointers and on success return a non-NULL handle to the registered thread. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_001: [ clds_hazard_pointers_register_thread shall initialize a fixed number of inline hazard pointer slots for the thread, all free. ]*/
 TEST_FUNCTION(clds_hazard_pointers_register_thread_succeeds)
 {
     // arrange
@@ -240,6 +326,7 @@ TEST_FUNCTION(clds_hazard_pointers_unregister_thread_with_NULL_handle_returns)
 /* clds_hazard_pointers_acquire */
 
 /*Tests_SRS_CLDS_HAZARD_POINTERS_01_011: [ clds_hazard_pointers_acquire shall acquire a hazard pointer for the given node and on success return a non-NULL handle to the hazard pointer record. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_002: [ If a fixed slot is free, clds_hazard_pointers_acquire shall publish node in that slot without allocating memory. ]*/
 TEST_FUNCTION(clds_hazard_pointer_acquire_succeeds)
 {
     // arrange
@@ -249,8 +336,6 @@ TEST_FUNCTION(clds_hazard_pointer_acquire_succeeds)
     void* pointer_1 = (void*)0x4242;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-
     // act
     hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
 
@@ -283,6 +368,11 @@ TEST_FUNCTION(clds_hazard_pointers_acquire_when_malloc_fails_returns_NULL)
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
     void* pointer_1 = (void*)0x4242;
+    // use up all fixed slots so that the next acquire has to allocate
+    for (uint32_t i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT; i++)
+    {
+        ASSERT_IS_NOT_NULL(clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x1000 + i)));
+    }
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
@@ -340,6 +430,149 @@ TEST_FUNCTION(clds_hazard_pointers_release_with_NULL_record_returns)
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_003: [ If all fixed slots are in use, clds_hazard_pointers_acquire shall take a hazard pointer record from the overflow list of the thread, allocating a new one if needed. ]*/
+TEST_FUNCTION(clds_hazard_pointers_acquire_when_all_fixed_slots_are_in_use_allocates_an_overflow_record)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE slot_hazard_pointers[TEST_HAZARD_POINTER_SLOT_COUNT];
+    void* pointer_1 = (void*)0x4242;
+    for (uint32_t i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT; i++)
+    {
+        slot_hazard_pointers[i] = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x1000 + i));
+        ASSERT_IS_NOT_NULL(slot_hazard_pointers[i]);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+
+    // assert
+    ASSERT_IS_NOT_NULL(hazard_pointer);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    for (uint32_t i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT; i++)
+    {
+        ASSERT_ARE_NOT_EQUAL(void_ptr, slot_hazard_pointers[i], hazard_pointer);
+    }
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_004: [ If clds_hazard_pointer_record is one of the fixed slots of the thread, clds_hazard_pointers_release shall clear the slot and mark it free. ]*/
+TEST_FUNCTION(clds_hazard_pointers_release_of_a_fixed_slot_makes_it_available_for_the_next_acquire)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, hazard_pointer_1, hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_005: [ Otherwise clds_hazard_pointers_release shall remove clds_hazard_pointer_record from the overflow list of the thread and keep it for reuse. ]*/
+TEST_FUNCTION(clds_hazard_pointers_release_of_an_overflow_record_keeps_it_for_reuse)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    for (uint32_t i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT; i++)
+    {
+        ASSERT_IS_NOT_NULL(clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x1000 + i)));
+    }
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, hazard_pointer_1, hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_012: [ In epoch mode, if the thread is not in a critical section, clds_hazard_pointers_acquire shall enter one by announcing the current reclamation epoch. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_013: [ In epoch mode, clds_hazard_pointers_acquire shall count the acquire as nested in the critical section and return the epoch record of the thread. ]*/
+TEST_FUNCTION(clds_hazard_pointers_acquire_in_epoch_mode_does_not_allocate)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointers[TEST_HAZARD_POINTER_SLOT_COUNT + 1];
+    uint32_t i;
+    umock_c_reset_all_calls();
+
+    // act
+    // more than the fixed slots, there is no overflow record in epoch mode
+    for (i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT + 1; i++)
+    {
+        hazard_pointers[i] = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x4242 + i));
+    }
+
+    // assert
+    for (i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT + 1; i++)
+    {
+        ASSERT_IS_NOT_NULL(hazard_pointers[i]);
+    }
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    for (i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT + 1; i++)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointers[i]);
+    }
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_014: [ In epoch mode, clds_hazard_pointers_release shall leave the critical section when the last acquired record of the thread is released. ]*/
+TEST_FUNCTION(clds_hazard_pointers_release_in_epoch_mode_of_a_nested_record_stays_in_the_critical_section)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE reader_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* node = (void*)0x4242;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE outer_record = clds_hazard_pointers_acquire(reader_thread, node);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE inner_record = clds_hazard_pointers_acquire(reader_thread, (void*)0x4243);
+    g_pending_reclaim_count = 0;
+
+    // act
+    clds_hazard_pointers_release(reader_thread, inner_record);
+    // reader_thread is still in the critical section it entered in epoch 0, so the epoch cannot get to 2
+    clds_hazard_pointers_reclaim(retiring_thread, node, count_reclaim);
+    clds_hazard_pointers_reclaim(retiring_thread, (void*)0x4244, count_reclaim);
+    clds_hazard_pointers_reclaim(retiring_thread, (void*)0x4245, count_reclaim);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, g_pending_reclaim_count);
+
+    // cleanup
+    clds_hazard_pointers_release(reader_thread, outer_record);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
 /* clds_hazard_pointers_reclaim */
 
 /*Tests_SRS_CLDS_HAZARD_POINTERS_01_016: [ clds_hazard_pointers_reclaim shall add the node to the reclaim list and when the reclaim threshold is reached, it shall trigger a reclaim cycle. ]*/
@@ -353,12 +586,7 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_adds_node_to_reclaim_list_and_trigger
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
     STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG));
 
     // act
@@ -415,12 +643,7 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_hazard_pointer_set_does_not_re
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*))); // scan buffer, first reclaim cycle on this thread
     STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
 
     // act
@@ -434,23 +657,23 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_hazard_pointer_set_does_not_re
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
-/*Tests_SRS_CLDS_HAZARD_POINTERS_01_020: [ If no thread has acquired a hazard pointer for node, reclaim_func shall be called for node to reclaim it. ]*/
-TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_pointer_that_is_not_acquired_reclaims_the_memory)
+/*Tests_SRS_CLDS_HAZARD_POINTERS_01_019: [ If any other thread has acquired a hazard pointer for node, the reclaim_func shall not be called for node. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_hazard_pointer_in_the_overflow_list_does_not_reclaim_the_pointer)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
     (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
     CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
     void* pointer_1 = (void*)0x4242;
+    for (uint32_t i = 0; i < TEST_HAZARD_POINTER_SLOT_COUNT; i++)
+    {
+        ASSERT_IS_NOT_NULL(clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x1000 + i)));
+    }
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*))); // scan buffer, first reclaim cycle on this thread
     STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
 
     // act
@@ -460,113 +683,426 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_pointer_that_is_not_acquired_r
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
-/*Tests_SRS_CLDS_HAZARD_POINTERS_42_001: [ clds_hazard_pointers_unregister_thread shall hand off any entries still on the thread's reclaim list to the global pending reclaim list of the hazard pointers instance. ]*/
-/*Tests_SRS_CLDS_HAZARD_POINTERS_42_003: [ clds_hazard_pointers_destroy shall reclaim all entries remaining on the global pending reclaim list. ]*/
-TEST_FUNCTION(node_retired_by_unregistering_thread_while_held_is_reclaimed_on_destroy)
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_006: [ A reclaim cycle shall collect the hazard pointers of all threads in a scan buffer owned by the reclaiming thread, which is kept for the following reclaim cycles. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_reuses_the_scan_buffer_of_the_thread)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
     (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE holding_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
-    void* node = (void*)0x4242;
-    // holding_thread protects node so it cannot be reclaimed yet
-    CLDS_HAZARD_POINTER_RECORD_HANDLE held_record = clds_hazard_pointers_acquire(holding_thread, node);
-    // retiring_thread retires node while it is still protected, so node stays on retiring_thread's reclaim list
-    clds_hazard_pointers_reclaim(retiring_thread, node, count_reclaim);
-    g_pending_reclaim_count = 0;
-    g_last_reclaimed_node = NULL;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_2));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
 
     // act
-    // retiring_thread hands its reclaim list off to the instance pending list, then the holder releases and the instance is destroyed
-    clds_hazard_pointers_unregister_thread(retiring_thread);
-    clds_hazard_pointers_release(holding_thread, held_record);
-    clds_hazard_pointers_unregister_thread(holding_thread);
-    clds_hazard_pointers_destroy(clds_hazard_pointers);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, g_pending_reclaim_count);
-    ASSERT_ARE_EQUAL(void_ptr, node, g_last_reclaimed_node);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
-/*Tests_SRS_CLDS_HAZARD_POINTERS_42_002: [ When a reclaim cycle is triggered, it shall also reclaim each entry on the global pending reclaim list whose node is no longer protected by any hazard pointer and re-park the rest. ]*/
-TEST_FUNCTION(pending_node_is_reclaimed_by_a_later_reclaim_cycle)
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_007: [ If the scan buffer cannot be grown, the reclaim cycle shall not reclaim any node. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_when_growing_the_scan_buffer_fails_does_not_reclaim)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
     (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE holding_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE sweeper_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
-    void* node = (void*)0x4242;
-    void* dummy = (void*)0x4243;
-    // holding_thread protects node so it cannot be reclaimed yet
-    CLDS_HAZARD_POINTER_RECORD_HANDLE held_record = clds_hazard_pointers_acquire(holding_thread, node);
-    // retiring_thread retires node (stranded, since node is protected) then hands it off to the instance pending list
-    clds_hazard_pointers_reclaim(retiring_thread, node, count_reclaim);
-    clds_hazard_pointers_unregister_thread(retiring_thread);
-    // the holder releases so node is now unprotected, but no reclaim cycle has run yet
-    clds_hazard_pointers_release(holding_thread, held_record);
-    g_pending_reclaim_count = 0;
-    g_last_reclaimed_node = NULL;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*)))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
 
     // act
-    // a reclaim cycle on a different live thread must sweep the pending list and reclaim node, before any destroy
-    clds_hazard_pointers_reclaim(sweeper_thread, dummy, count_reclaim);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
 
     // assert
-    // both the dummy (reclaimed directly) and node (swept from the pending list) must have run
-    ASSERT_ARE_EQUAL(int, 2, g_pending_reclaim_count);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    clds_hazard_pointers_unregister_thread(holding_thread);
-    clds_hazard_pointers_unregister_thread(sweeper_thread);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
-/* clds_hazard_pointers_set_reclaim_threshold */
-
-/*Tests_SRS_CLDS_HAZARD_POINTERS_01_021: [ clds_hazard_pointers_set_reclaim_threshold shall set the reclaim threshold for the hazard pointers instance to reclaim_threshold. ]*/
-/*Tests_SRS_CLDS_HAZARD_POINTERS_01_024: [ On success, clds_hazard_pointers_set_reclaim_threshold shall return 0. ]*/
-TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_succeeds)
+/*Tests_SRS_CLDS_HAZARD_POINTERS_01_020: [ If no thread has acquired a hazard pointer for node, reclaim_func shall be called for node to reclaim it. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_pointer_that_is_not_acquired_reclaims_the_memory)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
     // act
-    int result = clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 100);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
-/*Tests_SRS_CLDS_HAZARD_POINTERS_01_022: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_set_reclaim_threshold shall fail and return a non-zero value. ]*/
-TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_with_NULL_handle_fails)
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_023: [ clds_hazard_pointers_reclaim shall take the reclaim list entry for node from the pool of the thread and only allocate a new one if the pool is empty. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_024: [ A reclaim cycle shall keep the reclaim list entries of the reclaimed nodes in the pool of the reclaiming thread. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_reuses_the_entry_of_a_reclaimed_node)
 {
     // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_2));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
 
     // act
-    int result = clds_hazard_pointers_set_reclaim_threshold(NULL, 100);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
 
     // assert
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
-/*Tests_SRS_CLDS_HAZARD_POINTERS_01_023: [ If reclaim_threshold is 0, clds_hazard_pointers_set_reclaim_threshold shall fail and return a non-zero value. ]*/
-TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_with_zero_threshold_fails)
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_023: [ clds_hazard_pointers_reclaim shall take the reclaim list entry for node from the pool of the thread and only allocate a new one if the pool is empty. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_allocates_an_entry_when_the_pool_is_empty)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
-    umock_c_reset_all_calls();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 3);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    // pointer_1 is still in the reclaim list, so there is nothing in the pool
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_42_001: [ clds_hazard_pointers_unregister_thread shall hand off any entries still on the thread's reclaim list to the global pending reclaim list of the hazard pointers instance. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_42_003: [ clds_hazard_pointers_destroy shall reclaim all entries remaining on the global pending reclaim list. ]*/
+TEST_FUNCTION(node_retired_by_unregistering_thread_while_held_is_reclaimed_on_destroy)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE holding_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* node = (void*)0x4242;
+    // holding_thread protects node so it cannot be reclaimed yet
+    CLDS_HAZARD_POINTER_RECORD_HANDLE held_record = clds_hazard_pointers_acquire(holding_thread, node);
+    // retiring_thread retires node while it is still protected, so node stays on retiring_thread's reclaim list
+    clds_hazard_pointers_reclaim(retiring_thread, node, count_reclaim);
+    g_pending_reclaim_count = 0;
+    g_last_reclaimed_node = NULL;
+
+    // act
+    // retiring_thread hands its reclaim list off to the instance pending list, then the holder releases and the instance is destroyed
+    clds_hazard_pointers_unregister_thread(retiring_thread);
+    clds_hazard_pointers_release(holding_thread, held_record);
+    clds_hazard_pointers_unregister_thread(holding_thread);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, g_pending_reclaim_count);
+    ASSERT_ARE_EQUAL(void_ptr, node, g_last_reclaimed_node);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_42_002: [ When a reclaim cycle is triggered, it shall also reclaim each entry on the global pending reclaim list whose node is no longer protected by any hazard pointer and re-park the rest. ]*/
+TEST_FUNCTION(pending_node_is_reclaimed_by_a_later_reclaim_cycle)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE retiring_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE holding_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE sweeper_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* node = (void*)0x4242;
+    void* dummy = (void*)0x4243;
+    // holding_thread protects node so it cannot be reclaimed yet
+    CLDS_HAZARD_POINTER_RECORD_HANDLE held_record = clds_hazard_pointers_acquire(holding_thread, node);
+    // retiring_thread retires node (stranded, since node is protected) then hands it off to the instance pending list
+    clds_hazard_pointers_reclaim(retiring_thread, node, count_reclaim);
+    clds_hazard_pointers_unregister_thread(retiring_thread);
+    // the holder releases so node is now unprotected, but no reclaim cycle has run yet
+    clds_hazard_pointers_release(holding_thread, held_record);
+    g_pending_reclaim_count = 0;
+    g_last_reclaimed_node = NULL;
+
+    // act
+    // a reclaim cycle on a different live thread must sweep the pending list and reclaim node, before any destroy
+    clds_hazard_pointers_reclaim(sweeper_thread, dummy, count_reclaim);
+
+    // assert
+    // both the dummy (reclaimed directly) and node (swept from the pending list) must have run
+    ASSERT_ARE_EQUAL(int, 2, g_pending_reclaim_count);
+
+    // cleanup
+    clds_hazard_pointers_unregister_thread(holding_thread);
+    clds_hazard_pointers_unregister_thread(sweeper_thread);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_011: [ In epoch mode, a reclaim cycle shall call reclaim_func for each retired node once the reclamation epoch has advanced at least twice since the node was retired. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_in_epoch_mode_reclaims_after_the_epoch_advanced_twice)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    // retired in epoch 0, the cycle moves the epoch to 1
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    // retired in epoch 1, the cycle moves the epoch to 2 which is enough for pointer_1
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_011: [ In epoch mode, a reclaim cycle shall call reclaim_func for each retired node once the reclamation epoch has advanced at least twice since the node was retired. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_in_epoch_mode_does_not_reclaim_right_away)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_reclaim_batched */
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_025: [ If clds_hazard_pointers_thread is NULL, clds_hazard_pointers_reclaim_batched shall return. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_batched_with_NULL_thread_returns)
+{
+    // arrange
+    void* pointer_1 = (void*)0x4242;
+
+    // act
+    clds_hazard_pointers_reclaim_batched(NULL, pointer_1, count_reclaim_batch);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_026: [ If node is NULL, clds_hazard_pointers_reclaim_batched shall return. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_batched_with_NULL_node_returns)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, NULL, count_reclaim_batch);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_027: [ If reclaim_batch_func is NULL, clds_hazard_pointers_reclaim_batched shall return. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_batched_with_NULL_reclaim_batch_func_returns)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4242, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_028: [ clds_hazard_pointers_reclaim_batched shall add the node to the reclaim list and when the reclaim threshold is reached, it shall trigger a reclaim cycle. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_batched_below_the_threshold_does_not_reclaim)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 2);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    g_reclaim_batch_call_count = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4242, count_reclaim_batch);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, g_reclaim_batch_call_count);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_028: [ clds_hazard_pointers_reclaim_batched shall add the node to the reclaim list and when the reclaim threshold is reached, it shall trigger a reclaim cycle. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_029: [ A reclaim cycle shall call the reclaim_batch_func of the nodes that are safe to reclaim with an array of such nodes rather than once per node. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_batched_reclaims_all_safe_nodes_in_one_call)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 3);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4242, count_reclaim_batch);
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4243, count_reclaim_batch);
+    g_reclaim_batch_call_count = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4244, count_reclaim_batch);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 1, g_reclaim_batch_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, g_last_reclaim_batch_node_count);
+    // the reclaim list is newest first
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4244, g_last_reclaim_batch_nodes[0]);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, g_last_reclaim_batch_nodes[1]);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, g_last_reclaim_batch_nodes[2]);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_029: [ A reclaim cycle shall call the reclaim_batch_func of the nodes that are safe to reclaim with an array of such nodes rather than once per node. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_batched_does_not_pass_protected_nodes_to_the_batch_func)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 2);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)0x4242);
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4242, count_reclaim_batch);
+    g_reclaim_batch_call_count = 0;
+
+    // act
+    clds_hazard_pointers_reclaim_batched(clds_hazard_pointers_thread, (void*)0x4243, count_reclaim_batch);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, g_reclaim_batch_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, g_last_reclaim_batch_node_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, g_last_reclaim_batch_nodes[0]);
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_set_reclaim_threshold */
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_01_021: [ clds_hazard_pointers_set_reclaim_threshold shall set the reclaim threshold for the hazard pointers instance to reclaim_threshold. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_01_024: [ On success, clds_hazard_pointers_set_reclaim_threshold shall return 0. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 100);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_01_022: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_set_reclaim_threshold shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_with_NULL_handle_fails)
+{
+    // arrange
+
+    // act
+    int result = clds_hazard_pointers_set_reclaim_threshold(NULL, 100);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_01_023: [ If reclaim_threshold is 0, clds_hazard_pointers_set_reclaim_threshold shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_with_zero_threshold_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
 
     // act
     int result = clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 0);
@@ -579,4 +1115,606 @@ TEST_FUNCTION(clds_hazard_pointers_set_reclaim_threshold_with_zero_threshold_fai
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
+/* clds_hazard_pointers_set_adaptive_reclaim_threshold */
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_018: [ On success, clds_hazard_pointers_set_adaptive_reclaim_threshold shall return 0. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_adaptive_reclaim_threshold_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 100);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_015: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_set_adaptive_reclaim_threshold shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_adaptive_reclaim_threshold_with_NULL_handle_fails)
+{
+    // arrange
+
+    // act
+    int result = clds_hazard_pointers_set_adaptive_reclaim_threshold(NULL, 100);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_016: [ If max_reclaim_threshold is 0, clds_hazard_pointers_set_adaptive_reclaim_threshold shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_adaptive_reclaim_threshold_with_zero_max_reclaim_threshold_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 0);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_017: [ In hazard pointer mode, clds_hazard_pointers_set_adaptive_reclaim_threshold shall make the reclaim threshold of each thread twice the number of hazard pointers seen by the last reclaim cycle of that thread, but not less than the reclaim threshold set by clds_hazard_pointers_set_reclaim_threshold and not more than max_reclaim_threshold. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_adaptive_threshold_does_not_trigger_a_reclaim_cycle_below_twice_the_hazard_pointer_count)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    (void)clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 100);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointers[3];
+    uint32_t i;
+    for (i = 0; i < 3; i++)
+    {
+        hazard_pointers[i] = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x4242 + i));
+    }
+    // first reclaim cycle runs at the fixed threshold and sees the 3 hazard pointers, the threshold becomes 6
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x5000, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    // the first retire reuses the entry of the node reclaimed above
+    for (i = 0; i < 4; i++)
+    {
+        STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    }
+
+    // act
+    for (i = 0; i < 5; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5001 + i), test_reclaim_func);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    for (i = 0; i < 3; i++)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointers[i]);
+    }
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_017: [ In hazard pointer mode, clds_hazard_pointers_set_adaptive_reclaim_threshold shall make the reclaim threshold of each thread twice the number of hazard pointers seen by the last reclaim cycle of that thread, but not less than the reclaim threshold set by clds_hazard_pointers_set_reclaim_threshold and not more than max_reclaim_threshold. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_adaptive_threshold_triggers_a_reclaim_cycle_at_twice_the_hazard_pointer_count)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    (void)clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 100);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointers[3];
+    uint32_t i;
+    for (i = 0; i < 3; i++)
+    {
+        hazard_pointers[i] = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x4242 + i));
+    }
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x5000, test_reclaim_func);
+    for (i = 0; i < 5; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5001 + i), test_reclaim_func);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    // the reclaim list is newest first
+    for (i = 0; i < 6; i++)
+    {
+        STRICT_EXPECTED_CALL(test_reclaim_func((void*)(uintptr_t)(0x5006 - i)));
+    }
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x5006, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    for (i = 0; i < 3; i++)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointers[i]);
+    }
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_017: [ In hazard pointer mode, clds_hazard_pointers_set_adaptive_reclaim_threshold shall make the reclaim threshold of each thread twice the number of hazard pointers seen by the last reclaim cycle of that thread, but not less than the reclaim threshold set by clds_hazard_pointers_set_reclaim_threshold and not more than max_reclaim_threshold. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_adaptive_threshold_is_capped_at_max_reclaim_threshold)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    (void)clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 2);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointers[3];
+    uint32_t i;
+    for (i = 0; i < 3; i++)
+    {
+        hazard_pointers[i] = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x4242 + i));
+    }
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x5000, test_reclaim_func);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x5001, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func((void*)0x5002));
+    STRICT_EXPECTED_CALL(test_reclaim_func((void*)0x5001));
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    // 2 entries reach the cap even though there are 3 hazard pointers
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x5002, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    for (i = 0; i < 3; i++)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointers[i]);
+    }
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_get_reclaim_backlog */
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_019: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_get_reclaim_backlog shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_get_reclaim_backlog_with_NULL_handle_fails)
+{
+    // arrange
+    uint64_t reclaim_backlog;
+
+    // act
+    int result = clds_hazard_pointers_get_reclaim_backlog(NULL, &reclaim_backlog);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_020: [ If reclaim_backlog is NULL, clds_hazard_pointers_get_reclaim_backlog shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_get_reclaim_backlog_with_NULL_reclaim_backlog_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_get_reclaim_backlog(clds_hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_021: [ clds_hazard_pointers_get_reclaim_backlog shall provide in reclaim_backlog the number of retired nodes that were not reclaimed yet. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_022: [ On success, clds_hazard_pointers_get_reclaim_backlog shall return 0. ]*/
+TEST_FUNCTION(clds_hazard_pointers_get_reclaim_backlog_counts_the_nodes_that_could_not_be_reclaimed)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, count_reclaim);
+    uint64_t reclaim_backlog;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_get_reclaim_backlog(clds_hazard_pointers, &reclaim_backlog);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, reclaim_backlog);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_021: [ clds_hazard_pointers_get_reclaim_backlog shall provide in reclaim_backlog the number of retired nodes that were not reclaimed yet. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_040: [ clds_hazard_pointers_reclaim shall increment the reclaim backlog of the instance when it adds node to the reclaim list. ]*/
+TEST_FUNCTION(clds_hazard_pointers_get_reclaim_backlog_counts_the_retired_nodes_before_any_reclaim_cycle)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 3);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x4242, count_reclaim);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x4243, count_reclaim);
+    uint64_t reclaim_backlog;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_get_reclaim_backlog(clds_hazard_pointers, &reclaim_backlog);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, reclaim_backlog);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_021: [ clds_hazard_pointers_get_reclaim_backlog shall provide in reclaim_backlog the number of retired nodes that were not reclaimed yet. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_041: [ A reclaim cycle shall decrement the reclaim backlog of the instance for each node it reclaims. ]*/
+TEST_FUNCTION(clds_hazard_pointers_get_reclaim_backlog_is_0_after_everything_was_reclaimed)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, count_reclaim);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    // this cycle reclaims both nodes
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x4243, count_reclaim);
+    uint64_t reclaim_backlog;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_get_reclaim_backlog(clds_hazard_pointers, &reclaim_backlog);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 0, reclaim_backlog);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_set_async_reclaim */
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_030: [ If clds_hazard_pointers is NULL, clds_hazard_pointers_set_async_reclaim shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_async_reclaim_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+
+    // act
+    int result = clds_hazard_pointers_set_async_reclaim(NULL, 10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_031: [ If max_reclaim_backlog is 0, clds_hazard_pointers_set_async_reclaim shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_async_reclaim_with_0_max_reclaim_backlog_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 0);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_032: [ clds_hazard_pointers_set_async_reclaim shall register a thread for the worker of the instance, used by the worker to run reclaim cycles, and set the maximum reclaim backlog to max_reclaim_backlog. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_034: [ On success, clds_hazard_pointers_set_async_reclaim shall return 0. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_async_reclaim_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 10);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_032: [ clds_hazard_pointers_set_async_reclaim shall register a thread for the worker of the instance, used by the worker to run reclaim cycles, and set the maximum reclaim backlog to max_reclaim_backlog. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_034: [ On success, clds_hazard_pointers_set_async_reclaim shall return 0. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_async_reclaim_a_second_time_only_changes_the_max_reclaim_backlog)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 10));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 20);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_033: [ If registering the thread fails, clds_hazard_pointers_set_async_reclaim shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hazard_pointers_set_async_reclaim_when_registering_the_thread_fails_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    int result = clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_035: [ When async reclaim is enabled and the reclaim threshold is reached, the retiring thread shall hand off its reclaim list to the global pending reclaim list and schedule the worker of the instance instead of running a reclaim cycle. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_039: [ When async reclaim is enabled, the retiring thread shall only hand off its reclaim list once it holds at least 64 retired nodes, even if the reclaim threshold is lower. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_async_reclaim_schedules_the_worker_instead_of_reclaiming)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 100));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    uint32_t i;
+    for (i = 0; i < 63; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5000 + i), test_reclaim_func);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_schedule_process(test_worker_thread));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_039: [ When async reclaim is enabled, the retiring thread shall only hand off its reclaim list once it holds at least 64 retired nodes, even if the reclaim threshold is lower. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_async_reclaim_below_64_retired_nodes_neither_schedules_the_worker_nor_reclaims)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 100));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    uint32_t i;
+    for (i = 0; i < 62; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5000 + i), test_reclaim_func);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)0x4242, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_036: [ If the reclaim backlog is above max_reclaim_backlog after the hand off, the retiring thread shall run the reclaim cycle itself. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_async_reclaim_above_the_max_reclaim_backlog_reclaims_on_the_calling_thread)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 63));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    uint32_t i;
+    for (i = 0; i < 63; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5000 + i), test_reclaim_func);
+    }
+    umock_c_reset_all_calls();
+
+    // the hand off brings the backlog to 64
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
+    for (i = 0; i < 63; i++)
+    {
+        STRICT_EXPECTED_CALL(test_reclaim_func((void*)(uintptr_t)(0x5000 + 62 - i)));
+    }
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_037: [ If scheduling the worker fails, the retiring thread shall run the reclaim cycle itself. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_async_reclaim_when_scheduling_the_worker_fails_reclaims_on_the_calling_thread)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 100));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    uint32_t i;
+    for (i = 0; i < 63; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5000 + i), test_reclaim_func);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_schedule_process(test_worker_thread))
+        .SetReturn(WORKER_THREAD_SCHEDULE_PROCESS_ERROR);
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
+    for (i = 0; i < 63; i++)
+    {
+        STRICT_EXPECTED_CALL(test_reclaim_func((void*)(uintptr_t)(0x5000 + 62 - i)));
+    }
+    STRICT_EXPECTED_CALL(TQUEUE_POP(CLDS_HP_INACTIVE_THREAD)(IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG)); // pop from queue
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_038: [ When async reclaim is enabled, the worker of the instance shall run a reclaim cycle that reclaims the nodes handed off by the retiring threads. ]*/
+TEST_FUNCTION(clds_hazard_pointers_worker_with_async_reclaim_reclaims_the_handed_off_nodes)
+{
+    // arrange
+    WORKER_FUNC worker_func;
+    void* worker_func_context;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_create(IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_worker_func(&worker_func)
+        .CaptureArgumentValue_worker_func_context(&worker_func_context);
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 100));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    uint32_t i;
+    g_pending_reclaim_count = 0;
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, count_reclaim);
+    for (i = 0; i < 63; i++)
+    {
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)(uintptr_t)(0x5000 + i), count_reclaim);
+    }
+    ASSERT_ARE_EQUAL(int, 0, g_pending_reclaim_count);
+    umock_c_reset_all_calls();
+
+    // act
+    worker_func(worker_func_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 64, g_pending_reclaim_count);
+    // the first retired node is the last on the handed off list
+    ASSERT_ARE_EQUAL(void_ptr, pointer_1, g_last_reclaimed_node);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_024: [ A reclaim cycle shall keep the reclaim list entries of the reclaimed nodes in the pool of the reclaiming thread, as long as the pool holds less than 256 entries. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_042: [ When a reclaim cycle ends, the reclaim list entries that did not fit in the pool of the reclaiming thread shall be moved to the shared pool of the instance if that is empty. ]*/
+/*Tests_SRS_CLDS_HAZARD_POINTERS_07_044: [ If the pool of the thread is empty, clds_hazard_pointers_reclaim shall take all the reclaim list entries in the shared pool of the instance into the pool of the thread. ]*/
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_async_reclaim_stops_allocating_once_the_worker_pool_is_full)
+{
+    // arrange
+    WORKER_FUNC worker_func;
+    void* worker_func_context;
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(worker_thread_create(IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_worker_func(&worker_func)
+        .CaptureArgumentValue_worker_func_context(&worker_func_context);
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    ASSERT_ARE_EQUAL(int, 0, clds_hazard_pointers_set_async_reclaim(clds_hazard_pointers, 100));
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    uintptr_t next_node = 0x5000;
+    uint32_t round;
+    uint32_t i;
+    g_pending_reclaim_count = 0;
+    g_malloc_count = 0;
+    REGISTER_GLOBAL_MOCK_HOOK(malloc, hook_count_malloc);
+
+    // the entries of the first rounds fill the pool of the worker (256 entries), the next ones come back to the retiring thread through the shared pool
+    for (round = 0; round < 5; round++)
+    {
+        for (i = 0; i < 64; i++)
+        {
+            clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)next_node++, count_reclaim);
+        }
+        worker_func(worker_func_context);
+    }
+    size_t malloc_count_after_warm_up = g_malloc_count;
+    umock_c_reset_all_calls();
+
+    // act
+    for (round = 0; round < 100; round++)
+    {
+        for (i = 0; i < 64; i++)
+        {
+            clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)next_node++, count_reclaim);
+        }
+        worker_func(worker_func_context);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 105 * 64, g_pending_reclaim_count);
+    ASSERT_ARE_EQUAL(size_t, malloc_count_after_warm_up, g_malloc_count);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(malloc, real_gballoc_hl_malloc);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -283,10 +283,11 @@ static int delete_thread(void* arg)
     return result;
 }
 
-TEST_FUNCTION(clds_sorted_list_contended_delete_test)
+static void test_contended_delete(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode)
 {
     // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create_with_reclamation_mode(reclamation_mode);
+    ASSERT_IS_NOT_NULL(hazard_pointers);
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list;
     volatile_atomic int64_t sequence_number = -1;
@@ -362,6 +363,17 @@ TEST_FUNCTION(clds_sorted_list_contended_delete_test)
     free(items);
 }
 
+TEST_FUNCTION(clds_sorted_list_contended_delete_test)
+{
+    test_contended_delete(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+}
+
+TEST_FUNCTION(clds_sorted_list_contended_delete_test_with_epoch_reclamation)
+{
+    // the list code is the same, only the instance it gets picks the epoch based engine
+    test_contended_delete(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH);
+}
+
 static int single_insert_thread(void* arg)
 {
     THREAD_DATA* thread_data = arg;
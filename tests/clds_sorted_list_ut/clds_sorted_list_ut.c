@@ -24,6 +24,8 @@ TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_CO
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_COUNT_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
 
@@ -78,6 +80,32 @@ static int test_key_compare(void* context, void* key1, void* key2)
     return result;
 }
 
+typedef struct TEST_VISIT_CONTEXT_TAG
+{
+    uint32_t visited_keys[3];
+    size_t visited_count;
+    size_t stop_after;
+} TEST_VISIT_CONTEXT;
+
+static bool test_visit_cb(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item)
+{
+    TEST_VISIT_CONTEXT* visit_context = context;
+    TEST_ITEM* test_item = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    visit_context->visited_keys[visit_context->visited_count++] = test_item->key;
+    return (visit_context->visited_count < visit_context->stop_after);
+}
+
+static void test_find_visit_cb(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item)
+{
+    TEST_VISIT_CONTEXT* visit_context = context;
+    TEST_ITEM* test_item = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    visit_context->visited_keys[visit_context->visited_count++] = test_item->key;
+}
+
+static CLDS_SORTED_LIST_ITEM* g_factory_item;
+MOCK_FUNCTION_WITH_CODE(, CLDS_SORTED_LIST_ITEM*, test_item_factory, void*, context, void*, key)
+MOCK_FUNCTION_END(g_factory_item)
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -105,6 +133,7 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT);
 
     REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_BATCH_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
@@ -123,6 +152,7 @@ TEST_SUITE_CLEANUP(suite_cleanup)
 TEST_FUNCTION_INITIALIZE(method_init)
 {
     g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+    g_factory_item = NULL;
     umock_c_reset_all_calls();
 }
 
@@ -519,6 +549,290 @@ TEST_FUNCTION(clds_sorted_list_destroy_with_NULL_item_cleanup_callback_does_not_
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* clds_sorted_list_config_init */
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_016: [ clds_sorted_list_config_init shall store the hazard pointers instance, the callbacks with their contexts and start_sequence_number in config and return 0. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_CONFIG config;
+    volatile_atomic int64_t sequence_number = 45;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, hazard_pointers, config.clds_hazard_pointers);
+    ASSERT_IS_TRUE(config.get_item_key_cb == test_get_item_key);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, config.get_item_key_cb_context);
+    ASSERT_IS_TRUE(config.key_compare_cb == test_key_compare);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, config.key_compare_cb_context);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)&sequence_number, (void*)config.sequence_number);
+    ASSERT_IS_TRUE(config.skipped_seq_no_cb == test_skipped_seq_no_cb);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x5556, config.skipped_seq_no_cb_context);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_015: [ get_item_key_cb_context, key_compare_cb_context, start_sequence_number, skipped_seq_no_cb and skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_with_NULL_optional_arguments_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_CONFIG config;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, NULL, test_key_compare, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_010: [ If config is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_with_NULL_config_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_sorted_list_config_init(NULL, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_011: [ If clds_hazard_pointers is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_SORTED_LIST_CONFIG config;
+
+    // act
+    int result = clds_sorted_list_config_init(&config, NULL, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_012: [ If get_item_key_cb is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_with_NULL_get_item_key_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_CONFIG config;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_sorted_list_config_init(&config, hazard_pointers, NULL, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_013: [ If key_compare_cb is NULL, clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_with_NULL_key_compare_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_CONFIG config;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, NULL, (void*)0x4243, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_014: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_config_init shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_config_init_with_NULL_sequence_no_and_non_NULL_skipped_seq_no_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_CONFIG config;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, test_skipped_seq_no_cb, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_init */
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_017: [ If clds_sorted_list is NULL, clds_sorted_list_init shall return. ]*/
+TEST_FUNCTION(clds_sorted_list_init_with_NULL_clds_sorted_list_returns)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_CONFIG config;
+    ASSERT_ARE_EQUAL(int, 0, clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    clds_sorted_list_init(NULL, &config);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_018: [ If config is NULL, clds_sorted_list_init shall return. ]*/
+TEST_FUNCTION(clds_sorted_list_init_with_NULL_config_returns)
+{
+    // arrange
+    CLDS_SORTED_LIST list;
+
+    // act
+    clds_sorted_list_init(&list, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_019: [ clds_sorted_list_init shall initialize clds_sorted_list as an empty list that is not locked for writes and that uses the callbacks and the sequence number in config. ]*/
+TEST_FUNCTION(clds_sorted_list_init_initializes_an_empty_list_without_allocating_memory)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_CONFIG config;
+    CLDS_SORTED_LIST list;
+    uint64_t item_count;
+    ASSERT_ARE_EQUAL(int, 0, clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    clds_sorted_list_init(&list, &config);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(clds_sorted_list_find_key(&list, hazard_pointers_thread, (void*)0x42));
+    clds_sorted_list_lock_writes(&list);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_COUNT_OK, clds_sorted_list_get_count(&list, hazard_pointers_thread, &item_count));
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+    clds_sorted_list_unlock_writes(&list);
+
+    // cleanup
+    clds_sorted_list_deinit(&list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_019: [ clds_sorted_list_init shall initialize clds_sorted_list as an empty list that is not locked for writes and that uses the callbacks and the sequence number in config. ]*/
+TEST_FUNCTION(two_lists_initialized_with_the_same_config_share_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_CONFIG config;
+    CLDS_SORTED_LIST lists[2];
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t insert_seq_no_1;
+    int64_t insert_seq_no_2;
+    ASSERT_ARE_EQUAL(int, 0, clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL));
+    clds_sorted_list_init(&lists[0], &config);
+    clds_sorted_list_init(&lists[1], &config);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x42;
+    umock_c_reset_all_calls();
+
+    // act
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_insert(&lists[0], hazard_pointers_thread, item_1, &insert_seq_no_1));
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_insert(&lists[1], hazard_pointers_thread, item_2, &insert_seq_no_2));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 43, insert_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 44, insert_seq_no_2);
+
+    // cleanup
+    clds_sorted_list_deinit(&lists[0]);
+    clds_sorted_list_deinit(&lists[1]);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_deinit */
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_020: [ If clds_sorted_list is NULL, clds_sorted_list_deinit shall return. ]*/
+TEST_FUNCTION(clds_sorted_list_deinit_with_NULL_clds_sorted_list_returns)
+{
+    // arrange
+
+    // act
+    clds_sorted_list_deinit(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_021: [ Any items still present in the list shall be freed, calling for each the item_cleanup_callback passed to clds_sorted_list_node_create (if not NULL). ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_07_022: [ clds_sorted_list_deinit shall leave clds_sorted_list as an empty list and shall not free the memory of clds_sorted_list. ]*/
+TEST_FUNCTION(clds_sorted_list_deinit_with_2_items_frees_the_items_but_not_the_list)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_CONFIG config;
+    CLDS_SORTED_LIST list;
+    ASSERT_ARE_EQUAL(int, 0, clds_sorted_list_config_init(&config, hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL));
+    clds_sorted_list_init(&list, &config);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x43;
+    (void)clds_sorted_list_insert(&list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(&list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+    STRICT_EXPECTED_CALL(free(item_2));
+
+    // act
+    clds_sorted_list_deinit(&list);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(clds_sorted_list_find_key(&list, hazard_pointers_thread, (void*)0x42));
+    ASSERT_IS_NULL(clds_sorted_list_find_key(&list, hazard_pointers_thread, (void*)0x43));
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* clds_sorted_list_insert */
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
@@ -870,509 +1184,352 @@ TEST_FUNCTION(clds_sorted_list_insert_with_non_NULL_sequence_number_but_no_start
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_sorted_list_delete_item */
+/* clds_sorted_list_get_or_insert */
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_070: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_item_deletes_the_item)
+/* Tests_SRS_CLDS_SORTED_LIST_07_034: [ If clds_sorted_list is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_with_NULL_clds_sorted_list_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
-    STRICT_EXPECTED_CALL(free(item));
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(NULL, hazard_pointers_thread, item_1, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
-    clds_sorted_list_destroy(list);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds)
+/* Tests_SRS_CLDS_SORTED_LIST_07_035: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_insert(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
-    STRICT_EXPECTED_CALL(free(item_2));
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(list, NULL, item_1, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds)
+/* Tests_SRS_CLDS_SORTED_LIST_07_036: [ If item is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_with_NULL_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_insert(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
-    STRICT_EXPECTED_CALL(free(item_1));
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(list, hazard_pointers_thread, NULL, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds)
+/* Tests_SRS_CLDS_SORTED_LIST_07_037: [ If existing_item is NULL, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_with_NULL_existing_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    item_3_payload->key = 0x44;
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
-    STRICT_EXPECTED_CALL(free(item_2));
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(list, hazard_pointers_thread, item_1, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_deletes_the_item_NULL_cleanup_callback)
+/* Tests_SRS_CLDS_SORTED_LIST_07_038: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_with_non_NULL_sequence_number_but_no_start_sequence_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* existing_item = NULL;
+    int64_t insert_seq_no = 0;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item));
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(list, hazard_pointers_thread, item_1, &existing_item, &insert_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds_NULL_cleanup_callback)
+/* Tests_SRS_CLDS_SORTED_LIST_07_039: [ Otherwise clds_sorted_list_get_or_insert shall insert item in the list in the same way as clds_sorted_list_insert and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_when_the_key_is_not_in_the_list_inserts_the_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* existing_item = NULL;
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(list, hazard_pointers_thread, item_1, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, result);
+    ASSERT_IS_NULL(existing_item);
+    CLDS_SORTED_LIST_ITEM* found_item = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, found_item);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, found_item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds_NULL_cleanup_callback)
+/* Tests_SRS_CLDS_SORTED_LIST_07_040: [ If an item with the same key already exists in the list, clds_sorted_list_get_or_insert shall increment its reference count, store it in existing_item and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_sorted_list_get_or_insert_when_the_key_is_in_the_list_returns_the_existing_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* existing_item = NULL;
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_1));
 
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_get_or_insert(list, hazard_pointers_thread, item_2, &existing_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, existing_item);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, existing_item);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_2);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds_NULL_cleanup_callback)
+/* clds_sorted_list_compute_if_absent */
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_041: [ If clds_sorted_list is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_with_NULL_clds_sorted_list_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    item_3_payload->key = 0x44;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_2));
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(NULL, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
-    clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_015: [ If clds_sorted_list is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_with_NULL_list_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_07_042: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_delete_item(NULL, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, NULL, (void*)0x42, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_016: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_07_043: [ If key is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_delete_item(list, NULL, item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, NULL, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_017: [ If item is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_with_NULL_item_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_07_044: [ If item_factory is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_with_NULL_item_factory_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_SORTED_LIST_HANDLE list;
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, NULL, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, NULL, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_018: [ If the item does not exist in the list, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_on_an_empty_lists_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_07_045: [ If item is NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_with_NULL_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_018: [ If the item does not exist in the list, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_when_the_item_is_not_in_the_list_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_07_046: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_with_non_NULL_sequence_number_but_no_start_sequence_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    CLDS_SORTED_LIST_ITEM* item = NULL;
+    int64_t insert_seq_no = 0;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, &item, &insert_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_2);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_018: [ If the item does not exist in the list, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_twice_on_the_same_item_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_07_047: [ clds_sorted_list_compute_if_absent shall call item_factory with item_factory_context and key to create the new item only when it reaches the position where key would be inserted. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_07_049: [ On success clds_sorted_list_compute_if_absent shall store the new item in item, with its reference count incremented for the caller, and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_when_the_key_is_not_in_the_list_creates_and_inserts_the_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)CLDS_SORTED_LIST_NODE_INC_REF(TEST_ITEM, item);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
-    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x43;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    g_factory_item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, g_factory_item)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4244, (void*)0x42));
+
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, g_factory_item, item);
 
     // cleanup
     CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
@@ -1380,141 +1537,105 @@ TEST_FUNCTION(clds_sorted_list_delete_twice_on_the_same_item_returns_NOT_FOUND)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_063: [ For each delete the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_stamps_the_order)
+/* Tests_SRS_CLDS_SORTED_LIST_07_047: [ clds_sorted_list_compute_if_absent shall call item_factory with item_factory_context and key to create the new item only when it reaches the position where key would be inserted. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_on_an_empty_list_creates_and_inserts_the_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    volatile_atomic int64_t sequence_number = 42;
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result_1;
-    CLDS_SORTED_LIST_DELETE_RESULT result_2;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    int64_t delete_seq_no_1 = 0;
-    int64_t delete_seq_no_2 = 0;
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    g_factory_item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, g_factory_item)->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_2));
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4244, (void*)0x42));
 
     // act
-    result_1 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, &delete_seq_no_1);
-    result_2 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, &delete_seq_no_2);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_1);
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_2);
-    ASSERT_ARE_EQUAL(int64_t, 45, delete_seq_no_1);
-    ASSERT_ARE_EQUAL(int64_t, 46, delete_seq_no_2);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, g_factory_item, item);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_with_no_start_seq_no_stamps_the_order)
+/* Tests_SRS_CLDS_SORTED_LIST_07_048: [ If item_factory returns NULL, clds_sorted_list_compute_if_absent shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_when_item_factory_fails_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     volatile_atomic int64_t sequence_number = 42;
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result_1;
-    CLDS_SORTED_LIST_DELETE_RESULT result_2;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    int64_t delete_seq_no_2 = 0;
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, test_skipped_seq_no_cb, (void*)0x4243);
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item_2));
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4244, (void*)0x42));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x4243, 43));
 
     // act
-    result_1 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, NULL);
-    result_2 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, &delete_seq_no_2);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_1);
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_2);
-    ASSERT_ARE_EQUAL(int64_t, 46, delete_seq_no_2);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+    ASSERT_IS_NULL(item);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_065: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_with_non_NULL_sequence_no_and_no_start_sequence_no_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_07_050: [ If an item with key already exists in the list, clds_sorted_list_compute_if_absent shall increment its reference count, store it in item and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_sorted_list_compute_if_absent_when_the_key_is_in_the_list_returns_the_existing_item_without_calling_item_factory)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-    CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    int64_t delete_seq_no = 0;
-    item_1_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    CLDS_SORTED_LIST_ITEM* item = NULL;
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     // act
-    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, &delete_seq_no);
+    CLDS_SORTED_LIST_INSERT_RESULT result = clds_sorted_list_compute_if_absent(list, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4244, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, item);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_sorted_list_delete_key */
+/* clds_sorted_list_delete_item */
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_071: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_succeeds)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_070: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_item_deletes_the_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
@@ -1533,12 +1654,12 @@ TEST_FUNCTION(clds_sorted_list_delete_key_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
     STRICT_EXPECTED_CALL(free(item));
 
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1549,33 +1670,40 @@ TEST_FUNCTION(clds_sorted_list_delete_key_succeeds)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_succeeds_with_NULL_item_cleanup_callback)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, (void*)0x4242);
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
     CLDS_SORTED_LIST_DELETE_RESULT result;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_insert(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1586,68 +1714,108 @@ TEST_FUNCTION(clds_sorted_list_delete_key_succeeds_with_NULL_item_cleanup_callba
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_020: [ If clds_sorted_list is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_clds_sorted_list_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_insert(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
     // act
-    result = clds_sorted_list_delete_key(NULL, hazard_pointers_thread, (void*)0x42, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_021: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    item_3_payload->key = 0x44;
     CLDS_SORTED_LIST_DELETE_RESULT result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+
     // act
-    result = clds_sorted_list_delete_key(list, NULL, (void*)0x42, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_022: [ If key is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_key_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_deletes_the_item_NULL_cleanup_callback)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
@@ -1655,34 +1823,43 @@ TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_key_fails)
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(item));
+
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, NULL, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds_NULL_cleanup_callback)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
     item_1_payload->key = 0x42;
     item_2_payload->key = 0x43;
-    CLDS_SORTED_LIST_DELETE_RESULT result;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
@@ -1693,12 +1870,11 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1709,17 +1885,18 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds_NULL_cleanup_callback)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
@@ -1735,12 +1912,11 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_1));
 
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1751,18 +1927,19 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_2nd_out_of_3_items)
+/* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim_batched. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds_NULL_cleanup_callback)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
@@ -1781,12 +1958,11 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_2nd_out_of_3_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1797,85 +1973,187 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_2nd_out_of_3_items)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_024: [ If the key is not found, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_on_an_empty_list_yields_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_01_015: [ If clds_sorted_list is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_with_NULL_list_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_DELETE_RESULT result;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+    result = clds_sorted_list_delete_item(NULL, hazard_pointers_thread, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_024: [ If the key is not found, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_after_the_item_was_deleted_yields_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_01_016: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_SORTED_LIST_DELETE_RESULT result;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
-    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
+    result = clds_sorted_list_delete_item(list, NULL, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_066: [ For each delete key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_stamps_the_sequence_no)
+/* Tests_SRS_CLDS_SORTED_LIST_01_017: [ If item is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_with_NULL_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    volatile_atomic int64_t sequence_number = 42;
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
-    CLDS_SORTED_LIST_DELETE_RESULT result_1;
-    CLDS_SORTED_LIST_DELETE_RESULT result_2;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    int64_t delete_key_seq_no_1 = 0;
-    int64_t delete_key_seq_no_2 = 0;
+    CLDS_SORTED_LIST_HANDLE list;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_018: [ If the item does not exist in the list, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_on_an_empty_lists_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_018: [ If the item does not exist in the list, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_when_the_item_is_not_in_the_list_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_018: [ If the item does not exist in the list, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_twice_on_the_same_item_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)CLDS_SORTED_LIST_NODE_INC_REF(TEST_ITEM, item);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_063: [ For each delete the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_stamps_the_order)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_DELETE_RESULT result_1;
+    CLDS_SORTED_LIST_DELETE_RESULT result_2;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    int64_t delete_seq_no_1 = 0;
+    int64_t delete_seq_no_2 = 0;
     item_1_payload->key = 0x42;
     item_2_payload->key = 0x43;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
@@ -1889,45 +2167,43 @@ TEST_FUNCTION(clds_sorted_list_delete_key_stamps_the_sequence_no)
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result_1 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, &delete_key_seq_no_1);
-    result_2 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, &delete_key_seq_no_2);
+    result_1 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, &delete_seq_no_1);
+    result_2 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, &delete_seq_no_2);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_1);
     ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_2);
-    ASSERT_ARE_EQUAL(int64_t, 45, delete_key_seq_no_1);
-    ASSERT_ARE_EQUAL(int64_t, 46, delete_key_seq_no_2);
+    ASSERT_ARE_EQUAL(int64_t, 45, delete_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 46, delete_seq_no_2);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_sequence_no_and_non_NULL_start_Sequence_no_still_computes_the_sequence_numbers)
+/* Tests_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_with_no_start_seq_no_stamps_the_order)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     volatile_atomic int64_t sequence_number = 42;
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_SORTED_LIST_DELETE_RESULT result_1;
     CLDS_SORTED_LIST_DELETE_RESULT result_2;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    int64_t delete_key_seq_no_2 = 0;
+    int64_t delete_seq_no_2 = 0;
     item_1_payload->key = 0x42;
     item_2_payload->key = 0x43;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
@@ -1941,47 +2217,45 @@ TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_sequence_no_and_non_NULL_sta
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result_1 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
-    result_2 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, &delete_key_seq_no_2);
+    result_1 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, NULL);
+    result_2 = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_2, &delete_seq_no_2);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_1);
     ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_2);
-    ASSERT_ARE_EQUAL(int64_t, 46, delete_key_seq_no_2);
+    ASSERT_ARE_EQUAL(int64_t, 46, delete_seq_no_2);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_068: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_delete_key_with_non_NULL_sequence_no_and_no_start_sequence_no_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_065: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_with_non_NULL_sequence_no_and_no_start_sequence_no_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    int64_t delete_key_seq_no = 0;
+    int64_t delete_seq_no = 0;
     item_1_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, &delete_key_seq_no);
+    result = clds_sorted_list_delete_item(list, hazard_pointers_thread, item_1, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1992,21 +2266,20 @@ TEST_FUNCTION(clds_sorted_list_delete_key_with_non_NULL_sequence_no_and_no_start
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_sorted_list_remove_key */
+/* clds_sorted_list_delete_key */
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_073: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_succeeds)
+/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_071: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
@@ -2018,35 +2291,35 @@ TEST_FUNCTION(clds_sorted_list_remove_key_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
 
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_succeeds_with_NULL_item_cleanup_callback)
+/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_succeeds_with_NULL_item_cleanup_callback)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
@@ -2056,31 +2329,30 @@ TEST_FUNCTION(clds_sorted_list_remove_key_succeeds_with_NULL_item_cleanup_callba
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(item));
 
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_053: [ If clds_sorted_list is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_clds_sorted_list_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_020: [ If clds_sorted_list is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_clds_sorted_list_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
@@ -2088,27 +2360,26 @@ TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_clds_sorted_list_fails)
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_remove_key(NULL, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+    result = clds_sorted_list_delete_key(NULL, hazard_pointers_thread, (void*)0x42, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_055: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_021: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
@@ -2116,27 +2387,26 @@ TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_hazard_pointers_thread_fails
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_remove_key(list, NULL, (void*)0x42, &removed_item, NULL);
+    result = clds_sorted_list_delete_key(list, NULL, (void*)0x42, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_056: [ If key is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_key_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_022: [ If key is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
@@ -2144,22 +2414,21 @@ TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_key_fails)
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, NULL, &removed_item, NULL);
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
+/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
@@ -2167,12 +2436,11 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
     item_1_payload->key = 0x42;
     item_2_payload->key = 0x43;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_DELETE_RESULT result;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
@@ -2183,26 +2451,912 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
 
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
+/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    // act
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_2nd_out_of_3_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    item_3_payload->key = 0x44;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+
+    // act
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_024: [ If the key is not found, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_on_an_empty_list_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_024: [ If the key is not found, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_after_the_item_was_deleted_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_023: [ `clds_sorted_list_delete_key` shall stop looking for the key and return `CLDS_SORTED_LIST_DELETE_NOT_FOUND` when it reaches an item with a greater key.  ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_stops_at_the_first_greater_key_and_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x44;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_066: [ For each delete key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_stamps_the_sequence_no)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SORTED_LIST_DELETE_RESULT result_1;
+    CLDS_SORTED_LIST_DELETE_RESULT result_2;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    int64_t delete_key_seq_no_1 = 0;
+    int64_t delete_key_seq_no_2 = 0;
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+
+    // act
+    result_1 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, &delete_key_seq_no_1);
+    result_2 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, &delete_key_seq_no_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_1);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_2);
+    ASSERT_ARE_EQUAL(int64_t, 45, delete_key_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 46, delete_key_seq_no_2);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_sequence_no_and_non_NULL_start_Sequence_no_still_computes_the_sequence_numbers)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SORTED_LIST_DELETE_RESULT result_1;
+    CLDS_SORTED_LIST_DELETE_RESULT result_2;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    int64_t delete_key_seq_no_2 = 0;
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+
+    // act
+    result_1 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, NULL);
+    result_2 = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x43, &delete_key_seq_no_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_1);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, result_2);
+    ASSERT_ARE_EQUAL(int64_t, 46, delete_key_seq_no_2);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_068: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_delete_key_with_non_NULL_sequence_no_and_no_start_sequence_no_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    int64_t delete_key_seq_no = 0;
+    item_1_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_delete_key(list, hazard_pointers_thread, (void*)0x42, &delete_key_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_remove_key */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_073: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_succeeds_with_NULL_item_cleanup_callback)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_053: [ If clds_sorted_list is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_clds_sorted_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_remove_key(NULL, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_055: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_remove_key(list, NULL, (void*)0x42, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_056: [ If key is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, NULL, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim_batched shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_2nd_out_of_3_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    item_3_payload->key = 0x44;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_057: [ If the key is not found, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_on_an_empty_list_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_057: [ If the key is not found, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_after_the_item_was_deleted_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_024: [ `clds_sorted_list_remove_key` shall stop looking for the key and return `CLDS_SORTED_LIST_REMOVE_NOT_FOUND` when it reaches an item with a greater key.  ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_stops_at_the_first_greater_key_and_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x44;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_072: [ For each remove key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_stamps_the_sequence_numbers)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item_1;
+    CLDS_SORTED_LIST_ITEM* removed_item_2;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    CLDS_SORTED_LIST_REMOVE_RESULT result_1;
+    CLDS_SORTED_LIST_REMOVE_RESULT result_2;
+    int64_t remove_seq_no_1 = 0;
+    int64_t remove_seq_no_2 = 0;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+
+    // act
+    result_1 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item_1, &remove_seq_no_1);
+    result_2 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item_2, &remove_seq_no_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_1);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_2);
+    ASSERT_ARE_EQUAL(int64_t, 45, remove_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 46, remove_seq_no_2);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_1);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_2);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_074: [ If the sequence_number argument passed to clds_sorted_list_remove_key is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_sequence_number_and_non_NULL_start_sequence_number_still_computes_the_sequence_numbers)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item_1;
+    CLDS_SORTED_LIST_ITEM* removed_item_2;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    CLDS_SORTED_LIST_REMOVE_RESULT result_1;
+    CLDS_SORTED_LIST_REMOVE_RESULT result_2;
+    int64_t remove_seq_no_2 = 0;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
+
+    // act
+    result_1 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item_1, NULL);
+    result_2 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item_2, &remove_seq_no_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_1);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_2);
+    ASSERT_ARE_EQUAL(int64_t, 46, remove_seq_no_2);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_1);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_2);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_075: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_remove_key_with_non_NULL_sequence_number_and_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    item_1_payload->key = 0x42;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+    int64_t remove_seq_no = 0;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, &remove_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_find_key */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_succeeds_in_finding_an_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, result);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_finds_the_2nd_out_of_3_added_items)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
@@ -2210,15 +3364,18 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
-    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
     item_1_payload->key = 0x42;
     item_2_payload->key = 0x43;
+    item_3_payload->key = 0x44;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
@@ -2226,26 +3383,23 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
 
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x43);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_sorted_list_destroy(list);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_2nd_out_of_3_items)
+/* Tests_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_finds_the_last_added_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
@@ -2254,8 +3408,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_2nd_out_of_3_items)
     CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
-    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_ITEM* result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
     TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
@@ -2273,160 +3426,110 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_2nd_out_of_3_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
 
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x44);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_3, result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_sorted_list_destroy(list);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_057: [ If the key is not found, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_on_an_empty_list_yields_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_01_028: [ If clds_sorted_list is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_with_NULL_clds_sorted_list_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
-    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
+    result = clds_sorted_list_find_key(NULL, hazard_pointers_thread, (void*)0x42);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_NOT_FOUND, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_057: [ If the key is not found, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_after_the_item_was_deleted_yields_NOT_FOUND)
+/* Tests_SRS_CLDS_SORTED_LIST_01_030: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_with_NULL_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
-    CLDS_SORTED_LIST_ITEM* removed_item;
+    CLDS_SORTED_LIST_ITEM* result;
     TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
     item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
-    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
+    result = clds_sorted_list_find_key(list, NULL, (void*)0x42);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_NOT_FOUND, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_072: [ For each remove key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_stamps_the_sequence_numbers)
+/* Tests_SRS_CLDS_SORTED_LIST_01_031: [ If key is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    volatile_atomic int64_t sequence_number = 42;
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item_1;
-    CLDS_SORTED_LIST_ITEM* removed_item_2;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    CLDS_SORTED_LIST_REMOVE_RESULT result_1;
-    CLDS_SORTED_LIST_REMOVE_RESULT result_2;
-    int64_t remove_seq_no_1 = 0;
-    int64_t remove_seq_no_2 = 0;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-
     // act
-    result_1 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item_1, &remove_seq_no_1);
-    result_2 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item_2, &remove_seq_no_2);
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_1);
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_2);
-    ASSERT_ARE_EQUAL(int64_t, 45, remove_seq_no_1);
-    ASSERT_ARE_EQUAL(int64_t, 46, remove_seq_no_2);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_1);
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_2);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_074: [ If the sequence_number argument passed to clds_sorted_list_remove_key is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_sequence_number_and_non_NULL_start_sequence_number_still_computes_the_sequence_numbers)
+/* Tests_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_on_an_empty_list_returns_NULL)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    volatile_atomic int64_t sequence_number = 42;
-    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, &sequence_number, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item_1;
-    CLDS_SORTED_LIST_ITEM* removed_item_2;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    CLDS_SORTED_LIST_REMOVE_RESULT result_1;
-    CLDS_SORTED_LIST_REMOVE_RESULT result_2;
-    int64_t remove_seq_no_2 = 0;
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* result;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
@@ -2435,71 +3538,72 @@ TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_sequence_number_and_non_NULL
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
-
     // act
-    result_1 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item_1, NULL);
-    result_2 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item_2, &remove_seq_no_2);
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_1);
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, result_2);
-    ASSERT_ARE_EQUAL(int64_t, 46, remove_seq_no_2);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_1);
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, removed_item_2);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_075: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_sorted_list_remove_key_with_non_NULL_sequence_number_and_NULL_start_sequence_number_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_after_the_item_was_deleted_returns_NULL)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* removed_item;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    item_1_payload->key = 0x42;
-    CLDS_SORTED_LIST_REMOVE_RESULT result;
-    int64_t remove_seq_no = 0;
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* result;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     // act
-    result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, &remove_seq_no);
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_ERROR, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_sorted_list_find_key */
-
-/* Tests_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_succeeds_in_finding_an_item)
+/* Tests_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_when_the_item_is_not_in_the_list_returns_NULL)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
+    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
+    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
+    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
+    item_1_payload->key = 0x42;
+    item_2_payload->key = 0x43;
+    item_3_payload->key = 0x44;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
@@ -2513,17 +3617,16 @@ TEST_FUNCTION(clds_sorted_list_find_key_succeeds_in_finding_an_item)
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, item, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
     clds_sorted_list_destroy(list);
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_finds_the_2nd_out_of_3_added_items)
+/* Tests_SRS_CLDS_SORTED_LIST_07_025: [ `clds_sorted_list_find_key` shall stop looking for the key and return NULL when it reaches an item with a greater key.  ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_stops_at_the_first_greater_key_and_returns_NULL)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
@@ -2531,18 +3634,14 @@ TEST_FUNCTION(clds_sorted_list_find_key_finds_the_2nd_out_of_3_added_items)
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* result;
     TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
     TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
     item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    item_3_payload->key = 0x44;
+    item_2_payload->key = 0x44;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
@@ -2556,36 +3655,27 @@ TEST_FUNCTION(clds_sorted_list_find_key_finds_the_2nd_out_of_3_added_items)
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, item_2, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_sorted_list_destroy(list);
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find_key shall find in the list the first item that matches the criteria given by a user compare function. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find_key shall return a non-NULL pointer to the found linked list item. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_finds_the_last_added_item)
+/* Tests_SRS_CLDS_SORTED_LIST_01_034: [ clds_sorted_list_find_key shall return a pointer to the item with the reference count already incremented so that it can be safely used by the caller. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_result_has_the_ref_count_incremented)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    item_3_payload->key = 0x44;
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
     (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
@@ -2593,13 +3683,15 @@ TEST_FUNCTION(clds_sorted_list_find_key_finds_the_last_added_item)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item, IGNORED_ARG));
+
+    // no item cleanup and free should happen here
 
     // act
-    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x44);
+    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, item_3, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
@@ -2607,225 +3699,213 @@ TEST_FUNCTION(clds_sorted_list_find_key_finds_the_last_added_item)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_028: [ If clds_sorted_list is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_with_NULL_clds_sorted_list_fails)
+/* clds_sorted_list_find_key_and_visit */
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_026: [ If clds_sorted_list is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_with_NULL_clds_sorted_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(NULL, hazard_pointers_thread, (void*)0x42, test_find_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_07_027: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_find_key(NULL, hazard_pointers_thread, (void*)0x42);
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(list, NULL, (void*)0x42, test_find_visit_cb, &visit_context);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_030: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_with_NULL_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_07_028: [ If key is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_with_NULL_key_fails)
 {
     // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_find_key(list, NULL, (void*)0x42);
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(list, hazard_pointers_thread, NULL, test_find_visit_cb, &visit_context);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_031: [ If key is NULL, clds_sorted_list_find_key shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_with_NULL_key_fails)
+/* Tests_SRS_CLDS_SORTED_LIST_07_029: [ If visit_cb is NULL, clds_sorted_list_find_key_and_visit shall fail and return CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_with_NULL_visit_cb_fails)
 {
     // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_sorted_list_find_key(list, hazard_pointers_thread, NULL);
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(list, hazard_pointers_thread, (void*)0x42, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_ERROR, result);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_on_an_empty_list_returns_NULL)
+/* Tests_SRS_CLDS_SORTED_LIST_07_030: [ clds_sorted_list_find_key_and_visit shall call visit_cb with visit_cb_context and the found item while the item is protected only by the hazard pointer of clds_hazard_pointers_thread. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_07_032: [ On success clds_sorted_list_find_key_and_visit shall return CLDS_SORTED_LIST_FIND_AND_VISIT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_visits_the_2nd_out_of_3_added_items)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* result;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x43;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3)->key = 0x44;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     // act
-    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(list, hazard_pointers_thread, (void*)0x43, test_find_visit_cb, &visit_context);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 1, visit_context.visited_count);
+    ASSERT_ARE_EQUAL(uint32_t, 0x43, visit_context.visited_keys[0]);
 
     // cleanup
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_after_the_item_was_deleted_returns_NULL)
+/* Tests_SRS_CLDS_SORTED_LIST_07_031: [ clds_sorted_list_find_key_and_visit shall not increment the reference count of the found item. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_does_not_take_a_reference_on_the_item)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
     CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item)->key = 0x42;
     (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
-    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_OK, clds_sorted_list_find_key_and_visit(list, hazard_pointers_thread, (void*)0x42, test_find_visit_cb, &visit_context));
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // the only reference is the one held by the list, so destroying the list frees the item
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
+    clds_sorted_list_destroy(list);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
 
     // cleanup
-    clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_when_the_item_is_not_in_the_list_returns_NULL)
+/* Tests_SRS_CLDS_SORTED_LIST_07_033: [ If no item matching key is found in the list, clds_sorted_list_find_key_and_visit shall return CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND without calling visit_cb. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_on_an_empty_list_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_1_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1);
-    TEST_ITEM* item_2_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2);
-    TEST_ITEM* item_3_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3);
-    item_1_payload->key = 0x42;
-    item_2_payload->key = 0x43;
-    item_3_payload->key = 0x44;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     // act
-    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(list, hazard_pointers_thread, (void*)0x42, test_find_visit_cb, &visit_context);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
 
     // cleanup
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
     clds_sorted_list_destroy(list);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_SORTED_LIST_01_034: [ clds_sorted_list_find_key shall return a pointer to the item with the reference count already incremented so that it can be safely used by the caller. ]*/
-TEST_FUNCTION(clds_sorted_list_find_key_result_has_the_ref_count_incremented)
+/* Tests_SRS_CLDS_SORTED_LIST_07_033: [ If no item matching key is found in the list, clds_sorted_list_find_key_and_visit shall return CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND without calling visit_cb. ]*/
+TEST_FUNCTION(clds_sorted_list_find_key_and_visit_when_the_item_is_not_in_the_list_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
-    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_SORTED_LIST_ITEM* result;
-    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
-    item_payload->key = 0x42;
-    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
-    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item, NULL);
-    result = clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42);
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 0 };
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x44;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
-
-    // no item cleanup and free should happen here
 
     // act
-    (void)clds_sorted_list_delete_item(list, hazard_pointers_thread, item, NULL);
+    CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT result = clds_sorted_list_find_key_and_visit(list, hazard_pointers_thread, (void*)0x43, test_find_visit_cb, &visit_context);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_FIND_AND_VISIT_RESULT, CLDS_SORTED_LIST_FIND_AND_VISIT_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
 
     // cleanup
     clds_sorted_list_destroy(list);
-    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
@@ -3542,6 +4622,210 @@ TEST_FUNCTION(clds_sorted_list_get_all_with_1_item_but_item_count_2_still_succee
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* clds_sorted_list_visit */
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_001: [ If clds_sorted_list is NULL then clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_visit_with_NULL_clds_sorted_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 3 };
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(NULL, hazard_pointers_thread, test_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_002: [ If clds_hazard_pointers_thread is NULL then clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_visit_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 3 };
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(list, NULL, test_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_003: [ If visit_cb is NULL then clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_visit_with_NULL_visit_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(list, hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_008: [ When the end of the list is reached clds_sorted_list_visit shall succeed and return CLDS_SORTED_LIST_VISIT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_visit_on_empty_list_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 3 };
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(list, hazard_pointers_thread, test_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_004: [ clds_sorted_list_visit shall walk the items of the list in key order, while protecting each item with a hazard pointer. ]*/
+/*Tests_SRS_CLDS_SORTED_LIST_07_005: [ For each item, clds_sorted_list_visit shall call visit_cb with visit_cb_context and the item. ]*/
+/*Tests_SRS_CLDS_SORTED_LIST_07_008: [ When the end of the list is reached clds_sorted_list_visit shall succeed and return CLDS_SORTED_LIST_VISIT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_visit_visits_3_items_in_key_order)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 3 };
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x43;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3)->key = 0x44;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_3));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(list, hazard_pointers_thread, test_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 3, visit_context.visited_count);
+    ASSERT_ARE_EQUAL(uint32_t, 0x42, visit_context.visited_keys[0]);
+    ASSERT_ARE_EQUAL(uint32_t, 0x43, visit_context.visited_keys[1]);
+    ASSERT_ARE_EQUAL(uint32_t, 0x44, visit_context.visited_keys[2]);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_007: [ If visit_cb returns false, clds_sorted_list_visit shall stop and return CLDS_SORTED_LIST_VISIT_STOPPED. ]*/
+TEST_FUNCTION(clds_sorted_list_visit_stops_when_visit_cb_returns_false)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 2 };
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x43;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3)->key = 0x44;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_3, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(list, hazard_pointers_thread, test_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_STOPPED, result);
+    ASSERT_ARE_EQUAL(size_t, 2, visit_context.visited_count);
+    ASSERT_ARE_EQUAL(uint32_t, 0x42, visit_context.visited_keys[0]);
+    ASSERT_ARE_EQUAL(uint32_t, 0x43, visit_context.visited_keys[1]);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/*Tests_SRS_CLDS_SORTED_LIST_07_009: [ If any error occurs, clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_fails_clds_sorted_list_visit_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = real_clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = real_clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    TEST_VISIT_CONTEXT visit_context = { { 0 }, 0, 3 };
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x43;
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_1, NULL);
+    (void)clds_sorted_list_insert(list, hazard_pointers_thread, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_SORTED_LIST_VISIT_RESULT result = clds_sorted_list_visit(list, hazard_pointers_thread, test_visit_cb, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 1, visit_context.visited_count);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* clds_sorted_list_node_create */
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_036: [ item_cleanup_callback shall be allowed to be NULL. ]*/
@@ -3928,7 +5212,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_when_the_key_is_in_the_list_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x42, item_2, NULL, NULL, &old_item, &set_value_seq_no, false);
@@ -4036,7 +5320,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_succeeds_when_condition_check_db_return
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_1, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x42, item_2, test_item_condition_check, (void *)0x42, &old_item, &set_value_seq_no, false);
@@ -4090,7 +5374,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_when_the_key_is_in_the_list_for_the_2nd
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x43, item_3, NULL, NULL, &old_item, &set_value_seq_no, false);
@@ -4139,7 +5423,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_when_the_key_is_in_the_list_for_the_2nd
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_2, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x43, item_3, NULL, NULL, &old_item, NULL, false);
@@ -4189,7 +5473,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_with_NULL_sequence_number_still_increme
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(hazard_pointers_thread, item_3, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x43, item_2, NULL, NULL, &old_item, &set_value_seq_no, false);
@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/threadapi.h"
+#include "c_pal/interlocked.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#include "clds/clds_split_ordered_hash_table.h"
+
+#define THREAD_COUNT 4
+
+#ifdef _MSC_VER
+// on Windows run with more iterations. Normally this should be passed as an argument, but this should also do for now.
+#define INSERT_COUNT 100000
+#else
+// setting this way lower as we run with Helgrind on Linux and that is ... slow
+#define INSERT_COUNT 10000
+#endif
+
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+
+typedef struct TEST_ITEM_TAG
+{
+    uint64_t key;
+} TEST_ITEM;
+
+DECLARE_SPLIT_ORDERED_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+typedef struct THREAD_DATA_TAG
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers;
+    uint32_t thread_index;
+    bool delete_keys;
+} THREAD_DATA;
+
+static uint64_t test_compute_hash(void* key)
+{
+    // spread the keys of the different threads over all the buckets
+    return (uint64_t)(uintptr_t)key * 0x9E3779B97F4A7C15ULL;
+}
+
+static int test_key_compare(void* key1, void* key2)
+{
+    uint64_t key_1 = (uint64_t)(uintptr_t)key1;
+    uint64_t key_2 = (uint64_t)(uintptr_t)key2;
+    return (key_1 < key_2) ? -1 : (key_1 > key_2) ? 1 : 0;
+}
+
+static uint64_t get_thread_key(uint32_t thread_index, uint32_t i)
+{
+    return ((uint64_t)thread_index * INSERT_COUNT) + i + 1;
+}
+
+static CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* create_test_item(uint64_t key)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    ASSERT_IS_NOT_NULL(item, "Cannot create item for key %" PRIu64 "", key);
+    TEST_ITEM* test_item = CLDS_SPLIT_ORDERED_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+    test_item->key = key;
+    return item;
+}
+
+static int insert_find_delete_own_keys_thread(void* arg)
+{
+    THREAD_DATA* thread_data = arg;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(thread_data->hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        uint64_t key = get_thread_key(thread_data->thread_index, i);
+        ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(thread_data->split_ordered_hash_table, hazard_pointers_thread, (void*)(uintptr_t)key, create_test_item(key), NULL));
+    }
+
+    // the table grew while the other threads were inserting, all the keys have to be found in their new buckets
+    for (uint32_t i = 0; i < INSERT_COUNT; i++)
+    {
+        uint64_t key = get_thread_key(thread_data->thread_index, i);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = clds_split_ordered_hash_table_find(thread_data->split_ordered_hash_table, hazard_pointers_thread, (void*)(uintptr_t)key);
+        ASSERT_IS_NOT_NULL(item, "Key %" PRIu64 " not found", key);
+        ASSERT_ARE_EQUAL(uint64_t, key, CLDS_SPLIT_ORDERED_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    if (thread_data->delete_keys)
+    {
+        for (uint32_t i = 0; i < INSERT_COUNT; i++)
+        {
+            uint64_t key = get_thread_key(thread_data->thread_index, i);
+            ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_OK, clds_split_ordered_hash_table_delete(thread_data->split_ordered_hash_table, hazard_pointers_thread, (void*)(uintptr_t)key, NULL));
+            ASSERT_IS_NULL(clds_split_ordered_hash_table_find(thread_data->split_ordered_hash_table, hazard_pointers_thread, (void*)(uintptr_t)key));
+        }
+    }
+
+    clds_hazard_pointers_unregister_thread(hazard_pointers_thread);
+
+    return 0;
+}
+
+static void run_threads(THREAD_START_FUNC thread_func, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table, CLDS_HAZARD_POINTERS_HANDLE hazard_pointers, bool delete_keys)
+{
+    THREAD_HANDLE threads[THREAD_COUNT];
+    THREAD_DATA thread_data[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        thread_data[i].split_ordered_hash_table = split_ordered_hash_table;
+        thread_data[i].hazard_pointers = hazard_pointers;
+        thread_data[i].thread_index = i;
+        thread_data[i].delete_keys = delete_keys;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&threads[i], thread_func, &thread_data[i]));
+    }
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(threads[i], &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Thread %" PRIu32 " failed", i);
+    }
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, gballoc_hl_init(NULL, NULL));
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_find_delete_from_multiple_threads_while_growing_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare, 2, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+
+    // act
+    // assert
+    run_threads(insert_find_delete_own_keys_thread, split_ordered_hash_table, hazard_pointers, true);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_after_inserts_from_multiple_threads_returns_all_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare, 2, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+    run_threads(insert_find_delete_own_keys_thread, split_ordered_hash_table, hazard_pointers, false);
+
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, (uint64_t)THREAD_COUNT * INSERT_COUNT, item_count);
+
+    uint64_t key_sum = 0;
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        key_sum += CLDS_SPLIT_ORDERED_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i])->key;
+        CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+
+    // the keys are 1..THREAD_COUNT * INSERT_COUNT, each exactly once
+    ASSERT_ARE_EQUAL(uint64_t, item_count * (item_count + 1) / 2, key_sum);
+
+    // cleanup
+    free(items);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    clds_hazard_pointers_unregister_thread(hazard_pointers_thread);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
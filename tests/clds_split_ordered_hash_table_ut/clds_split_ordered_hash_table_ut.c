@@ -0,0 +1,2149 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include "clds_split_ordered_hash_table_ut_pch.h"
+
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, struct SORTED_LIST_NODE_SPLIT_ORDERED_HASH_TABLE_ITEM_TAG*, item)
+MOCK_FUNCTION_END()
+
+MOCK_FUNCTION_WITH_CODE(, uint64_t, test_compute_hash, void*, key)
+    (void)key;
+MOCK_FUNCTION_END((uint64_t)key)
+
+MOCK_FUNCTION_WITH_CODE(, void, test_skipped_seq_no_cb, void*, context, int64_t, skipped_seq_no)
+MOCK_FUNCTION_END()
+
+static CLDS_CONDITION_CHECK_RESULT g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+MOCK_FUNCTION_WITH_CODE(, CLDS_CONDITION_CHECK_RESULT, test_item_condition_check, void*, context, void*, new_key, void*, old_key)
+MOCK_FUNCTION_END(g_condition_check_result)
+
+static int test_key_compare_func(void* key_1, void* key_2)
+{
+    int result;
+    if (key_1 < key_2)
+    {
+        result = -1;
+    }
+    else if (key_1 > key_2)
+    {
+        result = 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+typedef struct TEST_ITEM_TAG
+{
+    int dummy;
+} TEST_ITEM;
+
+DECLARE_SPLIT_ORDERED_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+// simulates another thread inserting the same bucket start node first: the node ends up in the list, but the insert reports that the key already exists
+static bool g_lose_bucket_start_race;
+
+static CLDS_SORTED_LIST_INSERT_RESULT hook_clds_sorted_list_insert_losing_bucket_start_race(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (g_lose_bucket_start_race)
+    {
+        g_lose_bucket_start_race = false;
+
+        // the list keeps its own reference, the caller releases the one it passed in when it sees the key exists
+        ASSERT_ARE_EQUAL(int, 0, real_clds_sorted_list_node_inc_ref(item));
+        ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, real_clds_sorted_list_insert(clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number));
+        result = CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS;
+    }
+    else
+    {
+        result = real_clds_sorted_list_insert(clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number);
+    }
+
+    return result;
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, real_gballoc_hl_init(NULL, NULL));
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(on_umock_c_error), "umock_c_init failed");
+
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types(), "umocktypes_stdint_register_types failed");
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types(), "umocktypes_bool_register_types failed");
+
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+    REGISTER_CLDS_SORTED_LIST_GLOBAL_MOCK_HOOKS();
+    REGISTER_CANCELLATION_TOKEN_GLOBAL_MOCK_HOOKS();
+
+    REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_node_create, NULL);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_insert, CLDS_SORTED_LIST_INSERT_ERROR);
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_BATCH_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST_CONFIG*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const CLDS_SORTED_LIST_CONFIG*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_ITEM_CLEANUP_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_GET_ITEM_KEY_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_KEY_COMPARE_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_SKIPPED_SEQ_NO_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CONDITION_CHECK_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_VISIT_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THANDLE(CANCELLATION_TOKEN), void*);
+
+    REGISTER_TYPE(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_RESULT);
+    REGISTER_TYPE(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_RESULT);
+    REGISTER_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RESULT);
+    REGISTER_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT);
+    REGISTER_TYPE(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT);
+    REGISTER_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT);
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_negative_tests_deinit();
+    umock_c_deinit();
+
+    real_gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+    g_lose_bucket_start_race = false;
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+typedef struct CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT_TAG
+{
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread;
+    volatile_atomic int64_t start_seq_no;
+} CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT;
+
+static void setup_test_context(CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT* test_context)
+{
+    test_context->hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(test_context->hazard_pointers);
+    test_context->hazard_pointers_thread = clds_hazard_pointers_register_thread(test_context->hazard_pointers);
+    ASSERT_IS_NOT_NULL(test_context->hazard_pointers_thread);
+
+    (void)interlocked_exchange_64(&test_context->start_seq_no, 0);
+
+    umock_c_reset_all_calls();
+}
+
+static void destroy_test_context(CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT* test_context)
+{
+    clds_hazard_pointers_destroy(test_context->hazard_pointers);
+}
+
+static CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* insert_test_item(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table, CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT* test_context, void* key)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_IS_NOT_NULL(item);
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context->hazard_pointers_thread, key, item, NULL));
+    return item;
+}
+
+/* clds_split_ordered_hash_table_create */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_001: [ clds_split_ordered_hash_table_create shall create a new split ordered hash table object and on success it shall return a non-NULL handle to the newly created table. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_016: [ clds_split_ordered_hash_table_create shall initialize the sorted list configuration shared by all the buckets by calling clds_sorted_list_config_init, passing start_sequence_number to it. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_018: [ clds_split_ordered_hash_table_create shall allocate the first segment of buckets and the start node of bucket 0, which is the head of the list that holds all the items. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    volatile_atomic int64_t sequence_number = 55;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_SORTED_LIST)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_010: [ start_sequence_number, skipped_seq_no_cb and skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_sequence_number_and_skipped_seq_no_cb_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, NULL, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_SORTED_LIST)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_011: [ If compute_hash is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_compute_hash_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(NULL, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(split_ordered_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_012: [ If key_compare_func is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_key_compare_func_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, NULL, 2, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(split_ordered_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_013: [ If initial_bucket_size is 0, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_initial_bucket_size_zero_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 0, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(split_ordered_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_014: [ If clds_hazard_pointers is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(split_ordered_hash_table);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_015: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_sequence_number_and_non_NULL_skipped_seq_no_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, test_skipped_seq_no_cb, (void*)0x5556);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(split_ordered_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_002: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_underlying_calls_fail_clds_split_ordered_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table;
+    volatile_atomic int64_t sequence_number = 55;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG))
+        .SetFailReturn(MU_FAILURE);
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_SORTED_LIST)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG))
+        .CallCannotFail();
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG))
+        .CallCannotFail();
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+
+            // assert
+            ASSERT_IS_NULL(split_ordered_hash_table, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_017: [ The bucket count shall be initial_bucket_size rounded up to a power of 2 (at least 2). ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_004: [ The bucket of a key shall be the hash of the key masked with the bucket count minus 1. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_005: [ The bucket lists shall be allocated in segments that double in size, the first time a bucket in the segment is used. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_rounds_up_the_bucket_count_to_a_power_of_2)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 3, test_context.hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // 3 rounds up to 4 buckets, so hash 3 goes to bucket 3, which is in the segment for buckets 2 and 3, and splits from bucket 1
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_SORTED_LIST)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x3, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_destroy */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_020: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_destroy shall return. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_destroy_with_NULL_table_returns)
+{
+    // arrange
+
+    // act
+    clds_split_ordered_hash_table_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_022: [ clds_split_ordered_hash_table_destroy shall free all resources associated with the table. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_destroy_frees_the_table_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_021: [ clds_split_ordered_hash_table_destroy shall release all the items and bucket start nodes by walking the list once, starting at bucket 0. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_022: [ clds_split_ordered_hash_table_destroy shall free all resources associated with the table. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_destroy_releases_the_items_and_the_bucket_start_nodes)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x1);
+    umock_c_reset_all_calls();
+
+    // list order is: start of bucket 0, 0x2, start of bucket 1, 0x1
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_1));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item_2));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_insert */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_028: [ clds_split_ordered_hash_table_insert shall wait until the table is not locked for writes and count the insert as a pending write operation. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_029: [ clds_split_ordered_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_split_ordered_hash_table_create. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_030: [ clds_split_ordered_hash_table_insert shall insert the item in the list of its bucket by calling clds_sorted_list_insert, passing sequence_number to it. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_033: [ On success clds_split_ordered_hash_table_insert shall return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_034: [ clds_split_ordered_hash_table_insert shall decrement the count of pending write operations. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_in_bucket_0_inserts_the_item)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_006: [ When a bucket is used for the first time, a bucket start node shall be inserted in the list of its parent bucket (the bucket index without its highest bit set) by calling clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_007: [ The sequence number consumed by inserting a bucket start node shall be reported as skipped by calling the skipped sequence number callback passed to clds_split_ordered_hash_table_create (if not NULL). ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_009: [ The head of the bucket list shall be set to the bucket start node, so that the operations on the bucket start walking the list from there. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_in_a_new_bucket_inserts_the_bucket_start_node_and_reports_its_sequence_number_as_skipped)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, (void*)0x5556);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int64_t sequence_number = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x5556, 1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, &sequence_number));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 2, sequence_number);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_009: [ The head of the bucket list shall be set to the bucket start node, so that the operations on the bucket start walking the list from there. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_in_an_initialized_bucket_does_not_insert_another_bucket_start_node)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x1);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x5));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x5, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_019: [ If the number of items reaches the number of buckets, clds_split_ordered_hash_table_insert shall double the number of buckets. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_005: [ The bucket lists shall be allocated in segments that double in size, the first time a bucket in the segment is used. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_006: [ When a bucket is used for the first time, a bucket start node shall be inserted in the list of its parent bucket (the bucket index without its highest bit set) by calling clds_sorted_list_insert. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_when_the_item_count_reaches_the_bucket_count_doubles_the_buckets)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x4);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x8);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // 4 buckets now, 0x6 goes to bucket 2, which splits from bucket 0
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x6));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_SORTED_LIST)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_init(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x6, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_023: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_NULL_table_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(NULL, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_024: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, NULL, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_025: [ If key is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, NULL, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_026: [ If value is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_NULL_value_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_027: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_non_NULL_sequence_number_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_031: [ If the key already exists in the table, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREADY_EXISTS)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x1);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_003: [ The items shall be kept in one sorted list, ordered by the bit reversed hash of their key and then by key_compare_func. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_2_keys_with_the_same_hash_succeeds)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1))
+        .SetReturn(0x42);
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2))
+        .SetReturn(0x42);
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_032: [ If any error is encountered while inserting the item, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(when_underlying_calls_fail_clds_split_ordered_hash_table_insert_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1))
+        .CallCannotFail();
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_008: [ If another thread already inserted the bucket start node, the existing node shall be looked up by calling clds_sorted_list_find_key. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_009: [ The head of the bucket list shall be set to the bucket start node, so that the operations on the bucket start walking the list from there. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_when_another_thread_inserted_the_bucket_start_node_first_uses_the_existing_node)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, hook_clds_sorted_list_insert_losing_bucket_start_race);
+    g_lose_bucket_start_race = true;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_OK, result);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* found_item = clds_split_ordered_hash_table_find(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item, found_item);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, real_clds_sorted_list_insert);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_008: [ If another thread already inserted the bucket start node, the existing node shall be looked up by calling clds_sorted_list_find_key. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_032: [ If any error is encountered while inserting the item, clds_split_ordered_hash_table_insert shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_when_the_bucket_start_node_inserted_by_another_thread_is_not_found_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, hook_clds_sorted_list_insert_losing_bucket_start_race);
+    g_lose_bucket_start_race = true;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT result = clds_split_ordered_hash_table_insert(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_insert, real_clds_sorted_list_insert);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_delete */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_039: [ clds_split_ordered_hash_table_delete shall wait until the table is not locked for writes and count the delete as a pending write operation. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_040: [ clds_split_ordered_hash_table_delete shall delete the key from the list of its bucket by calling clds_sorted_list_delete_key, passing sequence_number to it. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_042: [ On success clds_split_ordered_hash_table_delete shall return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_044: [ clds_split_ordered_hash_table_delete shall decrement the count of pending write operations. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_deletes_the_key)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    int64_t sequence_number = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, &sequence_number));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 2, sequence_number);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_041: [ If the key is not found, clds_split_ordered_hash_table_delete shall return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x4, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_035: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_NULL_table_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(NULL, test_context.hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_036: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(split_ordered_hash_table, NULL, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_037: [ If key is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(split_ordered_hash_table, test_context.hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_038: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_non_NULL_sequence_number_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_043: [ If any error is encountered, clds_split_ordered_hash_table_delete shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_delete_key_fails_clds_split_ordered_hash_table_delete_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, NULL))
+        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT result = clds_split_ordered_hash_table_delete(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_remove */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_050: [ clds_split_ordered_hash_table_remove shall wait until the table is not locked for writes and count the remove as a pending write operation. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_051: [ clds_split_ordered_hash_table_remove shall remove the key from the list of its bucket by calling clds_sorted_list_remove_key, passing sequence_number to it, and return the removed item in item. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_removes_the_key)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x1);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item, removed_item);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_052: [ If the key is not found, clds_split_ordered_hash_table_remove shall return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, NULL));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_045: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_NULL_table_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(NULL, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_046: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, NULL, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_047: [ If key is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, test_context.hazard_pointers_thread, NULL, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_048: [ If item is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_049: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_non_NULL_sequence_number_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1, &removed_item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_053: [ If any error is encountered, clds_split_ordered_hash_table_remove shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_remove_key_fails_clds_split_ordered_hash_table_remove_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, NULL))
+        .SetReturn(CLDS_SORTED_LIST_REMOVE_ERROR);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT result = clds_split_ordered_hash_table_remove(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_set_value */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_070: [ clds_split_ordered_hash_table_set_value shall wait until the table is not locked for writes and count the set value as a pending write operation. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_071: [ clds_split_ordered_hash_table_set_value shall call clds_sorted_list_set_value on the list of the bucket of the key, passing new_item, old_item, sequence_number and only_if_exists set to false. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_075: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_split_ordered_hash_table_set_value shall succeed and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_a_new_key_inserts_the_item)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL, IGNORED_ARG, IGNORED_ARG, NULL, false));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(old_item);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_071: [ clds_split_ordered_hash_table_set_value shall call clds_sorted_list_set_value on the list of the bucket of the key, passing new_item, old_item, sequence_number and only_if_exists set to false. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_072: [ If condition_check_func is not NULL, it shall be called with condition_check_context and the keys of the new and old items. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_an_existing_key_replaces_the_item)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, false));
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x4243, (void*)0x2, (void*)0x2));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item_2, test_item_condition_check, (void*)0x4243, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, old_item);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_073: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_when_the_condition_is_not_met_returns_CONDITION_NOT_MET)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    g_condition_check_result = CLDS_CONDITION_CHECK_NOT_MET;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, false));
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x4243, (void*)0x2, (void*)0x2));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item, test_item_condition_check, (void*)0x4243, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_064: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_NULL_table_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(NULL, test_context.hazard_pointers_thread, (void*)0x2, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_065: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, NULL, (void*)0x2, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_066: [ If key is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, NULL, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_067: [ If new_item is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_NULL_new_item_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, NULL, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_068: [ If old_item is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_NULL_old_item_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_069: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_non_NULL_sequence_number_but_NULL_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item, NULL, NULL, &old_item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_074: [ If any error is encountered, clds_split_ordered_hash_table_set_value shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_set_value_fails_clds_split_ordered_hash_table_set_value_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL, IGNORED_ARG, IGNORED_ARG, NULL, false))
+        .SetReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT result = clds_split_ordered_hash_table_set_value(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x2, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_find */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_079: [ clds_split_ordered_hash_table_find shall find the key in the list of its bucket by calling clds_sorted_list_find_key and return the item with its reference count incremented. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_finds_the_key)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 8, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = clds_split_ordered_hash_table_find(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_080: [ If the key is not found, clds_split_ordered_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_with_a_key_that_is_not_in_the_table_returns_NULL)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = clds_split_ordered_hash_table_find(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_076: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_with_NULL_table_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = clds_split_ordered_hash_table_find(NULL, test_context.hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_077: [ If clds_hazard_pointers_thread is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = clds_split_ordered_hash_table_find(split_ordered_hash_table, NULL, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_078: [ If key is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = clds_split_ordered_hash_table_find(split_ordered_hash_table, test_context.hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_081: [ If any error occurs, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(when_creating_the_bucket_start_node_fails_clds_split_ordered_hash_table_find_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_create(IGNORED_ARG, NULL, NULL))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = clds_split_ordered_hash_table_find(split_ordered_hash_table, test_context.hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_snapshot */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_054: [ clds_split_ordered_hash_table_snapshot shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_086: [ If there are no items then clds_split_ordered_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_060: [ clds_split_ordered_hash_table_snapshot shall unlock the table for writes. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_no_items_succeeds)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(items);
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_055: [ clds_split_ordered_hash_table_snapshot shall allocate an array of CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* sized by the item count of the table. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_056: [ clds_split_ordered_hash_table_snapshot shall walk the list by calling clds_sorted_list_visit and add each item to the array, incrementing its reference count. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_057: [ clds_split_ordered_hash_table_snapshot shall skip the bucket start nodes. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_059: [ clds_split_ordered_hash_table_snapshot shall store the allocated array of items in items and the count of items in item_count and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_items_in_2_buckets_returns_the_items_in_split_order)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 4, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x1);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_inc_ref((CLDS_SORTED_LIST_ITEM*)item_2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_inc_ref((CLDS_SORTED_LIST_ITEM*)item_1));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    // bucket 2 sorts before bucket 1 in split order
+    ASSERT_ARE_EQUAL(void_ptr, item_2, items[0]);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, items[1]);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[1]);
+    free(items);
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_082: [ If clds_split_ordered_hash_table is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_NULL_table_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(NULL, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_083: [ If clds_hazard_pointers_thread is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, NULL, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_084: [ If items is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_NULL_items_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, test_context.hazard_pointers_thread, NULL, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_085: [ If item_count is NULL then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_NULL_item_count_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, test_context.hazard_pointers_thread, &items, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_087: [ If there are any other failures then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(when_allocating_the_items_array_fails_clds_split_ordered_hash_table_snapshot_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, test_context.hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_058: [ If cancellation_token is non-NULL and cancellation_token_is_canceled returns true for cancellation_token, clds_split_ordered_hash_table_snapshot shall fail and return CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ABANDONED. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_a_cancelled_token_is_abandoned)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, NULL, NULL, NULL);
+    (void)insert_test_item(split_ordered_hash_table, &test_context, (void*)0x2);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    THANDLE(CANCELLATION_TOKEN) cancellation_token = cancellation_token_create(true);
+    ASSERT_IS_NOT_NULL(cancellation_token);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_2(1, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_sorted_list_visit(IGNORED_ARG, test_context.hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(cancellation_token_is_canceled(cancellation_token));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT result = clds_split_ordered_hash_table_snapshot(split_ordered_hash_table, test_context.hazard_pointers_thread, &items, &item_count, cancellation_token);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_RESULT, CLDS_SPLIT_ORDERED_HASH_TABLE_SNAPSHOT_ABANDONED, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+    THANDLE_ASSIGN(CANCELLATION_TOKEN)(&cancellation_token, NULL);
+}
+
+/* on_sorted_list_skipped_seq_no */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_061: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_context_returns)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    void* test_on_sorted_list_skipped_seq_no_context;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &test_context.start_seq_no, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
+        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    test_on_sorted_list_skipped_seq_no(NULL, 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_062: [ If the sequence number callback passed to clds_split_ordered_hash_table_create was NULL, on_sorted_list_skipped_seq_no shall return. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_table_skipped_seq_no_cb_returns)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    void* test_on_sorted_list_skipped_seq_no_context;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &test_context.start_seq_no, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
+        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, NULL, NULL);
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+    umock_c_reset_all_calls();
+
+    // act
+    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_063: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_split_ordered_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_calls_the_table_skipped_seq_no_cb)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_TEST_CONTEXT test_context;
+    setup_test_context(&test_context);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    void* test_on_sorted_list_skipped_seq_no_context;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_config_init(IGNORED_ARG, test_context.hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &test_context.start_seq_no, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
+        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE split_ordered_hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 2, test_context.hazard_pointers, &test_context.start_seq_no, test_skipped_seq_no_cb, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(split_ordered_hash_table);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x5556, 42));
+
+    // act
+    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(split_ordered_hash_table);
+    destroy_test_context(&test_context);
+}
+
+/* clds_split_ordered_hash_table_node_create */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_088: [ clds_split_ordered_hash_table_node_create shall allocate a node of node_size bytes, store item_cleanup_callback and item_cleanup_callback_context in it and set its reference count to 1. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_node_create_succeeds)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_089: [ If any error happens, clds_split_ordered_hash_table_node_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_malloc_fails_clds_split_ordered_hash_table_node_create_fails)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(item);
+}
+
+/* clds_split_ordered_hash_table_node_inc_ref */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_090: [ If item is NULL, clds_split_ordered_hash_table_node_inc_ref shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_node_inc_ref_with_NULL_item_fails)
+{
+    // arrange
+
+    // act
+    int result = clds_split_ordered_hash_table_node_inc_ref(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_091: [ clds_split_ordered_hash_table_node_inc_ref shall increment the reference count of item by calling clds_sorted_list_node_inc_ref. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_093: [ clds_split_ordered_hash_table_node_release shall release the item by calling clds_sorted_list_node_release, which calls item_cleanup_callback when the reference count reaches 0. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_node_inc_ref_and_release_maintain_the_reference_count)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_inc_ref((CLDS_SORTED_LIST_ITEM*)item));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release((CLDS_SORTED_LIST_ITEM*)item));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+
+    // act
+    int result = clds_split_ordered_hash_table_node_inc_ref(item);
+    clds_split_ordered_hash_table_node_release(item);
+    clds_split_ordered_hash_table_node_release(item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_07_092: [ If item is NULL, clds_split_ordered_hash_table_node_release shall return. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_node_release_with_NULL_item_returns)
+{
+    // arrange
+
+    // act
+    clds_split_ordered_hash_table_node_release(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
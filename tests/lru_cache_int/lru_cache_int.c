@@ -26,7 +26,9 @@
 #include "clds/clds_hash_table.h"
 
 #include "c_util/hash.h"
+#ifdef _MSC_VER
 #include "c_util/thread_notifications_dispatcher.h"
+#endif
 
 #include "clds/lru_cache.h"
 
@@ -183,12 +185,16 @@ TEST_SUITE_CLEANUP(suite_cleanup)
 
 TEST_FUNCTION_INITIALIZE(method_init)
 {
+#ifdef _MSC_VER
     ASSERT_ARE_EQUAL(int, 0, thread_notifications_dispatcher_init());
+#endif
 }
 
 TEST_FUNCTION_CLEANUP(method_cleanup)
 {
+#ifdef _MSC_VER
     thread_notifications_dispatcher_deinit();
+#endif
 }
 
 typedef struct EVICT_CONTEXT_TAG
@@ -119,6 +119,7 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_BATCH_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CONDITION_CHECK_CB, void*);
 
     REGISTER_TYPE(LRU_CACHE_PUT_RESULT, LRU_CACHE_PUT_RESULT);
@@ -168,6 +169,8 @@ static void setup_ignore_hazard_pointers_calls(void)
         .IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
         .IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim_batched(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .IgnoreAllCalls();
 }
 
 static void setup_lock_and_inserttail()
@@ -5,6 +5,7 @@
 #include "real_clds_sorted_list_renames.h"
 #include "real_clds_hazard_pointers_renames.h"
 #include "real_sync_renames.h"
+#include "real_threadapi_renames.h"
 #include "real_interlocked_renames.h"
 #include "real_cancellation_token_renames.h"
 
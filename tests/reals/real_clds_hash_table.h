@@ -18,29 +18,69 @@
 #define REGISTER_CLDS_HASH_TABLE_GLOBAL_MOCK_HOOKS() \
     MU_FOR_EACH_1(R2, \
         clds_hash_table_create, \
+        clds_hash_table_create_with_hash_finalizer, \
         clds_hash_table_destroy, \
         clds_hash_table_insert, \
+        clds_hash_table_get_or_insert, \
+        clds_hash_table_compute_if_absent, \
         clds_hash_table_delete, \
         clds_hash_table_delete_key_value, \
         clds_hash_table_remove, \
         clds_hash_table_set_value, \
         clds_hash_table_find, \
+        clds_hash_table_find_and_visit, \
+        clds_hash_table_find_batch, \
+        clds_hash_table_insert_batch, \
+        clds_hash_table_delete_batch, \
         clds_hash_table_node_create, \
         clds_hash_table_node_inc_ref, \
         clds_hash_table_node_release, \
-        clds_hash_table_snapshot \
+        clds_hash_table_snapshot, \
+        clds_hash_table_snapshot_concurrent, \
+        clds_hash_table_snapshot_parallel, \
+        clds_hash_table_iterate_begin, \
+        clds_hash_table_iterate_next, \
+        clds_hash_table_iterate_end, \
+        clds_hash_table_migrate, \
+        clds_hash_table_set_migration_budget, \
+        clds_hash_table_reserve, \
+        clds_hash_table_bulk_load, \
+        clds_hash_table_snapshot_image_write, \
+        clds_hash_table_snapshot_image_get_info, \
+        clds_hash_table_snapshot_image_find, \
+        clds_hash_table_restore \
     )
 
 
 CLDS_HASH_TABLE_HANDLE real_clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context);
+CLDS_HASH_TABLE_HANDLE real_clds_hash_table_create_with_hash_finalizer(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context, CLDS_HASH_TABLE_HASH_FINALIZER hash_finalizer);
 void real_clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table);
 CLDS_HASH_TABLE_INSERT_RESULT real_clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number);
+CLDS_HASH_TABLE_INSERT_RESULT real_clds_hash_table_get_or_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, CLDS_HASH_TABLE_ITEM** existing_item, int64_t* sequence_number);
+CLDS_HASH_TABLE_INSERT_RESULT real_clds_hash_table_compute_if_absent(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, HASH_TABLE_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number);
 CLDS_HASH_TABLE_DELETE_RESULT real_clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number);
 CLDS_HASH_TABLE_DELETE_RESULT real_clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number);
 CLDS_HASH_TABLE_REMOVE_RESULT real_clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number);
 CLDS_HASH_TABLE_ITEM* real_clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+CLDS_HASH_TABLE_FIND_AND_VISIT_RESULT real_clds_hash_table_find_and_visit(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, HASH_TABLE_FIND_VISIT_CB visit_cb, void* visit_cb_context);
+int real_clds_hash_table_find_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, CLDS_HASH_TABLE_ITEM** items);
+int real_clds_hash_table_insert_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, CLDS_HASH_TABLE_ITEM** values, uint32_t key_count, CLDS_HASH_TABLE_INSERT_RESULT* results, int64_t* sequence_numbers);
+int real_clds_hash_table_delete_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, CLDS_HASH_TABLE_DELETE_RESULT* results, int64_t* sequence_numbers);
 CLDS_HASH_TABLE_SET_VALUE_RESULT real_clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number);
 CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, THANDLE(CANCELLATION_TOKEN) cancellation_token);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_concurrent(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, int64_t* sequence_number, THANDLE(CANCELLATION_TOKEN) cancellation_token);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_parallel(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t worker_count, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, THANDLE(CANCELLATION_TOKEN) cancellation_token);
+CLDS_HASH_TABLE_ITERATOR_HANDLE real_clds_hash_table_iterate_begin(CLDS_HASH_TABLE_HANDLE clds_hash_table);
+CLDS_HASH_TABLE_ITERATE_RESULT real_clds_hash_table_iterate_next(CLDS_HASH_TABLE_ITERATOR_HANDLE iterator, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM** items, uint32_t max_item_count, uint32_t* item_count);
+void real_clds_hash_table_iterate_end(CLDS_HASH_TABLE_ITERATOR_HANDLE iterator);
+CLDS_HASH_TABLE_MIGRATE_RESULT real_clds_hash_table_migrate(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t bucket_budget);
+int real_clds_hash_table_set_migration_budget(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t bucket_budget);
+CLDS_HASH_TABLE_RESERVE_RESULT real_clds_hash_table_reserve(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count);
+int real_clds_hash_table_bulk_load(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t worker_count, void** keys, CLDS_HASH_TABLE_ITEM** values, uint32_t key_count, CLDS_HASH_TABLE_INSERT_RESULT* results, int64_t* sequence_numbers);
+int real_clds_hash_table_snapshot_image_write(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HASH_TABLE_ITEM** items, uint64_t item_count, int64_t sequence_number, HASH_TABLE_GET_RECORD_SIZE_CB get_record_size, HASH_TABLE_SERIALIZE_RECORD_CB serialize_record, void* serialize_context, HASH_TABLE_WRITE_SNAPSHOT_IMAGE_CB write_image, void* write_image_context, uint64_t* image_size);
+int real_clds_hash_table_snapshot_image_get_info(const void* image, uint64_t image_size, uint64_t* record_count, int64_t* sequence_number);
+CLDS_HASH_TABLE_SNAPSHOT_IMAGE_FIND_RESULT real_clds_hash_table_snapshot_image_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, const void* image, uint64_t image_size, void* key, HASH_TABLE_RECORD_MATCH_CB record_match, void* record_match_context, const unsigned char** record, uint32_t* record_size);
+int real_clds_hash_table_restore(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t worker_count, const void* image, uint64_t image_size, HASH_TABLE_DESERIALIZE_RECORD_CB deserialize_record, void* deserialize_context, int64_t* sequence_number);
 
 // helper APIs for creating/destroying a hash table node
 CLDS_HASH_TABLE_ITEM* real_clds_hash_table_node_create(size_t node_size, HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
@@ -2,14 +2,34 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #define clds_hash_table_create real_clds_hash_table_create
+#define clds_hash_table_create_with_hash_finalizer real_clds_hash_table_create_with_hash_finalizer
 #define clds_hash_table_destroy real_clds_hash_table_destroy
 #define clds_hash_table_insert real_clds_hash_table_insert
+#define clds_hash_table_get_or_insert real_clds_hash_table_get_or_insert
+#define clds_hash_table_compute_if_absent real_clds_hash_table_compute_if_absent
 #define clds_hash_table_delete real_clds_hash_table_delete
 #define clds_hash_table_delete_key_value real_clds_hash_table_delete_key_value
 #define clds_hash_table_remove real_clds_hash_table_remove
 #define clds_hash_table_set_value real_clds_hash_table_set_value
 #define clds_hash_table_find real_clds_hash_table_find
+#define clds_hash_table_find_and_visit real_clds_hash_table_find_and_visit
+#define clds_hash_table_find_batch real_clds_hash_table_find_batch
+#define clds_hash_table_insert_batch real_clds_hash_table_insert_batch
+#define clds_hash_table_delete_batch real_clds_hash_table_delete_batch
 #define clds_hash_table_node_create real_clds_hash_table_node_create
 #define clds_hash_table_node_inc_ref real_clds_hash_table_node_inc_ref
 #define clds_hash_table_node_release real_clds_hash_table_node_release
 #define clds_hash_table_snapshot real_clds_hash_table_snapshot
+#define clds_hash_table_snapshot_concurrent real_clds_hash_table_snapshot_concurrent
+#define clds_hash_table_snapshot_parallel real_clds_hash_table_snapshot_parallel
+#define clds_hash_table_iterate_begin real_clds_hash_table_iterate_begin
+#define clds_hash_table_iterate_next real_clds_hash_table_iterate_next
+#define clds_hash_table_iterate_end real_clds_hash_table_iterate_end
+#define clds_hash_table_migrate real_clds_hash_table_migrate
+#define clds_hash_table_set_migration_budget real_clds_hash_table_set_migration_budget
+#define clds_hash_table_reserve real_clds_hash_table_reserve
+#define clds_hash_table_bulk_load real_clds_hash_table_bulk_load
+#define clds_hash_table_snapshot_image_write real_clds_hash_table_snapshot_image_write
+#define clds_hash_table_snapshot_image_get_info real_clds_hash_table_snapshot_image_get_info
+#define clds_hash_table_snapshot_image_find real_clds_hash_table_snapshot_image_find
+#define clds_hash_table_restore real_clds_hash_table_restore
@@ -12,25 +12,36 @@
 #define REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS() \
     MU_FOR_EACH_1(R2, \
         clds_hazard_pointers_create, \
+        clds_hazard_pointers_create_with_reclamation_mode, \
         clds_hazard_pointers_destroy, \
         clds_hazard_pointers_register_thread, \
         clds_hazard_pointers_unregister_thread, \
         clds_hazard_pointers_acquire, \
         clds_hazard_pointers_release, \
         clds_hazard_pointers_reclaim, \
-        clds_hazard_pointers_set_reclaim_threshold \
+        clds_hazard_pointers_reclaim_batched, \
+        clds_hazard_pointers_set_reclaim_threshold, \
+        clds_hazard_pointers_set_adaptive_reclaim_threshold, \
+        clds_hazard_pointers_get_reclaim_backlog, \
+        clds_hazard_pointers_set_async_reclaim \
     )
 
 #include <stddef.h>
+#include <stdint.h>
 
 CLDS_HAZARD_POINTERS_HANDLE real_clds_hazard_pointers_create(void);
+CLDS_HAZARD_POINTERS_HANDLE real_clds_hazard_pointers_create_with_reclamation_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode);
 void real_clds_hazard_pointers_destroy(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
 CLDS_HAZARD_POINTERS_THREAD_HANDLE real_clds_hazard_pointers_register_thread(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
 void real_clds_hazard_pointers_unregister_thread(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread);
 CLDS_HAZARD_POINTER_RECORD_HANDLE real_clds_hazard_pointers_acquire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node);
 void real_clds_hazard_pointers_release(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record);
 void real_clds_hazard_pointers_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, RECLAIM_FUNC reclaim_func);
+void real_clds_hazard_pointers_reclaim_batched(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, RECLAIM_BATCH_FUNC reclaim_batch_func);
 int real_clds_hazard_pointers_set_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t reclaim_threshold);
+int real_clds_hazard_pointers_set_adaptive_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t max_reclaim_threshold);
+int real_clds_hazard_pointers_get_reclaim_backlog(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint64_t* reclaim_backlog);
+int real_clds_hazard_pointers_set_async_reclaim(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t max_reclaim_backlog);
 
 
 #endif // REAL_CLDS_HAZARD_POINTERS_H
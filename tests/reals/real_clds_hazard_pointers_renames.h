@@ -5,11 +5,16 @@
 #include "real_worker_thread_renames.h"
 
 #define clds_hazard_pointers_create real_clds_hazard_pointers_create
+#define clds_hazard_pointers_create_with_reclamation_mode real_clds_hazard_pointers_create_with_reclamation_mode
 #define clds_hazard_pointers_destroy real_clds_hazard_pointers_destroy
 #define clds_hazard_pointers_register_thread real_clds_hazard_pointers_register_thread
 #define clds_hazard_pointers_unregister_thread real_clds_hazard_pointers_unregister_thread
 #define clds_hazard_pointers_acquire real_clds_hazard_pointers_acquire
 #define clds_hazard_pointers_release real_clds_hazard_pointers_release
 #define clds_hazard_pointers_reclaim real_clds_hazard_pointers_reclaim
+#define clds_hazard_pointers_reclaim_batched real_clds_hazard_pointers_reclaim_batched
 #define clds_hazard_pointers_set_reclaim_threshold real_clds_hazard_pointers_set_reclaim_threshold
+#define clds_hazard_pointers_set_adaptive_reclaim_threshold real_clds_hazard_pointers_set_adaptive_reclaim_threshold
+#define clds_hazard_pointers_get_reclaim_backlog real_clds_hazard_pointers_get_reclaim_backlog
+#define clds_hazard_pointers_set_async_reclaim real_clds_hazard_pointers_set_async_reclaim
 
@@ -0,0 +1,9 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include "real_gballoc_hl_renames.h"
+#include "real_clds_hazard_pointers_renames.h"
+
+#include "real_clds_hazard_pointers_thread_helper_renames.h"
+
+#include "../src/clds_hazard_pointers_thread_helper_linux.c"